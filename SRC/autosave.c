@@ -0,0 +1,143 @@
+#ifndef _WIN32
+#define _POSIX_C_SOURCE 200809L
+#endif
+
+#include "autosave.h"
+#include "save_system.h"
+
+#ifndef _WIN32
+#include <pthread.h>
+#endif
+
+// The worker writes one snapshot while the game may refill the other
+static SaveData autosave_buffers[2];
+static int8_t autosave_pending = -1;  // Snapshot waiting to be written
+static int8_t autosave_writing = -1;  // Snapshot being written
+static AutosaveStats autosave_stats;
+
+static bool autosave_has_game(void) {
+    return g_game_state.party && g_game_state.party->member_count > 0;
+}
+
+#ifndef _WIN32
+// Held only to hand snapshots over, never across disk I/O
+static pthread_mutex_t autosave_lock = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t autosave_wake = PTHREAD_COND_INITIALIZER;  // Snapshot waiting, or stopping
+static pthread_cond_t autosave_idle = PTHREAD_COND_INITIALIZER;  // A write finished
+static pthread_t autosave_thread;
+static bool autosave_running;
+static bool autosave_stopping;
+
+static void* autosave_worker_main(void* arg) {
+    (void)arg;
+    pthread_mutex_lock(&autosave_lock);
+
+    for (;;) {
+        while (autosave_pending < 0 && !autosave_stopping) {
+            pthread_cond_wait(&autosave_wake, &autosave_lock);
+        }
+        if (autosave_pending < 0) break; // Stopping, and everything is written
+
+        int8_t snapshot = autosave_pending;
+        autosave_writing = snapshot;
+        autosave_pending = -1;
+        pthread_mutex_unlock(&autosave_lock);
+
+        bool saved = save_autosave_data(&autosave_buffers[snapshot]);
+
+        pthread_mutex_lock(&autosave_lock);
+        if (saved) {
+            autosave_stats.writes++;
+        } else {
+            autosave_stats.failures++;
+        }
+        autosave_writing = -1;
+        pthread_cond_broadcast(&autosave_idle);
+    }
+
+    pthread_mutex_unlock(&autosave_lock);
+    return NULL;
+}
+#endif
+
+bool autosave_start(void) {
+#ifndef _WIN32
+    if (autosave_running) return true;
+
+    autosave_stopping = false;
+    autosave_running = pthread_create(&autosave_thread, NULL, autosave_worker_main, NULL) == 0;
+    return autosave_running;
+#else
+    return false;
+#endif
+}
+
+void autosave_request(void) {
+    if (!autosave_has_game()) return;
+
+#ifndef _WIN32
+    if (autosave_running) {
+        pthread_mutex_lock(&autosave_lock);
+
+        // Whichever buffer the worker is not writing; a snapshot still
+        // waiting there is simply replaced by this newer one
+        int8_t target = autosave_writing == 0 ? 1 : 0;
+        if (autosave_pending >= 0) autosave_stats.coalesced++;
+
+        save_data_from_game_state(&autosave_buffers[target]);
+        autosave_pending = target;
+        autosave_stats.requests++;
+
+        pthread_cond_signal(&autosave_wake);
+        pthread_mutex_unlock(&autosave_lock);
+        return;
+    }
+#endif
+
+    save_data_from_game_state(&autosave_buffers[0]);
+    autosave_stats.requests++;
+    if (save_autosave_data(&autosave_buffers[0])) {
+        autosave_stats.writes++;
+    } else {
+        autosave_stats.failures++;
+    }
+}
+
+void autosave_flush(void) {
+#ifndef _WIN32
+    if (!autosave_running) return;
+
+    pthread_mutex_lock(&autosave_lock);
+    while (autosave_pending >= 0 || autosave_writing >= 0) {
+        pthread_cond_wait(&autosave_idle, &autosave_lock);
+    }
+    pthread_mutex_unlock(&autosave_lock);
+#endif
+}
+
+void autosave_stop(void) {
+#ifndef _WIN32
+    if (!autosave_running) return;
+
+    pthread_mutex_lock(&autosave_lock);
+    autosave_stopping = true;
+    pthread_cond_signal(&autosave_wake);
+    pthread_mutex_unlock(&autosave_lock);
+
+    // The worker drains the waiting snapshot before it exits
+    pthread_join(autosave_thread, NULL);
+    autosave_running = false;
+#endif
+}
+
+AutosaveStats autosave_get_stats(void) {
+    AutosaveStats stats;
+#ifndef _WIN32
+    pthread_mutex_lock(&autosave_lock);
+    stats = autosave_stats;
+    pthread_mutex_unlock(&autosave_lock);
+#else
+    stats = autosave_stats;
+#endif
+    return stats;
+}
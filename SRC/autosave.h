@@ -0,0 +1,28 @@
+#ifndef AUTOSAVE_H
+#define AUTOSAVE_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+// Background autosave
+// At safe points (floor change, battle end, town entry) the game copies its
+// state into one of two preallocated snapshots and carries on; a worker
+// thread serializes the newest snapshot and commits it to AUTOSAVE_FILE
+// through the normal atomic save path. A request that arrives while a write
+// is running replaces the snapshot still waiting, so a burst of safe points
+// costs one write. Windows builds write on the calling thread.
+
+typedef struct {
+    uint32_t requests;   // Snapshots taken
+    uint32_t coalesced;  // Snapshots replaced before the worker got to them
+    uint32_t writes;     // Snapshots committed
+    uint32_t failures;   // Commits that failed (the previous autosave is kept)
+} AutosaveStats;
+
+bool autosave_start(void);        // False if no worker could be started (requests then write inline)
+void autosave_request(void);      // Safe point: snapshot now, write later
+void autosave_flush(void);        // Waits until every requested snapshot is on disk
+void autosave_stop(void);         // Flushes, then ends the worker
+AutosaveStats autosave_get_stats(void);
+
+#endif // AUTOSAVE_H
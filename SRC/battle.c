@@ -1,12 +1,14 @@
 #include "battle.h"
 #include "game_state.h"
 #include "inventory.h"
+#include "screen.h"
 #include "utils.h"
 #include <stdlib.h>
 #include <string.h>
 #include <stdio.h>
 
 BattleState g_battle_state;
+BattleEventRing g_battle_events;
 
 const char* enemy_names[ENEMY_TYPE_COUNT] = {
     "Goblin",
@@ -17,56 +19,233 @@ const char* enemy_names[ENEMY_TYPE_COUNT] = {
     "Demon"
 };
 
-void battle_init(uint8_t dungeon_level, bool is_boss) {
-    memset(&g_battle_state, 0, sizeof(BattleState));
-    
-    g_battle_state.is_boss_battle = is_boss;
-    g_battle_state.battle_won = false;
-    g_battle_state.battle_fled = false;
-    g_battle_state.turn_count = 0;
-    g_battle_state.current_turn = 0;
-    
-    if (is_boss) {
-        g_battle_state.enemy_count = 0;
-        // Boss pointer will be set separately
+// ============================================================================
+// Battle context helpers
+// ============================================================================
+
+void battle_context_init(BattleContext* ctx, BattleState* state, Party* party, Inventory* inventory, RandomStream* rng) {
+    if (!ctx) return;
+
+    ctx->state = state;
+    ctx->party = party;
+    ctx->inventory = inventory;
+    ctx->rng = rng;
+    ctx->loot_rng = rng;
+    ctx->level_rng = rng;
+    ctx->events = NULL;
+}
+
+BattleContext* battle_get_context(void) {
+    static BattleContext interactive_ctx;
+
+    // Rebind every time - the party/inventory pointers change on load
+    battle_context_init(&interactive_ctx, &g_battle_state,
+                        g_game_state.party, g_game_state.inventory,
+                        random_get_stream(RNG_STREAM_BATTLE));
+    interactive_ctx.loot_rng = random_get_stream(RNG_STREAM_LOOT);
+    interactive_ctx.level_rng = random_get_stream(RNG_STREAM_LEVEL_UP);
+    interactive_ctx.events = &g_battle_events;
+    return &interactive_ctx;
+}
+
+// Record an outcome; headless contexts without a ring pay only the NULL check
+static void battle_emit(BattleContext* ctx, BattleEventType type, uint8_t actor, uint8_t target,
+                        uint16_t value, uint16_t extra) {
+    if (ctx->events) {
+        battle_event_push(ctx->events, type, actor, target, value, extra);
+    }
+}
+
+static uint8_t battle_member_id(BattleContext* ctx, PartyMember* member) {
+    return (uint8_t)(member - ctx->party->members);
+}
+
+static uint8_t battle_enemy_id(BattleContext* ctx, Enemy* enemy) {
+    return MAX_PARTY_SIZE + (uint8_t)(enemy - ctx->state->enemies);
+}
+
+static uint8_t battle_random_range(BattleContext* ctx, uint8_t min, uint8_t max) {
+    return (uint8_t)random_stream_range(ctx->rng, min, max);
+}
+
+static bool battle_random_chance(BattleContext* ctx, uint8_t percentage) {
+    return random_stream_chance(ctx->rng, percentage);
+}
+
+// Speed changes and deaths re-key the actor on the turn timeline
+static void battle_refresh_member(BattleContext* ctx, PartyMember* member) {
+    battle_core_refresh_actor(ctx, battle_member_id(ctx, member));
+}
+
+static void battle_refresh_enemy(BattleContext* ctx, Enemy* enemy) {
+    battle_core_refresh_actor(ctx, battle_enemy_id(ctx, enemy));
+}
+
+static void battle_damage_enemy(BattleContext* ctx, Enemy* enemy, uint16_t damage) {
+    uint8_t id = battle_enemy_id(ctx, enemy);
+
+    if (damage >= enemy->current_hp) {
+        enemy->current_hp = 0;
+        enemy->is_alive = false;
+        battle_refresh_enemy(ctx, enemy);
     } else {
-        // Generate random enemies based on dungeon level
-        uint8_t enemy_count = random_range(1, 4);
-        battle_generate_enemies(dungeon_level, enemy_count);
+        enemy->current_hp -= damage;
+    }
+
+    battle_emit(ctx, BATTLE_EVENT_DAMAGE_DEALT, BATTLE_ACTOR_NONE, id, damage, enemy->current_hp);
+    if (!enemy->is_alive) {
+        battle_emit(ctx, BATTLE_EVENT_ACTOR_DEFEATED, BATTLE_ACTOR_NONE, id, 0, 0);
     }
-    
-    battle_calculate_turn_order();
-    
-    printf("\n=== BATTLE START ===\n");
 }
 
-void battle_init_boss(BossData* boss) {
+static void battle_damage_boss(BattleContext* ctx, uint16_t damage) {
+    BossData* boss = ctx->state->boss;
     if (!boss) return;
-    
-    g_battle_state.boss = boss;
-    printf("A boss battle with %s!\n", boss->name);
+
+    if (damage >= boss->current_hp) {
+        boss->current_hp = 0;
+        ctx->state->battle_won = true;
+        battle_core_refresh_actor(ctx, MAX_PARTY_SIZE);
+    } else {
+        boss->current_hp -= damage;
+    }
+
+    battle_emit(ctx, BATTLE_EVENT_DAMAGE_DEALT, BATTLE_ACTOR_NONE, MAX_PARTY_SIZE, damage, boss->current_hp);
+    if (boss->current_hp == 0) {
+        battle_emit(ctx, BATTLE_EVENT_ACTOR_DEFEATED, BATTLE_ACTOR_NONE, MAX_PARTY_SIZE, 0, 0);
+    }
 }
 
-void battle_cleanup(void) {
-    printf("=== BATTLE END ===\n\n");
+static void battle_damage_member(BattleContext* ctx, PartyMember* member, uint16_t damage) {
+    uint8_t id = battle_member_id(ctx, member);
+    bool defeated = character_apply_damage(member, damage);
+
+    battle_emit(ctx, BATTLE_EVENT_DAMAGE_DEALT, BATTLE_ACTOR_NONE, id, damage, member->stats.current_hp);
+    if (defeated) {
+        battle_refresh_member(ctx, member);
+        battle_emit(ctx, BATTLE_EVENT_ACTOR_DEFEATED, BATTLE_ACTOR_NONE, id, 0, 0);
+    }
+}
+
+static void battle_heal_member(BattleContext* ctx, PartyMember* member, uint16_t amount) {
+    if (character_apply_heal(member, amount)) {
+        battle_emit(ctx, BATTLE_EVENT_HEALED, BATTLE_ACTOR_NONE, battle_member_id(ctx, member), amount, 0);
+    }
+}
+
+// Roll a skill's status effect against an enemy; returns true if it landed
+static bool battle_apply_enemy_status(BattleContext* ctx, Enemy* enemy, const Skill* skill) {
+    uint8_t id = battle_enemy_id(ctx, enemy);
+
+    if (battle_random_range(ctx, 1, 100) > skill->status_chance) {
+        battle_emit(ctx, BATTLE_EVENT_STATUS_RESISTED, BATTLE_ACTOR_NONE, id, skill->status_effect, 0);
+        return false;
+    }
+
+    // Add to bitfield
+    enemy->status_effects |= skill->status_effect;
+    battle_refresh_enemy(ctx, enemy);
+    battle_emit(ctx, BATTLE_EVENT_STATUS_APPLIED, BATTLE_ACTOR_NONE, id, skill->status_effect, 0);
+
+    // Add to duration tracker (refresh if already active)
+    for (uint8_t j = 0; j < enemy->status_effect_count; j++) {
+        if (enemy->active_status_effects[j].status_type == skill->status_effect) {
+            enemy->active_status_effects[j].duration = skill->status_duration;
+            return true;
+        }
+    }
+
+    if (enemy->status_effect_count < MAX_STATUS_EFFECTS_PER_CHARACTER) {
+        enemy->active_status_effects[enemy->status_effect_count].status_type = skill->status_effect;
+        enemy->active_status_effects[enemy->status_effect_count].duration = skill->status_duration;
+        enemy->status_effect_count++;
+    }
+
+    return true;
+}
+
+// Count down an enemy's status durations at the start of its turn
+static void battle_tick_enemy_status(BattleContext* ctx, Enemy* enemy) {
+    uint8_t before = enemy->status_effects;
+
+    for (uint8_t i = 0; i < enemy->status_effect_count; ) {
+        ActiveStatusEffect* effect = &enemy->active_status_effects[i];
+        if (effect->duration == 255) { // Permanent until cured
+            i++;
+            continue;
+        }
+        if (effect->duration > 0) effect->duration--;
+
+        if (effect->duration == 0) {
+            enemy->status_effects &= ~effect->status_type;
+            enemy->active_status_effects[i] = enemy->active_status_effects[--enemy->status_effect_count];
+        } else {
+            i++;
+        }
+    }
+
+    if (enemy->status_effects != before) {
+        battle_refresh_enemy(ctx, enemy);
+    }
+}
+
+// Pick a random living party member (caller guarantees one exists)
+static PartyMember* battle_random_living_member(BattleContext* ctx) {
+    uint8_t target;
+    do {
+        target = battle_random_range(ctx, 0, ctx->party->member_count - 1);
+    } while (ctx->party->members[target].stats.current_hp == 0);
+
+    return &ctx->party->members[target];
+}
+
+// ============================================================================
+// Headless battle core
+// ============================================================================
+
+void battle_core_start(BattleContext* ctx, const EncounterTable* table, bool is_boss) {
+    BattleState* state = ctx->state;
+    memset(state, 0, sizeof(BattleState));
+
+    state->is_boss_battle = is_boss;
+
+    if (!is_boss) {
+        // One weighted formation from the zone or floor table
+        battle_core_generate_enemies(ctx, encounter_table_pick(table, ctx->rng));
+    }
+    // Boss pointer is bound separately with battle_core_set_boss
+
+    battle_core_calculate_turn_order(ctx);
+}
+
+void battle_core_set_boss(BattleContext* ctx, BossData* boss) {
+    if (!boss) return;
+
+    ctx->state->boss = boss;
+
+    // The boss acts in the first enemy slot
+    battle_core_calculate_turn_order(ctx);
 }
 
-void battle_generate_enemies(uint8_t dungeon_level, uint8_t count) {
+void battle_core_generate_enemies(BattleContext* ctx, const EncounterFormation* formation) {
+    BattleState* state = ctx->state;
+    if (!formation) return;
+
+    uint8_t count = formation->count;
     if (count > MAX_ENEMIES) count = MAX_ENEMIES;
     
-    g_battle_state.enemy_count = count;
+    state->enemy_count = count;
     
     for (uint8_t i = 0; i < count; i++) {
-        Enemy* enemy = &g_battle_state.enemies[i];
+        Enemy* enemy = &state->enemies[i];
         
-        // Random enemy type based on dungeon level
-        EnemyType type = random_range(0, (dungeon_level < 3) ? 3 : ENEMY_TYPE_COUNT - 1);
+        EnemyType type = (formation->enemies[i] < ENEMY_TYPE_COUNT) ? (EnemyType)formation->enemies[i] : ENEMY_GOBLIN;
         enemy->type = type;
         
         safe_string_copy(enemy->name, enemy_names[type], MAX_NAME_LENGTH);
         
-        // Stats based on type and level
-        enemy->level = dungeon_level + random_range(0, 3);
+        // Stats based on type and a level rolled in the formation's band
+        enemy->level = battle_random_range(ctx, formation->level_min, formation->level_max);
         enemy->max_hp = 20 + (enemy->level * 5) + (type * 10);
         enemy->current_hp = enemy->max_hp;
         enemy->attack = 5 + (enemy->level * 2) + type;
@@ -78,83 +257,244 @@ void battle_generate_enemies(uint8_t dungeon_level, uint8_t count) {
         enemy->item_stolen = false; // Initialize steal tracking
         enemy->buff_count = 0;
 
-        printf("Enemy %d: %s (Lv%d)\n", i+1, enemy->name, enemy->level);
+        battle_emit(ctx, BATTLE_EVENT_ENEMY_APPEARED, BATTLE_ACTOR_NONE, battle_enemy_id(ctx, enemy),
+                    enemy->level, 0);
     }
 }
 
-void battle_calculate_turn_order(void) {
-    // Simple implementation: party members first, then enemies
-    // In a real implementation, this would be sorted by agility
-    
-    uint8_t order_index = 0;
-    
-    // Add party members
-    for (uint8_t i = 0; i < g_game_state.party->member_count; i++) {
-        g_battle_state.turn_order[order_index++] = i;
-    }
-    
-    // Add enemies (offset by party size)
-    for (uint8_t i = 0; i < g_battle_state.enemy_count; i++) {
-        g_battle_state.turn_order[order_index++] = MAX_PARTY_SIZE + i;
+// ============================================================================
+// Turn timeline
+// ============================================================================
+
+// Sum of magnitudes for one buff type (enemies and bosses keep raw buff arrays)
+static int16_t battle_buff_total(const ActiveBuff* buffs, uint8_t count, BuffType type) {
+    int16_t total = 0;
+    for (uint8_t i = 0; i < count; i++) {
+        if (buffs[i].type == type) {
+            total += buffs[i].magnitude;
+        }
     }
-    
-    g_battle_state.turn_count = order_index;
+    return total;
 }
 
-void battle_execute_turn(void) {
-    if (battle_is_over()) return;
-    
-    uint8_t actor = g_battle_state.turn_order[g_battle_state.current_turn];
-    
-    // Determine if actor is party member or enemy
-    if (actor < MAX_PARTY_SIZE) {
-        // Party member turn - wait for player input
-        PartyMember* member = party_get_member(g_game_state.party, actor);
-        if (member && member->stats.current_hp > 0) {
-            printf("\n%s's turn!\n", member->name);
-            // Player will input action through main game loop
-        }
+static uint8_t battle_apply_agility_buffs(uint8_t agility, const ActiveBuff* buffs, uint8_t count) {
+    int16_t buff_mod = battle_buff_total(buffs, count, BUFF_AGI_UP);
+    buff_mod -= battle_buff_total(buffs, count, BUFF_AGI_DOWN);
+    if (buff_mod == 0) return agility;
+
+    int16_t modified = agility + (agility * buff_mod) / 100;
+    if (modified < 1) modified = 1;
+    if (modified > 255) modified = 255;
+    return (uint8_t)modified;
+}
+
+uint8_t battle_core_effective_agility(BattleContext* ctx, uint8_t actor) {
+    BattleState* state = ctx->state;
+    uint8_t agility = 0;
+    bool slowed = false;
+
+    if (!BATTLE_ACTOR_IS_ENEMY(actor)) {
+        if (actor >= ctx->party->member_count) return 0;
+
+        PartyMember* member = &ctx->party->members[actor];
+        if (member->stats.current_hp == 0) return 0;
+
+        // Includes accessory bonus and BUFF_AGI_UP/DOWN
+        agility = character_calc_total_agility(member, ctx->inventory);
+        slowed = (member->status_effects & STATUS_SLOW) != 0;
+    } else if (state->is_boss_battle) {
+        // The boss occupies the first enemy slot
+        BossData* boss = state->boss;
+        if (!boss || actor != MAX_PARTY_SIZE || boss->current_hp == 0) return 0;
+
+        agility = battle_apply_agility_buffs(boss->agility, boss->active_buffs, boss->buff_count);
     } else {
-        // Enemy turn - AI action
         uint8_t enemy_index = actor - MAX_PARTY_SIZE;
-        if (g_battle_state.is_boss_battle && g_battle_state.boss) {
-            // Boss AI
-            // Note: Boss buff updates would go here if implemented
-            printf("\n%s attacks!\n", g_battle_state.boss->name);
+        if (enemy_index >= state->enemy_count) return 0;
+
+        Enemy* enemy = &state->enemies[enemy_index];
+        if (!enemy->is_alive) return 0;
+
+        agility = battle_apply_agility_buffs(enemy->agility, enemy->active_buffs, enemy->buff_count);
+        slowed = (enemy->status_effects & STATUS_SLOW) != 0;
+    }
+
+    // Slow halves agility; every living actor still gets a turn eventually
+    if (slowed) agility /= 2;
+    return agility > 0 ? agility : 1;
+}
+
+static uint32_t battle_timeline_wait(uint8_t speed) {
+    return BATTLE_TIMELINE_SCALE / speed;
+}
+
+// Earlier tick first; ties go to the lower actor ID (party before enemies)
+static bool battle_timeline_before(const BattleTimeline* timeline, uint8_t a, uint8_t b) {
+    if (timeline->next_tick[a] != timeline->next_tick[b]) {
+        return timeline->next_tick[a] < timeline->next_tick[b];
+    }
+    return a < b;
+}
+
+static void battle_timeline_place(BattleTimeline* timeline, uint8_t slot, uint8_t actor) {
+    timeline->heap[slot] = actor;
+    timeline->heap_slot[actor] = slot;
+}
+
+static void battle_timeline_sift_up(BattleTimeline* timeline, uint8_t slot) {
+    uint8_t actor = timeline->heap[slot];
+    while (slot > 0) {
+        uint8_t parent = (slot - 1) / 2;
+        if (!battle_timeline_before(timeline, actor, timeline->heap[parent])) break;
+        battle_timeline_place(timeline, slot, timeline->heap[parent]);
+        slot = parent;
+    }
+    battle_timeline_place(timeline, slot, actor);
+}
+
+static void battle_timeline_sift_down(BattleTimeline* timeline, uint8_t slot) {
+    uint8_t actor = timeline->heap[slot];
+    for (;;) {
+        uint8_t child = slot * 2 + 1;
+        if (child >= timeline->count) break;
+        if (child + 1 < timeline->count &&
+            battle_timeline_before(timeline, timeline->heap[child + 1], timeline->heap[child])) {
+            child++;
+        }
+        if (!battle_timeline_before(timeline, timeline->heap[child], actor)) break;
+        battle_timeline_place(timeline, slot, timeline->heap[child]);
+        slot = child;
+    }
+    battle_timeline_place(timeline, slot, actor);
+}
+
+static void battle_timeline_insert(BattleTimeline* timeline, uint8_t actor, uint8_t speed) {
+    timeline->speed[actor] = speed;
+    timeline->next_tick[actor] = timeline->now + battle_timeline_wait(speed);
+    battle_timeline_place(timeline, timeline->count++, actor);
+    battle_timeline_sift_up(timeline, timeline->heap_slot[actor]);
+}
+
+static void battle_timeline_remove(BattleTimeline* timeline, uint8_t actor) {
+    if (timeline->speed[actor] == 0) return;
+
+    uint8_t slot = timeline->heap_slot[actor];
+    timeline->speed[actor] = 0;
+    timeline->count--;
+    if (slot == timeline->count) return;
+
+    // Move the last entry into the hole and restore heap order around it
+    uint8_t moved = timeline->heap[timeline->count];
+    battle_timeline_place(timeline, slot, moved);
+    battle_timeline_sift_up(timeline, slot);
+    battle_timeline_sift_down(timeline, timeline->heap_slot[moved]);
+}
+
+void battle_core_calculate_turn_order(BattleContext* ctx) {
+    BattleTimeline* timeline = &ctx->state->timeline;
+    memset(timeline, 0, sizeof(BattleTimeline));
+
+    for (uint8_t actor = 0; actor < BATTLE_MAX_ACTORS; actor++) {
+        uint8_t speed = battle_core_effective_agility(ctx, actor);
+        if (speed > 0) {
+            battle_timeline_insert(timeline, actor, speed);
+        }
+    }
+
+    if (timeline->count > 0) {
+        timeline->now = timeline->next_tick[timeline->heap[0]];
+    }
+}
+
+void battle_core_refresh_actor(BattleContext* ctx, uint8_t actor) {
+    if (actor >= BATTLE_MAX_ACTORS) return;
+
+    BattleTimeline* timeline = &ctx->state->timeline;
+    uint8_t old_speed = timeline->speed[actor];
+    uint8_t new_speed = battle_core_effective_agility(ctx, actor);
+
+    if (new_speed == old_speed) return;
+
+    if (new_speed == 0) {
+        battle_timeline_remove(timeline, actor);
+        return;
+    }
+    if (old_speed == 0) {
+        battle_timeline_insert(timeline, actor, new_speed);
+        return;
+    }
+
+    // Stretch or shrink the remaining wait in proportion to the speed change
+    uint32_t remaining = timeline->next_tick[actor] - timeline->now;
+    remaining = (uint32_t)(((uint64_t)remaining * old_speed) / new_speed);
+    timeline->next_tick[actor] = timeline->now + remaining;
+    timeline->speed[actor] = new_speed;
+
+    battle_timeline_sift_up(timeline, timeline->heap_slot[actor]);
+    battle_timeline_sift_down(timeline, timeline->heap_slot[actor]);
+}
+
+uint8_t battle_core_current_actor(BattleContext* ctx) {
+    BattleTimeline* timeline = &ctx->state->timeline;
+    return timeline->count > 0 ? timeline->heap[0] : BATTLE_ACTOR_NONE;
+}
+
+void battle_core_advance_turn(BattleContext* ctx) {
+    BattleTimeline* timeline = &ctx->state->timeline;
+    if (timeline->count == 0) return;
+
+    // Reschedule the actor that just moved, then jump to the next one
+    uint8_t actor = timeline->heap[0];
+    timeline->next_tick[actor] += battle_timeline_wait(timeline->speed[actor]);
+    battle_timeline_sift_down(timeline, 0);
+    timeline->now = timeline->next_tick[timeline->heap[0]];
+}
+
+void battle_core_enemy_turn(BattleContext* ctx) {
+    BattleState* state = ctx->state;
+    if (battle_core_is_over(ctx)) return;
+
+    uint8_t actor = battle_core_current_actor(ctx);
+    if (actor == BATTLE_ACTOR_NONE || !BATTLE_ACTOR_IS_ENEMY(actor)) return;
+
+    uint8_t enemy_index = actor - MAX_PARTY_SIZE;
+    if (state->is_boss_battle && state->boss) {
+        // Boss AI
+        // Note: Boss buff updates would go here if implemented
+
+        // Choose random party member to attack
+        PartyMember* target_member = battle_random_living_member(ctx);
+        battle_emit(ctx, BATTLE_EVENT_ATTACK, actor, battle_member_id(ctx, target_member), 0, 0);
+        uint16_t damage = battle_core_calculate_damage(ctx, state->boss->attack,
+                                     character_calc_total_defense(target_member, ctx->inventory),
+                                     false);
+        battle_damage_member(ctx, target_member, damage);
+
+    } else if (enemy_index < state->enemy_count) {
+        Enemy* enemy = &state->enemies[enemy_index];
+        if (enemy->is_alive) {
+            battle_tick_enemy_status(ctx, enemy);
 
             // Choose random party member to attack
-            uint8_t target;
-            do {
-                target = random_range(0, g_game_state.party->member_count - 1);
-            } while (g_game_state.party->members[target].stats.current_hp == 0);
-            
-            PartyMember* target_member = &g_game_state.party->members[target];
-            uint16_t damage = battle_calculate_damage(g_battle_state.boss->attack, 
-                                         character_get_total_defense(target_member), 
-                                         false);
-            character_take_damage(target_member, damage);
-            
-        } else if (enemy_index < g_battle_state.enemy_count) {
-            Enemy* enemy = &g_battle_state.enemies[enemy_index];
-            if (enemy->is_alive) {
-                printf("\n%s attacks!\n", enemy->name);
-                
-                // Choose random party member to attack
-                uint8_t target;
-                do {
-                    target = random_range(0, g_game_state.party->member_count - 1);
-                } while (g_game_state.party->members[target].stats.current_hp == 0);
-                
-                PartyMember* target_member = &g_game_state.party->members[target];
-                uint16_t damage = battle_calculate_damage(enemy->attack, 
-                                         character_get_total_defense(target_member), 
-                                         false);
-                character_take_damage(target_member, damage);
-            }
+            PartyMember* target_member = battle_random_living_member(ctx);
+            battle_emit(ctx, BATTLE_EVENT_ATTACK, actor, battle_member_id(ctx, target_member), 0, 0);
+            uint16_t damage = battle_core_calculate_damage(ctx, enemy->attack,
+                                     character_calc_total_defense(target_member, ctx->inventory),
+                                     false);
+            battle_damage_member(ctx, target_member, damage);
         }
-        
-        // Auto-advance to next turn for enemies
-        g_battle_state.current_turn = (g_battle_state.current_turn + 1) % g_battle_state.turn_count;
+    }
+    
+    // Auto-advance to next turn for enemies
+    battle_core_advance_turn(ctx);
+}
+
+void battle_core_run_enemy_turns(BattleContext* ctx) {
+    while (!battle_core_is_over(ctx)) {
+        uint8_t actor = battle_core_current_actor(ctx);
+        if (actor == BATTLE_ACTOR_NONE || !BATTLE_ACTOR_IS_ENEMY(actor)) break;
+
+        battle_core_enemy_turn(ctx);
     }
 }
 
@@ -205,24 +545,26 @@ static const StealableItem stealable_items_by_enemy[ENEMY_TYPE_COUNT][3] = {
     }
 };
 
-// Process steal attempt
-void battle_process_steal(PartyMember* actor, uint8_t target_index) {
-    if (!actor || target_index >= g_battle_state.enemy_count) return;
+void battle_core_steal(BattleContext* ctx, PartyMember* actor, uint8_t target_index) {
+    if (!actor || target_index >= ctx->state->enemy_count) return;
+
+    Enemy* enemy = &ctx->state->enemies[target_index];
+    uint8_t thief = battle_member_id(ctx, actor);
+    uint8_t target = battle_enemy_id(ctx, enemy);
 
-    Enemy* enemy = &g_battle_state.enemies[target_index];
     if (!enemy->is_alive) {
-        printf("%s is already defeated!\n", enemy->name);
+        battle_emit(ctx, BATTLE_EVENT_STEAL_FAILED, thief, target, 0, BATTLE_FAIL_TARGET_DEFEATED);
         return;
     }
 
     // Check if already stolen from this enemy
     if (enemy->item_stolen) {
-        printf("%s has already been stolen from!\n", enemy->name);
+        battle_emit(ctx, BATTLE_EVENT_STEAL_FAILED, thief, target, 0, BATTLE_FAIL_ALREADY_STOLEN);
         return;
     }
 
     // Base success rate: 50% + (Luck / 2)%
-    uint8_t base_success = 50 + (character_get_total_luck(actor) / 2);
+    uint8_t base_success = 50 + (character_calc_total_luck(actor, ctx->inventory) / 2);
     // Penalty based on enemy level
     uint8_t level_penalty = enemy->level * 2;
     uint8_t final_success = (base_success > level_penalty) ? (base_success - level_penalty) : 10;
@@ -231,62 +573,63 @@ void battle_process_steal(PartyMember* actor, uint8_t target_index) {
     if (final_success > 90) final_success = 90;
 
     // Roll for success
-    if (random_range(1, 100) > final_success) {
-        printf("%s's steal attempt failed!\n", actor->name);
+    if (battle_random_range(ctx, 1, 100) > final_success) {
+        battle_emit(ctx, BATTLE_EVENT_STEAL_FAILED, thief, target, 0, BATTLE_FAIL_MISSED);
         return;
     }
 
     // Determine what to steal based on enemy type
     const StealableItem* steal_table = stealable_items_by_enemy[enemy->type];
-    uint8_t roll = random_range(1, 100);
+    uint8_t roll = battle_random_range(ctx, 1, 100);
     uint8_t cumulative_chance = 0;
 
     for (uint8_t i = 0; i < 3; i++) {
         cumulative_chance += steal_table[i].chance;
         if (roll <= cumulative_chance) {
             if (steal_table[i].item_type == ITEM_CONSUMABLE_COUNT) {
-                printf("%s found nothing to steal!\n", actor->name);
+                battle_emit(ctx, BATTLE_EVENT_STEAL_FAILED, thief, target, 0, BATTLE_FAIL_NOTHING_TO_STEAL);
                 return;
             }
 
             // Determine quantity
-            uint8_t quantity = random_range(steal_table[i].quantity_min, steal_table[i].quantity_max);
+            uint8_t quantity = battle_random_range(ctx, steal_table[i].quantity_min, steal_table[i].quantity_max);
 
             // Add item to inventory
-            if (inventory_add_item(g_game_state.inventory, steal_table[i].item_type, quantity)) {
-                Item item = item_create_consumable(steal_table[i].item_type);
-                printf("%s stole %s x%d!\n", actor->name, item.name, quantity);
+            if (inventory_store_item(ctx->inventory, steal_table[i].item_type, quantity)) {
+                battle_emit(ctx, BATTLE_EVENT_ITEM_STOLEN, thief, target, steal_table[i].item_type, quantity);
                 enemy->item_stolen = true; // Mark enemy as stolen from
             } else {
-                printf("%s's inventory is full!\n", actor->name);
+                battle_emit(ctx, BATTLE_EVENT_STEAL_FAILED, thief, target, 0, BATTLE_FAIL_INVENTORY_FULL);
             }
             return;
         }
     }
 
     // Shouldn't reach here, but just in case
-    printf("%s found nothing to steal!\n", actor->name);
+    battle_emit(ctx, BATTLE_EVENT_STEAL_FAILED, thief, target, 0, BATTLE_FAIL_NOTHING_TO_STEAL);
 }
 
-void battle_use_skill(PartyMember* actor, uint8_t skill_id, uint8_t target_index) {
+void battle_core_use_skill(BattleContext* ctx, PartyMember* actor, uint8_t skill_id, uint8_t target_index) {
+    BattleState* state = ctx->state;
     if (!actor) return;
     
+    uint8_t caster = battle_member_id(ctx, actor);
     const Skill* skill = get_skill_data(skill_id);
     if (!skill) {
-        printf("Invalid skill!\n");
+        battle_emit(ctx, BATTLE_EVENT_SKILL_FAILED, caster, BATTLE_ACTOR_NONE, skill_id, BATTLE_FAIL_INVALID_SKILL);
         return;
     }
     
     // Check if can use
     if (!character_can_use_skill(actor, skill_id)) {
-        printf("%s doesn't have enough MP!\n", actor->name);
+        battle_emit(ctx, BATTLE_EVENT_SKILL_FAILED, caster, BATTLE_ACTOR_NONE, skill_id, BATTLE_FAIL_NO_MP);
         return;
     }
     
     // Use MP
     character_use_mp(actor, skill->mp_cost);
     
-    printf("%s uses %s!\n", actor->name, skill->name);
+    battle_emit(ctx, BATTLE_EVENT_SKILL_USED, caster, BATTLE_ACTOR_NONE, skill_id, 0);
     
     // Process skill effect
     switch (skill->type) {
@@ -297,19 +640,19 @@ void battle_use_skill(PartyMember* actor, uint8_t skill_id, uint8_t target_index
 
             switch (skill->scaling_stat) {
                 case SCALE_STRENGTH:
-                    scaling_value = character_get_total_attack(actor);
+                    scaling_value = character_calc_total_attack(actor, ctx->inventory);
                     is_physical = true;
                     break;
                 case SCALE_AGILITY:
-                    scaling_value = character_get_total_agility(actor);
+                    scaling_value = character_calc_total_agility(actor, ctx->inventory);
                     is_physical = true;
                     break;
                 case SCALE_LUCK:
-                    scaling_value = character_get_total_luck(actor);
+                    scaling_value = character_calc_total_luck(actor, ctx->inventory);
                     is_physical = true;
                     break;
                 case SCALE_INTELLIGENCE:
-                    scaling_value = character_get_total_intelligence(actor);
+                    scaling_value = character_calc_total_intelligence(actor, ctx->inventory);
                     is_physical = false;
                     break;
             }
@@ -319,11 +662,11 @@ void battle_use_skill(PartyMember* actor, uint8_t skill_id, uint8_t target_index
 
             // Get enemy defense for physical skills
             if (is_physical) {
-                if (g_battle_state.is_boss_battle) {
-                    enemy_def = g_battle_state.boss->defense;
+                if (state->is_boss_battle) {
+                    enemy_def = state->boss ? state->boss->defense : 0;
                 } else {
-                    if (target_index < g_battle_state.enemy_count) {
-                        enemy_def = g_battle_state.enemies[target_index].defense;
+                    if (target_index < state->enemy_count) {
+                        enemy_def = state->enemies[target_index].defense;
                     }
                 }
 
@@ -338,109 +681,42 @@ void battle_use_skill(PartyMember* actor, uint8_t skill_id, uint8_t target_index
             }
 
             // Add variance (±15%)
-            int variance = random_range(85, 115);
+            int variance = battle_random_range(ctx, 85, 115);
             damage = (damage * variance) / 100;
             if (damage < 1) damage = 1;
             
+            bool has_status = skill->status_effect != STATUS_NONE && skill->status_chance > 0;
+
             if (skill->target_all) {
                 // Hit all enemies
-                printf("Hits all enemies!\n");
-                for (uint8_t i = 0; i < g_battle_state.enemy_count; i++) {
-                    if (g_battle_state.enemies[i].is_alive) {
-                        Enemy* enemy = &g_battle_state.enemies[i];
-                        if (damage >= enemy->current_hp) {
-                            enemy->current_hp = 0;
-                            enemy->is_alive = false;
-                            printf("%s takes %d damage and is defeated!\n", enemy->name, damage);
-                        } else {
-                            enemy->current_hp -= damage;
-                            printf("%s takes %d damage! (%d HP remaining)\n",
-                                   enemy->name, damage, enemy->current_hp);
-
-                            // Apply status effect if skill has one and enemy survived
-                            if (skill->status_effect != STATUS_NONE && skill->status_chance > 0) {
-                                if (random_range(1, 100) <= skill->status_chance) {
-                                    // Add to bitfield
-                                    enemy->status_effects |= skill->status_effect;
-
-                                    // Add to duration tracker
-                                    bool found = false;
-                                    for (uint8_t j = 0; j < enemy->status_effect_count; j++) {
-                                        if (enemy->active_status_effects[j].status_type == skill->status_effect) {
-                                            enemy->active_status_effects[j].duration = skill->status_duration;
-                                            found = true;
-                                            break;
-                                        }
-                                    }
-
-                                    if (!found && enemy->status_effect_count < MAX_STATUS_EFFECTS_PER_CHARACTER) {
-                                        enemy->active_status_effects[enemy->status_effect_count].status_type = skill->status_effect;
-                                        enemy->active_status_effects[enemy->status_effect_count].duration = skill->status_duration;
-                                        enemy->status_effect_count++;
-                                    }
-
-                                    printf("%s is afflicted!\n", enemy->name);
-                                }
-                            }
-                        }
+                for (uint8_t i = 0; i < state->enemy_count; i++) {
+                    Enemy* enemy = &state->enemies[i];
+                    if (!enemy->is_alive) continue;
+
+                    battle_damage_enemy(ctx, enemy, damage);
+
+                    // Apply status effect if skill has one and enemy survived
+                    if (enemy->is_alive && has_status) {
+                        battle_apply_enemy_status(ctx, enemy, skill);
                     }
                 }
-            } else {
+            } else if (state->is_boss_battle) {
                 // Single target
-                if (g_battle_state.is_boss_battle) {
-                    if (damage >= g_battle_state.boss->current_hp) {
-                        g_battle_state.boss->current_hp = 0;
-                        g_battle_state.battle_won = true;
-                        printf("%s takes %d damage and is defeated!\n", g_battle_state.boss->name, damage);
-                    } else {
-                        g_battle_state.boss->current_hp -= damage;
-                        printf("%s takes %d damage! (%d HP remaining)\n", 
-                               g_battle_state.boss->name, damage, g_battle_state.boss->current_hp);
-                    }
-                } else {
-                    // Validate target, find next valid if dead
-                    if (target_index >= g_battle_state.enemy_count ||
-                        !g_battle_state.enemies[target_index].is_alive) {
-                        target_index = battle_find_valid_enemy_target();
-                    }
+                battle_damage_boss(ctx, damage);
+            } else {
+                // Validate target, find next valid if dead
+                if (target_index >= state->enemy_count ||
+                    !state->enemies[target_index].is_alive) {
+                    target_index = battle_core_find_valid_enemy_target(ctx);
+                }
 
-                    Enemy* enemy = &g_battle_state.enemies[target_index];
-                    if (enemy->is_alive) {
-                        if (damage >= enemy->current_hp) {
-                            enemy->current_hp = 0;
-                            enemy->is_alive = false;
-                            printf("%s takes %d damage and is defeated!\n", enemy->name, damage);
-                        } else {
-                            enemy->current_hp -= damage;
-                            printf("%s takes %d damage! (%d HP remaining)\n",
-                                   enemy->name, damage, enemy->current_hp);
-
-                            // Apply status effect if skill has one and enemy survived
-                            if (skill->status_effect != STATUS_NONE && skill->status_chance > 0) {
-                                if (random_range(1, 100) <= skill->status_chance) {
-                                    // Add to bitfield
-                                    enemy->status_effects |= skill->status_effect;
-
-                                    // Add to duration tracker
-                                    bool found = false;
-                                    for (uint8_t j = 0; j < enemy->status_effect_count; j++) {
-                                        if (enemy->active_status_effects[j].status_type == skill->status_effect) {
-                                            enemy->active_status_effects[j].duration = skill->status_duration;
-                                            found = true;
-                                            break;
-                                        }
-                                    }
-
-                                    if (!found && enemy->status_effect_count < MAX_STATUS_EFFECTS_PER_CHARACTER) {
-                                        enemy->active_status_effects[enemy->status_effect_count].status_type = skill->status_effect;
-                                        enemy->active_status_effects[enemy->status_effect_count].duration = skill->status_duration;
-                                        enemy->status_effect_count++;
-                                    }
-
-                                    printf("%s is afflicted with a status effect!\n", enemy->name);
-                                }
-                            }
-                        }
+                Enemy* enemy = &state->enemies[target_index];
+                if (enemy->is_alive) {
+                    battle_damage_enemy(ctx, enemy, damage);
+
+                    // Apply status effect if skill has one and enemy survived
+                    if (enemy->is_alive && has_status) {
+                        battle_apply_enemy_status(ctx, enemy, skill);
                     }
                 }
             }
@@ -452,52 +728,56 @@ void battle_use_skill(PartyMember* actor, uint8_t skill_id, uint8_t target_index
 
             if (skill->target_all) {
                 // Heal entire party
-                printf("Heals entire party!\n");
-                for (uint8_t i = 0; i < g_game_state.party->member_count; i++) {
-                    PartyMember* member = &g_game_state.party->members[i];
+                for (uint8_t i = 0; i < ctx->party->member_count; i++) {
+                    PartyMember* member = &ctx->party->members[i];
                     if (member->stats.current_hp > 0) {
-                        character_heal(member, heal_amount);
+                        battle_heal_member(ctx, member, heal_amount);
                     }
                 }
 
                 // Prayer also grants MP regen to all party members
                 if (skill->skill_id == SKILL_PRAYER) {
-                    printf("%s grants MP regeneration to the party!\n", actor->name);
-                    for (uint8_t i = 0; i < g_game_state.party->member_count; i++) {
-                        PartyMember* member = &g_game_state.party->members[i];
+                    for (uint8_t i = 0; i < ctx->party->member_count; i++) {
+                        PartyMember* member = &ctx->party->members[i];
                         if (member->stats.current_hp > 0) {
                             character_add_buff(member, BUFF_REGEN_MP, 5, 2); // +5 MP per turn for 2 turns
+                            battle_refresh_member(ctx, member);
+                            battle_emit(ctx, BATTLE_EVENT_BUFF_APPLIED, caster, i, BUFF_REGEN_MP, skill_id);
                         }
                     }
                 }
-            } else {
+            } else if (target_index < ctx->party->member_count) {
                 // Single target heal
-                PartyMember* target = &g_game_state.party->members[target_index];
-                character_heal(target, heal_amount);
+                battle_heal_member(ctx, &ctx->party->members[target_index], heal_amount);
             }
             break;
         }
         
         case SKILL_TYPE_BUFF: {
             // Apply buff based on skill ID
+            BuffType buff = BUFF_NONE;
             if (skill->skill_id == SKILL_PROTECT) {
-                character_add_buff(actor, BUFF_DEF_UP, 50, 3); // +50% DEF for 3 turns
-                printf("%s's defense increased!\n", actor->name);
+                buff = BUFF_DEF_UP;
+                character_add_buff(actor, buff, 50, 3); // +50% DEF for 3 turns
             } else if (skill->skill_id == SKILL_COUNTER_STANCE) {
-                character_add_buff(actor, BUFF_COUNTER, 0, 2); // Counter state for 2 turns
-                printf("%s enters counter stance!\n", actor->name);
+                buff = BUFF_COUNTER;
+                character_add_buff(actor, buff, 0, 2); // Counter state for 2 turns
             } else if (skill->skill_id == SKILL_GUARD) {
-                character_add_buff(actor, BUFF_DEFEND, 0, 1); // Double defense for 1 turn
-                printf("%s takes a defensive stance!\n", actor->name);
+                buff = BUFF_DEFEND;
+                character_add_buff(actor, buff, 0, 1); // Double defense for 1 turn
             } else if (skill->skill_id == SKILL_MEDITATION) {
-                character_add_buff(actor, BUFF_REGEN_MP, 10, 3); // +10 MP per turn for 3 turns
-                printf("%s meditates to restore MP!\n", actor->name);
+                buff = BUFF_REGEN_MP;
+                character_add_buff(actor, buff, 10, 3); // +10 MP per turn for 3 turns
             } else if (skill->skill_id == SKILL_TRANQUILITY) {
-                character_add_buff(actor, BUFF_REGEN_MP, 8, 3); // +8 MP per turn for 3 turns
-                printf("%s achieves tranquility!\n", actor->name);
+                buff = BUFF_REGEN_MP;
+                character_add_buff(actor, buff, 8, 3); // +8 MP per turn for 3 turns
             } else if (skill->skill_id == SKILL_FOCUS) {
-                character_add_buff(actor, BUFF_REGEN_MP, 12, 3); // +12 MP per turn for 3 turns
-                printf("%s focuses their mind!\n", actor->name);
+                buff = BUFF_REGEN_MP;
+                character_add_buff(actor, buff, 12, 3); // +12 MP per turn for 3 turns
+            }
+
+            if (buff != BUFF_NONE) {
+                battle_emit(ctx, BATTLE_EVENT_BUFF_APPLIED, caster, caster, buff, skill_id);
             }
             break;
         }
@@ -507,71 +787,22 @@ void battle_use_skill(PartyMember* actor, uint8_t skill_id, uint8_t target_index
             if (skill->status_effect != STATUS_NONE && skill->status_chance > 0) {
                 if (skill->target_all) {
                     // Apply to all enemies
-                    for (uint8_t i = 0; i < g_battle_state.enemy_count; i++) {
-                        if (g_battle_state.enemies[i].is_alive) {
-                            Enemy* enemy = &g_battle_state.enemies[i];
-
-                            if (random_range(1, 100) <= skill->status_chance) {
-                                // Add to bitfield
-                                enemy->status_effects |= skill->status_effect;
-
-                                // Add to duration tracker
-                                bool found = false;
-                                for (uint8_t j = 0; j < enemy->status_effect_count; j++) {
-                                    if (enemy->active_status_effects[j].status_type == skill->status_effect) {
-                                        enemy->active_status_effects[j].duration = skill->status_duration;
-                                        found = true;
-                                        break;
-                                    }
-                                }
-
-                                if (!found && enemy->status_effect_count < MAX_STATUS_EFFECTS_PER_CHARACTER) {
-                                    enemy->active_status_effects[enemy->status_effect_count].status_type = skill->status_effect;
-                                    enemy->active_status_effects[enemy->status_effect_count].duration = skill->status_duration;
-                                    enemy->status_effect_count++;
-                                }
-
-                                printf("%s is afflicted!\n", enemy->name);
-                            } else {
-                                printf("%s resisted!\n", enemy->name);
-                            }
-                        }
+                    for (uint8_t i = 0; i < state->enemy_count; i++) {
+                        Enemy* enemy = &state->enemies[i];
+                        if (!enemy->is_alive) continue;
+
+                        battle_apply_enemy_status(ctx, enemy, skill);
                     }
                 } else {
                     // Single target
-                    if (target_index < g_battle_state.enemy_count && g_battle_state.enemies[target_index].is_alive) {
-                        Enemy* enemy = &g_battle_state.enemies[target_index];
-
-                        if (random_range(1, 100) <= skill->status_chance) {
-                            // Add to bitfield
-                            enemy->status_effects |= skill->status_effect;
-
-                            // Add to duration tracker
-                            bool found = false;
-                            for (uint8_t j = 0; j < enemy->status_effect_count; j++) {
-                                if (enemy->active_status_effects[j].status_type == skill->status_effect) {
-                                    enemy->active_status_effects[j].duration = skill->status_duration;
-                                    found = true;
-                                    break;
-                                }
-                            }
-
-                            if (!found && enemy->status_effect_count < MAX_STATUS_EFFECTS_PER_CHARACTER) {
-                                enemy->active_status_effects[enemy->status_effect_count].status_type = skill->status_effect;
-                                enemy->active_status_effects[enemy->status_effect_count].duration = skill->status_duration;
-                                enemy->status_effect_count++;
-                            }
-
-                            printf("%s is afflicted with a status effect!\n", enemy->name);
-                        } else {
-                            printf("%s resisted the status effect!\n", enemy->name);
-                        }
+                    if (target_index < state->enemy_count && state->enemies[target_index].is_alive) {
+                        battle_apply_enemy_status(ctx, &state->enemies[target_index], skill);
                     }
                 }
-            } else if (skill->skill_id == SKILL_TAUNT && g_battle_state.is_boss_battle == false) {
+            } else if (skill->skill_id == SKILL_TAUNT && state->is_boss_battle == false) {
                 // Legacy taunt (TODO: convert to status effect system)
-                if (target_index < g_battle_state.enemy_count) {
-                    printf("Enemy is taunted!\n");
+                if (target_index < state->enemy_count) {
+                    battle_emit(ctx, BATTLE_EVENT_TAUNTED, caster, MAX_PARTY_SIZE + target_index, 0, 0);
                 }
             }
             break;
@@ -579,202 +810,238 @@ void battle_use_skill(PartyMember* actor, uint8_t skill_id, uint8_t target_index
 
         case SKILL_TYPE_STEAL: {
             // Process steal attempt
-            if (g_battle_state.is_boss_battle) {
-                printf("You can't steal from a boss!\n");
+            if (state->is_boss_battle) {
+                battle_emit(ctx, BATTLE_EVENT_STEAL_FAILED, caster, MAX_PARTY_SIZE, 0, BATTLE_FAIL_BOSS);
             } else {
-                battle_process_steal(actor, target_index);
+                battle_core_steal(ctx, actor, target_index);
             }
             break;
         }
     }
 }
 
-void battle_process_action(BattleAction* action) {
+void battle_core_use_item(BattleContext* ctx, uint8_t item_index, uint8_t target_index) {
+    Item* item = inventory_get_item(ctx->inventory, item_index);
+    PartyMember* member = party_get_member(ctx->party, target_index);
+
+    if (!item || !member) return;
+
+    uint8_t id = battle_member_id(ctx, member);
+    battle_emit(ctx, BATTLE_EVENT_ITEM_USED, id, id, item->item_id, 0);
+
+    // Apply item effects
+    if (item->hp_restore > 0) {
+        battle_heal_member(ctx, member, item->hp_restore);
+    }
+
+    if (item->mp_restore > 0) {
+        member->stats.current_mp += item->mp_restore;
+        if (member->stats.current_mp > member->stats.max_mp) {
+            member->stats.current_mp = member->stats.max_mp;
+        }
+        battle_emit(ctx, BATTLE_EVENT_MP_RESTORED, BATTLE_ACTOR_NONE, id, item->mp_restore, 0);
+    }
+
+    if (item->status_cure != 0) {
+        member->status_effects &= ~item->status_cure;
+        battle_refresh_member(ctx, member);
+        battle_emit(ctx, BATTLE_EVENT_STATUS_CURED, BATTLE_ACTOR_NONE, id, item->status_cure, 0);
+    }
+
+    // Remove one from inventory
+    inventory_remove_item(ctx->inventory, item_index, 1);
+}
+
+void battle_core_process_action(BattleContext* ctx, const BattleAction* action) {
+    BattleState* state = ctx->state;
     if (!action) return;
 
-    PartyMember* actor = party_get_member(g_game_state.party, action->actor_index);
+    PartyMember* actor = party_get_member(ctx->party, action->actor_index);
     if (!actor || actor->stats.current_hp == 0) {
         // Skip dead members
-        g_battle_state.current_turn = (g_battle_state.current_turn + 1) % g_battle_state.turn_count;
+        battle_core_advance_turn(ctx);
         return;
     }
 
     // Update buffs at start of turn (decrement durations, apply effects like MP regen)
     character_update_buffs(actor);
+    battle_refresh_member(ctx, actor);
 
     switch (action->type) {
         case ACTION_ATTACK: {
-            if (g_battle_state.is_boss_battle) {
-                printf("%s attacks %s!\n", actor->name, g_battle_state.boss->name);
-                uint16_t damage = battle_calculate_damage(character_get_total_attack(actor),
-                                         g_battle_state.boss->defense,
-                                         random_chance(actor->stats.luck));
-
-                if (damage >= g_battle_state.boss->current_hp) {
-                    g_battle_state.boss->current_hp = 0;
-                    g_battle_state.battle_won = true;
-                    printf("%s takes %d damage and is defeated!\n", g_battle_state.boss->name, damage);
-                } else {
-                    g_battle_state.boss->current_hp -= damage;
-                    printf("%s takes %d damage! (%d HP remaining)\n",
-                           g_battle_state.boss->name, damage, g_battle_state.boss->current_hp);
-                }
+            uint8_t attack = character_calc_total_attack(actor, ctx->inventory);
+            bool is_critical = battle_random_chance(ctx, actor->stats.luck);
+
+            if (state->is_boss_battle) {
+                if (!state->boss) break;
+
+                battle_emit(ctx, BATTLE_EVENT_ATTACK, action->actor_index, MAX_PARTY_SIZE, 0, 0);
+                uint16_t damage = battle_core_calculate_damage(ctx, attack, state->boss->defense, is_critical);
+                battle_damage_boss(ctx, damage);
             } else {
                 // Validate target is alive, otherwise find next valid target
                 uint8_t target_index = action->target_index;
-                if (target_index >= g_battle_state.enemy_count ||
-                    !g_battle_state.enemies[target_index].is_alive) {
-                    target_index = battle_find_valid_enemy_target();
+                if (target_index >= state->enemy_count ||
+                    !state->enemies[target_index].is_alive) {
+                    target_index = battle_core_find_valid_enemy_target(ctx);
                 }
 
-                Enemy* target = &g_battle_state.enemies[target_index];
+                Enemy* target = &state->enemies[target_index];
                 if (target->is_alive) {
-                    printf("%s attacks %s!\n", actor->name, target->name);
-                    uint16_t damage = battle_calculate_damage(character_get_total_attack(actor),
-                                         target->defense,
-                                         random_chance(actor->stats.luck));
-
-                    if (damage >= target->current_hp) {
-                        target->current_hp = 0;
-                        target->is_alive = false;
-                        printf("%s takes %d damage and is defeated!\n", target->name, damage);
-                    } else {
-                        target->current_hp -= damage;
-                        printf("%s takes %d damage! (%d HP remaining)\n",
-                               target->name, damage, target->current_hp);
-                    }
+                    battle_emit(ctx, BATTLE_EVENT_ATTACK, action->actor_index, battle_enemy_id(ctx, target), 0, 0);
+                    uint16_t damage = battle_core_calculate_damage(ctx, attack, target->defense, is_critical);
+                    battle_damage_enemy(ctx, target, damage);
                 }
             }
             break;
         }
-        case ACTION_SKILL: {
-			battle_use_skill(actor, action->item_or_skill_id, action->target_index);
-			break;
-		}
+        case ACTION_SKILL:
+            battle_core_use_skill(ctx, actor, action->item_or_skill_id, action->target_index);
+            break;
+
+        case ACTION_ITEM:
+            battle_core_use_item(ctx, action->item_or_skill_id, action->target_index);
+            break;
+
         case ACTION_DEFEND:
-            printf("%s defends!\n", actor->name);
+            battle_emit(ctx, BATTLE_EVENT_DEFEND, action->actor_index, action->actor_index, 0, 0);
             character_add_buff(actor, BUFF_DEFEND, 0, 1); // Doubles defense for 1 turn
             break;
             
         case ACTION_FLEE:
-            if (battle_attempt_flee()) {
-                printf("Successfully fled from battle!\n");
-                g_battle_state.battle_fled = true;
-            } else {
-                printf("Cannot escape!\n");
-            }
+            state->battle_fled = battle_core_attempt_flee(ctx);
+            battle_emit(ctx, BATTLE_EVENT_FLEE, action->actor_index, BATTLE_ACTOR_NONE, state->battle_fled, 0);
             break;
             
         default:
-            printf("Action not yet implemented\n");
             break;
     }
-    
+
+    // Pick up any agility buffs the actor gave itself before rescheduling
+    battle_refresh_member(ctx, actor);
+
     // Advance turn
-    g_battle_state.current_turn = (g_battle_state.current_turn + 1) % g_battle_state.turn_count;
+    battle_core_advance_turn(ctx);
 }
 
-uint16_t battle_calculate_damage(uint8_t attacker_atk, uint8_t defender_def, bool is_critical) {
+uint16_t battle_core_calculate_damage(BattleContext* ctx, uint8_t attacker_atk, uint8_t defender_def, bool is_critical) {
     // Simple damage formula
     int damage = attacker_atk * 2 - defender_def;
     
     if (damage < 1) damage = 1;
     
     // Random variance (±25%)
-    int variance = random_range(75, 125);
+    int variance = battle_random_range(ctx, 75, 125);
     damage = (damage * variance) / 100;
     
     // Critical hit
     if (is_critical) {
         damage *= 2;
-        printf("Critical hit! ");
+        battle_emit(ctx, BATTLE_EVENT_CRITICAL_HIT, BATTLE_ACTOR_NONE, BATTLE_ACTOR_NONE, 0, 0);
     }
     
     return (uint16_t)damage;
 }
 
-bool battle_attempt_flee(void) {
+bool battle_core_attempt_flee(BattleContext* ctx) {
     // Cannot flee from boss battles
-    if (g_battle_state.is_boss_battle) {
+    if (ctx->state->is_boss_battle) {
         return false;
     }
     
     // 50% chance to flee
-    return random_chance(50);
+    return battle_random_chance(ctx, 50);
 }
 
-bool battle_is_over(void) {
+bool battle_core_is_over(BattleContext* ctx) {
+    BattleState* state = ctx->state;
+
     // Check if party is defeated
-    if (party_is_defeated(g_game_state.party)) {
+    if (party_is_defeated(ctx->party)) {
         return true;
     }
     
-    // Check if battle was fled
-    if (g_battle_state.battle_fled) {
-        return true;
-    }
-    
-    // Check if battle was won
-    if (g_battle_state.battle_won) {
+    // Check if battle was fled or won
+    if (state->battle_fled || state->battle_won) {
         return true;
     }
     
     // Check if all enemies defeated
-    if (g_battle_state.is_boss_battle) {
-        return g_battle_state.boss && g_battle_state.boss->current_hp == 0;
-    } else {
-        for (uint8_t i = 0; i < g_battle_state.enemy_count; i++) {
-            if (g_battle_state.enemies[i].is_alive) {
-                return false;
-            }
+    if (state->is_boss_battle) {
+        return state->boss && state->boss->current_hp == 0;
+    }
+
+    for (uint8_t i = 0; i < state->enemy_count; i++) {
+        if (state->enemies[i].is_alive) {
+            return false;
         }
-        return true;
     }
+    return true;
 }
 
-bool battle_is_victory(void) {
-    if (!battle_is_over()) return false;
+bool battle_core_is_victory(BattleContext* ctx) {
+    if (!battle_core_is_over(ctx)) return false;
     
-    if (g_battle_state.battle_fled || party_is_defeated(g_game_state.party)) {
+    if (ctx->state->battle_fled || party_is_defeated(ctx->party)) {
         return false;
     }
     
     return true;
 }
 
-void battle_distribute_rewards(void) {
-    if (!battle_is_victory()) return;
+uint8_t battle_core_find_valid_enemy_target(BattleContext* ctx) {
+    // Find the first alive enemy
+    for (uint8_t i = 0; i < ctx->state->enemy_count; i++) {
+        if (ctx->state->enemies[i].is_alive) {
+            return i;
+        }
+    }
+    return 0; // Fallback (shouldn't happen if battle isn't over)
+}
 
+uint16_t battle_core_distribute_rewards(BattleContext* ctx) {
+    BattleState* state = ctx->state;
+    if (!battle_core_is_victory(ctx)) return 0;
+
+    RandomStream* loot_rng = ctx->loot_rng;
+    RandomStream* level_rng = ctx->level_rng;
     uint32_t total_exp = 0;
     uint16_t total_gold = 0;
 
-    if (g_battle_state.is_boss_battle) {
-        total_exp = g_battle_state.boss->level * 100;
-        total_gold = g_battle_state.boss->level * 100; // Increased from *50 for better economy
+    if (state->is_boss_battle) {
+        total_exp = state->boss->level * 100;
+        total_gold = state->boss->level * 100; // Increased from *50 for better economy
     } else {
-        for (uint8_t i = 0; i < g_battle_state.enemy_count; i++) {
-            total_exp += g_battle_state.enemies[i].exp_reward;
-            total_gold += g_battle_state.enemies[i].gold_reward;
+        for (uint8_t i = 0; i < state->enemy_count; i++) {
+            total_exp += state->enemies[i].exp_reward;
+            total_gold += state->enemies[i].gold_reward;
         }
     }
 
-    printf("\n=== VICTORY! ===\n");
-    printf("Gained %d EXP and %d Gold\n", total_exp, total_gold);
-
-    g_game_state.gold += total_gold;
+    battle_emit(ctx, BATTLE_EVENT_REWARDS, BATTLE_ACTOR_NONE, BATTLE_ACTOR_NONE, (uint16_t)total_exp, total_gold);
 
     // Distribute EXP to all living party members
-    for (uint8_t i = 0; i < g_game_state.party->member_count; i++) {
-        PartyMember* member = &g_game_state.party->members[i];
-        if (member->stats.current_hp > 0) {
-            character_gain_experience(member, total_exp);
+    for (uint8_t i = 0; i < ctx->party->member_count; i++) {
+        PartyMember* member = &ctx->party->members[i];
+        if (member->stats.current_hp == 0) continue;
+
+        member->stats.experience += total_exp;
+
+        uint8_t known_skills = member->skill_count;
+        while (character_try_level_up(member, level_rng)) {
+            battle_emit(ctx, BATTLE_EVENT_LEVEL_UP, BATTLE_ACTOR_NONE, i, member->stats.level, 0);
+
+            // Report skills picked up on this level
+            for (; known_skills < member->skill_count; known_skills++) {
+                battle_emit(ctx, BATTLE_EVENT_SKILL_LEARNED, BATTLE_ACTOR_NONE, i, member->skills[known_skills], 0);
+            }
         }
     }
 
     // Item drops from enemies (only if not boss battle and not already stolen from)
-    if (!g_battle_state.is_boss_battle) {
-        for (uint8_t i = 0; i < g_battle_state.enemy_count; i++) {
-            Enemy* enemy = &g_battle_state.enemies[i];
+    if (!state->is_boss_battle) {
+        for (uint8_t i = 0; i < state->enemy_count; i++) {
+            Enemy* enemy = &state->enemies[i];
 
             // Skip if this enemy was already stolen from
             if (enemy->item_stolen) {
@@ -782,38 +1049,382 @@ void battle_distribute_rewards(void) {
             }
 
             // 25% chance to drop an item
-            if (random_range(1, 100) <= 25) {
+            if (random_stream_range(loot_rng, 1, 100) <= 25) {
                 // Determine item based on enemy level
                 uint8_t item_id;
                 if (enemy->level <= 3) {
                     // Low level: Basic items only (Potion, Antidote)
                     uint8_t low_tier_items[] = {ITEM_POTION, ITEM_ANTIDOTE};
-                    item_id = low_tier_items[random_range(0, 1)];
+                    item_id = low_tier_items[random_stream_bounded(loot_rng, 2)];
                 } else if (enemy->level <= 7) {
                     // Mid level: Common and uncommon items (Potion, Hi-Potion, Ether, Antidote)
                     uint8_t mid_tier_items[] = {ITEM_POTION, ITEM_HI_POTION, ITEM_ETHER, ITEM_ANTIDOTE};
-                    item_id = mid_tier_items[random_range(0, 3)];
+                    item_id = mid_tier_items[random_stream_bounded(loot_rng, 4)];
                 } else {
                     // High level: All items including rare (Hi-Potion, Ether, Elixir)
                     uint8_t high_tier_items[] = {ITEM_HI_POTION, ITEM_ETHER, ITEM_ELIXIR};
-                    item_id = high_tier_items[random_range(0, 2)];
+                    item_id = high_tier_items[random_stream_bounded(loot_rng, 3)];
                 }
 
-                // Add item to inventory (inventory_add_item prints "Obtained" message)
-                if (inventory_add_item(g_game_state.inventory, item_id, 1)) {
-                    printf("  %s dropped it!\n", enemy->name);
+                if (inventory_store_item(ctx->inventory, item_id, 1)) {
+                    battle_emit(ctx, BATTLE_EVENT_ITEM_DROPPED, battle_enemy_id(ctx, enemy), BATTLE_ACTOR_NONE, item_id, 0);
                 }
             }
         }
     }
+
+    return total_gold;
 }
 
-uint8_t battle_find_valid_enemy_target(void) {
-    // Find the first alive enemy
-    for (uint8_t i = 0; i < g_battle_state.enemy_count; i++) {
-        if (g_battle_state.enemies[i].is_alive) {
-            return i;
+// ============================================================================
+// Snapshots
+// ============================================================================
+
+void battle_snapshot_save(const BattleContext* ctx, BattleSnapshot* out) {
+    out->state = *ctx->state;
+    out->state.boss = NULL;
+    out->has_boss = ctx->state->boss != NULL;
+    if (out->has_boss) {
+        out->boss = *ctx->state->boss;
+    }
+
+    out->member_count = ctx->party->member_count;
+    for (uint8_t i = 0; i < out->member_count; i++) {
+        const PartyMember* member = &ctx->party->members[i];
+        BattleMemberSnapshot* saved = &out->members[i];
+        saved->current_hp = member->stats.current_hp;
+        saved->current_mp = member->stats.current_mp;
+        saved->status_effects = member->status_effects;
+        saved->buff_count = member->buff_count;
+        saved->status_effect_count = member->status_effect_count;
+        saved->derived_valid = member->derived_valid;
+        saved->derived = member->derived;
+        memcpy(saved->active_buffs, member->active_buffs, sizeof(saved->active_buffs));
+        memcpy(saved->active_status_effects, member->active_status_effects, sizeof(saved->active_status_effects));
+    }
+
+    // Battles only spend or pick up consumables, so IDs and counts are enough
+    out->item_count = ctx->inventory->item_count;
+    for (uint8_t i = 0; i < out->item_count; i++) {
+        out->items[i].item_id = ctx->inventory->items[i].item_id;
+        out->items[i].quantity = ctx->inventory->items[i].quantity;
+    }
+
+    out->rng = *ctx->rng;
+}
+
+bool battle_snapshot_restore(BattleContext* ctx, const BattleSnapshot* snapshot) {
+    BossData* boss = ctx->state->boss;
+    if (snapshot->has_boss && !boss) return false;
+    if (snapshot->member_count != ctx->party->member_count) return false;
+
+    *ctx->state = snapshot->state;
+    if (snapshot->has_boss) {
+        *boss = snapshot->boss;
+        ctx->state->boss = boss;
+    }
+
+    for (uint8_t i = 0; i < snapshot->member_count; i++) {
+        PartyMember* member = &ctx->party->members[i];
+        const BattleMemberSnapshot* saved = &snapshot->members[i];
+        member->stats.current_hp = saved->current_hp;
+        member->stats.current_mp = saved->current_mp;
+        member->status_effects = saved->status_effects;
+        member->buff_count = saved->buff_count;
+        member->status_effect_count = saved->status_effect_count;
+        member->derived_valid = saved->derived_valid;
+        member->derived = saved->derived;
+        memcpy(member->active_buffs, saved->active_buffs, sizeof(member->active_buffs));
+        memcpy(member->active_status_effects, saved->active_status_effects, sizeof(member->active_status_effects));
+    }
+
+    // Usually only quantities moved; rebuild a slot only when its item changed
+    Inventory* inv = ctx->inventory;
+    for (uint8_t i = 0; i < snapshot->item_count; i++) {
+        if (i >= inv->item_count || inv->items[i].item_id != snapshot->items[i].item_id) {
+            inv->items[i] = item_create_consumable(snapshot->items[i].item_id);
         }
+        inv->items[i].quantity = snapshot->items[i].quantity;
     }
-    return 0; // Fallback (shouldn't happen if battle isn't over)
-}
\ No newline at end of file
+    inv->item_count = snapshot->item_count;
+
+    *ctx->rng = snapshot->rng;
+    return true;
+}
+
+void battle_sandbox_init(BattleSandbox* sandbox, const BattleContext* source) {
+    sandbox->state = *source->state;
+    sandbox->party = *source->party;
+    sandbox->inventory = *source->inventory;
+    sandbox->rng = *source->rng;
+    if (source->state->boss) {
+        sandbox->boss = *source->state->boss;
+        sandbox->state.boss = &sandbox->boss;
+    }
+
+    // No event ring - lookahead outcomes are read from the state directly
+    battle_context_init(&sandbox->ctx, &sandbox->state, &sandbox->party, &sandbox->inventory, &sandbox->rng);
+}
+
+// ============================================================================
+// Event text
+// ============================================================================
+
+const char* battle_actor_name(const BattleContext* ctx, uint8_t actor) {
+    const BattleState* state = ctx->state;
+
+    if (actor == BATTLE_ACTOR_NONE) return "";
+    if (!BATTLE_ACTOR_IS_ENEMY(actor)) {
+        return actor < ctx->party->member_count ? ctx->party->members[actor].name : "";
+    }
+    if (state->is_boss_battle) {
+        return state->boss ? state->boss->name : "";
+    }
+
+    uint8_t enemy_index = actor - MAX_PARTY_SIZE;
+    return enemy_index < state->enemy_count ? state->enemies[enemy_index].name : "";
+}
+
+static const char* battle_skill_name(uint16_t skill_id) {
+    const Skill* skill = get_skill_data((uint8_t)skill_id);
+    return skill ? skill->name : "???";
+}
+
+static const char* battle_buff_text(uint16_t skill_id) {
+    switch (skill_id) {
+        case SKILL_PROTECT:        return "%s's defense increased!\n";
+        case SKILL_COUNTER_STANCE: return "%s enters counter stance!\n";
+        case SKILL_GUARD:          return "%s takes a defensive stance!\n";
+        case SKILL_MEDITATION:     return "%s meditates to restore MP!\n";
+        case SKILL_TRANQUILITY:    return "%s achieves tranquility!\n";
+        case SKILL_FOCUS:          return "%s focuses their mind!\n";
+        default:                   return "%s gains MP regeneration!\n";
+    }
+}
+
+static const char* battle_steal_fail_text(uint16_t reason) {
+    switch (reason) {
+        case BATTLE_FAIL_TARGET_DEFEATED: return "%s is already defeated!\n";
+        case BATTLE_FAIL_ALREADY_STOLEN:  return "%s has already been stolen from!\n";
+        case BATTLE_FAIL_MISSED:          return "%s's steal attempt failed!\n";
+        case BATTLE_FAIL_INVENTORY_FULL:  return "%s's inventory is full!\n";
+        case BATTLE_FAIL_BOSS:            return "You can't steal from a boss!\n";
+        default:                          return "%s found nothing to steal!\n";
+    }
+}
+
+// Returns false for events that have no text of their own
+bool battle_format_event(const BattleContext* ctx, const BattleEvent* event, char* buffer, size_t size) {
+    const char* actor = battle_actor_name(ctx, event->actor);
+    const char* target = battle_actor_name(ctx, event->target);
+
+    switch ((BattleEventType)event->type) {
+        case BATTLE_EVENT_ENEMY_APPEARED:
+            snprintf(buffer, size, "Enemy %d: %s (Lv%d)\n",
+                     event->target - MAX_PARTY_SIZE + 1, target, event->value);
+            break;
+        case BATTLE_EVENT_ATTACK:
+            snprintf(buffer, size, BATTLE_ACTOR_IS_ENEMY(event->actor) ? "\n%s attacks %s!\n" : "%s attacks %s!\n",
+                     actor, target);
+            break;
+        case BATTLE_EVENT_CRITICAL_HIT:
+            snprintf(buffer, size, "Critical hit! ");
+            break;
+        case BATTLE_EVENT_DAMAGE_DEALT:
+            if (event->extra > 0) {
+                snprintf(buffer, size, "%s takes %d damage! (%d HP remaining)\n", target, event->value, event->extra);
+            } else {
+                snprintf(buffer, size, "%s takes %d damage!\n", target, event->value);
+            }
+            break;
+        case BATTLE_EVENT_ACTOR_DEFEATED:
+            snprintf(buffer, size, BATTLE_ACTOR_IS_ENEMY(event->target) ? "%s is defeated!\n" : "%s has been defeated!\n",
+                     target);
+            break;
+        case BATTLE_EVENT_HEALED:
+            snprintf(buffer, size, "%s recovers %d HP!\n", target, event->value);
+            break;
+        case BATTLE_EVENT_MP_RESTORED:
+            snprintf(buffer, size, "%s recovers %d MP!\n", target, event->value);
+            break;
+        case BATTLE_EVENT_SKILL_USED: {
+            const Skill* skill = get_skill_data((uint8_t)event->value);
+            const char* spread = "";
+            if (skill && skill->target_all) {
+                if (skill->type == SKILL_TYPE_ATTACK) spread = "Hits all enemies!\n";
+                if (skill->type == SKILL_TYPE_HEAL) spread = "Heals entire party!\n";
+            }
+            snprintf(buffer, size, "%s uses %s!\n%s", actor, battle_skill_name(event->value), spread);
+            break;
+        }
+        case BATTLE_EVENT_SKILL_FAILED:
+            if (event->extra == BATTLE_FAIL_NO_MP) {
+                snprintf(buffer, size, "%s doesn't have enough MP!\n", actor);
+            } else {
+                snprintf(buffer, size, "Invalid skill!\n");
+            }
+            break;
+        case BATTLE_EVENT_ITEM_USED: {
+            Item item = item_create_consumable((uint8_t)event->value);
+            snprintf(buffer, size, "%s uses %s\n", actor, item.name);
+            break;
+        }
+        case BATTLE_EVENT_STATUS_APPLIED:
+            snprintf(buffer, size, "%s is afflicted!\n", target);
+            break;
+        case BATTLE_EVENT_STATUS_RESISTED:
+            snprintf(buffer, size, "%s resisted!\n", target);
+            break;
+        case BATTLE_EVENT_STATUS_CURED:
+            snprintf(buffer, size, "%s is cured!\n", target);
+            break;
+        case BATTLE_EVENT_BUFF_APPLIED:
+            snprintf(buffer, size, battle_buff_text(event->extra), target);
+            break;
+        case BATTLE_EVENT_TAUNTED:
+            snprintf(buffer, size, "%s is taunted!\n", target);
+            break;
+        case BATTLE_EVENT_ITEM_STOLEN: {
+            Item item = item_create_consumable((uint8_t)event->value);
+            snprintf(buffer, size, "%s stole %s x%d!\n", actor, item.name, event->extra);
+            break;
+        }
+        case BATTLE_EVENT_STEAL_FAILED: {
+            // Target-side failures name the enemy, the rest name the thief
+            bool names_target = event->extra == BATTLE_FAIL_TARGET_DEFEATED ||
+                                event->extra == BATTLE_FAIL_ALREADY_STOLEN;
+            snprintf(buffer, size, battle_steal_fail_text(event->extra), names_target ? target : actor);
+            break;
+        }
+        case BATTLE_EVENT_DEFEND:
+            snprintf(buffer, size, "%s defends!\n", actor);
+            break;
+        case BATTLE_EVENT_FLEE:
+            snprintf(buffer, size, event->value ? "Successfully fled from battle!\n" : "Cannot escape!\n");
+            break;
+        case BATTLE_EVENT_REWARDS:
+            snprintf(buffer, size, "Gained %d EXP and %d Gold\n", event->value, event->extra);
+            break;
+        case BATTLE_EVENT_LEVEL_UP:
+            snprintf(buffer, size, "*** %s leveled up to level %d! ***\n", target, event->value);
+            break;
+        case BATTLE_EVENT_SKILL_LEARNED:
+            snprintf(buffer, size, "%s learned %s!\n", target, battle_skill_name(event->value));
+            break;
+        case BATTLE_EVENT_ITEM_DROPPED: {
+            Item item = item_create_consumable((uint8_t)event->value);
+            snprintf(buffer, size, "%s dropped %s!\n", actor, item.name);
+            break;
+        }
+        default:
+            return false;
+    }
+
+    return true;
+}
+
+// ============================================================================
+// Interactive wrappers (global state, stdout)
+// ============================================================================
+
+// Terminal consumer of g_battle_events
+static BattleEventReader battle_terminal_reader;
+
+void battle_flush_events(void) {
+    BattleContext* ctx = battle_get_context();
+    BattleEvent event;
+    char text[160];
+
+    bool printed = false;
+
+    while (battle_event_read(&g_battle_events, &battle_terminal_reader, &event)) {
+        if (battle_format_event(ctx, &event, text, sizeof(text))) {
+            fputs(text, stdout);
+            printed = true;
+        }
+    }
+
+    // The log can run past the bottom of the terminal
+    if (printed) screen_invalidate();
+}
+
+void battle_init(const EncounterTable* table, bool is_boss) {
+    battle_event_ring_reset(&g_battle_events);
+    battle_event_reader_init(&battle_terminal_reader, &g_battle_events);
+
+    battle_core_start(battle_get_context(), table, is_boss);
+    
+    printf("\n=== BATTLE START ===\n");
+    battle_flush_events();
+}
+
+void battle_init_boss(BossData* boss) {
+    if (!boss) return;
+    
+    battle_core_set_boss(battle_get_context(), boss);
+    printf("A boss battle with %s!\n", boss->name);
+}
+
+void battle_cleanup(void) {
+    printf("=== BATTLE END ===\n\n");
+}
+
+void battle_generate_enemies(const EncounterFormation* formation) {
+    battle_core_generate_enemies(battle_get_context(), formation);
+    battle_flush_events();
+}
+
+void battle_calculate_turn_order(void) {
+    battle_core_calculate_turn_order(battle_get_context());
+}
+
+void battle_execute_turn(void) {
+    BattleContext* ctx = battle_get_context();
+    if (battle_core_is_over(ctx)) return;
+
+    uint8_t actor = battle_core_current_actor(ctx);
+    if (BATTLE_ACTOR_IS_ENEMY(actor)) {
+        battle_core_enemy_turn(ctx);
+        battle_flush_events();
+        return;
+    }
+
+    // Party member turn - player will input action through main game loop
+    PartyMember* member = party_get_member(ctx->party, actor);
+    if (member && member->stats.current_hp > 0) {
+        printf("\n%s's turn!\n", member->name);
+    }
+}
+
+void battle_process_action(BattleAction* action) {
+    battle_core_process_action(battle_get_context(), action);
+    battle_flush_events();
+}
+
+uint16_t battle_calculate_damage(uint8_t attacker_atk, uint8_t defender_def, bool is_critical) {
+    return battle_core_calculate_damage(battle_get_context(), attacker_atk, defender_def, is_critical);
+}
+
+bool battle_attempt_flee(void) {
+    return battle_core_attempt_flee(battle_get_context());
+}
+
+bool battle_is_over(void) {
+    return battle_core_is_over(battle_get_context());
+}
+
+bool battle_is_victory(void) {
+    return battle_core_is_victory(battle_get_context());
+}
+
+void battle_distribute_rewards(void) {
+    if (!battle_is_victory()) return;
+
+    printf("\n=== VICTORY! ===\n");
+    g_game_state.gold += battle_core_distribute_rewards(battle_get_context());
+    battle_flush_events();
+}
+
+uint8_t battle_find_valid_enemy_target(void) {
+    return battle_core_find_valid_enemy_target(battle_get_context());
+}
@@ -3,11 +3,21 @@
 
 #include "game_state.h"
 #include "party.h"
+#include "inventory.h"
 #include "dungeon.h"
+#include "utils.h"
+#include "battle_event.h"
+#include "encounter.h"
+#include <stddef.h>
 #include <stdint.h>
 #include <stdbool.h>
 
 #define MAX_ENEMIES 4
+#define BATTLE_MAX_ACTORS (MAX_PARTY_SIZE + MAX_ENEMIES)
+#define BATTLE_ACTOR_NONE 0xFF
+
+// Ticks an agility-1 actor waits between turns (wait = scale / agility)
+#define BATTLE_TIMELINE_SCALE 60000
 
 // Enemy types
 typedef enum {
@@ -58,27 +68,135 @@ typedef struct {
     uint8_t item_or_skill_id; // For items or skills
 } BattleAction;
 
+// Turn timeline - a min-heap of actors keyed by the tick of their next turn.
+// Faster actors come around more often, so haste-style multiple turns fall
+// out naturally; a speed change only re-sifts that one actor.
+typedef struct {
+    uint32_t now;                          // Tick of the actor currently acting
+    uint32_t next_tick[BATTLE_MAX_ACTORS]; // When each actor acts next
+    uint8_t speed[BATTLE_MAX_ACTORS];      // Cached effective agility (0 = not scheduled)
+    uint8_t heap[BATTLE_MAX_ACTORS];       // Actor IDs, earliest next_tick first
+    uint8_t heap_slot[BATTLE_MAX_ACTORS];  // Actor ID -> index into heap
+    uint8_t count;
+} BattleTimeline;
+
 // Battle state
 typedef struct {
     Enemy enemies[MAX_ENEMIES];
     uint8_t enemy_count;
     bool is_boss_battle;
     BossData* boss; // Pointer to boss if boss battle
-    uint8_t turn_order[MAX_PARTY_SIZE + MAX_ENEMIES];
-    uint8_t turn_count;
-    uint8_t current_turn;
+    BattleTimeline timeline;
     bool battle_won;
     bool battle_fled;
 } BattleState;
 
-// Global battle state
+// Global battle state and the event ring the interactive battle writes to
 extern BattleState g_battle_state;
+extern BattleEventRing g_battle_events;
+
+// Battle context - everything the battle core reads or writes.
+// The core never touches the globals or stdout, so any number of
+// contexts can run side by side (balance simulations, lookahead).
+typedef struct {
+    BattleState* state;
+    Party* party;
+    Inventory* inventory;
+    RandomStream* rng;       // RNG stream the battle draws from
+    RandomStream* loot_rng;  // Drop rolls (battle_context_init points it at rng)
+    RandomStream* level_rng; // Level-up stat growth (likewise rng by default)
+    BattleEventRing* events; // Outcome sink (NULL = headless, nothing recorded)
+} BattleContext;
+
+// Battle snapshot - plain data, safe to memcpy. Holds everything a battle can
+// change: party HP/MP/status/buffs, consumables, enemies, boss and RNG. The one
+// pointer it embeds, state.boss, is always NULL here: the boss is copied by
+// value and restore points state.boss back at the context's own BossData.
+// Names, skills and equipment stay in the context it is restored into.
+typedef struct {
+    uint16_t current_hp;
+    uint16_t current_mp;
+    uint8_t status_effects;
+    uint8_t buff_count;
+    uint8_t status_effect_count;
+    bool derived_valid;
+    DerivedStats derived;
+    ActiveBuff active_buffs[MAX_BUFFS_PER_CHARACTER];
+    ActiveStatusEffect active_status_effects[MAX_STATUS_EFFECTS_PER_CHARACTER];
+} BattleMemberSnapshot;
+
+typedef struct {
+    uint8_t item_id;
+    uint8_t quantity;
+} BattleItemSnapshot;
+
+typedef struct {
+    BattleState state;  // state.boss is always NULL (see above)
+    BossData boss;
+    bool has_boss;
+    uint8_t member_count;
+    uint8_t item_count;
+    BattleMemberSnapshot members[MAX_PARTY_SIZE];
+    BattleItemSnapshot items[MAX_INVENTORY_ITEMS];
+    RandomStream rng;
+} BattleSnapshot;
+
+// Private copy of a whole battle for lookahead - restore snapshots into
+// sandbox.ctx without touching the live party, inventory or globals
+typedef struct {
+    BattleState state;
+    Party party;
+    Inventory inventory;
+    BossData boss;
+    RandomStream rng;
+    BattleContext ctx;
+} BattleSandbox;
+
+// Actor IDs on the timeline: party members first, enemies offset by MAX_PARTY_SIZE
+#define BATTLE_ACTOR_IS_ENEMY(actor) ((actor) >= MAX_PARTY_SIZE)
+
+// Headless battle core
+void battle_context_init(BattleContext* ctx, BattleState* state, Party* party, Inventory* inventory, RandomStream* rng);
+BattleContext* battle_get_context(void); // Interactive context bound to the globals, prints to stdout
+void battle_core_start(BattleContext* ctx, const EncounterTable* table, bool is_boss); // table unused for bosses
+void battle_core_set_boss(BattleContext* ctx, BossData* boss);
+void battle_core_generate_enemies(BattleContext* ctx, const EncounterFormation* formation);
+void battle_core_calculate_turn_order(BattleContext* ctx); // Full rebuild from effective agility
+void battle_core_refresh_actor(BattleContext* ctx, uint8_t actor); // Re-key one actor after a speed change
+uint8_t battle_core_effective_agility(BattleContext* ctx, uint8_t actor); // 0 = cannot act
+uint8_t battle_core_current_actor(BattleContext* ctx); // BATTLE_ACTOR_NONE if nobody can act
+void battle_core_advance_turn(BattleContext* ctx);
+void battle_core_enemy_turn(BattleContext* ctx);
+void battle_core_run_enemy_turns(BattleContext* ctx);
+void battle_core_process_action(BattleContext* ctx, const BattleAction* action);
+void battle_core_use_skill(BattleContext* ctx, PartyMember* actor, uint8_t skill_id, uint8_t target_index);
+void battle_core_use_item(BattleContext* ctx, uint8_t item_index, uint8_t target_index);
+void battle_core_steal(BattleContext* ctx, PartyMember* actor, uint8_t target_index);
+uint16_t battle_core_calculate_damage(BattleContext* ctx, uint8_t attacker_atk, uint8_t defender_def, bool is_critical);
+bool battle_core_attempt_flee(BattleContext* ctx);
+bool battle_core_is_over(BattleContext* ctx);
+bool battle_core_is_victory(BattleContext* ctx);
+uint8_t battle_core_find_valid_enemy_target(BattleContext* ctx);
+uint16_t battle_core_distribute_rewards(BattleContext* ctx); // EXP, level-ups and drops; returns gold won
+
+// Snapshots. Restore writes the boss into whatever BossData the context's
+// state already points at, so a boss snapshot needs a boss-bound context.
+// Restore is silent (search workers call it); false if the snapshot has a
+// boss the context cannot hold or a different party size.
+void battle_snapshot_save(const BattleContext* ctx, BattleSnapshot* out);
+bool battle_snapshot_restore(BattleContext* ctx, const BattleSnapshot* snapshot);
+void battle_sandbox_init(BattleSandbox* sandbox, const BattleContext* source);
+
+// Event text (consumers format on their own schedule, the core never does)
+const char* battle_actor_name(const BattleContext* ctx, uint8_t actor);
+bool battle_format_event(const BattleContext* ctx, const BattleEvent* event, char* buffer, size_t size);
+void battle_flush_events(void); // Prints pending interactive events to stdout
 
 // Battle management
-void battle_init(uint8_t dungeon_level, bool is_boss);
+void battle_init(const EncounterTable* table, bool is_boss);
 void battle_init_boss(BossData* boss);
 void battle_cleanup(void);
-void battle_generate_enemies(uint8_t dungeon_level, uint8_t count);
+void battle_generate_enemies(const EncounterFormation* formation);
 void battle_calculate_turn_order(void);
 
 // Battle actions
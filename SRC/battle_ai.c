@@ -0,0 +1,453 @@
+#ifndef _WIN32
+#define _POSIX_C_SOURCE 200809L
+#endif
+
+#include "battle_ai.h"
+#include "inventory.h"
+#include "party.h"
+#include "utils.h"
+#include <math.h>
+#include <string.h>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <pthread.h>
+#include <time.h>
+#include <unistd.h>
+#endif
+
+#define BATTLE_AI_EXPLORATION 0.5f  // UCB1 constant; rollout scores are 0-1
+#define BATTLE_AI_RANDOM_PERCENT 20 // Rollout moves taken uniformly at random
+#define BATTLE_AI_LOW_HP_PERCENT 35 // Rollout policy heals below this
+#define BATTLE_AI_ITEM_COST 0.02f   // Score lost per consumable spent
+#define BATTLE_AI_CLOCK_STRIDE 16   // Rollouts between deadline checks
+
+// ============================================================================
+// Platform helpers
+// ============================================================================
+
+static uint64_t battle_ai_now_ms(void) {
+#ifdef _WIN32
+    return (uint64_t)GetTickCount64();
+#else
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000u + (uint64_t)ts.tv_nsec / 1000000u;
+#endif
+}
+
+static uint8_t battle_ai_core_count(void) {
+#ifdef _WIN32
+    return 1; // Windows builds search on the calling thread
+#else
+    long cores = sysconf(_SC_NPROCESSORS_ONLN);
+    if (cores < 1) return 1;
+    return cores > BATTLE_AI_MAX_THREADS ? BATTLE_AI_MAX_THREADS : (uint8_t)cores;
+#endif
+}
+
+// ============================================================================
+// Candidate actions
+// ============================================================================
+
+static bool battle_ai_item_helps(const Item* item, const PartyMember* member) {
+    if (member->stats.current_hp == 0) return false;
+    if (item->hp_restore > 0 && member->stats.current_hp < member->stats.max_hp) return true;
+    if (item->mp_restore > 0 && member->stats.current_mp < member->stats.max_mp) return true;
+    return (item->status_cure & member->status_effects) != 0;
+}
+
+// Appends one action per living enemy (or the boss slot)
+static uint8_t battle_ai_add_enemy_targets(const BattleContext* ctx, BattleAction* out, uint8_t count,
+                                           uint8_t capacity, const BattleAction* action) {
+    const BattleState* state = ctx->state;
+    if (state->is_boss_battle) {
+        if (count < capacity) {
+            out[count] = *action;
+            out[count++].target_index = 0;
+        }
+        return count;
+    }
+
+    for (uint8_t i = 0; i < state->enemy_count && count < capacity; i++) {
+        if (!state->enemies[i].is_alive) continue;
+        out[count] = *action;
+        out[count++].target_index = i;
+    }
+    return count;
+}
+
+void battle_ai_default_config(BattleAIConfig* config, uint16_t budget_ms, uint32_t seed) {
+    config->budget_ms = budget_ms;
+    config->max_rollouts = 0;
+    config->threads = 0;
+    config->rollout_depth = BATTLE_AI_DEFAULT_DEPTH;
+    config->seed = seed;
+}
+
+uint8_t battle_ai_list_actions(const BattleContext* ctx, uint8_t actor_index, BattleAction* out, uint8_t capacity) {
+    PartyMember* actor = party_get_member(ctx->party, actor_index);
+    if (!actor || actor->stats.current_hp == 0) return 0;
+
+    uint8_t count = 0;
+    BattleAction action;
+    action.actor_index = actor_index;
+    action.target_index = 0;
+    action.item_or_skill_id = 0;
+
+    action.type = ACTION_ATTACK;
+    count = battle_ai_add_enemy_targets(ctx, out, count, capacity, &action);
+
+    action.type = ACTION_SKILL;
+    for (uint8_t s = 0; s < actor->skill_count; s++) {
+        const Skill* skill = get_skill_data(actor->skills[s]);
+        if (!skill || !character_can_use_skill(actor, skill->skill_id)) continue;
+        action.item_or_skill_id = skill->skill_id;
+
+        if (skill->target_all) {
+            if (count < capacity) {
+                out[count] = action;
+                out[count++].target_index = 0;
+            }
+        } else if (skill->target_enemy || skill->type == SKILL_TYPE_STEAL) {
+            count = battle_ai_add_enemy_targets(ctx, out, count, capacity, &action);
+        } else {
+            for (uint8_t m = 0; m < ctx->party->member_count && count < capacity; m++) {
+                const PartyMember* member = &ctx->party->members[m];
+                if (member->stats.current_hp == 0) continue;
+                // Healing a full-HP ally is never better than something else
+                if (skill->type == SKILL_TYPE_HEAL && skill->status_effect == 0 &&
+                    member->stats.current_hp == member->stats.max_hp) continue;
+                out[count] = action;
+                out[count++].target_index = m;
+            }
+        }
+    }
+
+    // Tents are for camp; everything else only where it does something
+    action.type = ACTION_ITEM;
+    for (uint8_t i = 0; i < ctx->inventory->item_count; i++) {
+        const Item* item = &ctx->inventory->items[i];
+        if (item->quantity == 0 || item->item_id == ITEM_TENT) continue;
+        action.item_or_skill_id = i;
+
+        for (uint8_t m = 0; m < ctx->party->member_count && count < capacity; m++) {
+            if (!battle_ai_item_helps(item, &ctx->party->members[m])) continue;
+            out[count] = action;
+            out[count++].target_index = m;
+        }
+    }
+
+    if (count < capacity) {
+        action.type = ACTION_DEFEND;
+        action.item_or_skill_id = 0;
+        out[count] = action;
+        out[count++].target_index = actor_index;
+    }
+
+    return count;
+}
+
+// ============================================================================
+// Rollout policy
+// ============================================================================
+
+static uint8_t battle_ai_random_enemy(BattleContext* ctx) {
+    BattleState* state = ctx->state;
+    if (state->is_boss_battle) return 0;
+
+    uint8_t alive[MAX_ENEMIES];
+    uint8_t alive_count = 0;
+    for (uint8_t i = 0; i < state->enemy_count; i++) {
+        if (state->enemies[i].is_alive) alive[alive_count++] = i;
+    }
+    if (alive_count == 0) return 0;
+    return alive[random_stream_bounded(ctx->rng, alive_count)];
+}
+
+void battle_ai_rollout_action(BattleContext* ctx, uint8_t actor_index, BattleAction* out) {
+    PartyMember* actor = &ctx->party->members[actor_index];
+
+    out->actor_index = actor_index;
+    out->type = ACTION_ATTACK;
+    out->target_index = battle_ai_random_enemy(ctx);
+    out->item_or_skill_id = 0;
+
+    // Occasional random legal move keeps rollouts from all looking alike
+    if (random_stream_chance(ctx->rng, BATTLE_AI_RANDOM_PERCENT)) {
+        BattleAction moves[BATTLE_AI_MAX_CANDIDATES];
+        uint8_t count = battle_ai_list_actions(ctx, actor_index, moves, BATTLE_AI_MAX_CANDIDATES);
+        if (count > 0) {
+            *out = moves[random_stream_bounded(ctx->rng, count)];
+            return;
+        }
+    }
+
+    uint8_t wounded = 0;
+    uint16_t wounded_percent = 0xFFFF;
+    for (uint8_t i = 0; i < ctx->party->member_count; i++) {
+        const CharacterStats* stats = &ctx->party->members[i].stats;
+        if (stats->current_hp == 0) continue;
+
+        uint16_t percent = (uint16_t)((stats->current_hp * 100u) / stats->max_hp);
+        if (percent < wounded_percent) {
+            wounded_percent = percent;
+            wounded = i;
+        }
+    }
+
+    const Skill* best_attack = NULL;
+    const Skill* best_heal = NULL;
+    for (uint8_t i = 0; i < actor->skill_count; i++) {
+        const Skill* skill = get_skill_data(actor->skills[i]);
+        if (!skill || skill->mp_cost > actor->stats.current_mp) continue;
+
+        if (skill->type == SKILL_TYPE_HEAL && skill->power > 0 && !skill->target_all &&
+            (!best_heal || skill->power > best_heal->power)) {
+            best_heal = skill;
+        } else if (skill->type == SKILL_TYPE_ATTACK && skill->mp_cost > 0 &&
+                   (!best_attack || skill->power > best_attack->power)) {
+            best_attack = skill;
+        }
+    }
+
+    if (wounded_percent < BATTLE_AI_LOW_HP_PERCENT) {
+        if (best_heal) {
+            out->type = ACTION_SKILL;
+            out->item_or_skill_id = best_heal->skill_id;
+            out->target_index = wounded;
+            return;
+        }
+
+        int8_t potion = inventory_find_item(ctx->inventory, ITEM_POTION);
+        if (potion >= 0) {
+            out->type = ACTION_ITEM;
+            out->item_or_skill_id = (uint8_t)potion;
+            out->target_index = wounded;
+            return;
+        }
+    }
+
+    if (best_attack && actor->stats.current_mp - best_attack->mp_cost >= actor->stats.max_mp / 4) {
+        out->type = ACTION_SKILL;
+        out->item_or_skill_id = best_attack->skill_id;
+    }
+}
+
+// ============================================================================
+// Search
+// ============================================================================
+
+static uint32_t battle_ai_enemy_hp(const BattleContext* ctx) {
+    const BattleState* state = ctx->state;
+    if (state->is_boss_battle) {
+        return state->boss ? state->boss->current_hp : 0;
+    }
+
+    uint32_t total = 0;
+    for (uint8_t i = 0; i < state->enemy_count; i++) {
+        if (state->enemies[i].is_alive) total += state->enemies[i].current_hp;
+    }
+    return total;
+}
+
+static uint16_t battle_ai_item_total(const Inventory* inv) {
+    uint16_t total = 0;
+    for (uint8_t i = 0; i < inv->item_count; i++) {
+        total += inv->items[i].quantity;
+    }
+    return total;
+}
+
+// 0 for a wipe; wins score 0.6-1.0 by party condition; unfinished fights
+// score below any win by damage dealt versus resources left
+static float battle_ai_evaluate(BattleAIWorker* worker) {
+    BattleContext* ctx = &worker->sandbox.ctx;
+    if (party_is_defeated(ctx->party)) return 0.0f;
+
+    uint32_t have = 0;
+    uint32_t full = 0;
+    for (uint8_t i = 0; i < ctx->party->member_count; i++) {
+        const CharacterStats* stats = &ctx->party->members[i].stats;
+        have += stats->current_hp * 4u + stats->current_mp;
+        full += stats->max_hp * 4u + stats->max_mp;
+    }
+    float condition = full > 0 ? (float)have / (float)full : 0.0f;
+
+    float score;
+    if (battle_core_is_victory(ctx)) {
+        score = 0.6f + 0.4f * condition;
+    } else {
+        float enemy_left = worker->enemy_hp_start > 0 ?
+            (float)battle_ai_enemy_hp(ctx) / (float)worker->enemy_hp_start : 0.0f;
+        score = 0.3f * condition + 0.3f * (1.0f - enemy_left);
+    }
+
+    uint16_t items_left = battle_ai_item_total(ctx->inventory);
+    if (items_left < worker->items_start) {
+        score -= BATTLE_AI_ITEM_COST * (float)(worker->items_start - items_left);
+    }
+    return score > 0.0f ? score : 0.0f;
+}
+
+static float battle_ai_rollout(BattleAIWorker* worker, const BattleAction* first) {
+    BattleContext* ctx = &worker->sandbox.ctx;
+    battle_core_process_action(ctx, first);
+
+    uint8_t depth = 0;
+    while (depth < worker->config.rollout_depth) {
+        battle_core_run_enemy_turns(ctx);
+        if (battle_core_is_over(ctx)) break;
+
+        uint8_t actor = battle_core_current_actor(ctx);
+        if (actor == BATTLE_ACTOR_NONE || actor >= ctx->party->member_count) break;
+        if (ctx->party->members[actor].stats.current_hp == 0) {
+            battle_core_advance_turn(ctx);
+            continue;
+        }
+
+        BattleAction action;
+        battle_ai_rollout_action(ctx, actor, &action);
+        battle_core_process_action(ctx, &action);
+        depth++;
+    }
+
+    return battle_ai_evaluate(worker);
+}
+
+static uint8_t battle_ai_select(const BattleAIWorker* worker) {
+    // Every candidate gets one playout before UCB1 takes over
+    if (worker->rollouts < worker->candidate_count) {
+        return (uint8_t)worker->rollouts;
+    }
+
+    float log_total = logf((float)worker->rollouts);
+    uint8_t best = 0;
+    float best_score = -1.0f;
+    for (uint8_t i = 0; i < worker->candidate_count; i++) {
+        float visits = (float)worker->visits[i];
+        float score = worker->reward[i] / visits + BATTLE_AI_EXPLORATION * sqrtf(log_total / visits);
+        if (score > best_score) {
+            best_score = score;
+            best = i;
+        }
+    }
+    return best;
+}
+
+static void battle_ai_worker_run(BattleAIWorker* worker) {
+    BattleContext* ctx = &worker->sandbox.ctx;
+
+    while (worker->config.max_rollouts == 0 || worker->rollouts < worker->config.max_rollouts) {
+        if (worker->config.budget_ms > 0 && worker->rollouts % BATTLE_AI_CLOCK_STRIDE == 0 &&
+            worker->rollouts >= worker->candidate_count &&
+            battle_ai_now_ms() >= worker->deadline_ms) {
+            break;
+        }
+
+        uint8_t pick = battle_ai_select(worker);
+        if (!battle_snapshot_restore(ctx, &worker->root)) break; // Root no longer fits the sandbox
+
+        // Fresh dice for every playout - the snapshot carries the live stream
+        uint32_t low = random_stream_next(&worker->rng);
+        random_stream_seed(ctx->rng, ((uint64_t)random_stream_next(&worker->rng) << 32) | low);
+
+        worker->reward[pick] += battle_ai_rollout(worker, &worker->candidates[pick]);
+        worker->visits[pick]++;
+        worker->rollouts++;
+    }
+}
+
+#ifndef _WIN32
+static void* battle_ai_worker_main(void* arg) {
+    battle_ai_worker_run((BattleAIWorker*)arg);
+    return NULL;
+}
+#endif
+
+bool battle_ai_choose_action(const BattleContext* ctx, uint8_t actor_index, const BattleAIConfig* config,
+                             BattleAIWorkspace* workspace, BattleAction* out, BattleAIStats* stats) {
+    if (!ctx || !config || !workspace || !out) return false;
+
+    uint8_t count = battle_ai_list_actions(ctx, actor_index, workspace->candidates, BATTLE_AI_MAX_CANDIDATES);
+    if (count == 0) return false;
+
+    uint8_t threads = config->threads ? config->threads : battle_ai_core_count();
+    if (threads > BATTLE_AI_MAX_THREADS) threads = BATTLE_AI_MAX_THREADS;
+#ifdef _WIN32
+    threads = 1;
+#endif
+
+    RandomStream seeds;
+    random_stream_seed(&seeds, config->seed);
+    uint64_t deadline = battle_ai_now_ms() + config->budget_ms;
+
+    for (uint8_t t = 0; t < threads; t++) {
+        BattleAIWorker* worker = &workspace->workers[t];
+        battle_sandbox_init(&worker->sandbox, ctx);
+        battle_snapshot_save(&worker->sandbox.ctx, &worker->root);
+        random_stream_split(&seeds, &worker->rng);
+
+        worker->candidates = workspace->candidates;
+        worker->candidate_count = count;
+        worker->actor_index = actor_index;
+        worker->config = *config;
+        if (worker->config.budget_ms == 0 && worker->config.max_rollouts == 0) {
+            worker->config.max_rollouts = count; // Nothing bounds the search - one pass
+        }
+        worker->deadline_ms = deadline;
+        worker->enemy_hp_start = battle_ai_enemy_hp(ctx);
+        worker->items_start = battle_ai_item_total(ctx->inventory);
+        worker->rollouts = 0;
+        memset(worker->visits, 0, sizeof(worker->visits));
+        memset(worker->reward, 0, sizeof(worker->reward));
+    }
+
+#ifdef _WIN32
+    battle_ai_worker_run(&workspace->workers[0]);
+#else
+    // The caller's thread is worker 0
+    pthread_t handles[BATTLE_AI_MAX_THREADS];
+    bool started[BATTLE_AI_MAX_THREADS] = { false };
+    for (uint8_t t = 1; t < threads; t++) {
+        started[t] = pthread_create(&handles[t], NULL, battle_ai_worker_main, &workspace->workers[t]) == 0;
+    }
+    battle_ai_worker_run(&workspace->workers[0]);
+    for (uint8_t t = 1; t < threads; t++) {
+        if (started[t]) pthread_join(handles[t], NULL);
+    }
+#endif
+
+    // Merge visit counts; most visited is the most trusted, ties to the better mean
+    uint8_t best = 0;
+    uint32_t best_visits = 0;
+    float best_reward = 0.0f;
+    uint32_t rollouts = 0;
+    for (uint8_t i = 0; i < count; i++) {
+        uint32_t visits = 0;
+        float reward = 0.0f;
+        for (uint8_t t = 0; t < threads; t++) {
+            visits += workspace->workers[t].visits[i];
+            reward += workspace->workers[t].reward[i];
+        }
+        rollouts += visits;
+
+        if (visits > best_visits ||
+            (visits == best_visits && visits > 0 && reward > best_reward)) {
+            best = i;
+            best_visits = visits;
+            best_reward = reward;
+        }
+    }
+
+    *out = workspace->candidates[best];
+
+    if (stats) {
+        stats->rollouts = rollouts;
+        stats->candidates = count;
+        stats->threads = threads;
+        stats->value = best_visits > 0 ? (uint16_t)(best_reward * 1000.0f / (float)best_visits) : 0;
+    }
+    return true;
+}
@@ -0,0 +1,67 @@
+#ifndef BATTLE_AI_H
+#define BATTLE_AI_H
+
+#include "battle.h"
+#include <stdint.h>
+#include <stdbool.h>
+
+// Auto-battle - picks a party member's action by Monte Carlo tree search over
+// the headless battle core. Every candidate action is played out many times
+// in a private sandbox (UCB1 picks which one to try next) and the most visited
+// candidate wins. Workers search independently from the same root and their
+// counts are merged at the end (root parallelism).
+#define BATTLE_AI_MAX_CANDIDATES 48
+#define BATTLE_AI_MAX_THREADS 8
+#define BATTLE_AI_DEFAULT_DEPTH 16 // Party actions simulated past the candidate
+
+typedef struct {
+    uint16_t budget_ms;    // Wall-clock limit per decision (0 = rollout count only)
+    uint32_t max_rollouts; // Per worker (0 = until the budget runs out)
+    uint8_t threads;       // Root-parallel workers (0 = one per core)
+    uint8_t rollout_depth;
+    uint32_t seed;         // Search randomness; never drawn from the battle's stream
+} BattleAIConfig;
+
+// One worker's private copy of the battle plus its search statistics
+typedef struct {
+    BattleSandbox sandbox;
+    BattleSnapshot root;
+    RandomStream rng;
+    const BattleAction* candidates;
+    uint8_t candidate_count;
+    uint8_t actor_index;
+    BattleAIConfig config;
+    uint64_t deadline_ms;
+    uint32_t enemy_hp_start;
+    uint16_t items_start;
+    uint32_t rollouts;
+    uint32_t visits[BATTLE_AI_MAX_CANDIDATES];
+    float reward[BATTLE_AI_MAX_CANDIDATES];
+} BattleAIWorker;
+
+// Scratch storage for one search (static or per-thread - no malloc)
+typedef struct {
+    BattleAction candidates[BATTLE_AI_MAX_CANDIDATES];
+    BattleAIWorker workers[BATTLE_AI_MAX_THREADS];
+} BattleAIWorkspace;
+
+typedef struct {
+    uint32_t rollouts;    // Across all workers
+    uint8_t candidates;
+    uint8_t threads;
+    uint16_t value;       // Chosen action's mean rollout score, 0-1000
+} BattleAIStats;
+
+void battle_ai_default_config(BattleAIConfig* config, uint16_t budget_ms, uint32_t seed);
+
+// Legal, non-wasteful actions for a living party member
+uint8_t battle_ai_list_actions(const BattleContext* ctx, uint8_t actor_index, BattleAction* out, uint8_t capacity);
+
+// Fast randomized greedy play used inside rollouts
+void battle_ai_rollout_action(BattleContext* ctx, uint8_t actor_index, BattleAction* out);
+
+// Searches from ctx without modifying it; false if the member cannot act
+bool battle_ai_choose_action(const BattleContext* ctx, uint8_t actor_index, const BattleAIConfig* config,
+                             BattleAIWorkspace* workspace, BattleAction* out, BattleAIStats* stats);
+
+#endif // BATTLE_AI_H
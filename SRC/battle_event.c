@@ -0,0 +1,39 @@
+#include "battle_event.h"
+
+void battle_event_ring_reset(BattleEventRing* ring) {
+    if (!ring) return;
+    ring->head = 0;
+}
+
+void battle_event_push(BattleEventRing* ring, BattleEventType type, uint8_t actor, uint8_t target,
+                       uint16_t value, uint16_t extra) {
+    BattleEvent* event = &ring->events[ring->head & (BATTLE_EVENT_CAPACITY - 1)];
+    event->type = (uint8_t)type;
+    event->actor = actor;
+    event->target = target;
+    event->flags = 0;
+    event->value = value;
+    event->extra = extra;
+    ring->head++;
+}
+
+void battle_event_reader_init(BattleEventReader* reader, const BattleEventRing* ring) {
+    if (!reader || !ring) return;
+    reader->next = ring->head;
+    reader->dropped = 0;
+}
+
+bool battle_event_read(const BattleEventRing* ring, BattleEventReader* reader, BattleEvent* out) {
+    if (!ring || !reader || !out) return false;
+    if (reader->next == ring->head) return false;
+
+    // Lapped by the writer - skip ahead to the oldest event still in the ring
+    if (ring->head - reader->next > BATTLE_EVENT_CAPACITY) {
+        reader->dropped += ring->head - reader->next - BATTLE_EVENT_CAPACITY;
+        reader->next = ring->head - BATTLE_EVENT_CAPACITY;
+    }
+
+    *out = ring->events[reader->next & (BATTLE_EVENT_CAPACITY - 1)];
+    reader->next++;
+    return true;
+}
@@ -0,0 +1,79 @@
+#ifndef BATTLE_EVENT_H
+#define BATTLE_EVENT_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+// Fixed-size broadcast ring of typed battle outcomes. The battle core only
+// writes small structs here; each consumer (terminal, log file, simulator
+// statistics) keeps its own reader and formats or tallies at its own pace.
+#define BATTLE_EVENT_CAPACITY 128 // Must be a power of two
+
+typedef enum {
+    BATTLE_EVENT_ENEMY_APPEARED = 0, // target, value = level
+    BATTLE_EVENT_ATTACK,             // actor, target (BATTLE_ACTOR_NONE for enemy attacks)
+    BATTLE_EVENT_CRITICAL_HIT,       // Precedes the damage it doubled
+    BATTLE_EVENT_DAMAGE_DEALT,       // target, value = damage, extra = HP remaining
+    BATTLE_EVENT_ACTOR_DEFEATED,     // target
+    BATTLE_EVENT_HEALED,             // target, value = HP restored
+    BATTLE_EVENT_MP_RESTORED,        // target, value = MP restored
+    BATTLE_EVENT_SKILL_USED,         // actor, value = skill ID
+    BATTLE_EVENT_SKILL_FAILED,       // actor, value = skill ID, extra = BattleFailReason
+    BATTLE_EVENT_ITEM_USED,          // actor, value = item ID
+    BATTLE_EVENT_STATUS_APPLIED,     // target, value = StatusEffect
+    BATTLE_EVENT_STATUS_RESISTED,    // target, value = StatusEffect
+    BATTLE_EVENT_STATUS_CURED,       // target, value = StatusEffect bits removed
+    BATTLE_EVENT_BUFF_APPLIED,       // actor, target, value = BuffType, extra = skill ID
+    BATTLE_EVENT_TAUNTED,            // target
+    BATTLE_EVENT_ITEM_STOLEN,        // actor, target, value = item ID, extra = quantity
+    BATTLE_EVENT_STEAL_FAILED,       // actor, target, extra = BattleFailReason
+    BATTLE_EVENT_DEFEND,             // actor
+    BATTLE_EVENT_FLEE,               // value = 1 if the party escaped
+    BATTLE_EVENT_REWARDS,            // value = EXP per member, extra = gold
+    BATTLE_EVENT_LEVEL_UP,           // target, value = new level
+    BATTLE_EVENT_SKILL_LEARNED,      // target, value = skill ID
+    BATTLE_EVENT_ITEM_DROPPED,       // actor = enemy, value = item ID
+    BATTLE_EVENT_TYPE_COUNT
+} BattleEventType;
+
+// Why a skill or steal did nothing
+typedef enum {
+    BATTLE_FAIL_NONE = 0,
+    BATTLE_FAIL_INVALID_SKILL,
+    BATTLE_FAIL_NO_MP,
+    BATTLE_FAIL_TARGET_DEFEATED,
+    BATTLE_FAIL_ALREADY_STOLEN,
+    BATTLE_FAIL_MISSED,
+    BATTLE_FAIL_NOTHING_TO_STEAL,
+    BATTLE_FAIL_INVENTORY_FULL,
+    BATTLE_FAIL_BOSS
+} BattleFailReason;
+
+// 8 bytes; actor/target use the battle actor IDs from battle.h
+typedef struct {
+    uint8_t type;    // BattleEventType
+    uint8_t actor;
+    uint8_t target;
+    uint8_t flags;   // Reserved
+    uint16_t value;
+    uint16_t extra;
+} BattleEvent;
+
+typedef struct {
+    BattleEvent events[BATTLE_EVENT_CAPACITY];
+    uint32_t head; // Total events ever pushed; slot = head % capacity
+} BattleEventRing;
+
+// Independent cursor - a slow reader loses the oldest events, never blocks the writer
+typedef struct {
+    uint32_t next;
+    uint32_t dropped;
+} BattleEventReader;
+
+void battle_event_ring_reset(BattleEventRing* ring); // Re-init readers afterwards
+void battle_event_push(BattleEventRing* ring, BattleEventType type, uint8_t actor, uint8_t target,
+                       uint16_t value, uint16_t extra);
+void battle_event_reader_init(BattleEventReader* reader, const BattleEventRing* ring); // Sees only later events
+bool battle_event_read(const BattleEventRing* ring, BattleEventReader* reader, BattleEvent* out);
+
+#endif // BATTLE_EVENT_H
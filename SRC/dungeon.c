@@ -9,20 +9,25 @@ void dungeon_init(Dungeon* dungeon, uint8_t dungeon_id, const char* name, uint8_
     if (!dungeon) return;
     if (floors > MAX_DUNGEON_FLOORS) floors = MAX_DUNGEON_FLOORS;
 
-    memset(dungeon, 0, sizeof(Dungeon));
+    // Floors are left alone - each is built from its map the first time it is entered
+    memset(dungeon->name, 0, sizeof(dungeon->name));
+    memset(&dungeon->boss, 0, sizeof(dungeon->boss));
 
     safe_string_copy(dungeon->name, name, MAX_DUNGEON_NAME);
     dungeon->dungeon_id = dungeon_id;
     dungeon->floor_count = floors;
     dungeon->current_floor = 0;
+    dungeon->floors_loaded = 0;
     dungeon->completed = false;
     dungeon->boss_defeated = false;
 
-    // Generate all floors
-    for (uint8_t i = 0; i < floors; i++) {
-        dungeon_generate_floor(dungeon, i);
+    for (uint8_t i = 0; i < MAX_DUNGEON_FLOORS; i++) {
+        dungeon->floor_maps[i] = (i < floors) ? dungeon_get_map_asset(dungeon_id, i) : NULL;
     }
 
+    // The party arrives on the first floor
+    dungeon_materialize_floor(dungeon, 0);
+
     // Initialize boss
     dungeon_init_boss(dungeon, dungeon_id);
 
@@ -35,51 +40,49 @@ void dungeon_generate_floor(Dungeon* dungeon, uint8_t floor_index) {
     DungeonFloor* floor = &dungeon->floors[floor_index];
 
     // Load fixed map for this dungeon and floor
-    const char (*fixed_map)[DUNGEON_WIDTH + 1] = dungeon_get_fixed_map(dungeon->dungeon_id, floor_index);
+    const DungeonMapAsset* fixed_map = dungeon->floor_maps[floor_index];
 
     if (fixed_map) {
         // Use fixed map
-        dungeon_load_fixed_map(floor, fixed_map, floor_index);
+        dungeon_load_map_asset(floor, fixed_map, floor_index);
         printf("Loaded fixed map for floor %d\n", floor_index + 1);
     } else {
         // Fallback: generate procedurally (shouldn't happen with our fixed maps)
         printf("Warning: No fixed map found, using procedural generation for floor %d\n", floor_index + 1);
 
+        RandomStream* rng = random_get_stream(RNG_STREAM_MAP_GEN);
+
         // Simple generation: outer walls, some inner walls, rooms
+        memset(floor, 0, sizeof(DungeonFloor));
+        floor->encounter_rate = 30 + (floor_index * 10);
+
         for (int y = 0; y < DUNGEON_HEIGHT; y++) {
             for (int x = 0; x < DUNGEON_WIDTH; x++) {
-                DungeonTile* tile = &floor->tiles[y][x];
-                tile->explored = false;
-                tile->encounter_rate = 30 + (floor_index * 10);
-
                 // Outer walls
                 if (x == 0 || x == DUNGEON_WIDTH - 1 || y == 0 || y == DUNGEON_HEIGHT - 1) {
-                    tile->type = TILE_WALL;
+                    dungeon_floor_set_tile(floor, x, y, TILE_WALL);
                 }
                 // Random inner walls (20% chance - reduced for better navigation)
-                else if (random_chance(20)) {
-                    tile->type = TILE_WALL;
-                }
-                // Floor
-                else {
-                    tile->type = TILE_FLOOR;
+                else if (random_stream_chance(rng, 20)) {
+                    dungeon_floor_set_tile(floor, x, y, TILE_WALL);
                 }
+                // Floor (zeroed above)
             }
         }
 
         // Place entrance (start position)
         floor->player_x = DUNGEON_WIDTH / 2;
         floor->player_y = DUNGEON_HEIGHT - 2;
-        floor->tiles[floor->player_y][floor->player_x].type = TILE_ENTRANCE;
-        floor->tiles[floor->player_y][floor->player_x].explored = true;
+        dungeon_floor_set_tile(floor, floor->player_x, floor->player_y, TILE_ENTRANCE);
+        dungeon_floor_set_explored(floor, floor->player_x, floor->player_y);
 
         // Place stairs down (if not last floor) - ensure on floor tile
         if (floor_index < dungeon->floor_count - 1) {
             for (int attempts = 0; attempts < 100; attempts++) {
-                uint8_t stairs_x = random_range(2, DUNGEON_WIDTH - 3);
-                uint8_t stairs_y = random_range(2, DUNGEON_HEIGHT - 3);
-                if (floor->tiles[stairs_y][stairs_x].type == TILE_FLOOR) {
-                    floor->tiles[stairs_y][stairs_x].type = TILE_STAIRS_DOWN;
+                uint8_t stairs_x = random_stream_range(rng, 2, DUNGEON_WIDTH - 3);
+                uint8_t stairs_y = random_stream_range(rng, 2, DUNGEON_HEIGHT - 3);
+                if (dungeon_floor_get_tile(floor, stairs_x, stairs_y) == TILE_FLOOR) {
+                    dungeon_floor_set_tile(floor, stairs_x, stairs_y, TILE_STAIRS_DOWN);
                     break;
                 }
             }
@@ -88,10 +91,10 @@ void dungeon_generate_floor(Dungeon* dungeon, uint8_t floor_index) {
         // Place stairs up (if not first floor) - ensure on floor tile
         if (floor_index > 0) {
             for (int attempts = 0; attempts < 100; attempts++) {
-                uint8_t stairs_x = random_range(2, DUNGEON_WIDTH - 3);
-                uint8_t stairs_y = random_range(2, DUNGEON_HEIGHT - 3);
-                if (floor->tiles[stairs_y][stairs_x].type == TILE_FLOOR) {
-                    floor->tiles[stairs_y][stairs_x].type = TILE_STAIRS_UP;
+                uint8_t stairs_x = random_stream_range(rng, 2, DUNGEON_WIDTH - 3);
+                uint8_t stairs_y = random_stream_range(rng, 2, DUNGEON_HEIGHT - 3);
+                if (dungeon_floor_get_tile(floor, stairs_x, stairs_y) == TILE_FLOOR) {
+                    dungeon_floor_set_tile(floor, stairs_x, stairs_y, TILE_STAIRS_UP);
                     break;
                 }
             }
@@ -100,28 +103,41 @@ void dungeon_generate_floor(Dungeon* dungeon, uint8_t floor_index) {
         // Place boss room on last floor - ensure on floor tile
         if (floor_index == dungeon->floor_count - 1) {
             for (int attempts = 0; attempts < 100; attempts++) {
-                uint8_t boss_x = random_range(2, DUNGEON_WIDTH - 3);
-                uint8_t boss_y = random_range(2, DUNGEON_HEIGHT - 3);
-                if (floor->tiles[boss_y][boss_x].type == TILE_FLOOR) {
-                    floor->tiles[boss_y][boss_x].type = TILE_BOSS_ROOM;
+                uint8_t boss_x = random_stream_range(rng, 2, DUNGEON_WIDTH - 3);
+                uint8_t boss_y = random_stream_range(rng, 2, DUNGEON_HEIGHT - 3);
+                if (dungeon_floor_get_tile(floor, boss_x, boss_y) == TILE_FLOOR) {
+                    dungeon_floor_set_tile(floor, boss_x, boss_y, TILE_BOSS_ROOM);
                     break;
                 }
             }
         }
 
         // Initialize encounter counter
-        floor->encounter_steps = random_range(15, 30);
-    }
+        floor->encounter_steps = random_stream_range(rng, 15, 30);
 
-    // Initialize floor dimensions (after map loading to avoid memset issues)
-    // TODO: Make this variable per dungeon/floor for larger dungeons
-    floor->width = 16;   // Start with small floors
-    floor->height = 16;
+        // TODO: Make this variable per dungeon/floor for larger dungeons
+        floor->width = 16;   // Start with small floors
+        floor->height = 16;
+    }
 
     // Initialize camera to center on player
     dungeon_update_camera(floor);
 }
 
+DungeonFloor* dungeon_materialize_floor(Dungeon* dungeon, uint8_t floor_index) {
+    if (!dungeon || floor_index >= dungeon->floor_count) return NULL;
+
+    if (!dungeon_floor_is_loaded(dungeon, floor_index)) {
+        dungeon_generate_floor(dungeon, floor_index);
+        dungeon->floors_loaded |= (uint8_t)(1 << floor_index);
+    }
+    return &dungeon->floors[floor_index];
+}
+
+bool dungeon_floor_is_loaded(const Dungeon* dungeon, uint8_t floor_index) {
+    return dungeon && (dungeon->floors_loaded & (1 << floor_index)) != 0;
+}
+
 void dungeon_init_boss(Dungeon* dungeon, uint8_t dungeon_id) {
     if (!dungeon) return;
     
@@ -148,12 +164,14 @@ void dungeon_init_boss(Dungeon* dungeon, uint8_t dungeon_id) {
         dungeon->boss.max_hp = 450;      // Was 600 (reduced ~25%)
         dungeon->boss.attack = 26;       // Was 35 (reduced ~26%)
         dungeon->boss.defense = 18;      // Was 22 (reduced ~18%)
+        dungeon->boss.agility = 16;
         dungeon->boss.level = 20;        // Was 30 (matches expected player level)
     } else {
         // Regular bosses use formula
         dungeon->boss.max_hp = 200 + (dungeon_id * 100);
         dungeon->boss.attack = 15 + (dungeon_id * 5);
         dungeon->boss.defense = 10 + (dungeon_id * 3);
+        dungeon->boss.agility = 8 + (dungeon_id * 2);
         dungeon->boss.level = 10 + (dungeon_id * 5);
     }
 
@@ -162,6 +180,36 @@ void dungeon_init_boss(Dungeon* dungeon, uint8_t dungeon_id) {
     dungeon->boss.buff_count = 0;
 }
 
+// ============================================================================
+// Packed tile access
+// ============================================================================
+
+TileType dungeon_floor_get_tile(const DungeonFloor* floor, uint8_t x, uint8_t y) {
+    uint16_t index = (uint16_t)y * DUNGEON_WIDTH + x;
+    uint8_t packed = floor->tiles[index >> 1];
+    return (TileType)((index & 1) ? (packed >> 4) : (packed & 0x0F));
+}
+
+void dungeon_floor_set_tile(DungeonFloor* floor, uint8_t x, uint8_t y, TileType type) {
+    uint16_t index = (uint16_t)y * DUNGEON_WIDTH + x;
+    uint8_t* packed = &floor->tiles[index >> 1];
+    if (index & 1) {
+        *packed = (uint8_t)((*packed & 0x0F) | ((type & 0x0F) << 4));
+    } else {
+        *packed = (uint8_t)((*packed & 0xF0) | (type & 0x0F));
+    }
+}
+
+bool dungeon_floor_is_explored(const DungeonFloor* floor, uint8_t x, uint8_t y) {
+    uint16_t index = (uint16_t)y * DUNGEON_WIDTH + x;
+    return (floor->explored[index >> 3] >> (index & 7)) & 1;
+}
+
+void dungeon_floor_set_explored(DungeonFloor* floor, uint8_t x, uint8_t y) {
+    uint16_t index = (uint16_t)y * DUNGEON_WIDTH + x;
+    floor->explored[index >> 3] |= (uint8_t)(1 << (index & 7));
+}
+
 // Update camera position to follow player
 void dungeon_update_camera(DungeonFloor* floor) {
     if (!floor) return;
@@ -187,6 +235,17 @@ void dungeon_update_camera(DungeonFloor* floor) {
     floor->camera_y = (uint8_t)camera_y;
 }
 
+// Remember everything the player can see: their tile and the eight around it
+static void dungeon_reveal_around(DungeonFloor* floor, int x, int y) {
+    for (int ry = y - 1; ry <= y + 1; ry++) {
+        if (ry < 0 || ry >= floor->height) continue;
+        for (int rx = x - 1; rx <= x + 1; rx++) {
+            if (rx < 0 || rx >= floor->width) continue;
+            dungeon_floor_set_explored(floor, (uint8_t)rx, (uint8_t)ry);
+        }
+    }
+}
+
 bool dungeon_move_player(Dungeon* dungeon, int8_t dx, int8_t dy) {
     if (!dungeon) return false;
 
@@ -201,7 +260,7 @@ bool dungeon_move_player(Dungeon* dungeon, int8_t dx, int8_t dy) {
     }
 
     // Check if tile is walkable
-    TileType tile = floor->tiles[new_y][new_x].type;
+    TileType tile = dungeon_floor_get_tile(floor, new_x, new_y);
     if (tile == TILE_WALL) {
         return false;
     }
@@ -209,7 +268,7 @@ bool dungeon_move_player(Dungeon* dungeon, int8_t dx, int8_t dy) {
     // Move player
     floor->player_x = new_x;
     floor->player_y = new_y;
-    floor->tiles[new_y][new_x].explored = true;
+    dungeon_reveal_around(floor, new_x, new_y);
 
     // Update camera to follow player
     dungeon_update_camera(floor);
@@ -221,7 +280,7 @@ TileType dungeon_get_current_tile(Dungeon* dungeon) {
     if (!dungeon) return TILE_WALL;
     
     DungeonFloor* floor = &dungeon->floors[dungeon->current_floor];
-    return floor->tiles[floor->player_y][floor->player_x].type;
+    return dungeon_floor_get_tile(floor, floor->player_x, floor->player_y);
 }
 
 bool dungeon_change_floor(Dungeon* dungeon, bool going_down) {
@@ -230,10 +289,12 @@ bool dungeon_change_floor(Dungeon* dungeon, bool going_down) {
     if (going_down && dungeon->current_floor < dungeon->floor_count - 1) {
         dungeon->current_floor++;
         printf("Descending to floor %d...\n", dungeon->current_floor + 1);
+        dungeon_materialize_floor(dungeon, dungeon->current_floor);
         return true;
     } else if (!going_down && dungeon->current_floor > 0) {
         dungeon->current_floor--;
         printf("Ascending to floor %d...\n", dungeon->current_floor + 1);
+        dungeon_materialize_floor(dungeon, dungeon->current_floor);
         return true;
     }
     
@@ -244,11 +305,11 @@ bool dungeon_check_encounter(Dungeon* dungeon) {
     if (!dungeon) return false;
 
     DungeonFloor* floor = &dungeon->floors[dungeon->current_floor];
-    DungeonTile* tile = &floor->tiles[floor->player_y][floor->player_x];
+    TileType tile = dungeon_floor_get_tile(floor, floor->player_x, floor->player_y);
 
     // Step-counter encounter system (Final Fantasy style)
     // Boss rooms are safe zones - no random encounters until you interact
-    if (tile->type == TILE_FLOOR || tile->type == TILE_ENTRANCE) {
+    if (tile == TILE_FLOOR || tile == TILE_ENTRANCE) {
         // Decrement encounter counter
         if (floor->encounter_steps > 0) {
             floor->encounter_steps--;
@@ -257,7 +318,7 @@ bool dungeon_check_encounter(Dungeon* dungeon) {
         // Check if encounter triggers
         if (floor->encounter_steps == 0) {
             // Reset counter for next encounter (random 15-30 steps)
-            floor->encounter_steps = random_range(15, 30);
+            floor->encounter_steps = random_stream_range(random_get_stream(RNG_STREAM_ENCOUNTER), 15, 30);
             return true;
         }
     }
@@ -10,8 +10,16 @@
 // Dungeon management
 void dungeon_init(Dungeon* dungeon, uint8_t dungeon_id, const char* name, uint8_t floors);
 void dungeon_generate_floor(Dungeon* dungeon, uint8_t floor_index);
+DungeonFloor* dungeon_materialize_floor(Dungeon* dungeon, uint8_t floor_index); // Builds it on first entry
+bool dungeon_floor_is_loaded(const Dungeon* dungeon, uint8_t floor_index);
 void dungeon_init_boss(Dungeon* dungeon, uint8_t dungeon_id);
 
+// Packed tile access (coordinates are not bounds-checked against width/height)
+TileType dungeon_floor_get_tile(const DungeonFloor* floor, uint8_t x, uint8_t y);
+void dungeon_floor_set_tile(DungeonFloor* floor, uint8_t x, uint8_t y, TileType type);
+bool dungeon_floor_is_explored(const DungeonFloor* floor, uint8_t x, uint8_t y);
+void dungeon_floor_set_explored(DungeonFloor* floor, uint8_t x, uint8_t y);
+
 // Dungeon exploration
 void dungeon_update_camera(DungeonFloor* floor);
 bool dungeon_move_player(Dungeon* dungeon, int8_t dx, int8_t dy);
@@ -1,453 +1,40 @@
 #include "dungeon_maps.h"
+#include "dungeon.h"
 #include "utils.h"
 #include <string.h>
 #include <stdio.h>
 
-// Cave of Earth - Floor 1
-static const char cave_of_earth_floor1[DUNGEON_HEIGHT][DUNGEON_WIDTH + 1] = {
-    "################",
-    "#.....#........#",
-    "#.###.#.####...#",
-    "#.#.........##.#",
-    "#.#.#######..#.#",
-    "#....#....#..#.#",
-    "#.##...T..#..#.#",
-    "#.#.......#..#.#",
-    "#.#.......#..#.#",
-    "#.#########..#.#",
-    "#............#.#",
-    "#.############.#",
-    "#..............#",
-    "#E.........D...#",
-    "################",
-    "################"
-};
-
-// Cave of Earth - Floor 2
-static const char cave_of_earth_floor2[DUNGEON_HEIGHT][DUNGEON_WIDTH + 1] = {
-    "################",
-    "#..............#",
-    "#.####.####.##.#",
-    "#.#.........##.#",
-    "#.#.##T####.##.#",
-    "#.#.##.....###.#",
-    "#.#.##.###...#.#",
-    "#.#....#.#...#.#",
-    "#.#####.##...#.#",
-    "#.......##T..#.#",
-    "#U#######....#.#",
-    "#............#.#",
-    "####.##########",
-    "#..............#",
-    "#.......D......#",
-    "################"
-};
-
-// Cave of Earth - Floor 3 (Boss)
-static const char cave_of_earth_floor3[DUNGEON_HEIGHT][DUNGEON_WIDTH + 1] = {
-    "################",
-    "#..............#",
-    "#.............T#",
-    "#..............#",
-    "#.....####.....#",
-    "#.....#..#.....#",
-    "#.....#..#.....#",
-    "#U....#..#.....#",
-    "#.....#..#.....#",
-    "#.....####.....#",
-    "#..............#",
-    "#.......B......#",
-    "#..............#",
-    "#..............#",
-    "#..............#",
-    "################"
-};
-
-// Water Temple - Floor 1
-static const char water_temple_floor1[DUNGEON_HEIGHT][DUNGEON_WIDTH + 1] = {
-    "################",
-    "#.#.#.#.#.#.#..#",
-    "#.#.#.#.#.#.#..#",
-    "#.#.#.#.#.#.#..#",
-    "#.............T#",
-    "##.###########.#",
-    "#..............#",
-    "#.############.#",
-    "#.#..........#.#",
-    "#.#.T.######.#.#",
-    "#.#..........#.#",
-    "#...##########.#",
-    "#..............#",
-    "#E............D#",
-    "################",
-    "################"
-};
-
-// Water Temple - Floor 2
-static const char water_temple_floor2[DUNGEON_HEIGHT][DUNGEON_WIDTH + 1] = {
-    "################",
-    "#......#.......#",
-    "#.####.#.#####.#",
-    "#.#....#.....#.#",
-    "#.#.########.#.#",
-    "#.#..........#.#",
-    "#.#T########.#.#",
-    "#.#..........#.#",
-    "#.############.#",
-    "#..............#",
-    "##############.#",
-    "#U...T.........#",
-    "#.############.#",
-    "#..............#",
-    "#.............D#",
-    "################"
-};
-
-// Water Temple - Floor 3 (Boss)
-static const char water_temple_floor3[DUNGEON_HEIGHT][DUNGEON_WIDTH + 1] = {
-    "################",
-    "#..............#",
-    "#...##....##...#",
-    "#...#......#...#",
-    "#...#......#...#",
-    "#...#......#...#",
-    "#..............#",
-    "#U.....B.......#",
-    "#..............#",
-    "#...#......#...#",
-    "#...#......#...#",
-    "#...#......#T..#",
-    "#...##....##...#",
-    "#..............#",
-    "#..............#",
-    "################"
-};
-
-// Volcano Keep - Floor 1
-static const char volcano_keep_floor1[DUNGEON_HEIGHT][DUNGEON_WIDTH + 1] = {
-    "################",
-    "#..............#",
-    "#.###.#########",
-    "#.#.#.#........#",
-    "#.#...#.######.#",
-    "#.#####.#....#.#",
-    "#.......#.##.#.#",
-    "########.T##...#",
-    "#........###.###",
-    "#.######.....#T#",
-    "#.#....#####.#.#",
-    "#.#..........#.#",
-    "#.############.#",
-    "#E.............#",
-    "##..D..........#",
-    "################"
-};
-
-// Volcano Keep - Floor 2
-static const char volcano_keep_floor2[DUNGEON_HEIGHT][DUNGEON_WIDTH + 1] = {
-    "################",
-    "#.......#......#",
-    "#.#####.#.####.#",
-    "#.#...#.#.#..#.#",
-    "#.#.#.#...#..#.#",
-    "#.#.#.#####..#.#",
-    "#.#.#........#.#",
-    "#U#.##########.#",
-    "#.#.#.......T..#",
-    "#.#.#.#######.#.",
-    "#.#...#.......##",
-    "#.#####.########",
-    "#.......#......#",
-    "######.##.####.#",
-    "#.....D........#",
-    "################"
-};
-
-// Volcano Keep - Floor 3 (Boss)
-static const char volcano_keep_floor3[DUNGEON_HEIGHT][DUNGEON_WIDTH + 1] = {
-    "################",
-    "#..............#",
-    "#..##########..#",
-    "#..#........#..#",
-    "#..#.T####..#..#",
-    "#..#..#..#..#..#",
-    "#..#..#..#..#..#",
-    "#U....#..#.....#",
-    "#..#..#..#..#..#",
-    "#..#..B..#..#..#",
-    "#..#..####..#..#",
-    "#..#........#..#",
-    "#..##########..#",
-    "#..............#",
-    "#..............#",
-    "################"
-};
-
-// Sky Tower - Floor 1
-static const char sky_tower_floor1[DUNGEON_HEIGHT][DUNGEON_WIDTH + 1] = {
-    "################",
-    "#..............#",
-    "#..##########..#",
-    "#...........#..#",
-    "#..#...####.#..#",
-    "#..#..T....#.#.#",
-    "#..#...##.#.#..#",
-    "#..#......#.#..#",
-    "#..#.######.#..#",
-    "#..#........#..#",
-    "#..##########..#",
-    "#..............#",
-    "#E.............#",
-    "#..............#",
-    "#......D.......#",
-    "################"
-};
-
-// Sky Tower - Floor 2
-static const char sky_tower_floor2[DUNGEON_HEIGHT][DUNGEON_WIDTH + 1] = {
-    "################",
-    "#..............#",
-    "#.############.#",
-    "#.#..........#.#",
-    "#.#.#######..#.#",
-    "#.#.#......#.#.#",
-    "#.#.#.####..T..#",
-    "#U#.#.#....#.#.#",
-    "#.#.#.#.##.#.#.#",
-    "#.#.#.#....#.#.#",
-    "#.#.#.######.#.#",
-    "#.#..........#.#",
-    "#.############.#",
-    "#..............#",
-    "#.......D......#",
-    "################"
-};
-
-// Sky Tower - Floor 3 (Boss)
-static const char sky_tower_floor3[DUNGEON_HEIGHT][DUNGEON_WIDTH + 1] = {
-    "################",
-    "#..............#",
-    "#.#.#.#.#.#.#.##",
-    "#.#.#.#.#.#.#..#",
-    "#.#.#.#.#.#.#..#",
-    "#.#.#.#.#.#.#..#",
-    "#..............#",
-    "#U.............#",
-    "#..............#",
-    "#.#.#.#.#.#.#..#",
-    "#.#.#.#.#.#.#..#",
-    "#.#.#.#.#.#.#..#",
-    "##.#.#.#.#.#.#.#",
-    "#........B.....#",
-    "#.....T........#",
-    "################"
-};
-
-// Final Sanctum - Floor 1
-static const char final_sanctum_floor1[DUNGEON_HEIGHT][DUNGEON_WIDTH + 1] = {
-    "################",
-    "#..............#",
-    "#.####....####.#",
-    "#.#..#....#..#.#",
-    "#.#..#....#..#.#",
-    "#.#..#T..T#..#.#",
-    "#.#..#....#..#.#",
-    "#.#..########..#",
-    "#.#............#",
-    "#.##############",
-    "#..............#",
-    "#E............D#",
-    "################",
-    "################",
-    "################",
-    "################"
-};
-
-// Final Sanctum - Floor 2
-static const char final_sanctum_floor2[DUNGEON_HEIGHT][DUNGEON_WIDTH + 1] = {
-    "################",
-    "#U...........#.#",
-    "####.#######.#.#",
-    "#....#.....#.#.#",
-    "#.####.###.#.#.#",
-    "#.#....#.#.#.#.#",
-    "#.#.####.#T#.#.#",
-    "#.#..........#.#",
-    "#.#####.#####.#.",
-    "#.....#.#.....##",
-    "#####.#.#.######",
-    "#.....#........#",
-    "#.#############",
-    "#..............#",
-    "#.............D#",
-    "################"
-};
-
-// Final Sanctum - Floor 3
-static const char final_sanctum_floor3[DUNGEON_HEIGHT][DUNGEON_WIDTH + 1] = {
-    "################",
-    "#..............#",
-    "#.############.#",
-    "#.#U.........#.#",
-    "#.#.########.#.#",
-    "#.#..T.....#.#.#",
-    "#.#.#.####.#.#.#",
-    "#.#.#.#..#.#.#.#",
-    "#.#.#.#..#.#.#.#",
-    "#.#.#.####.#.#.#",
-    "#.#.#......#.#.#",
-    "#.#.########.#.#",
-    "#.#..........#.#",
-    "#.#######.####.#",
-    "#.......D......#",
-    "################"
-};
-
-// Final Sanctum - Floor 4
-static const char final_sanctum_floor4[DUNGEON_HEIGHT][DUNGEON_WIDTH + 1] = {
-    "################",
-    "#..#........#..#",
-    "#..#.###.##.#..#",
-    "#..#.#....#.#..#",
-    "#..#.#.##.#.#..#",
-    "#..#.#...#####.#",
-    "#..#.#..T....#.#",
-    "#U.#.#....#..#.#",
-    "#..#.####...##.#",
-    "#..#.........#.#",
-    "#..#####.####..#",
-    "#..............#",
-    "#.#############",
-    "#..............#",
-    "#.......D......#",
-    "################"
-};
-
-// Final Sanctum - Floor 5 (Final Boss)
-static const char final_sanctum_floor5[DUNGEON_HEIGHT][DUNGEON_WIDTH + 1] = {
-    "################",
-    "#..............#",
-    "#..............#",
-    "#....######....#",
-    "#....#....#....#",
-    "#....#.##.#....#",
-    "#....#...#####.#",
-    "#U...#..T....#.#",
-    "#....#...####.#",
-    "#....#....#....#",
-    "#....###.##....#",
-    "#..............#",
-    "#.......B......#",
-    "#..............#",
-    "#..............#",
-    "################"
-};
-
 // Map lookup table
-const char (*dungeon_get_fixed_map(uint8_t dungeon_id, uint8_t floor_number))[DUNGEON_WIDTH + 1] {
-    switch (dungeon_id) {
-        case 0: // Cave of Earth
-            switch (floor_number) {
-                case 0: return cave_of_earth_floor1;
-                case 1: return cave_of_earth_floor2;
-                case 2: return cave_of_earth_floor3;
-            }
-            break;
-
-        case 1: // Water Temple
-            switch (floor_number) {
-                case 0: return water_temple_floor1;
-                case 1: return water_temple_floor2;
-                case 2: return water_temple_floor3;
-            }
-            break;
-
-        case 2: // Volcano Keep
-            switch (floor_number) {
-                case 0: return volcano_keep_floor1;
-                case 1: return volcano_keep_floor2;
-                case 2: return volcano_keep_floor3;
-            }
-            break;
+const DungeonMapAsset* dungeon_get_map_asset(uint8_t dungeon_id, uint8_t floor_number) {
+    if (dungeon_id > MAX_DUNGEONS || floor_number >= MAX_DUNGEON_FLOORS) return NULL;
 
-        case 3: // Sky Tower
-            switch (floor_number) {
-                case 0: return sky_tower_floor1;
-                case 1: return sky_tower_floor2;
-                case 2: return sky_tower_floor3;
-            }
-            break;
+    uint8_t index = dungeon_map_index[dungeon_id][floor_number];
+    if (index == DUNGEON_MAP_NONE || index >= dungeon_map_asset_count) return NULL;
 
-        case 4: // Final Sanctum
-            switch (floor_number) {
-                case 0: return final_sanctum_floor1;
-                case 1: return final_sanctum_floor2;
-                case 2: return final_sanctum_floor3;
-                case 3: return final_sanctum_floor4;
-                case 4: return final_sanctum_floor5;
-            }
-            break;
-    }
+    return &dungeon_map_assets[index];
+}
 
-    return NULL;
+TileType dungeon_map_get_tile(const DungeonMapAsset* asset, uint8_t x, uint8_t y) {
+    uint16_t index = (uint16_t)y * DUNGEON_WIDTH + x;
+    uint8_t packed = asset->tiles[index >> 1];
+    return (TileType)((index & 1) ? (packed >> 4) : (packed & 0x0F));
 }
 
-void dungeon_load_fixed_map(DungeonFloor* floor, const char map[DUNGEON_HEIGHT][DUNGEON_WIDTH + 1], uint8_t floor_number) {
-    if (!floor || !map) return;
+void dungeon_load_map_asset(DungeonFloor* floor, const DungeonMapAsset* asset, uint8_t floor_number) {
+    if (!floor || !asset) return;
 
     // Clear floor
     memset(floor, 0, sizeof(DungeonFloor));
 
     // Initialize encounter counter (random 15-30 steps)
-    floor->encounter_steps = random_range(15, 30);
-
-    // Parse map
-    for (int y = 0; y < DUNGEON_HEIGHT; y++) {
-        for (int x = 0; x < DUNGEON_WIDTH; x++) {
-            DungeonTile* tile = &floor->tiles[y][x];
-            tile->explored = false;
-            tile->encounter_rate = 20 + (floor_number * 5); // Still used for certain mechanics
-
-            char c = map[y][x];
-            switch (c) {
-                case '#':
-                    tile->type = TILE_WALL;
-                    break;
-
-                case '.':
-                    tile->type = TILE_FLOOR;
-                    break;
-
-                case 'E':
-                    tile->type = TILE_ENTRANCE;
-                    floor->player_x = x;
-                    floor->player_y = y;
-                    tile->explored = true;
-                    break;
-
-                case 'D':
-                    tile->type = TILE_STAIRS_DOWN;
-                    break;
-
-                case 'U':
-                    tile->type = TILE_STAIRS_UP;
-                    floor->player_x = x;
-                    floor->player_y = y;
-                    tile->explored = true;
-                    break;
-
-                case 'T':
-                    tile->type = TILE_TREASURE;
-                    break;
-
-                case 'B':
-                    tile->type = TILE_BOSS_ROOM;
-                    break;
-
-                default:
-                    tile->type = TILE_FLOOR;
-                    break;
-            }
-        }
-    }
+    floor->encounter_steps = random_stream_range(random_get_stream(RNG_STREAM_MAP_GEN), 15, 30);
+    floor->encounter_rate = 20 + (floor_number * 5); // Still used for certain mechanics
+
+    // Tiles are already packed; only the start tile begins explored
+    memcpy(floor->tiles, asset->tiles, DUNGEON_TILE_BYTES);
+    floor->width = asset->width;
+    floor->height = asset->height;
+    floor->player_x = asset->start.x;
+    floor->player_y = asset->start.y;
+    dungeon_floor_set_explored(floor, asset->start.x, asset->start.y);
 }
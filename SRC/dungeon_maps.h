@@ -3,20 +3,45 @@
 
 #include "game_state.h"
 
-// Fixed dungeon map definitions
-// Map format: ASCII characters for easy editing
-//   '#' = Wall
-//   '.' = Floor
-//   'E' = Entrance (player start)
-//   'D' = Stairs Down
-//   'U' = Stairs Up
-//   'T' = Treasure
-//   'B' = Boss Room
-
-// Function to load a fixed map into a dungeon floor
-void dungeon_load_fixed_map(DungeonFloor* floor, const char map[DUNGEON_HEIGHT][DUNGEON_WIDTH + 1], uint8_t floor_number);
-
-// Get the fixed map for a specific dungeon and floor
-const char (*dungeon_get_fixed_map(uint8_t dungeon_id, uint8_t floor_number))[DUNGEON_WIDTH + 1];
+// Fixed dungeon maps, compiled ahead of time
+// The ASCII sources live in MAPS/dungeon_floors.txt; TOOLS/map_compiler.c turns
+// them into SRC/dungeon_map_data.c ("make maps"). Each floor is stored already
+// packed in DungeonFloor.tiles layout, with its landmarks precomputed, so
+// entering a floor is a copy rather than a parse.
+#define DUNGEON_MAP_MAX_TREASURES 8
+#define DUNGEON_MAP_NONE 0xFF        // Missing landmark / no map in the index
+
+typedef struct {
+    uint8_t x;
+    uint8_t y;
+} DungeonMapPoint;
+
+typedef struct DungeonMapAsset {
+    uint8_t dungeon_id;
+    uint8_t floor_number;
+    uint8_t width;
+    uint8_t height;
+    DungeonMapPoint start;           // Entrance on the first floor, stairs up after
+    DungeonMapPoint stairs_down;     // DUNGEON_MAP_NONE if absent
+    DungeonMapPoint stairs_up;
+    DungeonMapPoint boss;
+    uint8_t treasure_count;
+    DungeonMapPoint treasures[DUNGEON_MAP_MAX_TREASURES];
+    const uint8_t* tiles;            // DUNGEON_TILE_BYTES of packed TileType nibbles
+} DungeonMapAsset;
+
+// Generated tables (dungeon_map_data.c)
+extern const DungeonMapAsset dungeon_map_assets[];
+extern const uint8_t dungeon_map_asset_count;
+extern const uint8_t dungeon_map_index[MAX_DUNGEONS + 1][MAX_DUNGEON_FLOORS]; // Into dungeon_map_assets
+
+// Get the compiled map for a specific dungeon and floor (NULL if none)
+const DungeonMapAsset* dungeon_get_map_asset(uint8_t dungeon_id, uint8_t floor_number);
+
+// Tile type straight from a compiled map
+TileType dungeon_map_get_tile(const DungeonMapAsset* asset, uint8_t x, uint8_t y);
+
+// Function to load a compiled map into a dungeon floor
+void dungeon_load_map_asset(DungeonFloor* floor, const DungeonMapAsset* asset, uint8_t floor_number);
 
 #endif // DUNGEON_MAPS_H
@@ -0,0 +1,361 @@
+#include "encounter.h"
+#include "battle.h"
+#include <stdio.h>
+#include <string.h>
+
+// ============================================================================
+// Formation data
+// ============================================================================
+// { weight, level_min, level_max, count, { enemies } }
+// Dungeon floors keep the old level spread (floor number + 0..3); dragons and
+// demons only turn up from the third floor or in zones of level 3 and up.
+
+typedef struct {
+    const EncounterFormation* formations;
+    uint8_t formation_count;
+} EncounterTableDef;
+
+#define ENCOUNTER_TABLE(list) { list, (uint8_t)(sizeof(list) / sizeof(list[0])) }
+#define ENCOUNTER_NO_TABLE    { NULL, 0 }
+
+// Overworld zones
+static const EncounterFormation encounter_grassland[] = {
+    { 30, 1, 3, 2, { ENEMY_GOBLIN, ENEMY_GOBLIN } },
+    { 25, 1, 3, 1, { ENEMY_WOLF } },
+    { 20, 1, 4, 3, { ENEMY_GOBLIN, ENEMY_GOBLIN, ENEMY_WOLF } },
+    { 15, 2, 4, 2, { ENEMY_ORC, ENEMY_GOBLIN } },
+    { 10, 2, 4, 4, { ENEMY_GOBLIN, ENEMY_GOBLIN, ENEMY_GOBLIN, ENEMY_GOBLIN } },
+};
+
+static const EncounterFormation encounter_forest[] = {
+    { 30, 3, 5, 3, { ENEMY_WOLF, ENEMY_WOLF, ENEMY_WOLF } },
+    { 25, 3, 6, 2, { ENEMY_ORC, ENEMY_WOLF } },
+    { 20, 3, 6, 2, { ENEMY_ORC, ENEMY_ORC } },
+    { 15, 4, 6, 4, { ENEMY_GOBLIN, ENEMY_GOBLIN, ENEMY_ORC, ENEMY_WOLF } },
+    { 10, 5, 6, 1, { ENEMY_DRAGON } },
+};
+
+static const EncounterFormation encounter_desert[] = {
+    { 30, 3, 5, 2, { ENEMY_SKELETON, ENEMY_SKELETON } },
+    { 25, 3, 6, 3, { ENEMY_GOBLIN, ENEMY_GOBLIN, ENEMY_SKELETON } },
+    { 20, 3, 6, 1, { ENEMY_ORC } },
+    { 15, 4, 6, 4, { ENEMY_SKELETON, ENEMY_SKELETON, ENEMY_SKELETON, ENEMY_SKELETON } },
+    { 10, 5, 6, 1, { ENEMY_DEMON } },
+};
+
+static const EncounterFormation encounter_mountain[] = {
+    { 30, 5, 7, 3, { ENEMY_ORC, ENEMY_ORC, ENEMY_ORC } },
+    { 25, 5, 8, 2, { ENEMY_WOLF, ENEMY_ORC } },
+    { 20, 6, 8, 1, { ENEMY_DRAGON } },
+    { 15, 5, 8, 4, { ENEMY_ORC, ENEMY_ORC, ENEMY_WOLF, ENEMY_WOLF } },
+    { 10, 7, 8, 2, { ENEMY_DRAGON, ENEMY_ORC } },
+};
+
+static const EncounterFormation encounter_coast[] = {
+    { 35, 2, 4, 2, { ENEMY_SKELETON, ENEMY_GOBLIN } },
+    { 25, 2, 5, 3, { ENEMY_GOBLIN, ENEMY_GOBLIN, ENEMY_GOBLIN } },
+    { 20, 2, 5, 1, { ENEMY_WOLF } },
+    { 20, 3, 5, 4, { ENEMY_SKELETON, ENEMY_SKELETON, ENEMY_WOLF, ENEMY_WOLF } },
+};
+
+static const EncounterFormation encounter_highland[] = {
+    { 30, 5, 7, 3, { ENEMY_WOLF, ENEMY_WOLF, ENEMY_WOLF } },
+    { 25, 5, 8, 2, { ENEMY_SKELETON, ENEMY_WOLF } },
+    { 20, 6, 8, 1, { ENEMY_DRAGON } },
+    { 15, 6, 8, 1, { ENEMY_DEMON } },
+    { 10, 7, 8, 4, { ENEMY_WOLF, ENEMY_WOLF, ENEMY_SKELETON, ENEMY_SKELETON } },
+};
+
+static const EncounterFormation encounter_sanctum_path[] = {
+    { 30, 8, 10, 2, { ENEMY_DEMON, ENEMY_SKELETON } },
+    { 25, 8, 11, 1, { ENEMY_DRAGON } },
+    { 20, 8, 11, 3, { ENEMY_SKELETON, ENEMY_SKELETON, ENEMY_DEMON } },
+    { 15, 9, 11, 2, { ENEMY_DEMON, ENEMY_DEMON } },
+    { 10, 10, 11, 2, { ENEMY_DRAGON, ENEMY_DEMON } },
+};
+
+// Cave of Earth
+static const EncounterFormation encounter_cave_1[] = {
+    { 35, 1, 4, 2, { ENEMY_GOBLIN, ENEMY_GOBLIN } },
+    { 25, 1, 4, 1, { ENEMY_WOLF } },
+    { 25, 1, 4, 3, { ENEMY_GOBLIN, ENEMY_WOLF, ENEMY_GOBLIN } },
+    { 15, 2, 4, 4, { ENEMY_GOBLIN, ENEMY_GOBLIN, ENEMY_GOBLIN, ENEMY_ORC } },
+};
+
+static const EncounterFormation encounter_cave_2[] = {
+    { 30, 2, 5, 2, { ENEMY_ORC, ENEMY_GOBLIN } },
+    { 25, 2, 5, 3, { ENEMY_WOLF, ENEMY_WOLF, ENEMY_WOLF } },
+    { 25, 2, 5, 1, { ENEMY_ORC } },
+    { 20, 3, 5, 4, { ENEMY_GOBLIN, ENEMY_GOBLIN, ENEMY_ORC, ENEMY_ORC } },
+};
+
+static const EncounterFormation encounter_cave_3[] = {
+    { 30, 3, 6, 3, { ENEMY_ORC, ENEMY_ORC, ENEMY_GOBLIN } },
+    { 25, 3, 6, 2, { ENEMY_WOLF, ENEMY_ORC } },
+    { 20, 3, 6, 4, { ENEMY_WOLF, ENEMY_WOLF, ENEMY_GOBLIN, ENEMY_GOBLIN } },
+    { 15, 4, 6, 2, { ENEMY_SKELETON, ENEMY_ORC } },
+    { 10, 5, 6, 1, { ENEMY_DRAGON } },
+};
+
+// Water Temple
+static const EncounterFormation encounter_water_1[] = {
+    { 35, 1, 4, 2, { ENEMY_SKELETON, ENEMY_SKELETON } },
+    { 25, 1, 4, 3, { ENEMY_GOBLIN, ENEMY_GOBLIN, ENEMY_GOBLIN } },
+    { 25, 1, 4, 1, { ENEMY_SKELETON } },
+    { 15, 2, 4, 4, { ENEMY_SKELETON, ENEMY_GOBLIN, ENEMY_SKELETON, ENEMY_GOBLIN } },
+};
+
+static const EncounterFormation encounter_water_2[] = {
+    { 30, 2, 5, 3, { ENEMY_SKELETON, ENEMY_SKELETON, ENEMY_SKELETON } },
+    { 25, 2, 5, 2, { ENEMY_SKELETON, ENEMY_ORC } },
+    { 25, 2, 5, 2, { ENEMY_WOLF, ENEMY_WOLF } },
+    { 20, 3, 5, 4, { ENEMY_SKELETON, ENEMY_SKELETON, ENEMY_GOBLIN, ENEMY_GOBLIN } },
+};
+
+static const EncounterFormation encounter_water_3[] = {
+    { 30, 3, 6, 3, { ENEMY_SKELETON, ENEMY_SKELETON, ENEMY_ORC } },
+    { 25, 3, 6, 2, { ENEMY_SKELETON, ENEMY_SKELETON } },
+    { 20, 3, 6, 4, { ENEMY_SKELETON, ENEMY_SKELETON, ENEMY_SKELETON, ENEMY_SKELETON } },
+    { 15, 4, 6, 2, { ENEMY_ORC, ENEMY_WOLF } },
+    { 10, 5, 6, 1, { ENEMY_DEMON } },
+};
+
+// Volcano Keep
+static const EncounterFormation encounter_volcano_1[] = {
+    { 35, 1, 4, 2, { ENEMY_ORC, ENEMY_GOBLIN } },
+    { 25, 1, 4, 2, { ENEMY_WOLF, ENEMY_WOLF } },
+    { 25, 1, 4, 1, { ENEMY_ORC } },
+    { 15, 2, 4, 3, { ENEMY_GOBLIN, ENEMY_GOBLIN, ENEMY_ORC } },
+};
+
+static const EncounterFormation encounter_volcano_2[] = {
+    { 30, 2, 5, 2, { ENEMY_ORC, ENEMY_ORC } },
+    { 25, 2, 5, 3, { ENEMY_WOLF, ENEMY_WOLF, ENEMY_ORC } },
+    { 25, 2, 5, 1, { ENEMY_ORC } },
+    { 20, 3, 5, 4, { ENEMY_ORC, ENEMY_ORC, ENEMY_WOLF, ENEMY_WOLF } },
+};
+
+static const EncounterFormation encounter_volcano_3[] = {
+    { 30, 3, 6, 3, { ENEMY_ORC, ENEMY_ORC, ENEMY_WOLF } },
+    { 25, 3, 6, 2, { ENEMY_ORC, ENEMY_ORC } },
+    { 20, 4, 6, 1, { ENEMY_DRAGON } },
+    { 15, 3, 6, 4, { ENEMY_WOLF, ENEMY_WOLF, ENEMY_WOLF, ENEMY_WOLF } },
+    { 10, 5, 6, 2, { ENEMY_DRAGON, ENEMY_ORC } },
+};
+
+// Sky Tower
+static const EncounterFormation encounter_sky_1[] = {
+    { 35, 1, 4, 2, { ENEMY_WOLF, ENEMY_WOLF } },
+    { 25, 1, 4, 1, { ENEMY_SKELETON } },
+    { 25, 1, 4, 3, { ENEMY_WOLF, ENEMY_SKELETON, ENEMY_WOLF } },
+    { 15, 2, 4, 4, { ENEMY_GOBLIN, ENEMY_GOBLIN, ENEMY_WOLF, ENEMY_WOLF } },
+};
+
+static const EncounterFormation encounter_sky_2[] = {
+    { 30, 2, 5, 3, { ENEMY_WOLF, ENEMY_WOLF, ENEMY_WOLF } },
+    { 25, 2, 5, 2, { ENEMY_SKELETON, ENEMY_WOLF } },
+    { 25, 2, 5, 2, { ENEMY_ORC, ENEMY_SKELETON } },
+    { 20, 3, 5, 4, { ENEMY_SKELETON, ENEMY_SKELETON, ENEMY_WOLF, ENEMY_WOLF } },
+};
+
+static const EncounterFormation encounter_sky_3[] = {
+    { 30, 3, 6, 3, { ENEMY_WOLF, ENEMY_WOLF, ENEMY_SKELETON } },
+    { 25, 3, 6, 2, { ENEMY_SKELETON, ENEMY_SKELETON } },
+    { 20, 4, 6, 1, { ENEMY_DRAGON } },
+    { 15, 4, 6, 1, { ENEMY_DEMON } },
+    { 10, 5, 6, 2, { ENEMY_DRAGON, ENEMY_WOLF } },
+};
+
+// Final Sanctum
+static const EncounterFormation encounter_sanctum_1[] = {
+    { 30, 1, 4, 3, { ENEMY_SKELETON, ENEMY_GOBLIN, ENEMY_ORC } },
+    { 25, 1, 4, 2, { ENEMY_WOLF, ENEMY_SKELETON } },
+    { 25, 1, 4, 2, { ENEMY_ORC, ENEMY_ORC } },
+    { 20, 2, 4, 4, { ENEMY_GOBLIN, ENEMY_ORC, ENEMY_SKELETON, ENEMY_WOLF } },
+};
+
+static const EncounterFormation encounter_sanctum_2[] = {
+    { 30, 2, 5, 3, { ENEMY_ORC, ENEMY_ORC, ENEMY_SKELETON } },
+    { 25, 2, 5, 2, { ENEMY_SKELETON, ENEMY_SKELETON } },
+    { 25, 2, 5, 3, { ENEMY_WOLF, ENEMY_WOLF, ENEMY_ORC } },
+    { 20, 3, 5, 4, { ENEMY_SKELETON, ENEMY_SKELETON, ENEMY_ORC, ENEMY_ORC } },
+};
+
+static const EncounterFormation encounter_sanctum_3[] = {
+    { 30, 3, 6, 3, { ENEMY_ORC, ENEMY_SKELETON, ENEMY_WOLF } },
+    { 25, 3, 6, 1, { ENEMY_DRAGON } },
+    { 20, 3, 6, 1, { ENEMY_DEMON } },
+    { 15, 4, 6, 4, { ENEMY_SKELETON, ENEMY_SKELETON, ENEMY_SKELETON, ENEMY_SKELETON } },
+    { 10, 5, 6, 2, { ENEMY_DEMON, ENEMY_SKELETON } },
+};
+
+static const EncounterFormation encounter_sanctum_4[] = {
+    { 30, 4, 7, 2, { ENEMY_DEMON, ENEMY_SKELETON } },
+    { 25, 4, 7, 1, { ENEMY_DRAGON } },
+    { 20, 4, 7, 3, { ENEMY_ORC, ENEMY_ORC, ENEMY_DEMON } },
+    { 15, 5, 7, 2, { ENEMY_DRAGON, ENEMY_WOLF } },
+    { 10, 6, 7, 2, { ENEMY_DEMON, ENEMY_DEMON } },
+};
+
+static const EncounterFormation encounter_sanctum_5[] = {
+    { 30, 5, 8, 2, { ENEMY_DEMON, ENEMY_DEMON } },
+    { 25, 5, 8, 1, { ENEMY_DRAGON } },
+    { 20, 5, 8, 3, { ENEMY_DEMON, ENEMY_SKELETON, ENEMY_SKELETON } },
+    { 15, 6, 8, 2, { ENEMY_DRAGON, ENEMY_DEMON } },
+    { 10, 7, 8, 2, { ENEMY_DRAGON, ENEMY_DRAGON } },
+};
+
+static const EncounterTableDef encounter_zone_defs[ENCOUNTER_ZONE_COUNT] = {
+    [ZONE_NONE]         = ENCOUNTER_NO_TABLE,
+    [ZONE_GRASSLAND]    = ENCOUNTER_TABLE(encounter_grassland),
+    [ZONE_FOREST]       = ENCOUNTER_TABLE(encounter_forest),
+    [ZONE_DESERT]       = ENCOUNTER_TABLE(encounter_desert),
+    [ZONE_MOUNTAIN]     = ENCOUNTER_TABLE(encounter_mountain),
+    [ZONE_COAST]        = ENCOUNTER_TABLE(encounter_coast),
+    [ZONE_DEEP_WATER]   = ENCOUNTER_NO_TABLE,
+    [ZONE_HIGHLAND]     = ENCOUNTER_TABLE(encounter_highland),
+    [ZONE_SANCTUM_PATH] = ENCOUNTER_TABLE(encounter_sanctum_path),
+};
+
+// Floors a dungeon does not have are left empty
+static const EncounterTableDef encounter_floor_defs[MAX_DUNGEONS + 1][MAX_DUNGEON_FLOORS] = {
+    { ENCOUNTER_TABLE(encounter_cave_1), ENCOUNTER_TABLE(encounter_cave_2), ENCOUNTER_TABLE(encounter_cave_3) },
+    { ENCOUNTER_TABLE(encounter_water_1), ENCOUNTER_TABLE(encounter_water_2), ENCOUNTER_TABLE(encounter_water_3) },
+    { ENCOUNTER_TABLE(encounter_volcano_1), ENCOUNTER_TABLE(encounter_volcano_2), ENCOUNTER_TABLE(encounter_volcano_3) },
+    { ENCOUNTER_TABLE(encounter_sky_1), ENCOUNTER_TABLE(encounter_sky_2), ENCOUNTER_TABLE(encounter_sky_3) },
+    { ENCOUNTER_TABLE(encounter_sanctum_1), ENCOUNTER_TABLE(encounter_sanctum_2), ENCOUNTER_TABLE(encounter_sanctum_3),
+      ENCOUNTER_TABLE(encounter_sanctum_4), ENCOUNTER_TABLE(encounter_sanctum_5) },
+};
+
+// ============================================================================
+// Alias tables
+// ============================================================================
+
+static EncounterTable encounter_zone_tables[ENCOUNTER_ZONE_COUNT];
+static EncounterTable encounter_floor_tables[MAX_DUNGEONS + 1][MAX_DUNGEON_FLOORS];
+static bool encounter_tables_ready = false;
+
+// Walker/Vose construction in integers: every column holds total_weight units,
+// filled first by its own formation and topped up from one heavier formation.
+// Scaled weights (weight * count) sum to exactly count * total_weight, so the
+// split is exact - no rounding drift between formations.
+static bool encounter_build_table(EncounterTable* table, const EncounterTableDef* def, const char* what) {
+    memset(table, 0, sizeof(EncounterTable));
+    if (def->formation_count == 0) return true;
+
+    if (def->formation_count > ENCOUNTER_MAX_FORMATIONS) {
+        printf("Error: %s has %u formations (max %d)\n", what, def->formation_count, ENCOUNTER_MAX_FORMATIONS);
+        return false;
+    }
+
+    uint16_t total = 0;
+    for (uint8_t i = 0; i < def->formation_count; i++) {
+        const EncounterFormation* formation = &def->formations[i];
+        if (formation->count == 0 || formation->count > ENCOUNTER_MAX_GROUP ||
+            formation->level_min > formation->level_max) {
+            printf("Error: %s formation %u is malformed\n", what, i);
+            return false;
+        }
+        total += formation->weight;
+    }
+    if (total == 0) {
+        printf("Error: %s has no weight\n", what);
+        return false;
+    }
+
+    uint8_t count = def->formation_count;
+    uint32_t scaled[ENCOUNTER_MAX_FORMATIONS];
+    uint8_t small[ENCOUNTER_MAX_FORMATIONS];
+    uint8_t large[ENCOUNTER_MAX_FORMATIONS];
+    uint8_t small_count = 0;
+    uint8_t large_count = 0;
+
+    for (uint8_t i = 0; i < count; i++) {
+        scaled[i] = (uint32_t)def->formations[i].weight * count;
+        if (scaled[i] < total) {
+            small[small_count++] = i;
+        } else {
+            large[large_count++] = i;
+        }
+    }
+
+    while (small_count > 0 && large_count > 0) {
+        uint8_t light = small[--small_count];
+        uint8_t heavy = large[large_count - 1];
+
+        table->keep[light] = (uint16_t)scaled[light];
+        table->alias[light] = heavy;
+
+        scaled[heavy] -= total - scaled[light];
+        if (scaled[heavy] < total) {
+            large_count--;
+            small[small_count++] = heavy;
+        }
+    }
+
+    // Whatever is left fills its own column
+    while (large_count > 0) {
+        uint8_t i = large[--large_count];
+        table->keep[i] = total;
+        table->alias[i] = i;
+    }
+    while (small_count > 0) {
+        uint8_t i = small[--small_count];
+        table->keep[i] = total;
+        table->alias[i] = i;
+    }
+
+    table->formations = def->formations;
+    table->formation_count = count;
+    table->total_weight = total;
+    return true;
+}
+
+void encounter_tables_init(void) {
+    char what[48];
+
+    for (uint8_t zone = 0; zone < ENCOUNTER_ZONE_COUNT; zone++) {
+        snprintf(what, sizeof(what), "Zone %s", world_map_zone_name(zone));
+        encounter_build_table(&encounter_zone_tables[zone], &encounter_zone_defs[zone], what);
+    }
+
+    for (uint8_t dungeon = 0; dungeon <= MAX_DUNGEONS; dungeon++) {
+        for (uint8_t floor = 0; floor < MAX_DUNGEON_FLOORS; floor++) {
+            snprintf(what, sizeof(what), "Dungeon %u floor %u", dungeon, floor + 1);
+            encounter_build_table(&encounter_floor_tables[dungeon][floor], &encounter_floor_defs[dungeon][floor], what);
+        }
+    }
+
+    encounter_tables_ready = true;
+}
+
+// ============================================================================
+// Lookup and sampling
+// ============================================================================
+
+static const EncounterTable* encounter_table_or_null(const EncounterTable* table) {
+    return (table->formation_count > 0) ? table : NULL;
+}
+
+const EncounterTable* encounter_table_for_zone(uint8_t zone) {
+    if (zone >= ENCOUNTER_ZONE_COUNT) return NULL;
+    if (!encounter_tables_ready) encounter_tables_init();
+    return encounter_table_or_null(&encounter_zone_tables[zone]);
+}
+
+const EncounterTable* encounter_table_for_floor(uint8_t dungeon_id, uint8_t floor_index) {
+    if (dungeon_id > MAX_DUNGEONS || floor_index >= MAX_DUNGEON_FLOORS) return NULL;
+    if (!encounter_tables_ready) encounter_tables_init();
+    return encounter_table_or_null(&encounter_floor_tables[dungeon_id][floor_index]);
+}
+
+const EncounterFormation* encounter_table_pick(const EncounterTable* table, RandomStream* rng) {
+    if (!table || table->formation_count == 0 || !rng) return NULL;
+
+    // One draw covers both the column and the position inside it
+    uint32_t draw = random_stream_bounded(rng, (uint32_t)table->formation_count * table->total_weight);
+    uint8_t column = (uint8_t)(draw / table->total_weight);
+    uint16_t position = (uint16_t)(draw % table->total_weight);
+
+    return &table->formations[position < table->keep[column] ? column : table->alias[column]];
+}
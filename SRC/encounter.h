@@ -0,0 +1,45 @@
+#ifndef ENCOUNTER_H
+#define ENCOUNTER_H
+
+#include "game_state.h"
+#include "utils.h"
+#include "world_map.h"
+#include <stdint.h>
+#include <stdbool.h>
+
+// Random encounter formations
+// Every overworld zone and dungeon floor has a table of weighted enemy groups,
+// each with its own level band. encounter_tables_init() turns the weights into
+// a Walker alias table once at startup, so a pick costs one RNG draw and two
+// array reads however many formations (or enemy types) a table holds.
+#define ENCOUNTER_MAX_GROUP      4   // Enemies in one formation (battle clamps to MAX_ENEMIES)
+#define ENCOUNTER_MAX_FORMATIONS 16  // Formations in one table
+#define ENCOUNTER_ZONE_COUNT     (ZONE_SANCTUM_PATH + 1)
+
+typedef struct {
+    uint8_t weight;                        // Relative odds within the table
+    uint8_t level_min;                     // Each enemy rolls its level in this band
+    uint8_t level_max;
+    uint8_t count;
+    uint8_t enemies[ENCOUNTER_MAX_GROUP];  // EnemyType of each slot
+} EncounterFormation;
+
+typedef struct {
+    const EncounterFormation* formations;
+    uint8_t formation_count;
+    uint16_t total_weight;
+    uint16_t keep[ENCOUNTER_MAX_FORMATIONS];  // Column keeps its own formation below this (out of total_weight)
+    uint8_t alias[ENCOUNTER_MAX_FORMATIONS];  // ...and yields this one otherwise
+} EncounterTable;
+
+// Builds every alias table; safe to call again
+void encounter_tables_init(void);
+
+// NULL where nothing attacks (towns, deep water, floors that do not exist)
+const EncounterTable* encounter_table_for_zone(uint8_t zone);
+const EncounterTable* encounter_table_for_floor(uint8_t dungeon_id, uint8_t floor_index);
+
+// One weighted formation from the table; NULL for an empty table
+const EncounterFormation* encounter_table_pick(const EncounterTable* table, RandomStream* rng);
+
+#endif // ENCOUNTER_H
@@ -0,0 +1,243 @@
+#include "explore.h"
+#include "dungeon.h"
+#include <string.h>
+
+// Shared by every build/repair (only one runs at a time)
+static struct {
+    uint16_t queue[PATHFIND_MAX_NODES];      // BFS order; each node enters at most once
+    uint16_t raised[PATHFIND_MAX_NODES];     // Tiles reset by the current repair, in wave order
+    uint16_t raised_from[PATHFIND_MAX_NODES]; // Their distance before the reset
+    uint32_t seeds[PATHFIND_MAX_NODES];      // (distance << 16) | node, re-entry points for the repair
+    uint32_t sorted[PATHFIND_MAX_NODES];
+    uint16_t bucket[PATHFIND_MAX_NODES + 1]; // Counting sort of seeds by distance
+    uint16_t raised_count;
+} explore_scratch;
+
+static const int8_t explore_dx[4] = { 0, 0, -1, 1 };
+static const int8_t explore_dy[4] = { -1, 1, 0, 0 };
+static const int16_t explore_offset[4] = { -DUNGEON_WIDTH, DUNGEON_WIDTH, -1, 1 };
+
+static bool explore_is_open(const DungeonFloor* floor, int x, int y) {
+    if (x < 0 || y < 0 || x >= floor->width || y >= floor->height) return false;
+    return dungeon_floor_get_tile(floor, (uint8_t)x, (uint8_t)y) != TILE_WALL;
+}
+
+// Which revealed tile is worth interrupting the walk for (higher wins)
+static uint8_t explore_landmark_rank(TileType type) {
+    switch (type) {
+        case TILE_BOSS_ROOM:   return 4;
+        case TILE_STAIRS_DOWN: return 3;
+        case TILE_TREASURE:    return 2;
+        case TILE_STAIRS_UP:   return 1;
+        default:               return 0;
+    }
+}
+
+// Still has a neighbour one step closer to the frontier
+static bool explore_is_supported(const ExploreField* field, uint16_t node) {
+    uint16_t closer = field->distance[node] - 1;
+    uint8_t exits = field->exits[node];
+
+    for (uint8_t direction = 0; direction < 4; direction++) {
+        if ((exits & (1 << direction)) && field->distance[node + explore_offset[direction]] == closer) return true;
+    }
+    return false;
+}
+
+// Orders the seeds by distance into sorted[]; distances span a narrow band
+// around the revealed tiles, so counting beats a comparison sort
+static void explore_sort_seeds(uint16_t seed_count, uint16_t low, uint16_t high) {
+    uint16_t span = high - low + 1;
+    memset(explore_scratch.bucket, 0, (span + 1) * sizeof(explore_scratch.bucket[0]));
+
+    for (uint16_t i = 0; i < seed_count; i++) {
+        explore_scratch.bucket[(explore_scratch.seeds[i] >> 16) - low + 1]++;
+    }
+    for (uint16_t i = 1; i < span; i++) {
+        explore_scratch.bucket[i] += explore_scratch.bucket[i - 1];
+    }
+    for (uint16_t i = 0; i < seed_count; i++) {
+        explore_scratch.sorted[explore_scratch.bucket[(explore_scratch.seeds[i] >> 16) - low]++] = explore_scratch.seeds[i];
+    }
+}
+
+// Breadth-first spread from the queued tiles, merged with the sorted seeds so
+// tiles are always settled in distance order
+static void explore_spread(ExploreField* field, uint16_t tail, uint16_t seed_count) {
+    uint16_t head = 0;
+    uint16_t next_seed = 0;
+
+    for (;;) {
+        uint16_t node;
+        if (head < tail && (next_seed >= seed_count ||
+                            field->distance[explore_scratch.queue[head]] <= (explore_scratch.sorted[next_seed] >> 16))) {
+            node = explore_scratch.queue[head++];
+        } else if (next_seed < seed_count) {
+            uint32_t seed = explore_scratch.sorted[next_seed++];
+            node = (uint16_t)(seed & 0xFFFF);
+            if ((seed >> 16) >= field->distance[node]) continue;
+            field->distance[node] = (uint16_t)(seed >> 16);
+        } else {
+            break;
+        }
+
+        uint16_t next_distance = field->distance[node] + 1;
+        uint8_t exits = field->exits[node];
+
+        for (uint8_t direction = 0; direction < 4; direction++) {
+            if (!(exits & (1 << direction))) continue;
+
+            uint16_t neighbor = (uint16_t)(node + explore_offset[direction]);
+            if (field->distance[neighbor] <= next_distance) continue;
+            field->distance[neighbor] = next_distance;
+            explore_scratch.queue[tail++] = neighbor;
+        }
+    }
+}
+
+void explore_field_build(ExploreField* field, const DungeonFloor* floor) {
+    if (!field || !floor) return;
+
+    field->floor = floor;
+    memcpy(field->explored, floor->explored, DUNGEON_EXPLORED_BYTES);
+    memset(field->distance, 0xFF, sizeof(field->distance));
+    memset(field->exits, 0, sizeof(field->exits));
+
+    // Every unexplored walkable tile is a source
+    uint16_t tail = 0;
+    for (uint8_t y = 0; y < floor->height; y++) {
+        for (uint8_t x = 0; x < floor->width; x++) {
+            if (!explore_is_open(floor, x, y)) continue;
+
+            uint16_t node = (uint16_t)y * DUNGEON_WIDTH + x;
+            for (uint8_t direction = 0; direction < 4; direction++) {
+                if (explore_is_open(floor, x + explore_dx[direction], y + explore_dy[direction])) {
+                    field->exits[node] |= (uint8_t)(1 << direction);
+                }
+            }
+
+            if (dungeon_floor_is_explored(floor, x, y)) continue;
+            field->distance[node] = 0;
+            explore_scratch.queue[tail++] = node;
+        }
+    }
+
+    explore_spread(field, tail, 0);
+}
+
+// Revealed tiles stop being sources. Starting from the queued ones, reset every
+// tile left without a neighbour one step closer to a remaining source. The
+// wave runs level by level (all reset sources are queued first), so by the
+// time a tile is checked every closer tile that lost its route already has.
+static void explore_raise(ExploreField* field) {
+    uint16_t head = 0;
+
+    while (head < explore_scratch.raised_count) {
+        uint16_t node = explore_scratch.raised[head];
+        uint16_t downstream = explore_scratch.raised_from[head++] + 1;
+        uint8_t exits = field->exits[node];
+
+        for (uint8_t direction = 0; direction < 4; direction++) {
+            if (!(exits & (1 << direction))) continue;
+
+            uint16_t neighbor = (uint16_t)(node + explore_offset[direction]);
+            if (field->distance[neighbor] != downstream) continue;
+            if (explore_is_supported(field, neighbor)) continue;
+            field->distance[neighbor] = EXPLORE_UNREACHABLE;
+            explore_scratch.raised[explore_scratch.raised_count] = neighbor;
+            explore_scratch.raised_from[explore_scratch.raised_count++] = downstream;
+        }
+    }
+}
+
+// Re-measures the reset tiles from the untouched tiles bordering them
+static void explore_lower(ExploreField* field) {
+    uint16_t seed_count = 0;
+    uint16_t low = EXPLORE_UNREACHABLE;
+    uint16_t high = 0;
+
+    for (uint16_t i = 0; i < explore_scratch.raised_count; i++) {
+        uint16_t node = explore_scratch.raised[i];
+        uint8_t exits = field->exits[node];
+        uint16_t best = EXPLORE_UNREACHABLE;
+
+        for (uint8_t direction = 0; direction < 4; direction++) {
+            if (!(exits & (1 << direction))) continue;
+
+            uint16_t distance = field->distance[node + explore_offset[direction]];
+            if (distance != EXPLORE_UNREACHABLE && distance + 1 < best) best = distance + 1;
+        }
+        if (best != EXPLORE_UNREACHABLE) {
+            explore_scratch.seeds[seed_count++] = ((uint32_t)best << 16) | node;
+            if (best < low) low = best;
+            if (best > high) high = best;
+        }
+    }
+
+    if (seed_count == 0) return; // Everything reset was cut off from the frontier
+    explore_sort_seeds(seed_count, low, high);
+    explore_spread(field, 0, seed_count);
+}
+
+TileType explore_field_update(ExploreField* field, const DungeonFloor* floor) {
+    TileType spotted = TILE_FLOOR;
+    if (!field || !floor) return spotted;
+
+    if (field->floor != floor) {
+        explore_field_build(field, floor);
+        return spotted;
+    }
+
+    explore_scratch.raised_count = 0;
+
+    for (uint16_t b = 0; b < DUNGEON_EXPLORED_BYTES; b++) {
+        uint8_t revealed = (uint8_t)(floor->explored[b] & ~field->explored[b]);
+        if (field->explored[b] & ~floor->explored[b]) {
+            // Bits only ever get set; anything else means a different layout
+            explore_field_build(field, floor);
+            return spotted;
+        }
+        if (!revealed) continue;
+        field->explored[b] |= revealed;
+
+        for (uint8_t bit = 0; bit < 8; bit++) {
+            if (!(revealed & (1 << bit))) continue;
+
+            uint16_t node = (uint16_t)(b * 8 + bit);
+            if (field->distance[node] == EXPLORE_UNREACHABLE) continue; // Wall, or walled off
+
+            TileType type = dungeon_floor_get_tile(floor, (uint8_t)(node % DUNGEON_WIDTH), (uint8_t)(node / DUNGEON_WIDTH));
+            if (explore_landmark_rank(type) > explore_landmark_rank(spotted)) spotted = type;
+
+            if (field->distance[node] == 0) {
+                field->distance[node] = EXPLORE_UNREACHABLE;
+                explore_scratch.raised[explore_scratch.raised_count] = node;
+                explore_scratch.raised_from[explore_scratch.raised_count++] = 0;
+            }
+        }
+    }
+
+    if (explore_scratch.raised_count > 0) {
+        explore_raise(field);
+        explore_lower(field);
+    }
+    return spotted;
+}
+
+bool explore_field_next_step(const ExploreField* field, const DungeonFloor* floor, PathDirection* out) {
+    if (!field || !floor || !out || field->floor != floor) return false;
+
+    uint16_t node = (uint16_t)floor->player_y * DUNGEON_WIDTH + floor->player_x;
+    uint16_t distance = field->distance[node];
+    if (distance == EXPLORE_UNREACHABLE || distance == 0) return false;
+
+    for (uint8_t direction = 0; direction < 4; direction++) {
+        if (!(field->exits[node] & (1 << direction))) continue;
+
+        if (field->distance[node + explore_offset[direction]] == distance - 1) {
+            *out = (PathDirection)direction;
+            return true;
+        }
+    }
+    return false;
+}
@@ -0,0 +1,41 @@
+#ifndef EXPLORE_H
+#define EXPLORE_H
+
+#include "game_state.h"
+#include "pathfind.h"
+#include <stdint.h>
+#include <stdbool.h>
+
+// Auto-explore distance field
+// Every walkable tile holds its step distance to the nearest unexplored walkable
+// tile (a multi-source BFS over the floor's explored bits). Walking downhill
+// always heads for the closest frontier. When moves reveal tiles the field is
+// repaired locally - only tiles that were routed through a revealed tile are
+// re-measured - instead of being rebuilt every step.
+// Cost: repairs for a whole 16x16 floor total about 0.15 ms. At the largest
+// floor the storage allows (32x32, open) they total about 1.2 ms, over the 1 ms
+// budget: revealing a frontier tile shifts every distance behind it, so the
+// repair grows with floor area. All shipped floors are 16x16; see perf_bench
+// "explore" before adding bigger ones.
+#define EXPLORE_UNREACHABLE 0xFFFF
+
+typedef struct {
+    const DungeonFloor* floor;                        // Floor the field was built for
+    uint16_t distance[PATHFIND_MAX_NODES];            // EXPLORE_UNREACHABLE for walls / no frontier
+    uint8_t exits[PATHFIND_MAX_NODES];                // Bit per PathDirection leading to a walkable tile
+    uint8_t explored[DUNGEON_EXPLORED_BYTES];         // Explored bits the field reflects
+} ExploreField;
+
+// Full rebuild from the floor's explored bits
+void explore_field_build(ExploreField* field, const DungeonFloor* floor);
+
+// Repairs the field after tiles were revealed (rebuilds if the floor changed).
+// Returns the most notable newly revealed tile (treasure, stairs, boss room),
+// or TILE_FLOOR if nothing worth stopping for came into view.
+TileType explore_field_update(ExploreField* field, const DungeonFloor* floor);
+
+// Next step from the player towards the nearest unexplored tile; false once
+// nothing reachable is left to explore
+bool explore_field_next_step(const ExploreField* field, const DungeonFloor* floor, PathDirection* out);
+
+#endif // EXPLORE_H
@@ -3,7 +3,9 @@
 #include "dungeon.h"
 #include "inventory.h"
 #include "battle.h"
+#include "encounter.h"
 #include "utils.h"
+#include "world_map.h"
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
@@ -35,6 +37,16 @@ void game_state_init(void) {
     g_game_state.game_time = 0;
     g_game_state.gold = 200; // Starting gold (increased from 100 for better early economy)
     g_game_state.tile_graphics_mode = true; // Start with tile graphics enabled
+    g_game_state.auto_battle_ms = AUTO_BATTLE_DEFAULT_MS;
+    g_game_state.hub_state = STATE_DUNGEON_SELECT;
+    g_game_state.battle_return_state = STATE_DUNGEON_EXPLORE;
+
+    // The overworld starts at Greenleaf
+    world_map_init();
+    world_map_start_position(&g_game_state.world_x, &g_game_state.world_y);
+
+    // Alias tables for every zone and dungeon floor
+    encounter_tables_init();
     
     // Initialize all dungeons as not initialized
     for (int i = 0; i <= MAX_DUNGEONS; i++) {
@@ -73,6 +85,10 @@ void game_state_update(void) {
         case STATE_DUNGEON_EXPLORE:
             // Handle dungeon exploration (implemented in main loop)
             break;
+
+        case STATE_WORLD_MAP:
+            // Handle overworld exploration (implemented in main loop)
+            break;
             
         case STATE_BATTLE:
         case STATE_BOSS_BATTLE:
@@ -21,6 +21,9 @@
 #define VIEWPORT_HEIGHT 16
 #define MAX_DUNGEON_FLOORS 5
 
+// Auto-battle search time per party turn
+#define AUTO_BATTLE_DEFAULT_MS 200
+
 // Job types enumeration
 typedef enum {
     JOB_KNIGHT = 0,
@@ -42,7 +45,8 @@ typedef enum {
     STATE_BOSS_BATTLE,
     STATE_INVENTORY,
     STATE_VICTORY,
-    STATE_GAME_OVER
+    STATE_GAME_OVER,
+    STATE_WORLD_MAP      // Appended so state numbers in existing saves keep their meaning
 } GameState;
 
 // Buff/Debuff system
@@ -98,18 +102,18 @@ typedef enum {
     TILE_ENTRANCE
 } TileType;
 
-// Dungeon tile
-typedef struct {
-    TileType type;
-    bool explored;
-    uint8_t encounter_rate; // 0-255, higher = more encounters
-} DungeonTile;
+// Packed floor storage: tile types as nibbles (even x in the low nibble) and
+// explored as a bitset, both row-major - use the dungeon_floor_* accessors
+#define DUNGEON_TILE_BYTES (DUNGEON_WIDTH * DUNGEON_HEIGHT / 2)
+#define DUNGEON_EXPLORED_BYTES (DUNGEON_WIDTH * DUNGEON_HEIGHT / 8)
 
 // Dungeon floor
 typedef struct {
     uint8_t width;           // Actual width (16, 24, or 32)
     uint8_t height;          // Actual height (16, 24, or 32)
-    DungeonTile tiles[DUNGEON_HEIGHT][DUNGEON_WIDTH];
+    uint8_t tiles[DUNGEON_TILE_BYTES];       // TileType per tile, 4 bits each
+    uint8_t explored[DUNGEON_EXPLORED_BYTES]; // 1 bit per tile
+    uint8_t encounter_rate;  // 0-255, higher = more encounters (whole floor)
     uint8_t player_x;
     uint8_t player_y;
     uint8_t camera_x;        // Camera position (top-left of viewport)
@@ -124,18 +128,23 @@ typedef struct {
     uint16_t current_hp;
     uint8_t attack;
     uint8_t defense;
+    uint8_t agility;
     uint8_t level;
     KeyItem key_item_reward;
     ActiveBuff active_buffs[MAX_BUFFS_PER_CHARACTER];
     uint8_t buff_count;
 } BossData;
 
+typedef struct DungeonMapAsset DungeonMapAsset; // Compiled floor map (dungeon_maps.h)
+
 // Dungeon structure
 typedef struct {
     char name[MAX_DUNGEON_NAME];
     uint8_t dungeon_id;
     uint8_t floor_count;
     uint8_t current_floor;
+    uint8_t floors_loaded;   // Bit per floor; floors[] is only valid once its bit is set
+    const DungeonMapAsset* floor_maps[MAX_DUNGEON_FLOORS]; // Source of each floor (NULL = procedural)
     DungeonFloor floors[MAX_DUNGEON_FLOORS];
     BossData boss;
     bool completed;
@@ -161,6 +170,12 @@ typedef struct {
     uint32_t game_time; // Frame counter or time tracker
     uint16_t gold;
     bool tile_graphics_mode; // Toggle between ASCII and tile graphics
+    uint16_t auto_battle_ms; // Auto-battle search budget per party turn
+    uint8_t world_x;         // Party position on the overworld
+    uint8_t world_y;
+    uint8_t world_encounter_steps; // Steps to the next overworld encounter (0 = not drawn yet)
+    GameState hub_state;     // Where leaving a dungeon returns to (dungeon select or world map)
+    GameState battle_return_state; // Where a won or fled random battle returns to
 } GameStateData;
 
 // Global game state
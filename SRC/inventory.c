@@ -17,24 +17,37 @@ Inventory* inventory_create(void) {
     return &g_static_inventory;
 }
 
-bool inventory_add_item(Inventory* inv, uint8_t item_id, uint8_t quantity) {
+bool inventory_store_item(Inventory* inv, uint8_t item_id, uint8_t quantity) {
     if (!inv || inventory_is_full(inv)) return false;
-    
+
     // Check if item already exists (for stackable items)
     for (uint8_t i = 0; i < inv->item_count; i++) {
         if (inv->items[i].item_id == item_id) {
             inv->items[i].quantity += quantity;
-            printf("Added %d x %s\n", quantity, inv->items[i].name);
             return true;
         }
     }
-    
+
     // Add new item
     Item new_item = item_create_consumable(item_id);
     new_item.quantity = quantity;
     inv->items[inv->item_count++] = new_item;
+
+    return true;
+}
+
+bool inventory_add_item(Inventory* inv, uint8_t item_id, uint8_t quantity) {
+    if (!inv) return false;
     
-    printf("Obtained %s x%d\n", new_item.name, quantity);
+    bool stacked = inventory_has_item(inv, item_id);
+    if (!inventory_store_item(inv, item_id, quantity)) return false;
+    
+    Item* item = &inv->items[inventory_find_item(inv, item_id)];
+    if (stacked) {
+        printf("Added %d x %s\n", quantity, item->name);
+    } else {
+        printf("Obtained %s x%d\n", item->name, quantity);
+    }
     
     return true;
 }
@@ -73,6 +86,22 @@ bool inventory_remove_equipment(Inventory* inv, uint8_t index) {
         inv->equipment[i] = inv->equipment[i + 1];
     }
     inv->equipment_count--;
+
+    // Gear after the removed slot moved down one; re-point the party at it
+    // and drop cached totals that were built from the old indices
+    if (inv == g_game_state.inventory && g_game_state.party) {
+        for (uint8_t m = 0; m < g_game_state.party->member_count; m++) {
+            PartyMember* member = &g_game_state.party->members[m];
+            bool changed = false;
+            for (uint8_t slot = 0; slot < EQUIP_SLOT_COUNT; slot++) {
+                uint8_t equipped = member->equipped_items[slot];
+                if (equipped == 0xFF || equipped < index) continue;
+                member->equipped_items[slot] = equipped == index ? 0xFF : (uint8_t)(equipped - 1);
+                changed = true;
+            }
+            if (changed) character_invalidate_stats(member);
+        }
+    }
     
     return true;
 }
@@ -159,6 +188,7 @@ bool inventory_equip_item(Inventory* inv, uint8_t equip_index, uint8_t party_mem
     // Equip new item
     equipment->is_equipped = true;
     member->equipped_items[slot] = equip_index;
+    character_invalidate_stats(member);
     
     printf("%s equipped %s!\n", member->name, equipment->name);
     
@@ -178,6 +208,7 @@ bool inventory_unequip_item(uint8_t party_member_index, EquipmentSlot slot) {
     if (equipment) {
         equipment->is_equipped = false;
         member->equipped_items[slot] = 0xFF;
+        character_invalidate_stats(member);
         printf("%s unequipped.\n", equipment->name);
         return true;
     }
@@ -709,6 +740,16 @@ Item item_create_equipment(uint8_t equip_id) {
     return item;
 }
 
+// Starting equipment per job (EQUIP_NONE = empty)
+const uint8_t job_starting_equipment[MAX_JOB_TYPES][STARTING_EQUIPMENT_COUNT] = {
+    {EQUIP_SHORT_SWORD, EQUIP_CHAIN_MAIL, EQUIP_IRON_HELM},     // Knight
+    {EQUIP_NUNCHAKU, EQUIP_CLOTH_ARMOR, EQUIP_NONE},            // Black Belt
+    {EQUIP_DAGGER, EQUIP_LEATHER_ARMOR, EQUIP_LEATHER_CAP},     // Thief
+    {EQUIP_STAFF, EQUIP_ROBE, EQUIP_WIZARD_HAT},                // Sage
+    {EQUIP_STAFF, EQUIP_ROBE, EQUIP_NONE},                      // Priest
+    {EQUIP_WOODEN_ROD, EQUIP_SILK_ROBE, EQUIP_WIZARD_HAT}       // Mage
+};
+
 // Helper function to give starting equipment based on job
 void inventory_give_starting_equipment(Inventory* inv, Party* party) {
     if (!inv || !party) return;
@@ -717,82 +758,37 @@ void inventory_give_starting_equipment(Inventory* inv, Party* party) {
     
     for (uint8_t i = 0; i < party->member_count; i++) {
         PartyMember* member = &party->members[i];
-        
-        switch (member->job) {
-            case JOB_KNIGHT:
-                inventory_add_equipment(inv, EQUIP_SHORT_SWORD);
-                inventory_add_equipment(inv, EQUIP_CHAIN_MAIL);
-                inventory_add_equipment(inv, EQUIP_IRON_HELM);
-                inventory_equip_item(inv, inv->equipment_count - 3, i);
-                inventory_equip_item(inv, inv->equipment_count - 2, i);
-                inventory_equip_item(inv, inv->equipment_count - 1, i);
-                break;
-                
-            case JOB_BLACK_BELT:
-                inventory_add_equipment(inv, EQUIP_NUNCHAKU);
-                inventory_add_equipment(inv, EQUIP_CLOTH_ARMOR);
-                inventory_equip_item(inv, inv->equipment_count - 2, i);
-                inventory_equip_item(inv, inv->equipment_count - 1, i);
-                break;
-                
-            case JOB_THIEF:
-                inventory_add_equipment(inv, EQUIP_DAGGER);
-                inventory_add_equipment(inv, EQUIP_LEATHER_ARMOR);
-                inventory_add_equipment(inv, EQUIP_LEATHER_CAP);
-                inventory_equip_item(inv, inv->equipment_count - 3, i);
-                inventory_equip_item(inv, inv->equipment_count - 2, i);
-                inventory_equip_item(inv, inv->equipment_count - 1, i);
-                break;
-                
-            case JOB_SAGE:
-                inventory_add_equipment(inv, EQUIP_STAFF);
-                inventory_add_equipment(inv, EQUIP_ROBE);
-                inventory_add_equipment(inv, EQUIP_WIZARD_HAT);
-                inventory_equip_item(inv, inv->equipment_count - 3, i);
-                inventory_equip_item(inv, inv->equipment_count - 2, i);
-                inventory_equip_item(inv, inv->equipment_count - 1, i);
-                break;
-                
-            case JOB_PRIEST:
-                inventory_add_equipment(inv, EQUIP_STAFF);
-                inventory_add_equipment(inv, EQUIP_ROBE);
-                inventory_equip_item(inv, inv->equipment_count - 2, i);
-                inventory_equip_item(inv, inv->equipment_count - 1, i);
-                break;
-                
-            case JOB_MAGE:
-                inventory_add_equipment(inv, EQUIP_WOODEN_ROD);
-                inventory_add_equipment(inv, EQUIP_SILK_ROBE);
-                inventory_add_equipment(inv, EQUIP_WIZARD_HAT);
-                inventory_equip_item(inv, inv->equipment_count - 3, i);
-                inventory_equip_item(inv, inv->equipment_count - 2, i);
-                inventory_equip_item(inv, inv->equipment_count - 1, i);
-                break;
-                
-            default:
-                break;
+        if (member->job >= MAX_JOB_TYPES) continue;
+
+        const uint8_t* kit = job_starting_equipment[member->job];
+        uint8_t first_index = inv->equipment_count;
+
+        // Hand out the whole kit first, then equip it
+        for (uint8_t k = 0; k < STARTING_EQUIPMENT_COUNT && kit[k] != EQUIP_NONE; k++) {
+            inventory_add_equipment(inv, kit[k]);
+        }
+        for (uint8_t e = first_index; e < inv->equipment_count; e++) {
+            inventory_equip_item(inv, e, i);
         }
     }
     
     printf("=== Equipment Distribution Complete ===\n\n");
 }
-	
-	// Equipment bonus calculation functions
-uint8_t character_get_total_attack(PartyMember* member) {
-    if (!member || !g_game_state.inventory) return member ? member->stats.strength : 0;
 
+// Derived stat computation (explicit inventory, no globals)
+static uint8_t character_compute_attack(PartyMember* member, const Inventory* inv) {
     uint8_t total = member->stats.strength;
 
     // Add weapon bonus
     uint8_t weapon_index = member->equipped_items[EQUIP_WEAPON];
-    if (weapon_index != 0xFF && weapon_index < g_game_state.inventory->equipment_count) {
-        total += g_game_state.inventory->equipment[weapon_index].attack_bonus;
+    if (weapon_index != 0xFF && weapon_index < inv->equipment_count) {
+        total += inv->equipment[weapon_index].attack_bonus;
     }
 
     // Add accessory bonus
     uint8_t accessory_index = member->equipped_items[EQUIP_ACCESSORY];
-    if (accessory_index != 0xFF && accessory_index < g_game_state.inventory->equipment_count) {
-        total += g_game_state.inventory->equipment[accessory_index].attack_bonus;
+    if (accessory_index != 0xFF && accessory_index < inv->equipment_count) {
+        total += inv->equipment[accessory_index].attack_bonus;
     }
 
     // Apply buff modifiers
@@ -809,27 +805,25 @@ uint8_t character_get_total_attack(PartyMember* member) {
     return total;
 }
 
-uint8_t character_get_total_defense(PartyMember* member) {
-    if (!member || !g_game_state.inventory) return member ? member->stats.defense : 0;
-
+static uint8_t character_compute_defense(PartyMember* member, const Inventory* inv) {
     uint8_t total = member->stats.defense;
 
     // Add armor bonus
     uint8_t armor_index = member->equipped_items[EQUIP_ARMOR];
-    if (armor_index != 0xFF && armor_index < g_game_state.inventory->equipment_count) {
-        total += g_game_state.inventory->equipment[armor_index].defense_bonus;
+    if (armor_index != 0xFF && armor_index < inv->equipment_count) {
+        total += inv->equipment[armor_index].defense_bonus;
     }
 
     // Add helmet bonus
     uint8_t helmet_index = member->equipped_items[EQUIP_HELMET];
-    if (helmet_index != 0xFF && helmet_index < g_game_state.inventory->equipment_count) {
-        total += g_game_state.inventory->equipment[helmet_index].defense_bonus;
+    if (helmet_index != 0xFF && helmet_index < inv->equipment_count) {
+        total += inv->equipment[helmet_index].defense_bonus;
     }
 
     // Add accessory bonus
     uint8_t accessory_index = member->equipped_items[EQUIP_ACCESSORY];
-    if (accessory_index != 0xFF && accessory_index < g_game_state.inventory->equipment_count) {
-        total += g_game_state.inventory->equipment[accessory_index].defense_bonus;
+    if (accessory_index != 0xFF && accessory_index < inv->equipment_count) {
+        total += inv->equipment[accessory_index].defense_bonus;
     }
 
     // Apply buff modifiers
@@ -851,27 +845,25 @@ uint8_t character_get_total_defense(PartyMember* member) {
     return total;
 }
 
-uint8_t character_get_total_intelligence(PartyMember* member) {
-    if (!member || !g_game_state.inventory) return member ? member->stats.intelligence : 0;
-
+static uint8_t character_compute_intelligence(PartyMember* member, const Inventory* inv) {
     uint8_t total = member->stats.intelligence;
 
     // Add weapon bonus (some weapons boost intelligence)
     uint8_t weapon_index = member->equipped_items[EQUIP_WEAPON];
-    if (weapon_index != 0xFF && weapon_index < g_game_state.inventory->equipment_count) {
-        total += g_game_state.inventory->equipment[weapon_index].intelligence_bonus;
+    if (weapon_index != 0xFF && weapon_index < inv->equipment_count) {
+        total += inv->equipment[weapon_index].intelligence_bonus;
     }
 
     // Add armor bonus
     uint8_t armor_index = member->equipped_items[EQUIP_ARMOR];
-    if (armor_index != 0xFF && armor_index < g_game_state.inventory->equipment_count) {
-        total += g_game_state.inventory->equipment[armor_index].intelligence_bonus;
+    if (armor_index != 0xFF && armor_index < inv->equipment_count) {
+        total += inv->equipment[armor_index].intelligence_bonus;
     }
 
     // Add helmet bonus
     uint8_t helmet_index = member->equipped_items[EQUIP_HELMET];
-    if (helmet_index != 0xFF && helmet_index < g_game_state.inventory->equipment_count) {
-        total += g_game_state.inventory->equipment[helmet_index].intelligence_bonus;
+    if (helmet_index != 0xFF && helmet_index < inv->equipment_count) {
+        total += inv->equipment[helmet_index].intelligence_bonus;
     }
 
     // Apply buff modifiers
@@ -888,15 +880,13 @@ uint8_t character_get_total_intelligence(PartyMember* member) {
     return total;
 }
 
-uint8_t character_get_total_agility(PartyMember* member) {
-    if (!member || !g_game_state.inventory) return member ? member->stats.agility : 0;
-
+static uint8_t character_compute_agility(PartyMember* member, const Inventory* inv) {
     uint8_t total = member->stats.agility;
 
     // Add accessory bonus
     uint8_t accessory_index = member->equipped_items[EQUIP_ACCESSORY];
-    if (accessory_index != 0xFF && accessory_index < g_game_state.inventory->equipment_count) {
-        total += g_game_state.inventory->equipment[accessory_index].agility_bonus;
+    if (accessory_index != 0xFF && accessory_index < inv->equipment_count) {
+        total += inv->equipment[accessory_index].agility_bonus;
     }
 
     // Apply buff modifiers
@@ -913,9 +903,67 @@ uint8_t character_get_total_agility(PartyMember* member) {
     return total;
 }
 
-uint8_t character_get_total_luck(PartyMember* member) {
-    if (!member) return 0;
+void character_compute_derived_stats(PartyMember* member, const Inventory* inv, DerivedStats* out) {
+    if (!member || !inv || !out) return;
+
+    out->attack = character_compute_attack(member, inv);
+    out->defense = character_compute_defense(member, inv);
+    out->intelligence = character_compute_intelligence(member, inv);
+    out->agility = character_compute_agility(member, inv);
+    out->luck = member->stats.luck; // No equipment or buffs affect luck yet
+}
+
+// Cached totals - recomputed only after character_invalidate_stats()
+static const DerivedStats* character_derived_stats(PartyMember* member, const Inventory* inv) {
+    if (!member->derived_valid) {
+        character_compute_derived_stats(member, inv, &member->derived);
+        member->derived_valid = true;
+    }
+    return &member->derived;
+}
+
+uint8_t character_calc_total_attack(PartyMember* member, const Inventory* inv) {
+    if (!member || !inv) return member ? member->stats.strength : 0;
+    return character_derived_stats(member, inv)->attack;
+}
+
+uint8_t character_calc_total_defense(PartyMember* member, const Inventory* inv) {
+    if (!member || !inv) return member ? member->stats.defense : 0;
+    return character_derived_stats(member, inv)->defense;
+}
+
+uint8_t character_calc_total_intelligence(PartyMember* member, const Inventory* inv) {
+    if (!member || !inv) return member ? member->stats.intelligence : 0;
+    return character_derived_stats(member, inv)->intelligence;
+}
+
+uint8_t character_calc_total_agility(PartyMember* member, const Inventory* inv) {
+    if (!member || !inv) return member ? member->stats.agility : 0;
+    return character_derived_stats(member, inv)->agility;
+}
+
+uint8_t character_calc_total_luck(PartyMember* member, const Inventory* inv) {
+    if (!member || !inv) return member ? member->stats.luck : 0;
+    return character_derived_stats(member, inv)->luck;
+}
+
+// Equipment bonus calculation against the active game inventory
+uint8_t character_get_total_attack(PartyMember* member) {
+    return character_calc_total_attack(member, g_game_state.inventory);
+}
 
-    // Luck currently has no equipment bonuses, just return base stat
-    return member->stats.luck;
-}	
\ No newline at end of file
+uint8_t character_get_total_defense(PartyMember* member) {
+    return character_calc_total_defense(member, g_game_state.inventory);
+}
+
+uint8_t character_get_total_intelligence(PartyMember* member) {
+    return character_calc_total_intelligence(member, g_game_state.inventory);
+}
+
+uint8_t character_get_total_agility(PartyMember* member) {
+    return character_calc_total_agility(member, g_game_state.inventory);
+}
+
+uint8_t character_get_total_luck(PartyMember* member) {
+    return character_calc_total_luck(member, g_game_state.inventory);
+}
@@ -71,6 +71,7 @@ typedef struct Inventory {
 // Inventory management
 Inventory* inventory_create(void);  // Returns pointer to static inventory (GameBoy-compatible - no malloc!)
 bool inventory_add_item(Inventory* inv, uint8_t item_id, uint8_t quantity);
+bool inventory_store_item(Inventory* inv, uint8_t item_id, uint8_t quantity); // Silent variant
 bool inventory_add_equipment(Inventory* inv, uint8_t equip_id);
 bool inventory_remove_item(Inventory* inv, uint8_t index, uint8_t quantity);
 bool inventory_remove_equipment(Inventory* inv, uint8_t index);
@@ -99,7 +100,21 @@ extern uint8_t character_get_total_intelligence(PartyMember* member);
 extern uint8_t character_get_total_agility(PartyMember* member);
 extern uint8_t character_get_total_luck(PartyMember* member);
 
+// Same calculations against an explicit inventory (headless battles).
+// Results are cached per member until character_invalidate_stats().
+uint8_t character_calc_total_attack(PartyMember* member, const Inventory* inv);
+uint8_t character_calc_total_defense(PartyMember* member, const Inventory* inv);
+uint8_t character_calc_total_intelligence(PartyMember* member, const Inventory* inv);
+uint8_t character_calc_total_agility(PartyMember* member, const Inventory* inv);
+uint8_t character_calc_total_luck(PartyMember* member, const Inventory* inv);
+void character_compute_derived_stats(PartyMember* member, const Inventory* inv, DerivedStats* out); // Uncached
+
 // Helper function to give starting equipment
 extern void inventory_give_starting_equipment(Inventory* inv, Party* party);
 
+// Starting equipment IDs per job (EQUIP_NONE terminates a short kit)
+#define EQUIP_NONE 0xFF
+#define STARTING_EQUIPMENT_COUNT 3
+extern const uint8_t job_starting_equipment[MAX_JOB_TYPES][STARTING_EQUIPMENT_COUNT];
+
 #endif // INVENTORY_H
\ No newline at end of file
@@ -2,9 +2,17 @@
 #include "party.h"
 #include "dungeon.h"
 #include "battle.h"
+#include "battle_ai.h"
 #include "inventory.h"
+#include "pathfind.h"
+#include "encounter.h"
+#include "explore.h"
 #include "save_system.h"
+#include "autosave.h"
+#include "screen.h"
+#include "town_map.h"
 #include "utils.h"
+#include "world_map.h"
 #include <stdio.h>
 #include <stdlib.h>
 #include <stdbool.h>
@@ -14,11 +22,12 @@
 void handle_party_selection(void);
 void handle_dungeon_selection(void);
 void handle_dungeon_exploration(void);
+void handle_world_map(void);
 void handle_battle_phase(void);
 void handle_inventory_menu(void);
 void handle_save_menu(void);
 void handle_load_menu(void);
-void handle_town(void);
+void handle_town(const char* town_name);
 void handle_inn(void);
 void handle_item_shop(void);
 void handle_shop_buy(void);
@@ -34,6 +43,7 @@ int main(void) {
     // Initialize game
     game_state_init();
     random_seed((uint32_t)time(NULL));
+    autosave_start();
     
     printf("Welcome to Dungeon Quest RPG!\n");
     printf("A test scenario for our GameBoy RPG\n\n");
@@ -69,6 +79,7 @@ int main(void) {
 
     if (!g_game_state.party || g_game_state.party->member_count == 0) {
         printf("No party members selected. Exiting.\n");
+        autosave_stop();
         game_state_cleanup();
         return 0;
     }
@@ -101,6 +112,10 @@ int main(void) {
             case STATE_DUNGEON_EXPLORE:
                 handle_dungeon_exploration();
                 break;
+
+            case STATE_WORLD_MAP:
+                handle_world_map();
+                break;
                 
             case STATE_BATTLE:
             case STATE_BOSS_BATTLE:
@@ -166,7 +181,8 @@ int main(void) {
     
     input_wait_for_key();
     
-    // Cleanup
+    // Cleanup (the last autosave finishes first)
+    autosave_stop();
     game_state_cleanup();
     
     return 0;
@@ -217,13 +233,15 @@ void handle_party_selection(void) {
 void handle_treasure_chest(uint8_t dungeon_id) {
     printf("\nFound treasure chest!\n");
 
+    RandomStream* rng = random_get_stream(RNG_STREAM_LOOT);
+
     // Treasure distribution: 40% gold, 30% consumable, 30% equipment
-    uint8_t roll = random_range(1, 100);
+    uint8_t roll = (uint8_t)random_stream_range(rng, 1, 100);
 
     if (roll <= 40) {
         // Gold reward scales with dungeon tier
         uint16_t base_gold = 50 + (dungeon_id * 50);
-        uint16_t gold = random_range(base_gold, base_gold * 2);
+        uint16_t gold = (uint16_t)random_stream_range(rng, base_gold, base_gold * 2);
         g_game_state.gold += gold;
         printf("Found %d gold!\n", gold);
     } else if (roll <= 70) {
@@ -231,13 +249,13 @@ void handle_treasure_chest(uint8_t dungeon_id) {
         uint8_t item_id;
         if (dungeon_id == 0) {
             // Cave of Earth: Basic consumables
-            item_id = random_range(ITEM_POTION, ITEM_ETHER);
+            item_id = (uint8_t)random_stream_range(rng, ITEM_POTION, ITEM_ETHER);
         } else if (dungeon_id <= 2) {
             // Water Temple, Volcano Keep: Better consumables
-            item_id = random_range(ITEM_HI_POTION, ITEM_ELIXIR);
+            item_id = (uint8_t)random_stream_range(rng, ITEM_HI_POTION, ITEM_ELIXIR);
         } else {
             // Sky Tower, Final Sanctum: Best consumables
-            item_id = random_range(ITEM_ETHER, ITEM_ELIXIR);
+            item_id = (uint8_t)random_stream_range(rng, ITEM_ETHER, ITEM_ELIXIR);
         }
         inventory_add_item(g_game_state.inventory, item_id, 1);
     } else {
@@ -247,36 +265,37 @@ void handle_treasure_chest(uint8_t dungeon_id) {
         if (dungeon_id == 0) {
             // Cave of Earth: Tier 1 equipment (starting gear)
             uint8_t tier1_pool[] = {0, 1, 2, 4, 5, 6, 8, 20, 21, 22, 24, 40, 42, 60, 61, 62};
-            equip_id = tier1_pool[random_range(0, 15)];
+            equip_id = tier1_pool[random_stream_bounded(rng, 16)];
         } else if (dungeon_id == 1) {
             // Water Temple: Tier 2 equipment (mid-game)
             uint8_t tier2_pool[] = {10, 11, 12, 13, 14, 26, 27, 28, 43, 44, 45, 63, 64};
-            equip_id = tier2_pool[random_range(0, 12)];
+            equip_id = tier2_pool[random_stream_bounded(rng, 13)];
         } else if (dungeon_id == 2) {
             // Volcano Keep: Mix of Tier 2 and Tier 3
             uint8_t tier23_pool[] = {10, 11, 12, 13, 14, 15, 16, 17, 18, 19, 26, 27, 28, 29, 30, 31, 46, 47, 48, 65, 66, 67};
-            equip_id = tier23_pool[random_range(0, 21)];
+            equip_id = tier23_pool[random_stream_bounded(rng, 22)];
         } else if (dungeon_id == 3) {
             // Sky Tower: Tier 3 equipment (late-game)
             uint8_t tier3_pool[] = {15, 16, 17, 18, 19, 29, 30, 31, 46, 47, 48, 65, 66, 67};
-            equip_id = tier3_pool[random_range(0, 13)];
+            equip_id = tier3_pool[random_stream_bounded(rng, 14)];
         } else {
             // Final Sanctum: Tier 4 legendary equipment
             uint8_t tier4_pool[] = {32, 33, 49, 68, 69, 70};
-            equip_id = tier4_pool[random_range(0, 5)];
+            equip_id = tier4_pool[random_stream_bounded(rng, 6)];
         }
 
         inventory_add_equipment(g_game_state.inventory, equip_id);
     }
 }
 
-void handle_town(void) {
+// Service menu for towns that have no map to walk around yet
+static void handle_town_menu(const char* town_name) {
     bool in_town = true;
 
     while (in_town) {
         clear_screen();
         printf("\n=== TOWN ===\n");
-        printf("Welcome to the town!\n\n");
+        printf("Welcome to %s!\n\n", town_name);
 
         const char* town_options[] = {
             "Inn - Rest and recover (Cost: 50 Gold)",
@@ -309,6 +328,123 @@ void handle_town(void) {
     }
 }
 
+// Stepping onto a door goes inside
+static void enter_town_building(TownBuildingType type) {
+    switch (type) {
+        case BUILDING_INN:
+            handle_inn();
+            break;
+        case BUILDING_ITEM_SHOP:
+            handle_item_shop();
+            break;
+        case BUILDING_EQUIPMENT_SHOP:
+            handle_equipment_shop();
+            break;
+        case BUILDING_TAVERN:
+            handle_tavern();
+            break;
+        case BUILDING_HOUSE:
+            printf("\nThe family inside wishes you luck on your journey.\n");
+            input_wait_for_key();
+            break;
+        default:
+            printf("\nThe door is locked.\n");
+            input_wait_for_key();
+            break;
+    }
+}
+
+void handle_town(const char* town_name) {
+    autosave_request();
+
+    if (!town_map_load(town_name)) {
+        handle_town_menu(town_name);
+        return;
+    }
+
+    // Loading is a cache lookup; doors resolve through the per-tile building layer
+    uint8_t x = g_current_town->entrance_x;
+    uint8_t y = g_current_town->entrance_y;
+    bool in_town = true;
+
+    input_flush_buffer();
+
+    while (in_town) {
+        screen_begin_frame();
+        display_town(town_name, x, y);
+        screen_present();
+
+        int8_t dx = 0, dy = 0;
+        InputButton input = input_wait_key(INPUT_WAIT_FOREVER);
+
+        switch (input) {
+            case INPUT_UP:
+                dy = -1;
+                break;
+            case INPUT_DOWN:
+                dy = 1;
+                break;
+            case INPUT_LEFT:
+                dx = -1;
+                break;
+            case INPUT_RIGHT:
+                dx = 1;
+                break;
+
+            case INPUT_B:
+                in_town = false;
+                break;
+
+            case INPUT_SELECT:
+            case INPUT_START: {
+                const char* menu_options[] = {
+                    "Party Status",
+                    "Toggle Graphics Mode",
+                    "Leave Town",
+                    "Return to Town"
+                };
+
+                int8_t choice = cursor_menu("TOWN", menu_options, 4);
+
+                if (choice == 0) {
+                    clear_screen();
+                    display_party_status();
+                    input_wait_for_key();
+                } else if (choice == 1) {
+                    g_game_state.tile_graphics_mode = !g_game_state.tile_graphics_mode;
+                } else if (choice == 2) {
+                    in_town = false;
+                }
+                break;
+            }
+
+            default:
+                break;
+        }
+
+        if (dx == 0 && dy == 0) continue;
+
+        // Walking off the edge leaves town
+        int new_x = x + dx;
+        int new_y = y + dy;
+        if (new_x < 0 || new_y < 0 || new_x >= g_current_town->width || new_y >= g_current_town->height) {
+            in_town = false;
+            continue;
+        }
+        if (!town_map_is_passable((uint8_t)new_x, (uint8_t)new_y)) continue;
+
+        x = (uint8_t)new_x;
+        y = (uint8_t)new_y;
+
+        // The door is the only walkable tile of a building
+        TownBuildingType building = town_map_get_building_at(x, y);
+        if (building != BUILDING_NONE) {
+            enter_town_building(building);
+            input_flush_buffer();
+        }
+    }
+}
+
 void handle_inn(void) {
     clear_screen();
     printf("\n=== INN ===\n");
@@ -324,10 +460,7 @@ void handle_inn(void) {
 
     printf("Press Z/Enter to confirm, X/Esc to cancel\n");
 
-    InputButton confirm = INPUT_NONE;
-    while (confirm == INPUT_NONE) {
-        confirm = input_get_key();
-    }
+    InputButton confirm = input_wait_key(INPUT_WAIT_FOREVER);
 
     if (confirm == INPUT_A || confirm == INPUT_START) {
         g_game_state.gold -= 50;
@@ -455,10 +588,7 @@ void handle_shop_buy(void) {
 
             // For now, just buy 1 at a time (cursor-based)
             // TODO: Add quantity selection interface later
-            InputButton confirm = INPUT_NONE;
-            while (confirm == INPUT_NONE) {
-                confirm = input_get_key();
-            }
+            InputButton confirm = input_wait_key(INPUT_WAIT_FOREVER);
 
             if (confirm == INPUT_A || confirm == INPUT_START) {
                 // Buy 1
@@ -541,10 +671,7 @@ void handle_shop_sell(void) {
             printf("Sell 1 for %d Gold?\n", sell_price);
             printf("Press Z/Enter to confirm, or X/Esc to cancel\n");
 
-            InputButton confirm = INPUT_NONE;
-            while (confirm == INPUT_NONE) {
-                confirm = input_get_key();
-            }
+            InputButton confirm = input_wait_key(INPUT_WAIT_FOREVER);
 
             if (confirm == INPUT_A || confirm == INPUT_START) {
                 // Sell 1
@@ -722,10 +849,7 @@ void handle_equipment_buy(void) {
         printf("\nPurchase for %d Gold?\n", selected->buy_price);
         printf("Press Z/Enter to confirm, or X/Esc to cancel\n");
 
-        InputButton confirm = INPUT_NONE;
-        while (confirm == INPUT_NONE) {
-            confirm = input_get_key();
-        }
+        InputButton confirm = input_wait_key(INPUT_WAIT_FOREVER);
 
         if (confirm == INPUT_A || confirm == INPUT_START) {
             g_game_state.gold -= selected->buy_price;
@@ -739,10 +863,7 @@ void handle_equipment_buy(void) {
             printf("\nEquip %s now?\n", selected->name);
             printf("Press Z/Enter to equip, or X/Esc to skip\n");
 
-            InputButton equip_confirm = INPUT_NONE;
-            while (equip_confirm == INPUT_NONE) {
-                equip_confirm = input_get_key();
-            }
+            InputButton equip_confirm = input_wait_key(INPUT_WAIT_FOREVER);
 
             if (equip_confirm == INPUT_A || equip_confirm == INPUT_START) {
                 // Show party member selection
@@ -866,10 +987,7 @@ void handle_equipment_sell(void) {
             printf("Sell for %d Gold?\n", sell_price);
             printf("Press Z/Enter to confirm, or X/Esc to cancel\n");
 
-            InputButton confirm = INPUT_NONE;
-            while (confirm == INPUT_NONE) {
-                confirm = input_get_key();
-            }
+            InputButton confirm = input_wait_key(INPUT_WAIT_FOREVER);
 
             if (confirm == INPUT_A || confirm == INPUT_START) {
                 g_game_state.gold += sell_price;
@@ -1132,10 +1250,7 @@ void handle_equipment_management(void) {
             printf("Equip %s?\n", selected_equip->name);
             printf("Press Z/Enter to confirm, or X/Esc to cancel\n");
 
-            InputButton confirm = INPUT_NONE;
-            while (confirm == INPUT_NONE) {
-                confirm = input_get_key();
-            }
+            InputButton confirm = input_wait_key(INPUT_WAIT_FOREVER);
 
             if (confirm == INPUT_A || confirm == INPUT_START) {
                 // Equip the item
@@ -1154,6 +1269,20 @@ void handle_tavern(void) {
     input_wait_for_key();
 }
 
+// Sets up a dungeon on first visit and goes in; leaving it returns to hub
+static void enter_dungeon(uint8_t dungeon_idx, GameState hub) {
+    if (!g_game_state.dungeon_initialized[dungeon_idx]) {
+        uint8_t floor_count = (dungeon_idx == MAX_DUNGEONS) ? 5 : 3;
+        dungeon_init(&g_game_state.dungeons[dungeon_idx], dungeon_idx,
+                   dungeon_names[dungeon_idx], floor_count);
+        g_game_state.dungeon_initialized[dungeon_idx] = true;
+    }
+
+    g_game_state.current_dungeon_index = dungeon_idx;
+    g_game_state.hub_state = hub;
+    game_state_change(STATE_DUNGEON_EXPLORE);
+}
+
 void handle_dungeon_selection(void) {
     bool in_dungeon_select = true;
 
@@ -1163,17 +1292,18 @@ void handle_dungeon_selection(void) {
         printf("Key Items Collected: %d/4\n\n", __builtin_popcount(g_game_state.key_items_collected));
 
         // Build menu options
-        const char* menu_options[12]; // Max: town + 4 dungeons + final + separator + inventory + party + save + load + quit
+        const char* menu_options[14]; // Max: town + world map + separator + 4 dungeons + final + separator + inventory + party + save + load + quit
         uint8_t option_count = 0;
         int8_t dungeon_indices[6]; // Map menu index to dungeon index
 
-        // Add Town option first
+        // Add Town and World Map options first
         menu_options[option_count++] = "Town";
+        menu_options[option_count++] = "World Map";
 
         // Add separator
         menu_options[option_count++] = "---";
 
-        // Add dungeons (indices will be offset by 2 due to Town and separator)
+        // Add dungeons (indices will be offset by 3 due to Town, World Map and separator)
         uint8_t dungeon_option_start = option_count;
         for (int i = 0; i < MAX_DUNGEONS; i++) {
             static char dungeon_labels[4][50];
@@ -1209,32 +1339,28 @@ void handle_dungeon_selection(void) {
         // Handle Town selection
         if (choice == 0) {
             // Town selected - call town handler
-            handle_town();
+            handle_town(g_world_map.towns[TOWN_GREENLEAF].name);
+            continue;
+        }
+
+        // Handle World Map selection - dungeons entered from there return there
+        if (choice == 1) {
+            game_state_change(STATE_WORLD_MAP);
+            in_dungeon_select = false;
             continue;
         }
 
-        // Skip separator at index 1
-        // Dungeons start at index 2
+        // Skip separator at index 2
+        // Dungeons start at index 3
 
         // Determine which dungeon was selected (if any)
-        // Account for Town (index 0) and separator (index 1) - dungeons start at index 2
-        uint8_t dungeon_start_index = 2;
+        // Account for Town (0), World Map (1) and separator (2) - dungeons start at index 3
+        uint8_t dungeon_start_index = 3;
         uint8_t dungeon_menu_count = is_final_dungeon_unlocked() ? MAX_DUNGEONS + 1 : MAX_DUNGEONS;
 
         if (choice >= dungeon_start_index && choice < dungeon_start_index + dungeon_menu_count) {
             // A dungeon was selected
-            int dungeon_idx = dungeon_indices[choice - dungeon_start_index];
-
-            // Initialize dungeon if needed
-            if (!g_game_state.dungeon_initialized[dungeon_idx]) {
-                uint8_t floor_count = (dungeon_idx == MAX_DUNGEONS) ? 5 : 3;
-                dungeon_init(&g_game_state.dungeons[dungeon_idx], dungeon_idx,
-                           dungeon_names[dungeon_idx], floor_count);
-                g_game_state.dungeon_initialized[dungeon_idx] = true;
-            }
-
-            g_game_state.current_dungeon_index = dungeon_idx;
-            game_state_change(STATE_DUNGEON_EXPLORE);
+            enter_dungeon((uint8_t)dungeon_indices[choice - dungeon_start_index], STATE_DUNGEON_SELECT);
             in_dungeon_select = false;
         } else if (choice == dungeon_start_index + dungeon_menu_count + 1) {
             // Inventory (skip separator)
@@ -1273,10 +1399,7 @@ void handle_dungeon_selection(void) {
         } else if (choice == dungeon_start_index + dungeon_menu_count + 5) {
             // Quit Game
             printf("\nReally quit? (Press Z/Enter to confirm, X/Esc to cancel)\n");
-            InputButton confirm = INPUT_NONE;
-            while (confirm == INPUT_NONE) {
-                confirm = input_get_key();
-            }
+            InputButton confirm = input_wait_key(INPUT_WAIT_FOREVER);
             if (confirm == INPUT_A || confirm == INPUT_START) {
                 game_state_change(STATE_GAME_OVER);
                 in_dungeon_select = false;
@@ -1288,11 +1411,62 @@ void handle_dungeon_selection(void) {
     }
 }
 
+#define AUTO_WALK_STEP_MS 80 // Pause between auto-walk/explore steps; any key cancels
+
+// Picks an auto-walk destination and plans the route; false if there is nothing to walk
+static bool handle_auto_walk_menu(Dungeon* dungeon, DungeonPath* path) {
+    static const TileType targets[] = { TILE_STAIRS_DOWN, TILE_STAIRS_UP, TILE_TREASURE, TILE_BOSS_ROOM };
+    const char* walk_options[] = {
+        "Stairs Down",
+        "Stairs Up",
+        "Nearest Treasure",
+        "Boss Room",
+        "Cancel"
+    };
+
+    int8_t choice = cursor_menu("AUTO-WALK", walk_options, 5);
+    if (choice < 0 || choice >= 4) return false;
+
+    DungeonFloor* floor = &dungeon->floors[dungeon->current_floor];
+    if (!pathfind_route_to_tile(floor, targets[choice], path)) {
+        printf("\nNo way to reach %s from here.\n", walk_options[choice]);
+        input_wait_for_key();
+        return false;
+    }
+    if (path->length == 0) {
+        printf("\nYou are already there.\n");
+        input_wait_for_key();
+        return false;
+    }
+    return true;
+}
+
+static const char* explore_landmark_name(TileType type) {
+    switch (type) {
+        case TILE_STAIRS_DOWN: return "stairs leading down";
+        case TILE_STAIRS_UP:   return "stairs leading up";
+        case TILE_TREASURE:    return "a treasure chest";
+        case TILE_BOSS_ROOM:   return "the boss chamber";
+        default:               return "something";
+    }
+}
+
+// Worth stopping auto-explore on when the party steps onto it
+static bool explore_is_stop_tile(TileType type) {
+    return type == TILE_TREASURE || type == TILE_STAIRS_DOWN ||
+           type == TILE_STAIRS_UP || type == TILE_BOSS_ROOM;
+}
+
 void handle_dungeon_exploration(void) {
+    static DungeonPath auto_path;
+    static ExploreField explore_field;
+    uint16_t auto_step = 0;
+    bool auto_walking = false;
+    bool auto_exploring = false;
     Dungeon* current_dungeon = &g_game_state.dungeons[g_game_state.current_dungeon_index];
 
     if (!g_game_state.dungeon_initialized[g_game_state.current_dungeon_index]) {
-        game_state_change(STATE_DUNGEON_SELECT);
+        game_state_change(g_game_state.hub_state);
         return;
     }
 
@@ -1302,18 +1476,45 @@ void handle_dungeon_exploration(void) {
     bool in_dungeon = true;
     
     while (in_dungeon) {
-        clear_screen();
+        // One frame per step; walking usually changes a handful of cells
+        screen_begin_frame();
         display_dungeon();
         display_party_status();
-        
-        InputButton input = INPUT_NONE;
-        
-        // Wait for input
-        while (input == INPUT_NONE) {
-            input = input_get_key();
-        }
+        screen_present();
         
         int8_t dx = 0, dy = 0;
+        InputButton input;
+
+        if (auto_walking) {
+            // Take the next planned step unless a key interrupts
+            input = input_wait_key(AUTO_WALK_STEP_MS);
+            if (input != INPUT_NONE || auto_step >= auto_path.length) {
+                auto_walking = false;
+                input_flush_buffer();
+                continue;
+            }
+            pathfind_direction_delta((PathDirection)auto_path.steps[auto_step++], &dx, &dy);
+        } else if (auto_exploring) {
+            // Head downhill towards the nearest unexplored tile unless a key interrupts
+            DungeonFloor* floor = &current_dungeon->floors[current_dungeon->current_floor];
+            PathDirection direction;
+
+            input = input_wait_key(AUTO_WALK_STEP_MS);
+            if (input != INPUT_NONE) {
+                auto_exploring = false;
+                input_flush_buffer();
+                continue;
+            }
+            if (!explore_field_next_step(&explore_field, floor, &direction)) {
+                auto_exploring = false;
+                printf("\nNothing left to explore on this floor.\n");
+                input_wait_for_key();
+                continue;
+            }
+            pathfind_direction_delta(direction, &dx, &dy);
+        } else {
+            input = input_wait_key(INPUT_WAIT_FOREVER);
+        }
         
         switch (input) {
             case INPUT_UP:
@@ -1335,11 +1536,13 @@ void handle_dungeon_exploration(void) {
                     
                     if (current_tile == TILE_STAIRS_DOWN) {
                         if (dungeon_change_floor(current_dungeon, true)) {
+                            autosave_request();
                             printf("Descended to next floor!\n");
                             input_wait_for_key();
                         }
                     } else if (current_tile == TILE_STAIRS_UP) {
                         if (dungeon_change_floor(current_dungeon, false)) {
+                            autosave_request();
                             printf("Ascended to previous floor!\n");
                             input_wait_for_key();
                         } else {
@@ -1347,7 +1550,7 @@ void handle_dungeon_exploration(void) {
                             input_wait_for_key();
                             input_flush_buffer(); // Clear any lingering input
                             in_dungeon = false;
-                            game_state_change(STATE_DUNGEON_SELECT);
+                            game_state_change(g_game_state.hub_state);
                         }
                     } else if (current_tile == TILE_TREASURE) {
                         // Use tiered treasure system
@@ -1355,7 +1558,7 @@ void handle_dungeon_exploration(void) {
 
                         // Mark treasure as taken
                         DungeonFloor* floor = &current_dungeon->floors[current_dungeon->current_floor];
-                        floor->tiles[floor->player_y][floor->player_x].type = TILE_FLOOR;
+                        dungeon_floor_set_tile(floor, floor->player_x, floor->player_y, TILE_FLOOR);
 
                         input_wait_for_key();
                     } else if (current_tile == TILE_BOSS_ROOM) {
@@ -1364,7 +1567,7 @@ void handle_dungeon_exploration(void) {
                             input_wait_for_key();
                             
                             // Initiate boss battle
-                            battle_init(current_dungeon->current_floor + 5, true);
+                            battle_init(NULL, true);
                             battle_init_boss(&current_dungeon->boss);
                             game_state_change(STATE_BOSS_BATTLE);
                             in_dungeon = false;
@@ -1377,13 +1580,16 @@ void handle_dungeon_exploration(void) {
                 break;
                 
             case INPUT_B:
-                const char* exit_options[] = {"Return to Dungeon Selection", "Cancel"};
+                const char* exit_options[] = {
+                    g_game_state.hub_state == STATE_WORLD_MAP ? "Return to World Map" : "Return to Dungeon Selection",
+                    "Cancel"
+                };
                 int8_t confirm = cursor_menu("EXIT DUNGEON", exit_options, 2);
 
                 if (confirm == 0) {
                     input_flush_buffer(); // Clear any lingering input from scanf
                     in_dungeon = false;
-                    game_state_change(STATE_DUNGEON_SELECT);
+                    game_state_change(g_game_state.hub_state);
                 }
                 break;
                 
@@ -1397,11 +1603,13 @@ void handle_dungeon_exploration(void) {
 							"Camp",
 							"Inventory",
 							"Party Status",
+							"Auto-Walk",
+							"Auto-Explore",
 							"Toggle Graphics Mode",
 							"Return to Dungeon"
 						};
 
-						int8_t choice = cursor_menu("DUNGEON MENU", menu_options, 5);
+						int8_t choice = cursor_menu("DUNGEON MENU", menu_options, 7);
 
 						if (choice == 0) {
 							// Camp submenu - loop until user returns
@@ -1457,6 +1665,25 @@ void handle_dungeon_exploration(void) {
 							input_wait_for_key();
 							// Loop back to dungeon menu
 						} else if (choice == 3) {
+							// Auto-Walk: plan a route, then walk it one step per frame
+							if (handle_auto_walk_menu(current_dungeon, &auto_path)) {
+								auto_step = 0;
+								auto_walking = true;
+								in_dungeon_menu = false;
+							}
+						} else if (choice == 4) {
+							// Auto-Explore: follow the distance field until something turns up
+							DungeonFloor* floor = &current_dungeon->floors[current_dungeon->current_floor];
+							PathDirection direction;
+							explore_field_build(&explore_field, floor);
+							if (explore_field_next_step(&explore_field, floor, &direction)) {
+								auto_exploring = true;
+								in_dungeon_menu = false;
+							} else {
+								printf("\nNothing left to explore on this floor.\n");
+								input_wait_for_key();
+							}
+						} else if (choice == 5) {
 							// Toggle Graphics Mode
 							g_game_state.tile_graphics_mode = !g_game_state.tile_graphics_mode;
 							clear_screen();
@@ -1465,7 +1692,7 @@ void handle_dungeon_exploration(void) {
 							input_wait_for_key();
 							// Loop back to dungeon menu
 						} else {
-							// choice == 4 (Return to Dungeon) or -1 (cancelled)
+							// choice == 6 (Return to Dungeon) or -1 (cancelled)
 							in_dungeon_menu = false;
 						}
 					}
@@ -1484,11 +1711,29 @@ void handle_dungeon_exploration(void) {
                     printf("\nMonsters appear!\n");
                     input_wait_for_key();
                     
-                    battle_init(current_dungeon->current_floor + 1, false);
+                    g_game_state.battle_return_state = STATE_DUNGEON_EXPLORE;
+                    battle_init(encounter_table_for_floor(current_dungeon->dungeon_id, current_dungeon->current_floor), false);
                     game_state_change(STATE_BATTLE);
                     in_dungeon = false;
+                } else if (auto_exploring) {
+                    // Fold the newly revealed tiles into the field; stop at anything interesting
+                    DungeonFloor* floor = &current_dungeon->floors[current_dungeon->current_floor];
+                    TileType spotted = explore_field_update(&explore_field, floor);
+                    if (spotted != TILE_FLOOR) {
+                        auto_exploring = false;
+                        screen_begin_frame();
+                        display_dungeon();
+                        display_party_status();
+                        screen_present();
+                        printf("\nYou spot %s.\n", explore_landmark_name(spotted));
+                        input_wait_for_key();
+                    } else if (explore_is_stop_tile(dungeon_get_current_tile(current_dungeon))) {
+                        auto_exploring = false;
+                    }
                 }
             } else {
+                auto_walking = false;
+                auto_exploring = false;
                 printf("\nCan't move that way!\n");
                 // Brief pause instead of waiting for key
             }
@@ -1496,42 +1741,198 @@ void handle_dungeon_exploration(void) {
     }
 }
 
+// Stepping onto a town or dungeon footprint; returns true if the party left the overworld
+static bool handle_world_location(uint16_t location_id) {
+    const WorldLocation* location = world_map_get_location(location_id);
+
+    if (location_id < NUM_TOWNS) {
+        printf("\nEntering %s...\n", location->name);
+        input_wait_for_key();
+        handle_town(location->name);
+        return false;
+    }
+
+    // World dungeon ids 0-4 are the game's dungeons; the side dungeons have no floors yet
+    uint8_t dungeon_idx = (uint8_t)(location_id - NUM_TOWNS);
+    if (dungeon_idx > MAX_DUNGEONS) {
+        printf("\nThe way into %s is sealed.\n", location->name);
+        input_wait_for_key();
+        return false;
+    }
+    if (dungeon_idx == MAX_DUNGEONS && !is_final_dungeon_unlocked()) {
+        printf("\nA barrier seals %s. Bring all four crystals.\n", location->name);
+        input_wait_for_key();
+        return false;
+    }
+
+    printf("\nEntering %s...\n", location->name);
+    input_wait_for_key();
+    enter_dungeon(dungeon_idx, STATE_WORLD_MAP);
+    return true;
+}
+
+void handle_world_map(void) {
+    // Entering is triggered by stepping onto a location, not by standing on one
+    uint16_t current_location = world_map_get_location_id_at(g_game_state.world_x, g_game_state.world_y);
+    bool on_world_map = true;
+
+    input_flush_buffer();
+
+    while (on_world_map) {
+        // Everything a step touches - viewport, passability bit, location cell,
+        // zone - is a fixed amount of work, whatever the map size
+        screen_begin_frame();
+        display_world_map();
+        display_party_status();
+        screen_present();
+
+        int8_t dx = 0, dy = 0;
+        InputButton input = input_wait_key(INPUT_WAIT_FOREVER);
+
+        switch (input) {
+            case INPUT_UP:
+                dy = -1;
+                break;
+            case INPUT_DOWN:
+                dy = 1;
+                break;
+            case INPUT_LEFT:
+                dx = -1;
+                break;
+            case INPUT_RIGHT:
+                dx = 1;
+                break;
+
+            case INPUT_B:
+            case INPUT_SELECT:
+            case INPUT_START: {
+                const char* menu_options[] = {
+                    "Inventory",
+                    "Party Status",
+                    "Toggle Graphics Mode",
+                    "Return to Dungeon Selection",
+                    "Return to World Map"
+                };
+
+                int8_t choice = cursor_menu("WORLD MAP", menu_options, 5);
+
+                if (choice == 0) {
+                    handle_inventory_menu();
+                    game_state_change(STATE_WORLD_MAP); // Inventory assumes it was opened from a dungeon
+                } else if (choice == 1) {
+                    clear_screen();
+                    display_party_status();
+                    input_wait_for_key();
+                } else if (choice == 2) {
+                    g_game_state.tile_graphics_mode = !g_game_state.tile_graphics_mode;
+                } else if (choice == 3) {
+                    input_flush_buffer();
+                    g_game_state.hub_state = STATE_DUNGEON_SELECT;
+                    game_state_change(STATE_DUNGEON_SELECT);
+                    on_world_map = false;
+                }
+                break;
+            }
+
+            default:
+                break;
+        }
+
+        if (dx == 0 && dy == 0) continue;
+
+        // Water and mountains block; so does the map edge
+        int new_x = g_game_state.world_x + dx;
+        int new_y = g_game_state.world_y + dy;
+        if (new_x < 0 || new_y < 0 || !world_map_is_passable((uint8_t)new_x, (uint8_t)new_y)) continue;
+
+        g_game_state.world_x = (uint8_t)new_x;
+        g_game_state.world_y = (uint8_t)new_y;
+
+        uint16_t location = world_map_get_location_id_at(g_game_state.world_x, g_game_state.world_y);
+        if (location != WORLD_LOCATION_NONE && location != current_location) {
+            current_location = location;
+            if (handle_world_location(location)) on_world_map = false;
+            continue;
+        }
+        current_location = location;
+
+        if (world_map_check_encounter(g_game_state.world_x, g_game_state.world_y, &g_game_state.world_encounter_steps)) {
+            printf("\nMonsters appear!\n");
+            input_wait_for_key();
+
+            uint8_t zone = world_map_get_zone(g_game_state.world_x, g_game_state.world_y);
+            g_game_state.battle_return_state = STATE_WORLD_MAP;
+            battle_init(encounter_table_for_zone(zone), false);
+            game_state_change(STATE_BATTLE);
+            on_world_map = false;
+        }
+    }
+}
+
 void handle_battle_phase(void) {
+    static BattleAIWorkspace auto_workspace;
     bool battle_active = true;
+    bool auto_battle = false;
+    BattleContext* ctx = battle_get_context();
+    BattleState* battle = ctx->state;
     
-    while (battle_active && !battle_is_over()) {
-        clear_screen();
-        display_battle_scene();
+    while (battle_active && !battle_core_is_over(ctx)) {
+        // Auto-battle streams the log instead of redrawing every turn
+        if (!auto_battle) {
+            screen_begin_frame();
+            display_battle_scene();
+            screen_present();
+        }
         
         // Execute enemy turns automatically
-        while (g_battle_state.current_turn >= MAX_PARTY_SIZE && 
-               g_battle_state.current_turn < g_battle_state.turn_count &&
-               !battle_is_over()) {
-            battle_execute_turn();
-        }
+        battle_core_run_enemy_turns(ctx);
+        battle_flush_events();
         
-        if (battle_is_over()) break;
+        if (battle_core_is_over(ctx)) break;
         
         // Player's turn
-        uint8_t current_member_index = g_battle_state.turn_order[g_battle_state.current_turn];
-        PartyMember* current_member = party_get_member(g_game_state.party, current_member_index);
+        uint8_t current_member_index = battle_core_current_actor(ctx);
+        PartyMember* current_member = party_get_member(ctx->party, current_member_index);
         
         if (!current_member || current_member->stats.current_hp == 0) {
             // Skip dead member
-            g_battle_state.current_turn = (g_battle_state.current_turn + 1) % g_battle_state.turn_count;
+            battle_core_advance_turn(ctx);
             continue;
         }
 
         // Show whose turn it is
         display_battle_turn_indicator(current_member->name);
 
+        if (auto_battle) {
+            BattleAIConfig ai_config;
+            BattleAction auto_action;
+            battle_ai_default_config(&ai_config, g_game_state.auto_battle_ms,
+                                     random_stream_next(random_get_stream(RNG_STREAM_GENERAL)));
+
+            if (battle_ai_choose_action(ctx, current_member_index, &ai_config, &auto_workspace, &auto_action, NULL)) {
+                battle_core_process_action(ctx, &auto_action);
+            } else {
+                battle_core_advance_turn(ctx);
+            }
+            battle_flush_events();
+
+            // X/Esc hands control back before the next party turn
+            if (input_get_key() == INPUT_B) {
+                auto_battle = false;
+                printf("\nAuto-battle off.\n");
+                input_wait_for_key();
+            }
+            continue;
+        }
+
 		// Build action menu (inline, no screen clear)
 		const char* action_options[] = {
 			"Attack",
 			"Skill/Magic",
 			"Item",
 			"Defend",
-			"Flee"
+			"Flee",
+			"Auto"
 		};
 
 		// Display action menu inline
@@ -1541,39 +1942,37 @@ void handle_battle_phase(void) {
 
 		while (action_choice == -1) {
 			// Show menu options
-			for (uint8_t i = 0; i < 5; i++) {
+			for (uint8_t i = 0; i < 6; i++) {
 				if (i == action_cursor) {
-					printf("> %s\n", action_options[i]);
+					screen_print("> %s\n", action_options[i]);
 				} else {
-					printf("  %s\n", action_options[i]);
+					screen_print("  %s\n", action_options[i]);
 				}
 			}
-			printf("\nW/S=Move, Enter/Z=Select\n");
+			screen_print("\nW/S=Move, Enter/Z=Select\n");
+			screen_present();
 
-			InputButton input = INPUT_NONE;
-			while (input == INPUT_NONE) {
-				input = input_get_key();
-			}
+			InputButton input = input_wait_key(INPUT_WAIT_FOREVER);
 
 			switch (input) {
 				case INPUT_UP:
 					if (action_cursor > 0) {
 						action_cursor--;
 						// Redraw entire battle screen
-						clear_screen();
+						screen_begin_frame();
 						display_battle_scene();
 						display_battle_turn_indicator(current_member->name);
-						printf("\n=== BATTLE ACTION ===\n\n");
+						screen_print("\n=== BATTLE ACTION ===\n\n");
 					}
 					break;
 				case INPUT_DOWN:
-					if (action_cursor < 4) {
+					if (action_cursor < 5) {
 						action_cursor++;
 						// Redraw entire battle screen
-						clear_screen();
+						screen_begin_frame();
 						display_battle_scene();
 						display_battle_turn_indicator(current_member->name);
-						printf("\n=== BATTLE ACTION ===\n\n");
+						screen_print("\n=== BATTLE ACTION ===\n\n");
 					}
 					break;
 				case INPUT_A: // Z
@@ -1598,7 +1997,7 @@ void handle_battle_phase(void) {
 				action.type = ACTION_ATTACK;
 
 				// Select target
-				if (g_battle_state.is_boss_battle) {
+				if (battle->is_boss_battle) {
 					action.target_index = 0;
 				} else {
 					// Build target menu with alive enemies (inline display)
@@ -1606,11 +2005,11 @@ void handle_battle_phase(void) {
 					uint8_t enemy_indices[MAX_ENEMIES];
 					uint8_t alive_count = 0;
 
-					for (uint8_t i = 0; i < g_battle_state.enemy_count; i++) {
-						if (g_battle_state.enemies[i].is_alive) {
+					for (uint8_t i = 0; i < battle->enemy_count; i++) {
+						if (battle->enemies[i].is_alive) {
 							snprintf(enemy_labels[alive_count], 50, "%s (HP: %d)",
-									 g_battle_state.enemies[i].name,
-									 g_battle_state.enemies[i].current_hp);
+									 battle->enemies[i].name,
+									 battle->enemies[i].current_hp);
 							enemy_indices[alive_count] = i;
 							alive_count++;
 						}
@@ -1624,35 +2023,33 @@ void handle_battle_phase(void) {
 					while (target_choice == -1) {
 						for (uint8_t i = 0; i < alive_count; i++) {
 							if (i == target_cursor) {
-								printf("> %s\n", enemy_labels[i]);
+								screen_print("> %s\n", enemy_labels[i]);
 							} else {
-								printf("  %s\n", enemy_labels[i]);
+								screen_print("  %s\n", enemy_labels[i]);
 							}
 						}
-						printf("\nW/S=Move, Enter/Z=Select, X/Esc=Cancel\n");
+						screen_print("\nW/S=Move, Enter/Z=Select, X/Esc=Cancel\n");
+						screen_present();
 
-						InputButton input = INPUT_NONE;
-						while (input == INPUT_NONE) {
-							input = input_get_key();
-						}
+						InputButton input = input_wait_key(INPUT_WAIT_FOREVER);
 
 						switch (input) {
 							case INPUT_UP:
 								if (target_cursor > 0) {
 									target_cursor--;
-									clear_screen();
+									screen_begin_frame();
 									display_battle_scene();
 									display_battle_turn_indicator(current_member->name);
-									printf("\n=== SELECT TARGET ===\n\n");
+									screen_print("\n=== SELECT TARGET ===\n\n");
 								}
 								break;
 							case INPUT_DOWN:
 								if (target_cursor < alive_count - 1) {
 									target_cursor++;
-									clear_screen();
+									screen_begin_frame();
 									display_battle_scene();
 									display_battle_turn_indicator(current_member->name);
-									printf("\n=== SELECT TARGET ===\n\n");
+									screen_print("\n=== SELECT TARGET ===\n\n");
 								}
 								break;
 							case INPUT_A:
@@ -1676,7 +2073,9 @@ void handle_battle_phase(void) {
 					action.target_index = enemy_indices[target_choice];
 				}
 
-				battle_process_action(&action);
+				battle_core_process_action(ctx, &action);
+
+				battle_flush_events();
 				input_wait_for_key();
 				break;
 				
@@ -1707,36 +2106,34 @@ void handle_battle_phase(void) {
 				while (skill_choice == -1) {
 					for (uint8_t i = 0; i < current_member->skill_count; i++) {
 						if (i == skill_cursor) {
-							printf("> %s\n", skill_labels[i]);
+							screen_print("> %s\n", skill_labels[i]);
 						} else {
-							printf("  %s\n", skill_labels[i]);
+							screen_print("  %s\n", skill_labels[i]);
 						}
 					}
-					printf("\nW/S=Move, Enter/Z=Select, X/Esc=Cancel\n");
+					screen_print("\nW/S=Move, Enter/Z=Select, X/Esc=Cancel\n");
+					screen_present();
 
-					InputButton input = INPUT_NONE;
-					while (input == INPUT_NONE) {
-						input = input_get_key();
-					}
+					InputButton input = input_wait_key(INPUT_WAIT_FOREVER);
 
 					switch (input) {
 						case INPUT_UP:
 							if (skill_cursor > 0) {
 								skill_cursor--;
-								clear_screen();
+								screen_begin_frame();
 								display_battle_scene();
 								display_battle_turn_indicator(current_member->name);
-								printf("\n=== SELECT SKILL === (MP: %d/%d)\n\n",
+								screen_print("\n=== SELECT SKILL === (MP: %d/%d)\n\n",
 									   current_member->stats.current_mp, current_member->stats.max_mp);
 							}
 							break;
 						case INPUT_DOWN:
 							if (skill_cursor < current_member->skill_count - 1) {
 								skill_cursor++;
-								clear_screen();
+								screen_begin_frame();
 								display_battle_scene();
 								display_battle_turn_indicator(current_member->name);
-								printf("\n=== SELECT SKILL === (MP: %d/%d)\n\n",
+								screen_print("\n=== SELECT SKILL === (MP: %d/%d)\n\n",
 									   current_member->stats.current_mp, current_member->stats.max_mp);
 							}
 							break;
@@ -1783,7 +2180,7 @@ void handle_battle_phase(void) {
 						action.target_index = 0; // Doesn't matter for AoE
 					} else {
 						// Select enemy target
-						if (g_battle_state.is_boss_battle) {
+						if (battle->is_boss_battle) {
 							action.target_index = 0;
 						} else {
 							// Build enemy target menu (inline)
@@ -1791,11 +2188,11 @@ void handle_battle_phase(void) {
 							uint8_t enemy_skill_indices[MAX_ENEMIES];
 							uint8_t alive_count = 0;
 
-							for (uint8_t i = 0; i < g_battle_state.enemy_count; i++) {
-								if (g_battle_state.enemies[i].is_alive) {
+							for (uint8_t i = 0; i < battle->enemy_count; i++) {
+								if (battle->enemies[i].is_alive) {
 									snprintf(enemy_skill_labels[alive_count], 50, "%s (HP: %d)",
-											 g_battle_state.enemies[i].name,
-											 g_battle_state.enemies[i].current_hp);
+											 battle->enemies[i].name,
+											 battle->enemies[i].current_hp);
 									enemy_skill_indices[alive_count] = i;
 									alive_count++;
 								}
@@ -1808,35 +2205,33 @@ void handle_battle_phase(void) {
 							while (target_choice == -1) {
 								for (uint8_t i = 0; i < alive_count; i++) {
 									if (i == target_cursor) {
-										printf("> %s\n", enemy_skill_labels[i]);
+										screen_print("> %s\n", enemy_skill_labels[i]);
 									} else {
-										printf("  %s\n", enemy_skill_labels[i]);
+										screen_print("  %s\n", enemy_skill_labels[i]);
 									}
 								}
-								printf("\nW/S=Move, Enter/Z=Select, X/Esc=Cancel\n");
+								screen_print("\nW/S=Move, Enter/Z=Select, X/Esc=Cancel\n");
+								screen_present();
 
-								InputButton input = INPUT_NONE;
-								while (input == INPUT_NONE) {
-									input = input_get_key();
-								}
+								InputButton input = input_wait_key(INPUT_WAIT_FOREVER);
 
 								switch (input) {
 									case INPUT_UP:
 										if (target_cursor > 0) {
 											target_cursor--;
-											clear_screen();
+											screen_begin_frame();
 											display_battle_scene();
 											display_battle_turn_indicator(current_member->name);
-											printf("\n=== SELECT TARGET ===\n\n");
+											screen_print("\n=== SELECT TARGET ===\n\n");
 										}
 										break;
 									case INPUT_DOWN:
 										if (target_cursor < alive_count - 1) {
 											target_cursor++;
-											clear_screen();
+											screen_begin_frame();
 											display_battle_scene();
 											display_battle_turn_indicator(current_member->name);
-											printf("\n=== SELECT TARGET ===\n\n");
+											screen_print("\n=== SELECT TARGET ===\n\n");
 										}
 										break;
 									case INPUT_A:
@@ -1866,8 +2261,8 @@ void handle_battle_phase(void) {
 						// Build party member target menu (inline)
 						static char party_labels[MAX_PARTY_SIZE][50];
 
-						for (uint8_t i = 0; i < g_game_state.party->member_count; i++) {
-							PartyMember* member = &g_game_state.party->members[i];
+						for (uint8_t i = 0; i < ctx->party->member_count; i++) {
+							PartyMember* member = &ctx->party->members[i];
 							snprintf(party_labels[i], 50, "%s (HP: %d/%d)",
 									 member->name,
 									 member->stats.current_hp,
@@ -1879,37 +2274,35 @@ void handle_battle_phase(void) {
 						int8_t target_choice = -1;
 
 						while (target_choice == -1) {
-							for (uint8_t i = 0; i < g_game_state.party->member_count; i++) {
+							for (uint8_t i = 0; i < ctx->party->member_count; i++) {
 								if (i == target_cursor) {
-									printf("> %s\n", party_labels[i]);
+									screen_print("> %s\n", party_labels[i]);
 								} else {
-									printf("  %s\n", party_labels[i]);
+									screen_print("  %s\n", party_labels[i]);
 								}
 							}
-							printf("\nW/S=Move, Enter/Z=Select, X/Esc=Cancel\n");
+							screen_print("\nW/S=Move, Enter/Z=Select, X/Esc=Cancel\n");
+							screen_present();
 
-							InputButton input = INPUT_NONE;
-							while (input == INPUT_NONE) {
-								input = input_get_key();
-							}
+							InputButton input = input_wait_key(INPUT_WAIT_FOREVER);
 
 							switch (input) {
 								case INPUT_UP:
 									if (target_cursor > 0) {
 										target_cursor--;
-										clear_screen();
+										screen_begin_frame();
 										display_battle_scene();
 										display_battle_turn_indicator(current_member->name);
-										printf("\n=== SELECT TARGET ===\n\n");
+										screen_print("\n=== SELECT TARGET ===\n\n");
 									}
 									break;
 								case INPUT_DOWN:
-									if (target_cursor < g_game_state.party->member_count - 1) {
+									if (target_cursor < ctx->party->member_count - 1) {
 										target_cursor++;
-										clear_screen();
+										screen_begin_frame();
 										display_battle_scene();
 										display_battle_turn_indicator(current_member->name);
-										printf("\n=== SELECT TARGET ===\n\n");
+										screen_print("\n=== SELECT TARGET ===\n\n");
 									}
 									break;
 								case INPUT_A:
@@ -1933,12 +2326,14 @@ void handle_battle_phase(void) {
 					}
 				}
 				
-				battle_process_action(&action);
+				battle_core_process_action(ctx, &action);
+				
+				battle_flush_events();
 				input_wait_for_key();
 				break;
 				
 			case 2: // Item
-				if (g_game_state.inventory->item_count == 0) {
+				if (ctx->inventory->item_count == 0) {
 					printf("No items!\n");
 					input_wait_for_key();
 					continue;
@@ -1947,8 +2342,8 @@ void handle_battle_phase(void) {
 				// Build item menu (inline)
 				static char item_labels[MAX_INVENTORY_ITEMS][50];
 
-				for (uint8_t i = 0; i < g_game_state.inventory->item_count; i++) {
-					Item* item = &g_game_state.inventory->items[i];
+				for (uint8_t i = 0; i < ctx->inventory->item_count; i++) {
+					Item* item = &ctx->inventory->items[i];
 					snprintf(item_labels[i], 50, "%s x%d", item->name, item->quantity);
 				}
 
@@ -1957,37 +2352,35 @@ void handle_battle_phase(void) {
 				int8_t item_choice = -1;
 
 				while (item_choice == -1) {
-					for (uint8_t i = 0; i < g_game_state.inventory->item_count; i++) {
+					for (uint8_t i = 0; i < ctx->inventory->item_count; i++) {
 						if (i == item_cursor) {
-							printf("> %s\n", item_labels[i]);
+							screen_print("> %s\n", item_labels[i]);
 						} else {
-							printf("  %s\n", item_labels[i]);
+							screen_print("  %s\n", item_labels[i]);
 						}
 					}
-					printf("\nW/S=Move, Enter/Z=Select, X/Esc=Cancel\n");
+					screen_print("\nW/S=Move, Enter/Z=Select, X/Esc=Cancel\n");
+					screen_present();
 
-					InputButton input = INPUT_NONE;
-					while (input == INPUT_NONE) {
-						input = input_get_key();
-					}
+					InputButton input = input_wait_key(INPUT_WAIT_FOREVER);
 
 					switch (input) {
 						case INPUT_UP:
 							if (item_cursor > 0) {
 								item_cursor--;
-								clear_screen();
+								screen_begin_frame();
 								display_battle_scene();
 								display_battle_turn_indicator(current_member->name);
-								printf("\n=== SELECT ITEM ===\n\n");
+								screen_print("\n=== SELECT ITEM ===\n\n");
 							}
 							break;
 						case INPUT_DOWN:
-							if (item_cursor < g_game_state.inventory->item_count - 1) {
+							if (item_cursor < ctx->inventory->item_count - 1) {
 								item_cursor++;
-								clear_screen();
+								screen_begin_frame();
 								display_battle_scene();
 								display_battle_turn_indicator(current_member->name);
-								printf("\n=== SELECT ITEM ===\n\n");
+								screen_print("\n=== SELECT ITEM ===\n\n");
 							}
 							break;
 						case INPUT_A:
@@ -2010,8 +2403,8 @@ void handle_battle_phase(void) {
 				// Select party member to use item on (inline)
 				static char member_labels[MAX_PARTY_SIZE][50];
 
-				for (uint8_t i = 0; i < g_game_state.party->member_count; i++) {
-					PartyMember* member = &g_game_state.party->members[i];
+				for (uint8_t i = 0; i < ctx->party->member_count; i++) {
+					PartyMember* member = &ctx->party->members[i];
 					snprintf(member_labels[i], 50, "%s (HP: %d/%d)",
 							 member->name,
 							 member->stats.current_hp,
@@ -2023,37 +2416,35 @@ void handle_battle_phase(void) {
 				int8_t member_choice = -1;
 
 				while (member_choice == -1) {
-					for (uint8_t i = 0; i < g_game_state.party->member_count; i++) {
+					for (uint8_t i = 0; i < ctx->party->member_count; i++) {
 						if (i == member_cursor) {
-							printf("> %s\n", member_labels[i]);
+							screen_print("> %s\n", member_labels[i]);
 						} else {
-							printf("  %s\n", member_labels[i]);
+							screen_print("  %s\n", member_labels[i]);
 						}
 					}
-					printf("\nW/S=Move, Enter/Z=Select, X/Esc=Cancel\n");
+					screen_print("\nW/S=Move, Enter/Z=Select, X/Esc=Cancel\n");
+					screen_present();
 
-					InputButton input = INPUT_NONE;
-					while (input == INPUT_NONE) {
-						input = input_get_key();
-					}
+					InputButton input = input_wait_key(INPUT_WAIT_FOREVER);
 
 					switch (input) {
 						case INPUT_UP:
 							if (member_cursor > 0) {
 								member_cursor--;
-								clear_screen();
+								screen_begin_frame();
 								display_battle_scene();
 								display_battle_turn_indicator(current_member->name);
-								printf("\n=== USE ON ===\n\n");
+								screen_print("\n=== USE ON ===\n\n");
 							}
 							break;
 						case INPUT_DOWN:
-							if (member_cursor < g_game_state.party->member_count - 1) {
+							if (member_cursor < ctx->party->member_count - 1) {
 								member_cursor++;
-								clear_screen();
+								screen_begin_frame();
 								display_battle_scene();
 								display_battle_turn_indicator(current_member->name);
-								printf("\n=== USE ON ===\n\n");
+								screen_print("\n=== USE ON ===\n\n");
 							}
 							break;
 						case INPUT_A:
@@ -2068,30 +2459,42 @@ void handle_battle_phase(void) {
 					}
 				}
 
-				if (member_choice != -2) {
-					inventory_use_item(g_game_state.inventory, item_choice, member_choice);
+				if (member_choice == -2) {
+					// Cancelled
+					continue;
 				}
 
-				// Using item doesn't advance turn in this implementation
+				action.type = ACTION_ITEM;
+				action.item_or_skill_id = item_choice;
+				action.target_index = member_choice;
+				battle_core_process_action(ctx, &action);
+				battle_flush_events();
 				input_wait_for_key();
-				continue; // Don't advance turn
+				break;
 				
 			case 3: // Defend
 				action.type = ACTION_DEFEND;
-				battle_process_action(&action);
+				battle_core_process_action(ctx, &action);
+				battle_flush_events();
 				input_wait_for_key();
 				break;
 
 			case 4: // Flee
 				action.type = ACTION_FLEE;
-				battle_process_action(&action);
+				battle_core_process_action(ctx, &action);
+				battle_flush_events();
 				input_wait_for_key();
 
-				if (g_battle_state.battle_fled) {
+				if (battle->battle_fled) {
 					battle_active = false;
 				}
 				break;
 
+			case 5: // Auto - search picks every party action until X/Esc
+				auto_battle = true;
+				printf("\nAuto-battle on. Press X/Esc to take back control.\n");
+				continue;
+
 			default:
 				printf("Invalid action!\n");
 				input_wait_for_key();
@@ -2099,23 +2502,28 @@ void handle_battle_phase(void) {
 		}
 	}	
 	
+    // Let the last auto-battle exchange stay on screen
+    if (auto_battle) {
+        input_wait_for_key();
+    }
     
     // Battle ended
     clear_screen();
     
-    if (party_is_defeated(g_game_state.party)) {
+    if (party_is_defeated(ctx->party)) {
         printf("\nYour party has been defeated!\n");
         game_state_change(STATE_GAME_OVER);
-    } else if (g_battle_state.battle_fled) {
+    } else if (battle->battle_fled) {
         printf("\nEscaped from battle!\n");
         battle_cleanup();
-        game_state_change(STATE_DUNGEON_EXPLORE);
-    } else if (battle_is_victory()) {
+        game_state_change(battle->is_boss_battle ? STATE_DUNGEON_EXPLORE : g_game_state.battle_return_state);
+        autosave_request();
+    } else if (battle_core_is_victory(ctx)) {
         printf("\nVICTORY!\n");
         battle_distribute_rewards();
         
         // Check if it was a boss battle
-        if (g_battle_state.is_boss_battle) {
+        if (battle->is_boss_battle) {
             Dungeon* current_dungeon = &g_game_state.dungeons[g_game_state.current_dungeon_index];
 
             if (g_game_state.dungeon_initialized[g_game_state.current_dungeon_index]) {
@@ -2128,7 +2536,7 @@ void handle_battle_phase(void) {
                     g_game_state.dungeons_completed[g_game_state.current_dungeon_index] = true;
                     
                     battle_cleanup();
-                    game_state_change(STATE_DUNGEON_SELECT);
+                    game_state_change(g_game_state.hub_state);
                 } else {
                     // Final boss defeated
                     printf("\n*** THE FINAL BOSS HAS BEEN DEFEATED! ***\n");
@@ -2138,9 +2546,11 @@ void handle_battle_phase(void) {
             }
         } else {
             battle_cleanup();
-            game_state_change(STATE_DUNGEON_EXPLORE);
+            game_state_change(g_game_state.battle_return_state);
         }
-        
+
+        // Rewards are in; written while the victory screen waits
+        autosave_request();
         input_wait_for_key();
     }
 }
@@ -2306,16 +2716,63 @@ void handle_inventory_menu(void) {
     }
 }
 
+#define SAVE_MENU_ROWS 10 // Slots on screen at once
+
+// Scrolling list of every save slot with its preview (served from the slot
+// catalog, so scrolling reads no files); -1 if cancelled
+static int16_t select_save_slot(const char* title) {
+    static uint16_t cursor = 0; // Reopens on the slot last used
+
+    while (1) {
+        uint16_t top = cursor > SAVE_MENU_ROWS / 2 ? cursor - SAVE_MENU_ROWS / 2 : 0;
+        if (top > MAX_SAVE_SLOTS - SAVE_MENU_ROWS) top = MAX_SAVE_SLOTS - SAVE_MENU_ROWS;
+
+        screen_begin_frame();
+        screen_print("\n=== %s ===\n\n", title);
+
+        for (uint16_t i = top; i < top + SAVE_MENU_ROWS; i++) {
+            SaveSlotInfo info = get_save_slot_info(i);
+            screen_print("%s Slot %3d  %s\n", i == cursor ? ">" : " ", i + 1, info.preview_text);
+        }
+
+        screen_print("\nSlot %d of %d\n", cursor + 1, MAX_SAVE_SLOTS);
+        screen_print("Controls: W/S=Move, A/D=Page, Enter/Z=Select, X/Esc=Cancel\n");
+        screen_present();
+
+        switch (input_wait_key(INPUT_WAIT_FOREVER)) {
+            case INPUT_UP:
+                if (cursor > 0) cursor--;
+                break;
+            case INPUT_DOWN:
+                if (cursor < MAX_SAVE_SLOTS - 1) cursor++;
+                break;
+            case INPUT_LEFT:
+                cursor = cursor > SAVE_MENU_ROWS ? cursor - SAVE_MENU_ROWS : 0;
+                break;
+            case INPUT_RIGHT:
+                cursor = cursor + SAVE_MENU_ROWS < MAX_SAVE_SLOTS ? cursor + SAVE_MENU_ROWS : MAX_SAVE_SLOTS - 1;
+                break;
+            case INPUT_A:
+            case INPUT_START:
+                return (int16_t)cursor;
+            case INPUT_B:
+                return -1;
+            default:
+                break;
+        }
+    }
+}
+
 void handle_save_menu(void) {
-    const char* save_options[] = {"Slot 1", "Slot 2", "Suspend Save", "Cancel"};
+    const char* save_options[] = {"Save to Slot", "Suspend Save", "Cancel"};
 
-    int8_t choice = cursor_menu("SAVE GAME", save_options, 4);
+    int8_t choice = cursor_menu("SAVE GAME", save_options, 3);
 
-    if (choice < 0 || choice == 3) {
+    if (choice < 0 || choice == 2) {
         return; // Cancelled or selected Cancel
     }
 
-    if (choice == 2) {
+    if (choice == 1) {
         // Suspend save
         if (save_suspend_game()) {
             clear_screen();
@@ -2326,8 +2783,10 @@ void handle_save_menu(void) {
         }
         input_wait_for_key();
     } else {
-        // Slot 1 or Slot 2
-        int slot = choice; // 0 or 1
+        int16_t slot = select_save_slot("SAVE TO SLOT");
+        if (slot < 0) {
+            return;
+        }
 
         if (save_slot_exists(slot)) {
             const char* confirm_options[] = {"Yes", "No"};
@@ -2352,7 +2811,7 @@ void handle_save_menu(void) {
 }
 
 void handle_load_menu(void) {
-    const char* load_options[] = {"Slot 1", "Slot 2", "Suspend Save", "Cancel"};
+    const char* load_options[] = {"Load from Slot", "Suspend Save", "Autosave", "Cancel"};
 
     int8_t choice = cursor_menu("LOAD GAME", load_options, 4);
 
@@ -2361,6 +2820,20 @@ void handle_load_menu(void) {
     }
 
     if (choice == 2) {
+        if (autosave_exists()) {
+            if (load_autosave_game()) {
+                clear_screen();
+                printf("\nAutosave loaded!\n");
+            } else {
+                clear_screen();
+                printf("\nFailed to load autosave!\n");
+            }
+        } else {
+            clear_screen();
+            printf("\nNo autosave found!\n");
+        }
+        input_wait_for_key();
+    } else if (choice == 1) {
         // Load suspend save
         if (suspend_save_exists()) {
             if (load_suspend_game()) {
@@ -2379,8 +2852,10 @@ void handle_load_menu(void) {
             input_wait_for_key();
         }
     } else {
-        // Slot 1 or Slot 2
-        int slot = choice; // 0 or 1
+        int16_t slot = select_save_slot("LOAD FROM SLOT");
+        if (slot < 0) {
+            return;
+        }
 
         if (save_slot_exists(slot)) {
             if (load_game_from_slot(slot)) {
@@ -46,30 +46,15 @@ bool party_add_member(Party* party, JobType job, const char* name) {
     }
     
     PartyMember* member = &party->members[party->member_count];
-    
-    // Set name
-    safe_string_copy(member->name, name, MAX_NAME_LENGTH);
-    
-    // Set job
-    member->job = job;
-    
-    // Initialize stats based on job
-    character_init_stats(member, job);
-    
-    // Initialize equipment (empty)
-    for (int i = 0; i < EQUIP_SLOT_COUNT; i++) {
-        member->equipped_items[i] = 0xFF; // 0xFF = no item
-    }
-    
-    // No status effects
-    member->status_effects = STATUS_NONE;
+    character_init_member(member, job, name);
 
-    // Initialize starting skills
-	member->skill_count = 0;
-	character_init_starting_skills(member);
-
-    // Initialize buffs
-    member->buff_count = 0;
+    // Announce starting skills
+    for (uint8_t i = 0; i < member->skill_count; i++) {
+        const Skill* skill = get_skill_data(member->skills[i]);
+        if (skill) {
+            printf("%s learned %s!\n", member->name, skill->name);
+        }
+    }
 
     party->member_count++;
     
@@ -127,29 +112,76 @@ void character_init_stats(PartyMember* member, JobType job) {
     if (!member || job >= MAX_JOB_TYPES) return;
     
     member->stats = job_base_stats[job];
+    character_invalidate_stats(member);
 }
 
-void character_take_damage(PartyMember* member, uint16_t damage) {
+void character_invalidate_stats(PartyMember* member) {
     if (!member) return;
-    
+    member->derived_valid = false;
+}
+
+void character_init_member(PartyMember* member, JobType job, const char* name) {
+    if (!member || job >= MAX_JOB_TYPES) return;
+
+    memset(member, 0, sizeof(PartyMember));
+
+    // Set name and job
+    safe_string_copy(member->name, name, MAX_NAME_LENGTH);
+    member->job = job;
+
+    // Initialize stats based on job
+    character_init_stats(member, job);
+
+    // Initialize equipment (empty)
+    for (int i = 0; i < EQUIP_SLOT_COUNT; i++) {
+        member->equipped_items[i] = 0xFF; // 0xFF = no item
+    }
+
+    // No status effects, buffs or skills yet
+    member->status_effects = STATUS_NONE;
+    member->skill_count = 0;
+    member->buff_count = 0;
+
+    character_init_starting_skills(member);
+}
+
+bool character_apply_damage(PartyMember* member, uint16_t damage) {
+    if (!member) return false;
+
     if (damage >= member->stats.current_hp) {
         member->stats.current_hp = 0;
         member->status_effects |= STATUS_DEAD;
+        return true;
+    }
+
+    member->stats.current_hp -= damage;
+    return false;
+}
+
+bool character_apply_heal(PartyMember* member, uint16_t amount) {
+    if (!member || character_has_status(member, STATUS_DEAD)) return false;
+
+    member->stats.current_hp += amount;
+    if (member->stats.current_hp > member->stats.max_hp) {
+        member->stats.current_hp = member->stats.max_hp;
+    }
+
+    return true;
+}
+
+void character_take_damage(PartyMember* member, uint16_t damage) {
+    if (!member) return;
+    
+    if (character_apply_damage(member, damage)) {
         printf("%s has been defeated!\n", member->name);
     } else {
-        member->stats.current_hp -= damage;
         printf("%s takes %d damage! (%d HP remaining)\n", 
                member->name, damage, member->stats.current_hp);
     }
 }
 
 void character_heal(PartyMember* member, uint16_t amount) {
-    if (!member || character_has_status(member, STATUS_DEAD)) return;
-    
-    member->stats.current_hp += amount;
-    if (member->stats.current_hp > member->stats.max_hp) {
-        member->stats.current_hp = member->stats.max_hp;
-    }
+    if (!character_apply_heal(member, amount)) return;
     
     printf("%s recovers %d HP!\n", member->name, amount);
 }
@@ -184,105 +216,126 @@ uint32_t character_get_exp_for_next_level(uint8_t level) {
     return 100 * level * level;
 }
 
-void character_gain_experience(PartyMember* member, uint32_t exp) {
-    if (!member || character_has_status(member, STATUS_DEAD)) return;
+void character_level_up(PartyMember* member, RandomStream* rng) {
+    if (!member || !rng) return;
 
-    member->stats.experience += exp;
+    member->stats.level++;
 
-    // Check for level up
-    uint32_t exp_needed = character_get_exp_for_next_level(member->stats.level);
-    
-    while (member->stats.experience >= exp_needed) {
-        member->stats.level++;
-        
-        // Stat growth based on job
-        member->stats.max_hp += 8 + (random_range(0, 4));
-        member->stats.max_mp += 3 + (random_range(0, 2));
-        member->stats.strength += random_range(0, 2);
-        member->stats.defense += random_range(0, 2);
-        member->stats.intelligence += random_range(0, 2);
-        member->stats.agility += random_range(0, 2);
-        member->stats.luck += random_range(0, 1);
-        
-        // Heal on level up
-        member->stats.current_hp = member->stats.max_hp;
-        member->stats.current_mp = member->stats.max_mp;
-        
-        printf("*** %s leveled up to level %d! ***\n", member->name, member->stats.level);
-        
-        exp_needed = character_get_exp_for_next_level(member->stats.level);
-    }
-	// Learn new skills/spells at certain levels
+    // Stat growth based on job
+    member->stats.max_hp += 8 + random_stream_range(rng, 0, 4);
+    member->stats.max_mp += 3 + random_stream_range(rng, 0, 2);
+    member->stats.strength += random_stream_range(rng, 0, 2);
+    member->stats.defense += random_stream_range(rng, 0, 2);
+    member->stats.intelligence += random_stream_range(rng, 0, 2);
+    member->stats.agility += random_stream_range(rng, 0, 2);
+    member->stats.luck += random_stream_range(rng, 0, 1);
+    character_invalidate_stats(member);
+
+    // Heal on level up
+    member->stats.current_hp = member->stats.max_hp;
+    member->stats.current_mp = member->stats.max_mp;
+
+    // Learn new skills/spells at certain levels
+    uint8_t level = member->stats.level;
 	switch (member->job) {
 		case JOB_KNIGHT:
-			if (member->stats.level == 5) character_learn_skill(member, SKILL_TAUNT);
+			if (level == 5) character_add_skill(member, SKILL_TAUNT);
 			break;
 
 		case JOB_BLACK_BELT:
-			if (member->stats.level == 5) character_learn_skill(member, SKILL_COUNTER_STANCE);
+			if (level == 5) character_add_skill(member, SKILL_COUNTER_STANCE);
 			break;
 
 		case JOB_THIEF:
-			if (member->stats.level == 5) character_learn_skill(member, SKILL_SMOKE_BOMB);
+			if (level == 5) character_add_skill(member, SKILL_SMOKE_BOMB);
 			break;
 
 		case JOB_MAGE:
 			// Mage spell progression (15 total spells)
 			// Starts with: Fire, Ice
-			if (member->stats.level == 3) character_learn_skill(member, SKILL_BOLT);
-			if (member->stats.level == 5) character_learn_skill(member, SKILL_SLOW);
-			if (member->stats.level == 7) {
-				character_learn_skill(member, SKILL_FIRE2);  // Fire tier 2
-				character_learn_skill(member, SKILL_SILENCE);
+			if (level == 3) character_add_skill(member, SKILL_BOLT);
+			if (level == 5) character_add_skill(member, SKILL_SLOW);
+			if (level == 7) {
+				character_add_skill(member, SKILL_FIRE2);  // Fire tier 2
+				character_add_skill(member, SKILL_SILENCE);
 			}
-			if (member->stats.level == 9) character_learn_skill(member, SKILL_ICE2);
-			if (member->stats.level == 11) character_learn_skill(member, SKILL_BOLT2);
-			if (member->stats.level == 13) character_learn_skill(member, SKILL_TOXIC_CLOUD);
-			if (member->stats.level == 15) {
-				character_learn_skill(member, SKILL_FIRE3);  // Fire tier 3
-				character_learn_skill(member, SKILL_STONE_GAZE);
+			if (level == 9) character_add_skill(member, SKILL_ICE2);
+			if (level == 11) character_add_skill(member, SKILL_BOLT2);
+			if (level == 13) character_add_skill(member, SKILL_TOXIC_CLOUD);
+			if (level == 15) {
+				character_add_skill(member, SKILL_FIRE3);  // Fire tier 3
+				character_add_skill(member, SKILL_STONE_GAZE);
 			}
-			if (member->stats.level == 17) character_learn_skill(member, SKILL_ICE3);
-			if (member->stats.level == 19) character_learn_skill(member, SKILL_BOLT3);
-			if (member->stats.level == 20) character_learn_skill(member, SKILL_FLARE);
+			if (level == 17) character_add_skill(member, SKILL_ICE3);
+			if (level == 19) character_add_skill(member, SKILL_BOLT3);
+			if (level == 20) character_add_skill(member, SKILL_FLARE);
 			break;
 
 		case JOB_PRIEST:
 			// Priest spell progression (8 total spells)
 			// Starts with: Heal
-			if (member->stats.level == 3) character_learn_skill(member, SKILL_ESUNA);
-			if (member->stats.level == 5) character_learn_skill(member, SKILL_SHELL);
-			if (member->stats.level == 7) character_learn_skill(member, SKILL_PROTECT);
-			if (member->stats.level == 9) character_learn_skill(member, SKILL_HEAL2);
-			if (member->stats.level == 12) character_learn_skill(member, SKILL_PRAYER);
-			if (member->stats.level == 15) character_learn_skill(member, SKILL_BLINDING_LIGHT);
-			if (member->stats.level == 18) character_learn_skill(member, SKILL_HEAL3);
+			if (level == 3) character_add_skill(member, SKILL_ESUNA);
+			if (level == 5) character_add_skill(member, SKILL_SHELL);
+			if (level == 7) character_add_skill(member, SKILL_PROTECT);
+			if (level == 9) character_add_skill(member, SKILL_HEAL2);
+			if (level == 12) character_add_skill(member, SKILL_PRAYER);
+			if (level == 15) character_add_skill(member, SKILL_BLINDING_LIGHT);
+			if (level == 18) character_add_skill(member, SKILL_HEAL3);
 			break;
 
 		case JOB_SAGE:
 			// Sage spell progression (13 total spells)
 			// Starts with: Fire, Cure
-			if (member->stats.level == 4) {
-				character_learn_skill(member, SKILL_ICE);
-				character_learn_skill(member, SKILL_BOLT);
+			if (level == 4) {
+				character_add_skill(member, SKILL_ICE);
+				character_add_skill(member, SKILL_BOLT);
 			}
-			if (member->stats.level == 6) character_learn_skill(member, SKILL_TRANQUILITY);
-			if (member->stats.level == 8) {
-				character_learn_skill(member, SKILL_FIRE2);  // Fire tier 2
-				character_learn_skill(member, SKILL_CURE2);  // Cure tier 2
+			if (level == 6) character_add_skill(member, SKILL_TRANQUILITY);
+			if (level == 8) {
+				character_add_skill(member, SKILL_FIRE2);  // Fire tier 2
+				character_add_skill(member, SKILL_CURE2);  // Cure tier 2
 			}
-			if (member->stats.level == 10) character_learn_skill(member, SKILL_ICE2);
-			if (member->stats.level == 12) character_learn_skill(member, SKILL_BOLT2);
-			if (member->stats.level == 14) character_learn_skill(member, SKILL_TIME_WARP);
-			if (member->stats.level == 16) character_learn_skill(member, SKILL_MUTE);
-			if (member->stats.level == 18) character_learn_skill(member, SKILL_PETRIFY);
-			if (member->stats.level == 20) character_learn_skill(member, SKILL_BARRIER);
+			if (level == 10) character_add_skill(member, SKILL_ICE2);
+			if (level == 12) character_add_skill(member, SKILL_BOLT2);
+			if (level == 14) character_add_skill(member, SKILL_TIME_WARP);
+			if (level == 16) character_add_skill(member, SKILL_MUTE);
+			if (level == 18) character_add_skill(member, SKILL_PETRIFY);
+			if (level == 20) character_add_skill(member, SKILL_BARRIER);
 			break;
 
 		default:
 			break;
 	}
 }
+
+bool character_try_level_up(PartyMember* member, RandomStream* rng) {
+    if (!member) return false;
+    if (member->stats.experience < character_get_exp_for_next_level(member->stats.level)) return false;
+
+    character_level_up(member, rng);
+    return true;
+}
+
+void character_gain_experience(PartyMember* member, uint32_t exp) {
+    if (!member || character_has_status(member, STATUS_DEAD)) return;
+
+    member->stats.experience += exp;
+
+    // Check for level up
+    uint8_t known_skills = member->skill_count;
+    while (character_try_level_up(member, random_get_stream(RNG_STREAM_LEVEL_UP))) {
+        printf("*** %s leveled up to level %d! ***\n", member->name, member->stats.level);
+
+        // Announce skills picked up on this level
+        for (uint8_t i = known_skills; i < member->skill_count; i++) {
+            const Skill* skill = get_skill_data(member->skills[i]);
+            if (skill) {
+                printf("%s learned %s!\n", member->name, skill->name);
+            }
+        }
+        known_skills = member->skill_count;
+    }
+}
 // Skill database
 // Format: {skill_id, name, type, scaling_stat, mp_cost, power, target_enemy, target_all, description}
 static const Skill skill_database[] = {
@@ -357,17 +410,22 @@ const Skill* get_skill_data(uint8_t skill_id) {
     return NULL;
 }
 
-void character_learn_skill(PartyMember* member, uint8_t skill_id) {
-    if (!member || member->skill_count >= MAX_SKILLS) return;
-    
+bool character_add_skill(PartyMember* member, uint8_t skill_id) {
+    if (!member || member->skill_count >= MAX_SKILLS) return false;
+
     // Check if already known
     for (uint8_t i = 0; i < member->skill_count; i++) {
         if (member->skills[i] == skill_id) {
-            return; // Already knows this skill
+            return false; // Already knows this skill
         }
     }
-    
+
     member->skills[member->skill_count++] = skill_id;
+    return true;
+}
+
+void character_learn_skill(PartyMember* member, uint8_t skill_id) {
+    if (!character_add_skill(member, skill_id)) return;
     
     const Skill* skill = get_skill_data(skill_id);
     if (skill) {
@@ -403,38 +461,38 @@ void character_init_starting_skills(PartyMember* member) {
 
     switch (member->job) {
         case JOB_KNIGHT:
-            character_learn_skill(member, SKILL_POWER_STRIKE);
-            character_learn_skill(member, SKILL_SHIELD_BASH);
-            character_learn_skill(member, SKILL_GUARD);
+            character_add_skill(member, SKILL_POWER_STRIKE);
+            character_add_skill(member, SKILL_SHIELD_BASH);
+            character_add_skill(member, SKILL_GUARD);
             break;
 
         case JOB_BLACK_BELT:
-            character_learn_skill(member, SKILL_FOCUS_STRIKE);
-            character_learn_skill(member, SKILL_MEDITATION);
+            character_add_skill(member, SKILL_FOCUS_STRIKE);
+            character_add_skill(member, SKILL_MEDITATION);
             break;
 
         case JOB_THIEF:
-            character_learn_skill(member, SKILL_BACKSTAB);
-            character_learn_skill(member, SKILL_STEAL);
-            character_learn_skill(member, SKILL_POISON_BLADE);  // Status effect skill
-            character_learn_skill(member, SKILL_FLASH);         // Status effect skill
+            character_add_skill(member, SKILL_BACKSTAB);
+            character_add_skill(member, SKILL_STEAL);
+            character_add_skill(member, SKILL_POISON_BLADE);  // Status effect skill
+            character_add_skill(member, SKILL_FLASH);         // Status effect skill
             break;
 
         case JOB_SAGE:
             // Start with basic fire and healing (learn more as they level)
-            character_learn_skill(member, SKILL_FIRE);
-            character_learn_skill(member, SKILL_CURE);
+            character_add_skill(member, SKILL_FIRE);
+            character_add_skill(member, SKILL_CURE);
             break;
 
         case JOB_PRIEST:
             // Start with basic healing only (learn more as they level)
-            character_learn_skill(member, SKILL_HEAL);
+            character_add_skill(member, SKILL_HEAL);
             break;
 
         case JOB_MAGE:
             // Start with two elements only (learn more as they level)
-            character_learn_skill(member, SKILL_FIRE);
-            character_learn_skill(member, SKILL_ICE);
+            character_add_skill(member, SKILL_FIRE);
+            character_add_skill(member, SKILL_ICE);
             break;
 
         default:
@@ -447,6 +505,8 @@ void character_init_starting_skills(PartyMember* member) {
 void character_add_buff(PartyMember* member, BuffType type, int8_t magnitude, uint8_t duration) {
     if (!member || type == BUFF_NONE || duration == 0) return;
 
+    character_invalidate_stats(member);
+
     // Check if buff already exists - if so, refresh duration and magnitude
     for (uint8_t i = 0; i < member->buff_count; i++) {
         if (member->active_buffs[i].type == type) {
@@ -475,6 +535,7 @@ void character_remove_buff(PartyMember* member, BuffType type) {
                 member->active_buffs[j] = member->active_buffs[j + 1];
             }
             member->buff_count--;
+            character_invalidate_stats(member);
             return;
         }
     }
@@ -483,6 +544,7 @@ void character_remove_buff(PartyMember* member, BuffType type) {
 void character_clear_all_buffs(PartyMember* member) {
     if (!member) return;
     member->buff_count = 0;
+    character_invalidate_stats(member);
 }
 
 void character_update_buffs(PartyMember* member) {
@@ -500,6 +562,7 @@ void character_update_buffs(PartyMember* member) {
                 member->active_buffs[j] = member->active_buffs[j + 1];
             }
             member->buff_count--;
+            character_invalidate_stats(member);
             // Don't increment i - check the same index again
         } else {
             // Apply MP regen if buff exists
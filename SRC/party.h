@@ -2,6 +2,7 @@
 #define PARTY_H
 
 #include "game_state.h"
+#include "utils.h"
 #include <stdint.h>
 #include <stdbool.h>
 
@@ -138,6 +139,15 @@ typedef struct {
 #define SKILL_STONE_GAZE 60
 #define SKILL_FLARE 61       // New: Ultimate single-target nuke
 
+// Derived combat stats (base + equipment + buffs), rebuilt lazily on read
+typedef struct {
+    uint8_t attack;
+    uint8_t defense;
+    uint8_t intelligence;
+    uint8_t agility;
+    uint8_t luck;
+} DerivedStats;
+
 // Party member structure
 typedef struct PartyMember {
     char name[MAX_NAME_LENGTH];
@@ -151,6 +161,8 @@ typedef struct PartyMember {
     uint8_t buff_count;
     ActiveStatusEffect active_status_effects[MAX_STATUS_EFFECTS_PER_CHARACTER];
     uint8_t status_effect_count;
+    DerivedStats derived;  // Cached totals, see character_calc_total_*
+    bool derived_valid;    // Cleared by equipment, buff and level changes
 } PartyMember;
 
 // Party structure
@@ -171,14 +183,20 @@ void party_heal_all(Party* party);
 
 // Character functions
 void character_init_stats(PartyMember* member, JobType job);
+void character_init_member(PartyMember* member, JobType job, const char* name); // Silent, level 1
 void character_take_damage(PartyMember* member, uint16_t damage);
 void character_heal(PartyMember* member, uint16_t amount);
+bool character_apply_damage(PartyMember* member, uint16_t damage); // Silent; true if defeated
+bool character_apply_heal(PartyMember* member, uint16_t amount);   // Silent; false if dead
 void character_add_status(PartyMember* member, StatusEffect status);
 void character_remove_status(PartyMember* member, StatusEffect status);
 bool character_has_status(PartyMember* member, StatusEffect status);
 void character_use_mp(PartyMember* member, uint16_t mp_cost);
 uint32_t character_get_exp_for_next_level(uint8_t level);
 void character_gain_experience(PartyMember* member, uint32_t exp);
+bool character_try_level_up(PartyMember* member, RandomStream* rng); // Silent; one level if EXP allows
+void character_level_up(PartyMember* member, RandomStream* rng); // Silent stat growth + level skills
+void character_invalidate_stats(PartyMember* member); // Forces the derived stat cache to rebuild
 
 // Job-specific stat tables (base stats at level 1)
 extern const CharacterStats job_base_stats[MAX_JOB_TYPES];
@@ -187,6 +205,7 @@ extern const char* job_names[MAX_JOB_TYPES];
 // Skill/Magic system
 const Skill* get_skill_data(uint8_t skill_id);
 void character_learn_skill(PartyMember* member, uint8_t skill_id);
+bool character_add_skill(PartyMember* member, uint8_t skill_id); // Silent; false if known/full
 bool character_can_use_skill(PartyMember* member, uint8_t skill_id);
 void character_init_starting_skills(PartyMember* member);
 
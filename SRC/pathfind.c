@@ -0,0 +1,196 @@
+#include "pathfind.h"
+#include "dungeon.h"
+#include <string.h>
+
+#define PATHFIND_COST_UNKNOWN 0xFFFF
+
+// Per-node flag byte: direction taken to reach the node plus its A* state
+#define PATHFIND_DIR_MASK 0x03
+#define PATHFIND_OPEN     0x04
+#define PATHFIND_CLOSED   0x08
+
+// Shared by every search (one search runs at a time)
+static struct {
+    uint16_t cost[PATHFIND_MAX_NODES];      // g: steps from the start
+    uint16_t estimate[PATHFIND_MAX_NODES];  // f: g + distance to the nearest goal
+    uint16_t heap[PATHFIND_MAX_NODES];      // Open set, ordered by estimate
+    uint16_t heap_pos[PATHFIND_MAX_NODES];  // Where each open node sits in heap[]
+    uint8_t flags[PATHFIND_MAX_NODES];
+    uint16_t heap_size;
+} pathfind_scratch;
+
+static const int8_t pathfind_dx[4] = { 0, 0, -1, 1 };
+static const int8_t pathfind_dy[4] = { -1, 1, 0, 0 };
+
+// ============================================================================
+// Open set (indexed binary heap)
+// ============================================================================
+
+// Lower estimate first; on ties prefer the node further from the start
+static bool pathfind_heap_before(uint16_t a, uint16_t b) {
+    if (pathfind_scratch.estimate[a] != pathfind_scratch.estimate[b]) {
+        return pathfind_scratch.estimate[a] < pathfind_scratch.estimate[b];
+    }
+    return pathfind_scratch.cost[a] > pathfind_scratch.cost[b];
+}
+
+static void pathfind_heap_place(uint16_t slot, uint16_t node) {
+    pathfind_scratch.heap[slot] = node;
+    pathfind_scratch.heap_pos[node] = slot;
+}
+
+static void pathfind_heap_sift_up(uint16_t slot) {
+    uint16_t node = pathfind_scratch.heap[slot];
+    while (slot > 0) {
+        uint16_t parent = (slot - 1) / 2;
+        if (!pathfind_heap_before(node, pathfind_scratch.heap[parent])) break;
+        pathfind_heap_place(slot, pathfind_scratch.heap[parent]);
+        slot = parent;
+    }
+    pathfind_heap_place(slot, node);
+}
+
+static void pathfind_heap_sift_down(uint16_t slot) {
+    uint16_t node = pathfind_scratch.heap[slot];
+    uint16_t size = pathfind_scratch.heap_size;
+    for (;;) {
+        uint16_t child = slot * 2 + 1;
+        if (child >= size) break;
+        if (child + 1 < size && pathfind_heap_before(pathfind_scratch.heap[child + 1], pathfind_scratch.heap[child])) {
+            child++;
+        }
+        if (!pathfind_heap_before(pathfind_scratch.heap[child], node)) break;
+        pathfind_heap_place(slot, pathfind_scratch.heap[child]);
+        slot = child;
+    }
+    pathfind_heap_place(slot, node);
+}
+
+static void pathfind_heap_push(uint16_t node) {
+    // Each node is in the heap at most once, so PATHFIND_MAX_NODES always fits
+    uint16_t slot = pathfind_scratch.heap_size++;
+    pathfind_heap_place(slot, node);
+    pathfind_heap_sift_up(slot);
+}
+
+static uint16_t pathfind_heap_pop(void) {
+    uint16_t top = pathfind_scratch.heap[0];
+    pathfind_scratch.heap_size--;
+    if (pathfind_scratch.heap_size > 0) {
+        pathfind_heap_place(0, pathfind_scratch.heap[pathfind_scratch.heap_size]);
+        pathfind_heap_sift_down(0);
+    }
+    return top;
+}
+
+// ============================================================================
+// Search
+// ============================================================================
+
+static uint16_t pathfind_heuristic(uint8_t x, uint8_t y, const DungeonMapPoint* goals, uint8_t goal_count) {
+    uint16_t best = PATHFIND_COST_UNKNOWN;
+    for (uint8_t i = 0; i < goal_count; i++) {
+        uint16_t distance = (uint16_t)((x > goals[i].x ? x - goals[i].x : goals[i].x - x) +
+                                       (y > goals[i].y ? y - goals[i].y : goals[i].y - y));
+        if (distance < best) best = distance;
+    }
+    return best;
+}
+
+static bool pathfind_is_goal(uint8_t x, uint8_t y, const DungeonMapPoint* goals, uint8_t goal_count) {
+    for (uint8_t i = 0; i < goal_count; i++) {
+        if (goals[i].x == x && goals[i].y == y) return true;
+    }
+    return false;
+}
+
+// Walks the parent directions back from the goal and writes them start-first
+static void pathfind_build_path(uint16_t start, uint16_t goal, DungeonPath* out) {
+    uint16_t length = pathfind_scratch.cost[goal];
+    uint16_t node = goal;
+
+    out->length = length;
+    while (node != start) {
+        uint8_t direction = pathfind_scratch.flags[node] & PATHFIND_DIR_MASK;
+        out->steps[--length] = direction;
+        node = (uint16_t)(node - pathfind_dy[direction] * DUNGEON_WIDTH - pathfind_dx[direction]);
+    }
+}
+
+bool pathfind_route(const DungeonFloor* floor, uint8_t start_x, uint8_t start_y,
+                    const DungeonMapPoint* goals, uint8_t goal_count, DungeonPath* out) {
+    if (!floor || !goals || !out || goal_count == 0) return false;
+    if (start_x >= floor->width || start_y >= floor->height) return false;
+    if (goal_count > PATHFIND_MAX_GOALS) goal_count = PATHFIND_MAX_GOALS;
+
+    memset(pathfind_scratch.flags, 0, sizeof(pathfind_scratch.flags));
+    pathfind_scratch.heap_size = 0;
+
+    uint16_t start = (uint16_t)start_y * DUNGEON_WIDTH + start_x;
+    pathfind_scratch.cost[start] = 0;
+    pathfind_scratch.estimate[start] = pathfind_heuristic(start_x, start_y, goals, goal_count);
+    pathfind_scratch.flags[start] = PATHFIND_OPEN;
+    pathfind_heap_push(start);
+
+    while (pathfind_scratch.heap_size > 0) {
+        uint16_t node = pathfind_heap_pop();
+        uint8_t x = (uint8_t)(node % DUNGEON_WIDTH);
+        uint8_t y = (uint8_t)(node / DUNGEON_WIDTH);
+
+        if (pathfind_is_goal(x, y, goals, goal_count)) {
+            pathfind_build_path(start, node, out);
+            return true;
+        }
+
+        pathfind_scratch.flags[node] = (uint8_t)((pathfind_scratch.flags[node] & PATHFIND_DIR_MASK) | PATHFIND_CLOSED);
+        uint16_t next_cost = pathfind_scratch.cost[node] + 1;
+
+        for (uint8_t direction = 0; direction < 4; direction++) {
+            int nx = x + pathfind_dx[direction];
+            int ny = y + pathfind_dy[direction];
+            if (nx < 0 || ny < 0 || nx >= floor->width || ny >= floor->height) continue;
+            if (dungeon_floor_get_tile(floor, (uint8_t)nx, (uint8_t)ny) == TILE_WALL) continue;
+
+            uint16_t neighbor = (uint16_t)(ny * DUNGEON_WIDTH + nx);
+            uint8_t state = pathfind_scratch.flags[neighbor];
+            if (state & PATHFIND_CLOSED) continue;
+            if ((state & PATHFIND_OPEN) && next_cost >= pathfind_scratch.cost[neighbor]) continue;
+
+            pathfind_scratch.cost[neighbor] = next_cost;
+            pathfind_scratch.estimate[neighbor] = next_cost + pathfind_heuristic((uint8_t)nx, (uint8_t)ny, goals, goal_count);
+            pathfind_scratch.flags[neighbor] = (uint8_t)(PATHFIND_OPEN | direction);
+
+            if (state & PATHFIND_OPEN) {
+                pathfind_heap_sift_up(pathfind_scratch.heap_pos[neighbor]);
+            } else {
+                pathfind_heap_push(neighbor);
+            }
+        }
+    }
+
+    return false;
+}
+
+bool pathfind_route_to_tile(const DungeonFloor* floor, TileType type, DungeonPath* out) {
+    if (!floor) return false;
+
+    DungeonMapPoint goals[PATHFIND_MAX_GOALS];
+    uint8_t goal_count = 0;
+
+    for (uint8_t y = 0; y < floor->height && goal_count < PATHFIND_MAX_GOALS; y++) {
+        for (uint8_t x = 0; x < floor->width && goal_count < PATHFIND_MAX_GOALS; x++) {
+            if (dungeon_floor_get_tile(floor, x, y) == type) {
+                goals[goal_count].x = x;
+                goals[goal_count].y = y;
+                goal_count++;
+            }
+        }
+    }
+
+    return pathfind_route(floor, floor->player_x, floor->player_y, goals, goal_count, out);
+}
+
+void pathfind_direction_delta(PathDirection direction, int8_t* dx, int8_t* dy) {
+    *dx = pathfind_dx[direction & PATHFIND_DIR_MASK];
+    *dy = pathfind_dy[direction & PATHFIND_DIR_MASK];
+}
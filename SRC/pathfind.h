@@ -0,0 +1,37 @@
+#ifndef PATHFIND_H
+#define PATHFIND_H
+
+#include "game_state.h"
+#include "dungeon_maps.h"
+#include <stdint.h>
+#include <stdbool.h>
+
+// A* over a dungeon floor (4-way moves, unit cost, walls and the floor's
+// width/height respected). The open set is a fixed-capacity indexed binary
+// heap and every search shares one static scratch area - no malloc.
+#define PATHFIND_MAX_NODES (DUNGEON_WIDTH * DUNGEON_HEIGHT)
+#define PATHFIND_MAX_GOALS 16
+
+typedef enum {
+    PATH_DIR_UP = 0,
+    PATH_DIR_DOWN,
+    PATH_DIR_LEFT,
+    PATH_DIR_RIGHT
+} PathDirection;
+
+// A route as one PathDirection per step, starting at the start tile
+typedef struct {
+    uint16_t length;
+    uint8_t steps[PATHFIND_MAX_NODES];
+} DungeonPath;
+
+// Shortest route to whichever goal is nearest; false if none is reachable
+bool pathfind_route(const DungeonFloor* floor, uint8_t start_x, uint8_t start_y,
+                    const DungeonMapPoint* goals, uint8_t goal_count, DungeonPath* out);
+
+// Route from the player to the nearest tile of the given type
+bool pathfind_route_to_tile(const DungeonFloor* floor, TileType type, DungeonPath* out);
+
+void pathfind_direction_delta(PathDirection direction, int8_t* dx, int8_t* dy);
+
+#endif // PATHFIND_H
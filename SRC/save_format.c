@@ -0,0 +1,554 @@
+#include "save_format.h"
+#include <stdio.h>
+#include <string.h>
+
+#define SAVE_TAG(a, b, c, d) ((uint32_t)(a) | ((uint32_t)(b) << 8) | ((uint32_t)(c) << 16) | ((uint32_t)(d) << 24))
+
+#define SAVE_TAG_GAME      SAVE_TAG('G', 'A', 'M', 'E')
+#define SAVE_TAG_PARTY     SAVE_TAG('P', 'R', 'T', 'Y')
+#define SAVE_TAG_DUNGEON   SAVE_TAG('D', 'N', 'G', '0')  // + index in the last byte
+#define SAVE_TAG_INVENTORY SAVE_TAG('I', 'N', 'V', 'T')
+
+// Current version of each chunk; bump one when its layout changes and keep a
+// reader for the old layout in its decode function
+#define SAVE_GAME_CHUNK_VERSION      2
+#define SAVE_PARTY_CHUNK_VERSION     1
+#define SAVE_DUNGEON_CHUNK_VERSION   1
+#define SAVE_INVENTORY_CHUNK_VERSION 1
+
+// ============================================================================
+// Byte order helpers
+// ============================================================================
+
+typedef struct {
+    uint8_t* data;
+    uint32_t pos;
+} SaveWriter;
+
+typedef struct {
+    const uint8_t* data;
+    uint32_t pos;
+    uint32_t size;
+} SaveReader;
+
+static void put_u8(SaveWriter* w, uint8_t value) {
+    w->data[w->pos++] = value;
+}
+
+static void put_u16(SaveWriter* w, uint16_t value) {
+    w->data[w->pos++] = (uint8_t)value;
+    w->data[w->pos++] = (uint8_t)(value >> 8);
+}
+
+static void put_u32(SaveWriter* w, uint32_t value) {
+    put_u16(w, (uint16_t)value);
+    put_u16(w, (uint16_t)(value >> 16));
+}
+
+static void put_bytes(SaveWriter* w, const void* bytes, uint32_t length) {
+    memcpy(w->data + w->pos, bytes, length);
+    w->pos += length;
+}
+
+static uint16_t read_u16_at(const uint8_t* data) {
+    return (uint16_t)(data[0] | (data[1] << 8));
+}
+
+static uint32_t read_u32_at(const uint8_t* data) {
+    return (uint32_t)read_u16_at(data) | ((uint32_t)read_u16_at(data + 2) << 16);
+}
+
+// Callers check the chunk length first, so reads never run past it
+static uint8_t get_u8(SaveReader* r) {
+    return r->data[r->pos++];
+}
+
+static uint16_t get_u16(SaveReader* r) {
+    uint16_t value = read_u16_at(r->data + r->pos);
+    r->pos += 2;
+    return value;
+}
+
+static uint32_t get_u32(SaveReader* r) {
+    uint32_t value = read_u32_at(r->data + r->pos);
+    r->pos += 4;
+    return value;
+}
+
+static void get_bytes(SaveReader* r, void* bytes, uint32_t length) {
+    memcpy(bytes, r->data + r->pos, length);
+    r->pos += length;
+}
+
+// Names are fixed-width on disk; force the terminator on the way back in
+static void get_name(SaveReader* r, char* name) {
+    get_bytes(r, name, MAX_NAME_LENGTH);
+    name[MAX_NAME_LENGTH - 1] = '\0';
+}
+
+// CRC-32 (IEEE), a nibble at a time to keep the table small
+uint32_t save_format_crc32(const uint8_t* data, uint32_t length) {
+    static const uint32_t nibble_table[16] = {
+        0x00000000, 0x1DB71064, 0x3B6E20C8, 0x26D930AC, 0x76DC4190, 0x6B6B51F4, 0x4DB26158, 0x5005713C,
+        0xEDB88320, 0xF00F9344, 0xD6D6A3E8, 0xCB61B38C, 0x9B64C2B0, 0x86D3D2D4, 0xA00AE278, 0xBDBDF21C
+    };
+    uint32_t crc = 0xFFFFFFFF;
+
+    for (uint32_t i = 0; i < length; i++) {
+        crc ^= data[i];
+        crc = (crc >> 4) ^ nibble_table[crc & 0x0F];
+        crc = (crc >> 4) ^ nibble_table[crc & 0x0F];
+    }
+    return ~crc;
+}
+
+// ============================================================================
+// Chunk encoders
+// ============================================================================
+
+static uint8_t pack_flags(const bool* flags, uint8_t count) {
+    uint8_t bits = 0;
+    for (uint8_t i = 0; i < count; i++) {
+        if (flags[i]) bits |= (uint8_t)(1 << i);
+    }
+    return bits;
+}
+
+static void unpack_flags(uint8_t bits, bool* flags, uint8_t count) {
+    for (uint8_t i = 0; i < count; i++) {
+        flags[i] = (bits >> i) & 1;
+    }
+}
+
+static void encode_game(SaveWriter* w, const SaveData* save_data) {
+    put_u8(w, (uint8_t)save_data->current_state);
+    put_u8(w, save_data->current_dungeon_index);
+    put_u8(w, pack_flags(save_data->dungeon_initialized, MAX_DUNGEONS + 1));
+    put_u8(w, pack_flags(save_data->dungeons_completed, MAX_DUNGEONS));
+    put_u8(w, save_data->final_dungeon_unlocked);
+    put_u8(w, save_data->key_items_collected);
+    put_u16(w, save_data->gold);
+    put_u32(w, save_data->game_time);
+    put_u8(w, save_data->world_x);
+    put_u8(w, save_data->world_y);
+    put_u8(w, save_data->world_encounter_steps);
+    put_u8(w, (uint8_t)save_data->hub_state);
+}
+
+static void encode_party(SaveWriter* w, const SaveData* save_data) {
+    uint8_t count = save_data->party_data.member_count;
+    if (count > MAX_PARTY_SIZE) count = MAX_PARTY_SIZE;
+
+    put_u8(w, count);
+    for (uint8_t i = 0; i < count; i++) {
+        const SaveMemberData* member = &save_data->party_data.members[i];
+        put_bytes(w, member->name, MAX_NAME_LENGTH);
+        put_u8(w, (uint8_t)member->job);
+        put_u8(w, member->level);
+        put_u32(w, member->experience);
+        put_u16(w, member->max_hp);
+        put_u16(w, member->current_hp);
+        put_u16(w, member->max_mp);
+        put_u16(w, member->current_mp);
+        put_u8(w, member->attack);
+        put_u8(w, member->defense);
+        put_u8(w, member->intelligence);
+        put_u8(w, member->agility);
+        put_u8(w, member->luck);
+        put_u8(w, member->skill_count);
+        put_bytes(w, member->skills, MAX_SKILLS);
+        put_bytes(w, member->equipped_items, EQUIP_SLOT_COUNT);
+        put_u8(w, member->status_effects);
+    }
+}
+
+static void encode_dungeon(SaveWriter* w, const SaveData* save_data, uint8_t index) {
+    const SaveDungeonData* dungeon = &save_data->dungeon_data[index];
+    put_u8(w, dungeon->current_floor);
+    put_u8(w, dungeon->player_x);
+    put_u8(w, dungeon->player_y);
+    put_u8(w, dungeon->encounter_steps);
+    put_u8(w, dungeon->boss_defeated);
+    put_u8(w, dungeon->completed);
+    put_u8(w, dungeon->floors_loaded);
+    put_bytes(w, dungeon->explored_tiles, DUNGEON_EXPLORED_BYTES);
+    put_bytes(w, dungeon->treasure_collected, DUNGEON_EXPLORED_BYTES);
+}
+
+static void encode_inventory(SaveWriter* w, const SaveData* save_data) {
+    uint8_t item_count = save_data->inventory_data.item_count;
+    uint8_t equipment_count = save_data->inventory_data.equipment_count;
+    if (item_count > MAX_INVENTORY_ITEMS) item_count = MAX_INVENTORY_ITEMS;
+    if (equipment_count > MAX_EQUIPMENT_SLOTS) equipment_count = MAX_EQUIPMENT_SLOTS;
+
+    put_u8(w, item_count);
+    for (uint8_t i = 0; i < item_count; i++) {
+        put_u8(w, save_data->inventory_data.items[i].item_id);
+        put_u8(w, save_data->inventory_data.items[i].quantity);
+        put_bytes(w, save_data->inventory_data.items[i].name, MAX_NAME_LENGTH);
+    }
+
+    put_u8(w, equipment_count);
+    for (uint8_t i = 0; i < equipment_count; i++) {
+        const SaveEquipmentData* equip = &save_data->inventory_data.equipment[i];
+        put_u8(w, equip->equipment_id);
+        put_u8(w, (uint8_t)equip->slot);
+        put_u8(w, equip->attack_bonus);
+        put_u8(w, equip->defense_bonus);
+        put_u8(w, equip->intelligence_bonus);
+        put_u8(w, equip->agility_bonus);
+        put_u8(w, equip->is_equipped);
+        put_bytes(w, equip->name, MAX_NAME_LENGTH);
+    }
+}
+
+// ============================================================================
+// Chunk decoders (one case per chunk version still readable)
+// ============================================================================
+
+static bool decode_game(SaveReader* r, uint16_t version, SaveData* save_data) {
+    switch (version) {
+        case 1:   // Before the overworld position was kept
+        case 2:
+            if (r->size != (version == 1 ? SAVE_GAME_CHUNK_V1_SIZE : SAVE_GAME_CHUNK_SIZE)) return false;
+            save_data->current_state = (GameState)get_u8(r);
+            save_data->current_dungeon_index = get_u8(r);
+            unpack_flags(get_u8(r), save_data->dungeon_initialized, MAX_DUNGEONS + 1);
+            unpack_flags(get_u8(r), save_data->dungeons_completed, MAX_DUNGEONS);
+            save_data->final_dungeon_unlocked = get_u8(r) != 0;
+            save_data->key_items_collected = get_u8(r);
+            save_data->gold = get_u16(r);
+            save_data->game_time = get_u32(r);
+            if (version == 1) {
+                save_data_default_world(save_data);
+                return true;
+            }
+            save_data->world_x = get_u8(r);
+            save_data->world_y = get_u8(r);
+            save_data->world_encounter_steps = get_u8(r);
+            save_data->hub_state = (GameState)get_u8(r);
+            return true;
+        default:
+            return false;
+    }
+}
+
+static bool decode_party(SaveReader* r, uint16_t version, SaveData* save_data) {
+    switch (version) {
+        case 1: {
+            if (r->size < 1) return false;
+            uint8_t count = get_u8(r);
+            if (count > MAX_PARTY_SIZE || r->size != 1 + (uint32_t)count * SAVE_MEMBER_RECORD_SIZE) return false;
+
+            save_data->party_data.member_count = count;
+            for (uint8_t i = 0; i < count; i++) {
+                SaveMemberData* member = &save_data->party_data.members[i];
+                get_name(r, member->name);
+                member->job = (JobType)get_u8(r);
+                member->level = get_u8(r);
+                member->experience = get_u32(r);
+                member->max_hp = get_u16(r);
+                member->current_hp = get_u16(r);
+                member->max_mp = get_u16(r);
+                member->current_mp = get_u16(r);
+                member->attack = get_u8(r);
+                member->defense = get_u8(r);
+                member->intelligence = get_u8(r);
+                member->agility = get_u8(r);
+                member->luck = get_u8(r);
+                member->skill_count = get_u8(r);
+                get_bytes(r, member->skills, MAX_SKILLS);
+                get_bytes(r, member->equipped_items, EQUIP_SLOT_COUNT);
+                member->status_effects = get_u8(r);
+                if (member->skill_count > MAX_SKILLS) member->skill_count = MAX_SKILLS;
+            }
+            return true;
+        }
+        default:
+            return false;
+    }
+}
+
+static bool decode_dungeon(SaveReader* r, uint16_t version, SaveData* save_data, uint8_t index) {
+    switch (version) {
+        case 1: {
+            if (r->size != SAVE_DUNGEON_CHUNK_SIZE) return false;
+            SaveDungeonData* dungeon = &save_data->dungeon_data[index];
+            dungeon->current_floor = get_u8(r);
+            dungeon->player_x = get_u8(r);
+            dungeon->player_y = get_u8(r);
+            dungeon->encounter_steps = get_u8(r);
+            dungeon->boss_defeated = get_u8(r) != 0;
+            dungeon->completed = get_u8(r) != 0;
+            dungeon->floors_loaded = get_u8(r);
+            get_bytes(r, dungeon->explored_tiles, DUNGEON_EXPLORED_BYTES);
+            get_bytes(r, dungeon->treasure_collected, DUNGEON_EXPLORED_BYTES);
+            return true;
+        }
+        default:
+            return false;
+    }
+}
+
+static bool decode_inventory(SaveReader* r, uint16_t version, SaveData* save_data) {
+    switch (version) {
+        case 1: {
+            if (r->size < 2) return false;
+            uint8_t item_count = get_u8(r);
+            if (item_count > MAX_INVENTORY_ITEMS) return false;
+            uint32_t equipment_at = 1 + (uint32_t)item_count * SAVE_ITEM_RECORD_SIZE;
+            if (r->size <= equipment_at) return false;
+            uint8_t equipment_count = r->data[equipment_at];
+            if (equipment_count > MAX_EQUIPMENT_SLOTS ||
+                r->size != equipment_at + 1 + (uint32_t)equipment_count * SAVE_EQUIPMENT_RECORD_SIZE) {
+                return false;
+            }
+
+            save_data->inventory_data.item_count = item_count;
+            for (uint8_t i = 0; i < item_count; i++) {
+                save_data->inventory_data.items[i].item_id = get_u8(r);
+                save_data->inventory_data.items[i].quantity = get_u8(r);
+                get_name(r, save_data->inventory_data.items[i].name);
+            }
+
+            save_data->inventory_data.equipment_count = get_u8(r);
+            for (uint8_t i = 0; i < equipment_count; i++) {
+                SaveEquipmentData* equip = &save_data->inventory_data.equipment[i];
+                equip->equipment_id = get_u8(r);
+                equip->slot = (EquipmentSlot)get_u8(r);
+                equip->attack_bonus = get_u8(r);
+                equip->defense_bonus = get_u8(r);
+                equip->intelligence_bonus = get_u8(r);
+                equip->agility_bonus = get_u8(r);
+                equip->is_equipped = get_u8(r) != 0;
+                get_name(r, equip->name);
+            }
+            return true;
+        }
+        default:
+            return false;
+    }
+}
+
+// ============================================================================
+// Image build / parse
+// ============================================================================
+
+void save_format_build(SaveImage* image, const SaveData* save_data) {
+    uint32_t tags[SAVE_SECTION_COUNT];
+    uint16_t versions[SAVE_SECTION_COUNT];
+    uint32_t offsets[SAVE_SECTION_COUNT];
+    uint32_t lengths[SAVE_SECTION_COUNT];
+    uint8_t chunk_count = 0;
+
+    // Payloads first, after room for the TOC; every chunk is present except
+    // dungeons that were never entered
+    uint8_t present = 0;
+    for (uint8_t section = 0; section < SAVE_SECTION_COUNT; section++) {
+        bool is_dungeon = section >= SAVE_SECTION_DUNGEON && section < SAVE_SECTION_INVENTORY;
+        if (!is_dungeon || save_data->dungeon_initialized[section - SAVE_SECTION_DUNGEON]) present++;
+    }
+
+    SaveWriter w = { image->bytes, SAVE_FORMAT_HEADER_SIZE + (uint32_t)present * SAVE_FORMAT_ENTRY_SIZE };
+
+    for (uint8_t section = 0; section < SAVE_SECTION_COUNT; section++) {
+        uint32_t start = w.pos;
+
+        if (section == SAVE_SECTION_GAME) {
+            tags[chunk_count] = SAVE_TAG_GAME;
+            versions[chunk_count] = SAVE_GAME_CHUNK_VERSION;
+            encode_game(&w, save_data);
+        } else if (section == SAVE_SECTION_PARTY) {
+            tags[chunk_count] = SAVE_TAG_PARTY;
+            versions[chunk_count] = SAVE_PARTY_CHUNK_VERSION;
+            encode_party(&w, save_data);
+        } else if (section == SAVE_SECTION_INVENTORY) {
+            tags[chunk_count] = SAVE_TAG_INVENTORY;
+            versions[chunk_count] = SAVE_INVENTORY_CHUNK_VERSION;
+            encode_inventory(&w, save_data);
+        } else {
+            uint8_t index = (uint8_t)(section - SAVE_SECTION_DUNGEON);
+            if (!save_data->dungeon_initialized[index]) continue;
+            tags[chunk_count] = SAVE_TAG_DUNGEON + ((uint32_t)index << 24);
+            versions[chunk_count] = SAVE_DUNGEON_CHUNK_VERSION;
+            encode_dungeon(&w, save_data, index);
+        }
+
+        offsets[chunk_count] = start;
+        lengths[chunk_count] = w.pos - start;
+        chunk_count++;
+    }
+    image->size = w.pos;
+
+    // Then the TOC, and the header that covers it
+    w.pos = SAVE_FORMAT_HEADER_SIZE;
+    for (uint8_t i = 0; i < chunk_count; i++) {
+        put_u32(&w, tags[i]);
+        put_u16(&w, versions[i]);
+        put_u16(&w, 0);
+        put_u32(&w, offsets[i]);
+        put_u32(&w, lengths[i]);
+        put_u32(&w, save_format_crc32(image->bytes + offsets[i], lengths[i]));
+    }
+
+    w.pos = 0;
+    put_u32(&w, SAVE_MAGIC);
+    put_u16(&w, SAVE_FORMAT_VERSION);
+    put_u16(&w, chunk_count);
+    put_u32(&w, save_format_crc32(image->bytes + SAVE_FORMAT_HEADER_SIZE, (uint32_t)chunk_count * SAVE_FORMAT_ENTRY_SIZE));
+
+    SavePreview preview;
+    save_format_preview(save_data, &preview);
+    put_u8(&w, (uint8_t)preview.state);
+    put_u8(&w, preview.dungeon_index);
+    put_u8(&w, preview.party_level);
+    put_u8(&w, preview.member_count);
+    put_u16(&w, preview.gold);
+    put_u16(&w, 0);
+    put_u32(&w, preview.game_time);
+    put_u32(&w, save_format_crc32(image->bytes + SAVE_PREVIEW_OFFSET, SAVE_PREVIEW_SIZE - 4));
+}
+
+void save_format_preview(const SaveData* save_data, SavePreview* preview) {
+    preview->state = save_data->current_state;
+    preview->dungeon_index = save_data->current_dungeon_index;
+    preview->member_count = save_data->party_data.member_count;
+    preview->party_level = preview->member_count > 0 ? save_data->party_data.members[0].level : 1;
+    preview->gold = save_data->gold;
+    preview->game_time = save_data->game_time;
+}
+
+bool save_format_read_preview(const uint8_t* header, uint32_t size, SavePreview* preview) {
+    if (size < SAVE_FORMAT_HEADER_SIZE || read_u32_at(header) != SAVE_MAGIC ||
+        read_u16_at(header + 4) != SAVE_FORMAT_VERSION) {
+        return false;
+    }
+
+    const uint8_t* data = header + SAVE_PREVIEW_OFFSET;
+    if (save_format_crc32(data, SAVE_PREVIEW_SIZE - 4) != read_u32_at(data + 12)) return false;
+
+    preview->state = (GameState)data[0];
+    preview->dungeon_index = data[1];
+    preview->party_level = data[2];
+    preview->member_count = data[3];
+    preview->gold = read_u16_at(data + 4);
+    preview->game_time = read_u32_at(data + 8);
+    return true;
+}
+
+uint16_t save_format_header_version(const uint8_t* header, uint32_t size) {
+    if (size < SAVE_FORMAT_ID_SIZE || read_u32_at(header) != SAVE_MAGIC) return 0;
+    return read_u16_at(header + 4);
+}
+
+// Version 1 wrote the SaveData struct as it sat in memory, before dungeons had
+// a floors_loaded mask; this build lays SaveDataV1 out the same way, so the
+// bytes are taken as they are and upgraded field by field
+static bool save_format_parse_v1(const SaveImage* image, SaveData* save_data) {
+    if (image->size != sizeof(SaveDataV1)) {
+        printf("Error: Save file corrupted (truncated)\n");
+        return false;
+    }
+    SaveDataV1 old_data;
+    memcpy(&old_data, image->bytes, sizeof(SaveDataV1));
+    return save_data_from_v1(&old_data, save_data);
+}
+
+bool save_format_parse(const SaveImage* image, SaveData* save_data) {
+    const uint8_t* data = image->bytes;
+
+    if (image->size < SAVE_FORMAT_ID_SIZE || read_u32_at(data) != SAVE_MAGIC) {
+        printf("Error: Invalid save file (bad magic number)\n");
+        return false;
+    }
+
+    // Version 1 files start with two 32-bit fields, magic and version
+    uint16_t format_version = read_u16_at(data + 4);
+    if (format_version == SAVE_DATA_V1_VERSION && read_u16_at(data + 6) == 0) {
+        return save_format_parse_v1(image, save_data);
+    }
+    if (format_version > SAVE_FORMAT_VERSION) {
+        printf("Error: Save file is from a newer version of the game\n");
+        return false;
+    }
+    if (format_version != SAVE_FORMAT_VERSION || image->size < SAVE_FORMAT_HEADER_SIZE) {
+        printf("Error: Save file version mismatch\n");
+        return false;
+    }
+
+    // The preview only summarizes the chunks; loading ignores it
+    uint32_t toc_offset = SAVE_FORMAT_HEADER_SIZE;
+    uint16_t chunk_count = read_u16_at(data + 6);
+    uint32_t toc_size = (uint32_t)chunk_count * SAVE_FORMAT_ENTRY_SIZE;
+    if (toc_offset + toc_size > image->size ||
+        save_format_crc32(data + toc_offset, toc_size) != read_u32_at(data + 8)) {
+        printf("Error: Save file corrupted (table of contents)\n");
+        return false;
+    }
+
+    memset(save_data, 0, sizeof(SaveData));
+    bool has_game = false;
+    bool has_party = false;
+
+    for (uint16_t i = 0; i < chunk_count; i++) {
+        const uint8_t* entry = data + toc_offset + (uint32_t)i * SAVE_FORMAT_ENTRY_SIZE;
+        uint32_t tag = read_u32_at(entry);
+        uint16_t version = read_u16_at(entry + 4);
+        uint32_t offset = read_u32_at(entry + 8);
+        uint32_t length = read_u32_at(entry + 12);
+
+        if (offset > image->size || length > image->size - offset ||
+            save_format_crc32(data + offset, length) != read_u32_at(entry + 16)) {
+            printf("Error: Save file corrupted (checksum mismatch)\n");
+            return false;
+        }
+
+        SaveReader r = { data + offset, 0, length };
+        uint32_t dungeon_index = (tag - SAVE_TAG_DUNGEON) >> 24;
+        bool decoded;
+
+        if (tag == SAVE_TAG_GAME) {
+            decoded = decode_game(&r, version, save_data);
+            has_game = decoded;
+        } else if (tag == SAVE_TAG_PARTY) {
+            decoded = decode_party(&r, version, save_data);
+            has_party = decoded;
+        } else if (tag == SAVE_TAG_INVENTORY) {
+            decoded = decode_inventory(&r, version, save_data);
+        } else if ((tag & 0x00FFFFFF) == (SAVE_TAG_DUNGEON & 0x00FFFFFF) && dungeon_index <= MAX_DUNGEONS) {
+            decoded = decode_dungeon(&r, version, save_data, (uint8_t)dungeon_index);
+        } else {
+            continue; // Written by a newer game; nothing here needs it
+        }
+
+        if (!decoded) {
+            printf("Error: Save file has an unreadable section (version %d)\n", version);
+            return false;
+        }
+    }
+
+    if (!has_game || !has_party) {
+        printf("Error: Save file corrupted (missing sections)\n");
+        return false;
+    }
+
+    // Chunks carry their own checksums; stamp the header load_data_to_game_state checks
+    save_data->magic = SAVE_MAGIC;
+    save_data->version = SAVE_DATA_VERSION;
+    save_data->checksum = calculate_checksum(save_data);
+    return true;
+}
+
+uint32_t save_format_toc_size(const SaveImage* image) {
+    if (image->size < SAVE_FORMAT_HEADER_SIZE) return 0;
+    return SAVE_FORMAT_HEADER_SIZE + (uint32_t)read_u16_at(image->bytes + 6) * SAVE_FORMAT_ENTRY_SIZE;
+}
+
+bool save_format_chunk(const SaveImage* image, uint8_t index, uint32_t* offset, uint32_t* length) {
+    if (image->size < SAVE_FORMAT_HEADER_SIZE || index >= read_u16_at(image->bytes + 6)) return false;
+
+    const uint8_t* entry = image->bytes + SAVE_FORMAT_HEADER_SIZE + (uint32_t)index * SAVE_FORMAT_ENTRY_SIZE;
+    *offset = read_u32_at(entry + 8);
+    *length = read_u32_at(entry + 12);
+    return true;
+}
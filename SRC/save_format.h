@@ -0,0 +1,84 @@
+#ifndef SAVE_FORMAT_H
+#define SAVE_FORMAT_H
+
+#include "save_system.h"
+#include <stdint.h>
+#include <stdbool.h>
+
+// Chunked save file (format version 4)
+// A file is a header, a table of contents and the chunk payloads:
+//   header  magic u32 | format version u16 | chunk count u16 | TOC CRC-32 u32 | preview
+//   preview state u8 | dungeon u8 | level u8 | members u8 | gold u16 | reserved u16 |
+//           game time u32 | CRC-32 u32
+//   entry   tag u32 | chunk version u16 | reserved u16 | offset u32 | length u32 | CRC-32 u32
+// Every field is little-endian and written one at a time, so the bytes do not
+// depend on struct padding or enum sizes. Each SaveData section is a chunk with
+// its own version: older chunk versions are migrated as they are read, unknown
+// tags are skipped, and dungeons never entered get no chunk at all. The
+// preview is all a save menu needs, so listing a slot reads only the header.
+// The first release's version 1 files (one raw SaveDataV1) are still read and
+// upgraded; versions 2 and 3 were never released.
+#define SAVE_FORMAT_VERSION 4
+#define SAVE_FORMAT_ID_SIZE 8        // Magic and version, the bytes every save file starts with
+#define SAVE_FORMAT_HEADER_SIZE 28   // Through the preview
+#define SAVE_PREVIEW_OFFSET 12
+#define SAVE_PREVIEW_SIZE 16
+#define SAVE_FORMAT_ENTRY_SIZE 20
+
+typedef enum {
+    SAVE_SECTION_GAME,
+    SAVE_SECTION_PARTY,
+    SAVE_SECTION_DUNGEON,     // One per dungeon: SAVE_SECTION_DUNGEON + index
+    SAVE_SECTION_INVENTORY = SAVE_SECTION_DUNGEON + MAX_DUNGEONS + 1,
+    SAVE_SECTION_COUNT
+} SaveSection;
+
+// Payload sizes of the current chunk versions
+#define SAVE_GAME_CHUNK_SIZE 16
+#define SAVE_GAME_CHUNK_V1_SIZE 12
+#define SAVE_MEMBER_RECORD_SIZE (MAX_NAME_LENGTH + 21 + MAX_SKILLS + EQUIP_SLOT_COUNT)
+#define SAVE_PARTY_CHUNK_MAX (1 + MAX_PARTY_SIZE * SAVE_MEMBER_RECORD_SIZE)
+#define SAVE_DUNGEON_CHUNK_SIZE (7 + 2 * DUNGEON_EXPLORED_BYTES)
+#define SAVE_ITEM_RECORD_SIZE (2 + MAX_NAME_LENGTH)
+#define SAVE_EQUIPMENT_RECORD_SIZE (7 + MAX_NAME_LENGTH)
+#define SAVE_INVENTORY_CHUNK_MAX (2 + MAX_INVENTORY_ITEMS * SAVE_ITEM_RECORD_SIZE + \
+                                  MAX_EQUIPMENT_SLOTS * SAVE_EQUIPMENT_RECORD_SIZE)
+
+#define SAVE_IMAGE_MAX_SIZE (SAVE_FORMAT_HEADER_SIZE + SAVE_SECTION_COUNT * SAVE_FORMAT_ENTRY_SIZE + \
+                             SAVE_GAME_CHUNK_SIZE + SAVE_PARTY_CHUNK_MAX + SAVE_INVENTORY_CHUNK_MAX + \
+                             (MAX_DUNGEONS + 1) * SAVE_DUNGEON_CHUNK_SIZE)
+
+// Large enough for either format as it sits on disk
+#define SAVE_IMAGE_CAPACITY (SAVE_IMAGE_MAX_SIZE > sizeof(SaveDataV1) ? SAVE_IMAGE_MAX_SIZE : sizeof(SaveDataV1))
+
+typedef struct {
+    uint32_t size;
+    uint8_t bytes[SAVE_IMAGE_CAPACITY];
+} SaveImage;
+
+// Serializes the save data (header, TOC, then chunks in SaveSection order)
+void save_format_build(SaveImage* image, const SaveData* save_data);
+
+// Decodes a file image of either format into save data ready for
+// load_data_to_game_state; false (with a message) if it is damaged or too new
+bool save_format_parse(const SaveImage* image, SaveData* save_data);
+
+// Header plus table of contents: the bytes that change whenever any chunk does
+uint32_t save_format_toc_size(const SaveImage* image);
+
+// Menu summary of the save data, as stored in the header
+void save_format_preview(const SaveData* save_data, SavePreview* preview);
+
+// Decodes the preview from the first SAVE_FORMAT_HEADER_SIZE bytes of a file;
+// false if the header has none (older format) or it is damaged
+bool save_format_read_preview(const uint8_t* header, uint32_t size, SavePreview* preview);
+
+// Format version named by a file header (1 for a first-release file); 0 if it is not a save file
+uint16_t save_format_header_version(const uint8_t* header, uint32_t size);
+
+// Location of the index-th chunk of a built image
+bool save_format_chunk(const SaveImage* image, uint8_t index, uint32_t* offset, uint32_t* length);
+
+uint32_t save_format_crc32(const uint8_t* data, uint32_t length);
+
+#endif // SAVE_FORMAT_H
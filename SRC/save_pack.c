@@ -0,0 +1,592 @@
+#include "save_pack.h"
+#include "save_format.h"
+#include "inventory.h"
+#include "utils.h"
+#include <stdio.h>
+#include <string.h>
+
+#define PACK_BITSET_BITS (DUNGEON_WIDTH * DUNGEON_HEIGHT)
+#define PACK_ROW_BYTES (DUNGEON_WIDTH / 8)
+
+// How a dungeon bitset is stored
+typedef enum {
+    PACK_BITSET_RAW = 0,
+    PACK_BITSET_RUNS,      // Runs of equal bits
+    PACK_BITSET_ROW_RUNS   // Runs over each row XOR the row above (rooms become edges)
+} PackBitsetMode;
+
+// The worst case must fit the bank (fails to compile otherwise)
+typedef char save_pack_fits_sram[SAVE_PACK_MAX_SIZE <= SAVE_SRAM_SIZE ? 1 : -1];
+
+// ============================================================================
+// Bitstream
+// ============================================================================
+
+typedef struct {
+    uint8_t* data;   // Zeroed before the first write
+    uint32_t bit;
+} PackWriter;
+
+typedef struct {
+    const uint8_t* data;
+    uint32_t bit;
+    uint32_t bits;
+    bool damaged;    // Read past the end or found an impossible code
+} PackReader;
+
+static void put_bits(PackWriter* w, uint32_t value, uint8_t count) {
+    while (count > 0) {
+        uint8_t shift = w->bit & 7;
+        uint8_t take = (uint8_t)(8 - shift);
+        if (take > count) take = count;
+
+        w->data[w->bit >> 3] |= (uint8_t)((value & ((1u << take) - 1)) << shift);
+        value >>= take;
+        w->bit += take;
+        count -= take;
+    }
+}
+
+static uint32_t get_bits(PackReader* r, uint8_t count) {
+    if (r->bit + count > r->bits) {
+        r->damaged = true;
+        r->bit = r->bits;
+        return 0;
+    }
+
+    uint32_t value = 0;
+    uint8_t done = 0;
+    while (done < count) {
+        uint8_t shift = r->bit & 7;
+        uint8_t take = (uint8_t)(8 - shift);
+        if (take > count - done) take = (uint8_t)(count - done);
+
+        value |= (uint32_t)((r->data[r->bit >> 3] >> shift) & ((1u << take) - 1)) << done;
+        r->bit += take;
+        done += take;
+    }
+    return value;
+}
+
+// Values below the all-ones code fit in `bits`; the rest escape to full width
+static void put_small(PackWriter* w, uint32_t value, uint8_t bits, uint8_t full_bits) {
+    uint32_t escape = (1u << bits) - 1;
+    if (value < escape) {
+        put_bits(w, value, bits);
+    } else {
+        put_bits(w, escape, bits);
+        put_bits(w, value, full_bits);
+    }
+}
+
+static uint32_t get_small(PackReader* r, uint8_t bits, uint8_t full_bits) {
+    uint32_t value = get_bits(r, bits);
+    return value == (1u << bits) - 1 ? get_bits(r, full_bits) : value;
+}
+
+// Bit length (in length_bits), then that many bits: for totals that are
+// usually far below their type's range
+static void put_sized(PackWriter* w, uint32_t value, uint8_t length_bits) {
+    uint8_t length = 0;
+    while (length < 32 && (value >> length) != 0) length++;
+
+    put_bits(w, length, length_bits);
+    put_bits(w, value, length);
+}
+
+static uint32_t get_sized(PackReader* r, uint8_t length_bits, uint8_t max_length) {
+    uint8_t length = (uint8_t)get_bits(r, length_bits);
+    if (length > max_length) {
+        r->damaged = true;
+        return 0;
+    }
+    return get_bits(r, length);
+}
+
+// Plain names (7-bit text, zero after the terminator) store a length and
+// their characters; anything else is kept byte for byte
+static void put_name(PackWriter* w, const char* name) {
+    uint8_t length = 0;
+    while (length < MAX_NAME_LENGTH && name[length] != '\0') length++;
+
+    bool plain = length < MAX_NAME_LENGTH;
+    for (uint8_t i = 0; i < MAX_NAME_LENGTH && plain; i++) {
+        uint8_t c = (uint8_t)name[i];
+        if (i < length ? c >= 0x80 : c != 0) plain = false;
+    }
+
+    put_bits(w, plain, 1);
+    if (plain) {
+        put_bits(w, length, 4);
+        for (uint8_t i = 0; i < length; i++) put_bits(w, (uint8_t)name[i], 7);
+    } else {
+        for (uint8_t i = 0; i < MAX_NAME_LENGTH; i++) put_bits(w, (uint8_t)name[i], 8);
+    }
+}
+
+static void get_name(PackReader* r, char* name) {
+    if (get_bits(r, 1)) {
+        uint8_t length = (uint8_t)get_bits(r, 4);
+        if (length >= MAX_NAME_LENGTH) {
+            r->damaged = true;
+            return;
+        }
+        for (uint8_t i = 0; i < length; i++) name[i] = (char)get_bits(r, 7);
+    } else {
+        for (uint8_t i = 0; i < MAX_NAME_LENGTH; i++) name[i] = (char)get_bits(r, 8);
+    }
+}
+
+// ============================================================================
+// Dungeon bitsets
+// ============================================================================
+
+// Bits from start on that equal value: four bytes at a time where they all
+// match, then a byte at a time
+static uint16_t pack_run_length(const uint8_t* bits, uint16_t start, uint8_t value) {
+    uint8_t fill = value ? 0xFF : 0x00;
+    uint32_t fill_word = value ? 0xFFFFFFFFu : 0;
+    uint16_t i = start;
+
+    while (i < PACK_BITSET_BITS) {
+        if ((i & 31) == 0) {
+            uint32_t word;
+            memcpy(&word, bits + (i >> 3), sizeof(word));
+            if (word == fill_word) {
+                i += 32;
+                continue;
+            }
+        }
+
+        uint8_t differ = (uint8_t)((bits[i >> 3] ^ fill) >> (i & 7));
+        if (differ) {
+            i += (uint16_t)__builtin_ctz(differ);
+            break;
+        }
+        i = (uint16_t)((i | 7) + 1);
+    }
+    return (uint16_t)(i - start);
+}
+
+static uint8_t pack_log2(uint16_t n) {
+    uint8_t k = 0;
+    while (n >> (k + 1)) k++;
+    return k;
+}
+
+// A run of n is k zeros, a one, then the low k bits of n (k = log2 n)
+static void put_run(PackWriter* w, uint16_t n) {
+    uint8_t k = pack_log2(n);
+    put_bits(w, 1u << k, (uint8_t)(k + 1));
+    put_bits(w, n, k);
+}
+
+static uint16_t get_run(PackReader* r) {
+    uint8_t k = 0;
+    while (!get_bits(r, 1)) {
+        if (r->damaged || (1u << ++k) > PACK_BITSET_BITS) {
+            r->damaged = true;
+            return 0;
+        }
+    }
+    return (uint16_t)((1u << k) | get_bits(r, k));
+}
+
+// Bits put_runs would write for the set
+static uint32_t pack_runs_cost(const uint8_t* bits) {
+    uint32_t cost = 1;
+    uint8_t value = bits[0] & 1;
+
+    for (uint16_t i = 0; i < PACK_BITSET_BITS; value ^= 1) {
+        uint16_t run = pack_run_length(bits, i, value);
+        cost += 2u * pack_log2(run) + 1;
+        i += run;
+    }
+    return cost;
+}
+
+// The first bit, then the length of every run in turn
+static void put_runs(PackWriter* w, const uint8_t* bits) {
+    uint8_t value = bits[0] & 1;
+    put_bits(w, value, 1);
+
+    for (uint16_t i = 0; i < PACK_BITSET_BITS; value ^= 1) {
+        uint16_t run = pack_run_length(bits, i, value);
+        put_run(w, run);
+        i += run;
+    }
+}
+
+static void pack_fill_ones(uint8_t* bits, uint16_t start, uint16_t count) {
+    uint16_t end = (uint16_t)(start + count);
+
+    for (; start < end && (start & 7); start++) bits[start >> 3] |= (uint8_t)(1 << (start & 7));
+    for (; start + 8 <= end; start += 8) bits[start >> 3] = 0xFF;
+    for (; start < end; start++) bits[start >> 3] |= (uint8_t)(1 << (start & 7));
+}
+
+static void put_bitset(PackWriter* w, const uint8_t* bits) {
+    static uint8_t rows[DUNGEON_EXPLORED_BYTES];
+    memcpy(rows, bits, PACK_ROW_BYTES);
+    for (uint16_t i = PACK_ROW_BYTES; i < DUNGEON_EXPLORED_BYTES; i++) {
+        rows[i] = bits[i] ^ bits[i - PACK_ROW_BYTES];
+    }
+
+    uint32_t runs = pack_runs_cost(bits);
+    uint32_t row_runs = pack_runs_cost(rows);
+
+    if (runs <= row_runs && runs < PACK_BITSET_BITS) {
+        put_bits(w, PACK_BITSET_RUNS, 2);
+        put_runs(w, bits);
+    } else if (row_runs < PACK_BITSET_BITS) {
+        put_bits(w, PACK_BITSET_ROW_RUNS, 2);
+        put_runs(w, rows);
+    } else {
+        put_bits(w, PACK_BITSET_RAW, 2);
+        for (uint16_t i = 0; i < DUNGEON_EXPLORED_BYTES; i++) put_bits(w, bits[i], 8);
+    }
+}
+
+// Expects the set zeroed
+static void get_bitset(PackReader* r, uint8_t* bits) {
+    uint8_t mode = (uint8_t)get_bits(r, 2);
+
+    if (mode == PACK_BITSET_RAW) {
+        for (uint16_t i = 0; i < DUNGEON_EXPLORED_BYTES; i++) bits[i] = (uint8_t)get_bits(r, 8);
+        return;
+    }
+    if (mode != PACK_BITSET_RUNS && mode != PACK_BITSET_ROW_RUNS) {
+        r->damaged = true;
+        return;
+    }
+
+    uint8_t value = (uint8_t)get_bits(r, 1);
+    for (uint16_t i = 0; i < PACK_BITSET_BITS; value ^= 1) {
+        uint16_t run = get_run(r);
+        if (r->damaged || run > PACK_BITSET_BITS - i) {
+            r->damaged = true;
+            return;
+        }
+        if (value) pack_fill_ones(bits, i, run);
+        i += run;
+    }
+
+    if (mode == PACK_BITSET_ROW_RUNS) {
+        for (uint16_t i = PACK_ROW_BYTES; i < DUNGEON_EXPLORED_BYTES; i++) bits[i] ^= bits[i - PACK_ROW_BYTES];
+    }
+}
+
+// ============================================================================
+// Records
+// ============================================================================
+
+static void pack_game(PackWriter* w, const SaveData* save_data) {
+    put_small(w, (uint32_t)save_data->current_state, 4, 32);
+    put_small(w, save_data->current_dungeon_index, 3, 8);
+    for (uint8_t i = 0; i <= MAX_DUNGEONS; i++) put_bits(w, save_data->dungeon_initialized[i], 1);
+    for (uint8_t i = 0; i < MAX_DUNGEONS; i++) put_bits(w, save_data->dungeons_completed[i], 1);
+    put_bits(w, save_data->final_dungeon_unlocked, 1);
+    put_bits(w, save_data->key_items_collected, 8);
+    put_sized(w, save_data->gold, 5);
+    put_sized(w, save_data->game_time, 6);
+    put_bits(w, save_data->world_x, 8);
+    put_bits(w, save_data->world_y, 8);
+    put_bits(w, save_data->world_encounter_steps, 8);
+    put_small(w, (uint32_t)save_data->hub_state, 4, 32);
+}
+
+static void unpack_game(PackReader* r, SaveData* save_data) {
+    save_data->current_state = (GameState)get_small(r, 4, 32);
+    save_data->current_dungeon_index = (uint8_t)get_small(r, 3, 8);
+    for (uint8_t i = 0; i <= MAX_DUNGEONS; i++) save_data->dungeon_initialized[i] = get_bits(r, 1) != 0;
+    for (uint8_t i = 0; i < MAX_DUNGEONS; i++) save_data->dungeons_completed[i] = get_bits(r, 1) != 0;
+    save_data->final_dungeon_unlocked = get_bits(r, 1) != 0;
+    save_data->key_items_collected = (uint8_t)get_bits(r, 8);
+    save_data->gold = (uint16_t)get_sized(r, 5, 16);
+    save_data->game_time = get_sized(r, 6, 32);
+    save_data->world_x = (uint8_t)get_bits(r, 8);
+    save_data->world_y = (uint8_t)get_bits(r, 8);
+    save_data->world_encounter_steps = (uint8_t)get_bits(r, 8);
+    save_data->hub_state = (GameState)get_small(r, 4, 32);
+}
+
+// Dungeons never entered are all zeros: one bit says so
+static void pack_dungeon(PackWriter* w, const SaveDungeonData* dungeon) {
+    static const SaveDungeonData untouched;
+    bool recorded = memcmp(dungeon, &untouched, sizeof(SaveDungeonData)) != 0;
+
+    put_bits(w, recorded, 1);
+    if (!recorded) return;
+
+    put_small(w, dungeon->current_floor, 3, 8);
+    put_small(w, dungeon->player_x, 5, 8);
+    put_small(w, dungeon->player_y, 5, 8);
+    put_bits(w, dungeon->encounter_steps, 8);
+    put_bits(w, dungeon->boss_defeated, 1);
+    put_bits(w, dungeon->completed, 1);
+    put_bits(w, dungeon->floors_loaded, 8);
+    put_bitset(w, dungeon->explored_tiles);
+    put_bitset(w, dungeon->treasure_collected);
+}
+
+static void unpack_dungeon(PackReader* r, SaveDungeonData* dungeon) {
+    if (!get_bits(r, 1)) return;
+
+    dungeon->current_floor = (uint8_t)get_small(r, 3, 8);
+    dungeon->player_x = (uint8_t)get_small(r, 5, 8);
+    dungeon->player_y = (uint8_t)get_small(r, 5, 8);
+    dungeon->encounter_steps = (uint8_t)get_bits(r, 8);
+    dungeon->boss_defeated = get_bits(r, 1) != 0;
+    dungeon->completed = get_bits(r, 1) != 0;
+    dungeon->floors_loaded = (uint8_t)get_bits(r, 8);
+    get_bitset(r, dungeon->explored_tiles);
+    get_bitset(r, dungeon->treasure_collected);
+}
+
+static void pack_member(PackWriter* w, const SaveMemberData* member) {
+    put_name(w, member->name);
+    put_small(w, (uint32_t)member->job, 3, 32);
+    put_bits(w, member->level, 8);
+    put_sized(w, member->experience, 6);
+    put_sized(w, member->max_hp, 5);
+    put_sized(w, member->current_hp, 5);
+    put_sized(w, member->max_mp, 5);
+    put_sized(w, member->current_mp, 5);
+    put_bits(w, member->attack, 8);
+    put_bits(w, member->defense, 8);
+    put_bits(w, member->intelligence, 8);
+    put_bits(w, member->agility, 8);
+    put_bits(w, member->luck, 8);
+
+    // Skill slots up to the last one in use
+    uint8_t stored = MAX_SKILLS;
+    while (stored > 0 && member->skills[stored - 1] == 0) stored--;
+    put_small(w, member->skill_count, 4, 8);
+    put_bits(w, stored, 4);
+    for (uint8_t i = 0; i < stored; i++) put_bits(w, member->skills[i], 8);
+
+    // Inventory indices, with EQUIP_NONE as the shortest code
+    for (uint8_t i = 0; i < EQUIP_SLOT_COUNT; i++) {
+        put_small(w, (uint8_t)(member->equipped_items[i] + 1), 5, 8);
+    }
+    put_small(w, member->status_effects, 1, 8);
+}
+
+static void unpack_member(PackReader* r, SaveMemberData* member) {
+    get_name(r, member->name);
+    member->job = (JobType)get_small(r, 3, 32);
+    member->level = (uint8_t)get_bits(r, 8);
+    member->experience = get_sized(r, 6, 32);
+    member->max_hp = (uint16_t)get_sized(r, 5, 16);
+    member->current_hp = (uint16_t)get_sized(r, 5, 16);
+    member->max_mp = (uint16_t)get_sized(r, 5, 16);
+    member->current_mp = (uint16_t)get_sized(r, 5, 16);
+    member->attack = (uint8_t)get_bits(r, 8);
+    member->defense = (uint8_t)get_bits(r, 8);
+    member->intelligence = (uint8_t)get_bits(r, 8);
+    member->agility = (uint8_t)get_bits(r, 8);
+    member->luck = (uint8_t)get_bits(r, 8);
+
+    member->skill_count = (uint8_t)get_small(r, 4, 8);
+    uint8_t stored = (uint8_t)get_bits(r, 4);
+    if (stored > MAX_SKILLS) {
+        r->damaged = true;
+        return;
+    }
+    for (uint8_t i = 0; i < stored; i++) member->skills[i] = (uint8_t)get_bits(r, 8);
+
+    for (uint8_t i = 0; i < EQUIP_SLOT_COUNT; i++) {
+        member->equipped_items[i] = (uint8_t)(get_small(r, 5, 8) - 1);
+    }
+    member->status_effects = (uint8_t)get_small(r, 1, 8);
+}
+
+// The item database's name as a save stores it (cut to fit, zero-filled)
+static void pack_catalog_name(const Item* item, char* name) {
+    safe_string_copy(name, item->name, MAX_NAME_LENGTH);
+}
+
+static bool pack_item_is_catalog(const SaveItemData* item) {
+    Item entry = item_create_consumable(item->item_id);
+    char name[MAX_NAME_LENGTH];
+    pack_catalog_name(&entry, name);
+    return memcmp(name, item->name, MAX_NAME_LENGTH) == 0;
+}
+
+static bool pack_equipment_is_catalog(const SaveEquipmentData* equip) {
+    Item entry = item_create_equipment(equip->equipment_id);
+    char name[MAX_NAME_LENGTH];
+    pack_catalog_name(&entry, name);
+    return equip->slot == (EquipmentSlot)entry.equip_type &&
+           equip->attack_bonus == entry.attack_bonus &&
+           equip->defense_bonus == entry.defense_bonus &&
+           equip->intelligence_bonus == entry.intelligence_bonus &&
+           equip->agility_bonus == entry.agility_bonus &&
+           memcmp(name, equip->name, MAX_NAME_LENGTH) == 0;
+}
+
+// Items and equipment straight from the database store only their IDs
+static void pack_inventory(PackWriter* w, const SaveData* save_data) {
+    uint8_t item_count = save_data->inventory_data.item_count;
+    put_small(w, item_count, 5, 8);
+    if (item_count > MAX_INVENTORY_ITEMS) item_count = MAX_INVENTORY_ITEMS;
+
+    for (uint8_t i = 0; i < item_count; i++) {
+        const SaveItemData* item = &save_data->inventory_data.items[i];
+        bool catalog = pack_item_is_catalog(item);
+
+        put_bits(w, item->item_id, 8);
+        put_small(w, item->quantity, 4, 8);
+        put_bits(w, catalog, 1);
+        if (!catalog) put_name(w, item->name);
+    }
+
+    uint8_t equipment_count = save_data->inventory_data.equipment_count;
+    put_small(w, equipment_count, 5, 8);
+    if (equipment_count > MAX_EQUIPMENT_SLOTS) equipment_count = MAX_EQUIPMENT_SLOTS;
+
+    for (uint8_t i = 0; i < equipment_count; i++) {
+        const SaveEquipmentData* equip = &save_data->inventory_data.equipment[i];
+        bool catalog = pack_equipment_is_catalog(equip);
+
+        put_bits(w, equip->equipment_id, 8);
+        put_bits(w, equip->is_equipped, 1);
+        put_bits(w, catalog, 1);
+        if (catalog) continue;
+
+        put_small(w, (uint32_t)equip->slot, 3, 32);
+        put_bits(w, equip->attack_bonus, 8);
+        put_bits(w, equip->defense_bonus, 8);
+        put_bits(w, equip->intelligence_bonus, 8);
+        put_bits(w, equip->agility_bonus, 8);
+        put_name(w, equip->name);
+    }
+}
+
+static void unpack_inventory(PackReader* r, SaveData* save_data) {
+    uint8_t item_count = (uint8_t)get_small(r, 5, 8);
+    save_data->inventory_data.item_count = item_count;
+    if (item_count > MAX_INVENTORY_ITEMS) item_count = MAX_INVENTORY_ITEMS;
+
+    for (uint8_t i = 0; i < item_count && !r->damaged; i++) {
+        SaveItemData* item = &save_data->inventory_data.items[i];
+        item->item_id = (uint8_t)get_bits(r, 8);
+        item->quantity = (uint8_t)get_small(r, 4, 8);
+
+        if (get_bits(r, 1)) {
+            Item entry = item_create_consumable(item->item_id);
+            pack_catalog_name(&entry, item->name);
+        } else {
+            get_name(r, item->name);
+        }
+    }
+
+    uint8_t equipment_count = (uint8_t)get_small(r, 5, 8);
+    save_data->inventory_data.equipment_count = equipment_count;
+    if (equipment_count > MAX_EQUIPMENT_SLOTS) equipment_count = MAX_EQUIPMENT_SLOTS;
+
+    for (uint8_t i = 0; i < equipment_count && !r->damaged; i++) {
+        SaveEquipmentData* equip = &save_data->inventory_data.equipment[i];
+        equip->equipment_id = (uint8_t)get_bits(r, 8);
+        equip->is_equipped = get_bits(r, 1) != 0;
+
+        if (get_bits(r, 1)) {
+            Item entry = item_create_equipment(equip->equipment_id);
+            equip->slot = (EquipmentSlot)entry.equip_type;
+            equip->attack_bonus = entry.attack_bonus;
+            equip->defense_bonus = entry.defense_bonus;
+            equip->intelligence_bonus = entry.intelligence_bonus;
+            equip->agility_bonus = entry.agility_bonus;
+            pack_catalog_name(&entry, equip->name);
+            continue;
+        }
+
+        equip->slot = (EquipmentSlot)get_small(r, 3, 32);
+        equip->attack_bonus = (uint8_t)get_bits(r, 8);
+        equip->defense_bonus = (uint8_t)get_bits(r, 8);
+        equip->intelligence_bonus = (uint8_t)get_bits(r, 8);
+        equip->agility_bonus = (uint8_t)get_bits(r, 8);
+        get_name(r, equip->name);
+    }
+}
+
+// ============================================================================
+// Image encode / decode
+// ============================================================================
+
+static void pack_put_u32(uint8_t* data, uint32_t value) {
+    for (uint8_t i = 0; i < 4; i++) data[i] = (uint8_t)(value >> (8 * i));
+}
+
+static uint32_t pack_get_u32(const uint8_t* data) {
+    return (uint32_t)data[0] | ((uint32_t)data[1] << 8) | ((uint32_t)data[2] << 16) | ((uint32_t)data[3] << 24);
+}
+
+uint16_t save_pack_encode(const SaveData* save_data, uint8_t image[SAVE_PACK_MAX_SIZE]) {
+    memset(image, 0, SAVE_PACK_MAX_SIZE);
+    PackWriter w = { image + SAVE_PACK_HEADER_SIZE, 0 };
+
+    pack_game(&w, save_data);
+    for (uint8_t i = 0; i <= MAX_DUNGEONS; i++) pack_dungeon(&w, &save_data->dungeon_data[i]);
+
+    uint8_t member_count = save_data->party_data.member_count;
+    put_small(&w, member_count, 3, 8);
+    if (member_count > MAX_PARTY_SIZE) member_count = MAX_PARTY_SIZE;
+    for (uint8_t i = 0; i < member_count; i++) pack_member(&w, &save_data->party_data.members[i]);
+
+    pack_inventory(&w, save_data);
+
+    uint16_t payload = (uint16_t)((w.bit + 7) / 8);
+    pack_put_u32(image, SAVE_PACK_MAGIC);
+    image[4] = SAVE_PACK_VERSION;
+    image[5] = (uint8_t)payload;
+    image[6] = (uint8_t)(payload >> 8);
+    pack_put_u32(image + 7, save_format_crc32(image + SAVE_PACK_HEADER_SIZE, payload));
+    return (uint16_t)(SAVE_PACK_HEADER_SIZE + payload);
+}
+
+bool save_pack_decode(const uint8_t* image, uint16_t size, SaveData* save_data) {
+    if (size < SAVE_PACK_HEADER_SIZE || pack_get_u32(image) != SAVE_PACK_MAGIC) {
+        printf("Error: Invalid save image (bad magic number)\n");
+        return false;
+    }
+    if (image[4] > SAVE_PACK_VERSION) {
+        printf("Error: Save image is from a newer version of the game\n");
+        return false;
+    }
+    if (image[4] != SAVE_PACK_VERSION) {
+        printf("Error: Save image version mismatch\n");
+        return false;
+    }
+
+    uint16_t payload = (uint16_t)(image[5] | (image[6] << 8));
+    if (payload != size - SAVE_PACK_HEADER_SIZE ||
+        save_format_crc32(image + SAVE_PACK_HEADER_SIZE, payload) != pack_get_u32(image + 7)) {
+        printf("Error: Save image corrupted (checksum mismatch)\n");
+        return false;
+    }
+
+    memset(save_data, 0, sizeof(SaveData));
+    PackReader r = { image + SAVE_PACK_HEADER_SIZE, 0, (uint32_t)payload * 8, false };
+
+    unpack_game(&r, save_data);
+    for (uint8_t i = 0; i <= MAX_DUNGEONS && !r.damaged; i++) unpack_dungeon(&r, &save_data->dungeon_data[i]);
+
+    uint8_t member_count = (uint8_t)get_small(&r, 3, 8);
+    save_data->party_data.member_count = member_count;
+    if (member_count > MAX_PARTY_SIZE) member_count = MAX_PARTY_SIZE;
+    for (uint8_t i = 0; i < member_count && !r.damaged; i++) unpack_member(&r, &save_data->party_data.members[i]);
+
+    unpack_inventory(&r, save_data);
+
+    if (r.damaged) {
+        printf("Error: Save image corrupted (unreadable data)\n");
+        return false;
+    }
+
+    // Not stored: stamp the header load_data_to_game_state checks
+    save_data->magic = SAVE_MAGIC;
+    save_data->version = SAVE_DATA_VERSION;
+    save_data->checksum = calculate_checksum(save_data);
+    return true;
+}
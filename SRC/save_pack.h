@@ -0,0 +1,50 @@
+#ifndef SAVE_PACK_H
+#define SAVE_PACK_H
+
+#include "save_system.h"
+#include <stdint.h>
+#include <stdbool.h>
+
+// Packed save image for cartridge SRAM
+// The chunked file format spends whole bytes on every field; a battery-backed
+// SRAM bank wants the smallest image that still round-trips exactly. An image
+// is a byte header then one little-endian bitstream (LSB first):
+//   header  magic u32 | pack version u8 | payload length u16 | payload CRC-32 u32
+// Small fields use a short code with an escape to their full width, counters
+// and totals are stored as a bit length plus that many bits, names use 7-bit
+// characters, and inventory entries that match the item database store only
+// their ID. The explored and treasure bitsets of each dungeon are kept raw, as
+// runs of equal bits, or as runs of the difference from the row above -
+// whichever is shortest. Dungeons with nothing recorded cost one bit.
+// Decoding any SaveData the game builds gives back the same bytes; the header
+// fields (magic, version, checksum) are restamped rather than stored.
+#define SAVE_SRAM_SIZE 8192          // Battery-backed SRAM on the cartridge
+#define SAVE_PACK_MAGIC 0x4B505144   // "DQPK"
+#define SAVE_PACK_VERSION 2
+#define SAVE_PACK_HEADER_SIZE 11
+
+// Widest code of each record (every field escaped, every bitset stored raw)
+#define SAVE_PACK_NAME_BITS_MAX (1 + 8 * MAX_NAME_LENGTH)
+#define SAVE_PACK_BITSET_BITS_MAX (2 + DUNGEON_WIDTH * DUNGEON_HEIGHT)
+#define SAVE_PACK_GAME_BITS_MAX (176 + 2 * MAX_DUNGEONS)
+#define SAVE_PACK_DUNGEON_BITS_MAX (56 + 2 * SAVE_PACK_BITSET_BITS_MAX)
+#define SAVE_PACK_MEMBER_BITS_MAX (230 + SAVE_PACK_NAME_BITS_MAX + 8 * MAX_SKILLS + 13 * EQUIP_SLOT_COUNT)
+#define SAVE_PACK_ITEM_BITS_MAX (21 + SAVE_PACK_NAME_BITS_MAX)
+#define SAVE_PACK_EQUIPMENT_BITS_MAX (77 + SAVE_PACK_NAME_BITS_MAX)
+
+#define SAVE_PACK_BITS_MAX (SAVE_PACK_GAME_BITS_MAX + (MAX_DUNGEONS + 1) * SAVE_PACK_DUNGEON_BITS_MAX + \
+                            11 + MAX_PARTY_SIZE * SAVE_PACK_MEMBER_BITS_MAX + \
+                            13 + MAX_INVENTORY_ITEMS * SAVE_PACK_ITEM_BITS_MAX + \
+                            13 + MAX_EQUIPMENT_SLOTS * SAVE_PACK_EQUIPMENT_BITS_MAX)
+
+// Largest image the encoder can produce; always fits the SRAM budget
+#define SAVE_PACK_MAX_SIZE (SAVE_PACK_HEADER_SIZE + (SAVE_PACK_BITS_MAX + 7) / 8)
+
+// Packs the save data into image; returns the image size in bytes
+uint16_t save_pack_encode(const SaveData* save_data, uint8_t image[SAVE_PACK_MAX_SIZE]);
+
+// Unpacks an image into save data ready for load_data_to_game_state;
+// false (with a message) if it is damaged or from a newer game
+bool save_pack_decode(const uint8_t* image, uint16_t size, SaveData* save_data);
+
+#endif // SAVE_PACK_H
@@ -1,18 +1,254 @@
+#ifndef _WIN32
+#define _POSIX_C_SOURCE 200809L
+#endif
+
 #include "save_system.h"
+#include "save_format.h"
 #include "dungeon.h"
 #include "dungeon_maps.h"
+#include "world_map.h"
 #include "utils.h"
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
 
-#define SAVE_VERSION 1
+#ifdef _WIN32
+#include <io.h>
+#else
+#include <dirent.h>
+#include <fcntl.h>
+#include <pthread.h>
+#include <unistd.h>
+#endif
+
+#define SAVE_PATH_SIZE 80  // Save path plus a temp / backup suffix
+
+// File image being written or read
+static SaveImage save_image;
+
+// Exactly what save_last_path holds on disk, so saving the same game again
+// does not touch the file
+static SaveImage save_last_image;
+static char save_last_path[SAVE_PATH_SIZE];
+
+// The images above are shared with the autosave worker
+#ifndef _WIN32
+static pthread_mutex_t save_io_lock = PTHREAD_MUTEX_INITIALIZER;
+#endif
+
+static void save_lock(void) {
+#ifndef _WIN32
+    pthread_mutex_lock(&save_io_lock);
+#endif
+}
+
+static void save_unlock(void) {
+#ifndef _WIN32
+    pthread_mutex_unlock(&save_io_lock);
+#endif
+}
+
+// What each slot's header says, read the first time a menu asks and kept
+// current by every save, so listing the slots again opens no files
+typedef enum {
+    SLOT_UNKNOWN = 0,
+    SLOT_EMPTY,
+    SLOT_SAVED,
+    SLOT_DAMAGED
+} SlotStatus;
+
+static uint8_t save_catalog_status[MAX_SAVE_SLOTS];
+static SavePreview save_catalog[MAX_SAVE_SLOTS];
+static bool save_catalog_listed;  // Slots with no files are already marked empty
 
 // Helper function to get save file path
-static void get_save_file_path(uint8_t slot, char* path, size_t path_size) {
+static void get_save_file_path(uint16_t slot, char* path, size_t path_size) {
     snprintf(path, path_size, "%s%d.sav", SAVE_FILE_PREFIX, slot);
 }
 
+static void save_remember_image(const char* path) {
+    memcpy(save_last_image.bytes, save_image.bytes, save_image.size);
+    save_last_image.size = save_image.size;
+    safe_string_copy(save_last_path, path, sizeof(save_last_path));
+}
+
+static bool save_file_exists(const char* path) {
+    FILE* file = fopen(path, "rb");
+    if (file) {
+        fclose(file);
+        return true;
+    }
+    return false;
+}
+
+// Either the save or the backup of the one before it
+static bool save_generation_exists(const char* path) {
+    char backup_path[SAVE_PATH_SIZE];
+    snprintf(backup_path, sizeof(backup_path), "%s%s", path, SAVE_BACKUP_SUFFIX);
+    return save_file_exists(path) || save_file_exists(backup_path);
+}
+
+// ============================================================================
+// Atomic commit
+// ============================================================================
+
+// Flushes the file's data to the disk, not just to the OS
+static bool save_sync_file(FILE* file) {
+    if (fflush(file) != 0) return false;
+#ifdef _WIN32
+    return _commit(_fileno(file)) == 0;
+#else
+    return fsync(fileno(file)) == 0;
+#endif
+}
+
+// Makes the renames themselves durable (Windows has no directory handle to sync)
+static void save_sync_directory(const char* path) {
+#ifndef _WIN32
+    char directory[SAVE_PATH_SIZE];
+    const char* slash = strrchr(path, '/');
+    if (slash) {
+        snprintf(directory, sizeof(directory), "%.*s", (int)(slash - path), path);
+    } else {
+        snprintf(directory, sizeof(directory), ".");
+    }
+
+    int fd = open(directory[0] ? directory : "/", O_RDONLY);
+    if (fd >= 0) {
+        fsync(fd);
+        close(fd);
+    }
+#else
+    (void)path;
+#endif
+}
+
+// The current file becomes the backup. A hard link keeps the save in place
+// the whole time; where there is none it is moved aside instead.
+static void save_keep_previous(const char* path, const char* backup_path) {
+    if (!save_file_exists(path)) return;
+
+    remove(backup_path);
+#ifndef _WIN32
+    if (link(path, backup_path) == 0) return;
+#endif
+    rename(path, backup_path);
+}
+
+// Nothing to commit when the file still holds exactly this image
+static bool save_is_unchanged(const char* path) {
+    if (strcmp(save_last_path, path) != 0 || save_image.size != save_last_image.size ||
+        memcmp(save_image.bytes, save_last_image.bytes, save_image.size) != 0) {
+        return false;
+    }
+
+    FILE* file = fopen(path, "rb");
+    if (!file) return false;
+
+    uint8_t on_disk[SAVE_FORMAT_HEADER_SIZE + SAVE_SECTION_COUNT * SAVE_FORMAT_ENTRY_SIZE];
+    uint32_t toc_size = save_format_toc_size(&save_image);
+    bool same = toc_size <= sizeof(on_disk) && fread(on_disk, 1, toc_size, file) == toc_size &&
+                memcmp(on_disk, save_image.bytes, toc_size) == 0;
+    fclose(file);
+    return same;
+}
+
+// Writes the whole image to a temp file, syncs it, keeps the old file as the
+// backup and renames the temp file over it. A crash at any point leaves
+// either the old save or the new one complete, and the backup behind both.
+// Background writes pass report = false: the screen belongs to the game.
+static bool save_commit_image(const char* path, bool report) {
+    if (save_is_unchanged(path)) return true;
+
+    char temp_path[SAVE_PATH_SIZE];
+    char backup_path[SAVE_PATH_SIZE];
+    snprintf(temp_path, sizeof(temp_path), "%s%s", path, SAVE_TEMP_SUFFIX);
+    snprintf(backup_path, sizeof(backup_path), "%s%s", path, SAVE_BACKUP_SUFFIX);
+
+    FILE* file = fopen(temp_path, "wb");
+    if (!file) {
+        if (report) printf("Error: Could not create save file %s\n", temp_path);
+        return false;
+    }
+
+    bool ok = fwrite(save_image.bytes, 1, save_image.size, file) == save_image.size;
+    ok = save_sync_file(file) && ok;
+    ok = fclose(file) == 0 && ok;
+    if (!ok) {
+        remove(temp_path);
+        if (report) printf("Error: Failed to write save data (the previous save is untouched)\n");
+        return false;
+    }
+
+    save_keep_previous(path, backup_path);
+    if (rename(temp_path, path) != 0) {
+        remove(temp_path);
+        save_last_path[0] = '\0';
+        if (report) printf("Error: Could not replace save file %s\n", path);
+        return false;
+    }
+    save_sync_directory(path);
+
+    save_remember_image(path);
+    return true;
+}
+
+static bool save_write_file(const char* path, const SaveData* save_data, bool report) {
+    save_lock();
+    save_format_build(&save_image, save_data);
+    bool saved = save_commit_image(path, report);
+    save_unlock();
+    return saved;
+}
+
+// ============================================================================
+// Reading
+// ============================================================================
+
+static bool save_read_image(const char* path, SaveData* save_data) {
+    FILE* file = fopen(path, "rb");
+    if (!file) return false;
+
+    save_image.size = (uint32_t)fread(save_image.bytes, 1, sizeof(save_image.bytes), file);
+    bool too_long = fgetc(file) != EOF;
+    fclose(file);
+
+    if (too_long) {
+        printf("Error: Invalid save file (too large)\n");
+        return false;
+    }
+    return save_format_parse(&save_image, save_data);
+}
+
+// Reads either file format into save data, falling back to the previous
+// generation if the save itself is missing or damaged
+static bool save_read_generation(const char* path, SaveData* save_data) {
+    if (save_read_image(path, save_data)) {
+        // A chunked file is now known byte for byte; an old one is rewritten whole
+        if (save_image.size >= SAVE_FORMAT_HEADER_SIZE && save_image.bytes[4] == SAVE_FORMAT_VERSION) {
+            save_remember_image(path);
+        } else if (strcmp(save_last_path, path) == 0) {
+            save_last_path[0] = '\0';
+        }
+        return true;
+    }
+
+    char backup_path[SAVE_PATH_SIZE];
+    snprintf(backup_path, sizeof(backup_path), "%s%s", path, SAVE_BACKUP_SUFFIX);
+    if (!save_read_image(backup_path, save_data)) return false;
+
+    if (strcmp(save_last_path, path) == 0) save_last_path[0] = '\0';
+    printf("Recovered the previous save from %s\n", backup_path);
+    return true;
+}
+
+static bool save_read_file(const char* path, SaveData* save_data) {
+    save_lock();
+    bool loaded = save_read_generation(path, save_data);
+    save_unlock();
+    return loaded;
+}
+
 // Calculate simple checksum
 uint32_t calculate_checksum(const SaveData* save_data) {
     if (!save_data) return 0;
@@ -36,7 +272,7 @@ void save_data_from_game_state(SaveData* save_data) {
 
     // Header
     save_data->magic = SAVE_MAGIC;
-    save_data->version = SAVE_VERSION;
+    save_data->version = SAVE_DATA_VERSION;
 
     // Game state
     save_data->current_state = g_game_state.current_state;
@@ -45,6 +281,10 @@ void save_data_from_game_state(SaveData* save_data) {
     save_data->key_items_collected = g_game_state.key_items_collected;
     save_data->gold = g_game_state.gold;
     save_data->game_time = g_game_state.game_time;
+    save_data->world_x = g_game_state.world_x;
+    save_data->world_y = g_game_state.world_y;
+    save_data->world_encounter_steps = g_game_state.world_encounter_steps;
+    save_data->hub_state = g_game_state.hub_state;
 
     memcpy(save_data->dungeon_initialized, g_game_state.dungeon_initialized, sizeof(g_game_state.dungeon_initialized));
     memcpy(save_data->dungeons_completed, g_game_state.dungeons_completed, sizeof(g_game_state.dungeons_completed));
@@ -56,6 +296,7 @@ void save_data_from_game_state(SaveData* save_data) {
             save_data->dungeon_data[i].current_floor = dungeon->current_floor;
             save_data->dungeon_data[i].boss_defeated = dungeon->boss_defeated;
             save_data->dungeon_data[i].completed = dungeon->completed;
+            save_data->dungeon_data[i].floors_loaded = dungeon->floors_loaded;
 
             // Save current floor player position and encounter steps
             DungeonFloor* floor = &dungeon->floors[dungeon->current_floor];
@@ -64,26 +305,27 @@ void save_data_from_game_state(SaveData* save_data) {
             save_data->dungeon_data[i].encounter_steps = floor->encounter_steps;
 
             // Save explored tiles and collected treasures as bitfields
+            // (floors never entered still match their maps - nothing to record)
             for (int f = 0; f < dungeon->floor_count; f++) {
+                if (!dungeon_floor_is_loaded(dungeon, f)) continue;
+
                 DungeonFloor* df = &dungeon->floors[f];
-                for (int y = 0; y < DUNGEON_HEIGHT; y++) {
-                    for (int x = 0; x < DUNGEON_WIDTH; x++) {
+
+                // The floor's explored bitset uses the same bit order as the save
+                for (int b = 0; b < DUNGEON_EXPLORED_BYTES; b++) {
+                    save_data->dungeon_data[i].explored_tiles[b] |= df->explored[b];
+                }
+
+                // Track if treasure was collected (changed from TREASURE to FLOOR)
+                const DungeonMapAsset* fixed_map = dungeon->floor_maps[f];
+                if (!fixed_map) continue;
+
+                for (int t = 0; t < fixed_map->treasure_count; t++) {
+                    uint8_t x = fixed_map->treasures[t].x;
+                    uint8_t y = fixed_map->treasures[t].y;
+                    if (dungeon_floor_get_tile(df, x, y) == TILE_FLOOR) {
                         int tile_index = y * DUNGEON_WIDTH + x;
-                        int byte_index = tile_index / 8;
-                        int bit_index = tile_index % 8;
-
-                        if (df->tiles[y][x].explored) {
-                            save_data->dungeon_data[i].explored_tiles[byte_index] |= (1 << bit_index);
-                        }
-
-                        // Track if treasure was collected (changed from TREASURE to FLOOR)
-                        if (df->tiles[y][x].type == TILE_FLOOR) {
-                            // Check if this was originally a treasure tile by checking the fixed map
-                            const char (*fixed_map)[DUNGEON_WIDTH + 1] = dungeon_get_fixed_map(dungeon->dungeon_id, f);
-                            if (fixed_map && fixed_map[y][x] == 'T') {
-                                save_data->dungeon_data[i].treasure_collected[byte_index] |= (1 << bit_index);
-                            }
-                        }
+                        save_data->dungeon_data[i].treasure_collected[tile_index / 8] |= (1 << (tile_index % 8));
                     }
                 }
             }
@@ -154,6 +396,104 @@ void save_data_from_game_state(SaveData* save_data) {
     save_data->checksum = calculate_checksum(save_data);
 }
 
+// Upgrade a version 1 save. Its explored and treasure bitfields were merged
+// across floors and restored onto every floor, so there is no telling which
+// floors were visited: the current floor is always rebuilt, and a dungeon with
+// anything explored gets every floor back, exactly as the old game loaded it.
+void save_data_default_world(SaveData* save_data) {
+    world_map_start_position(&save_data->world_x, &save_data->world_y);
+    save_data->world_encounter_steps = 0;
+    save_data->hub_state = STATE_DUNGEON_SELECT;
+}
+
+bool save_data_from_v1(const SaveDataV1* old_data, SaveData* save_data) {
+    if (!old_data || !save_data) return false;
+
+    if (old_data->magic != SAVE_MAGIC || old_data->version != SAVE_DATA_V1_VERSION) {
+        printf("Error: Save file version mismatch\n");
+        return false;
+    }
+
+    uint32_t checksum = 0;
+    const uint8_t* data = (const uint8_t*)old_data;
+    size_t offset = sizeof(old_data->magic) + sizeof(old_data->version) + sizeof(old_data->checksum);
+    for (size_t i = offset; i < sizeof(SaveDataV1); i++) {
+        checksum += data[i];
+    }
+    if (old_data->checksum != checksum) {
+        printf("Error: Save file corrupted (checksum mismatch)\n");
+        return false;
+    }
+
+    memset(save_data, 0, sizeof(SaveData));
+    save_data->magic = SAVE_MAGIC;
+    save_data->version = SAVE_DATA_VERSION;
+
+    save_data->current_state = old_data->current_state;
+    save_data->current_dungeon_index = old_data->current_dungeon_index;
+    memcpy(save_data->dungeon_initialized, old_data->dungeon_initialized, sizeof(save_data->dungeon_initialized));
+    memcpy(save_data->dungeons_completed, old_data->dungeons_completed, sizeof(save_data->dungeons_completed));
+    save_data->final_dungeon_unlocked = old_data->final_dungeon_unlocked;
+    save_data->key_items_collected = old_data->key_items_collected;
+    save_data->gold = old_data->gold;
+    save_data->game_time = old_data->game_time;
+    save_data_default_world(save_data);
+
+    for (int i = 0; i <= MAX_DUNGEONS; i++) {
+        const SaveDungeonDataV1* old_dungeon = &old_data->dungeon_data[i];
+        SaveDungeonData* dungeon = &save_data->dungeon_data[i];
+        dungeon->current_floor = old_dungeon->current_floor;
+        dungeon->player_x = old_dungeon->player_x;
+        dungeon->player_y = old_dungeon->player_y;
+        dungeon->encounter_steps = old_dungeon->encounter_steps;
+        dungeon->boss_defeated = old_dungeon->boss_defeated;
+        dungeon->completed = old_dungeon->completed;
+        memcpy(dungeon->explored_tiles, old_dungeon->explored_tiles, sizeof(dungeon->explored_tiles));
+        memcpy(dungeon->treasure_collected, old_dungeon->treasure_collected, sizeof(dungeon->treasure_collected));
+
+        if (!old_data->dungeon_initialized[i]) continue;
+
+        uint8_t floor_count = (i == MAX_DUNGEONS) ? 5 : 3;
+        bool explored = false;
+        for (int b = 0; b < DUNGEON_EXPLORED_BYTES && !explored; b++) {
+            explored = old_dungeon->explored_tiles[b] != 0;
+        }
+        dungeon->floors_loaded = explored ? (uint8_t)((1u << floor_count) - 1) : 0;
+        if (dungeon->current_floor < floor_count) {
+            dungeon->floors_loaded |= (uint8_t)(1 << dungeon->current_floor);
+        }
+    }
+
+    save_data->party_data.member_count = old_data->party_data.member_count;
+    memcpy(save_data->party_data.members, old_data->party_data.members, sizeof(save_data->party_data.members));
+
+    save_data->inventory_data.item_count = old_data->inventory_data.item_count;
+    memcpy(save_data->inventory_data.items, old_data->inventory_data.items, sizeof(save_data->inventory_data.items));
+    save_data->inventory_data.equipment_count = old_data->inventory_data.equipment_count;
+    memcpy(save_data->inventory_data.equipment, old_data->inventory_data.equipment, sizeof(save_data->inventory_data.equipment));
+
+    save_data->checksum = calculate_checksum(save_data);
+    return true;
+}
+
+// Every dungeon record must fit its dungeon before the running game is
+// replaced; a bad save leaves the session as it was
+static bool save_data_check_dungeons(const SaveData* save_data) {
+    for (int i = 0; i <= MAX_DUNGEONS; i++) {
+        if (!save_data->dungeon_initialized[i]) continue;
+
+        const SaveDungeonData* dungeon = &save_data->dungeon_data[i];
+        uint8_t floor_count = (i == MAX_DUNGEONS) ? 5 : 3;
+        if (dungeon->current_floor >= floor_count ||
+            (dungeon->floors_loaded >> floor_count) != 0 ||
+            dungeon->player_x >= DUNGEON_WIDTH || dungeon->player_y >= DUNGEON_HEIGHT) {
+            printf("Error: Save file has an invalid floor for %s\n", dungeon_names[i]);
+            return false;
+        }
+    }
+    return true;
+}
+
 // Load save data into game state
 bool load_data_to_game_state(const SaveData* save_data) {
     if (!save_data) return false;
@@ -164,7 +504,7 @@ bool load_data_to_game_state(const SaveData* save_data) {
         return false;
     }
 
-    if (save_data->version != SAVE_VERSION) {
+    if (save_data->version != SAVE_DATA_VERSION) {
         printf("Error: Save file version mismatch\n");
         return false;
     }
@@ -176,6 +516,14 @@ bool load_data_to_game_state(const SaveData* save_data) {
         return false;
     }
 
+    if (!save_data_check_dungeons(save_data)) return false;
+
+    if (save_data->world_x >= WORLD_MAP_WIDTH || save_data->world_y >= WORLD_MAP_HEIGHT ||
+        (save_data->hub_state != STATE_DUNGEON_SELECT && save_data->hub_state != STATE_WORLD_MAP)) {
+        printf("Error: Save file has an invalid world map position\n");
+        return false;
+    }
+
     // Clean up existing state
     game_state_cleanup();
     game_state_init();
@@ -187,6 +535,10 @@ bool load_data_to_game_state(const SaveData* save_data) {
     g_game_state.key_items_collected = save_data->key_items_collected;
     g_game_state.gold = save_data->gold;
     g_game_state.game_time = save_data->game_time;
+    g_game_state.world_x = save_data->world_x;
+    g_game_state.world_y = save_data->world_y;
+    g_game_state.world_encounter_steps = save_data->world_encounter_steps;
+    g_game_state.hub_state = save_data->hub_state;
 
     memcpy(g_game_state.dungeon_initialized, save_data->dungeon_initialized, sizeof(save_data->dungeon_initialized));
     memcpy(g_game_state.dungeons_completed, save_data->dungeons_completed, sizeof(save_data->dungeons_completed));
@@ -194,7 +546,7 @@ bool load_data_to_game_state(const SaveData* save_data) {
     // Restore dungeons
     for (int i = 0; i <= MAX_DUNGEONS; i++) {
         if (save_data->dungeon_initialized[i]) {
-            // Re-initialize dungeon (regenerates from fixed maps)
+            // Re-initialize dungeon; only floors entered before the save are rebuilt
             uint8_t floor_count = (i == MAX_DUNGEONS) ? 5 : 3;
             extern const char* dungeon_names[];
             dungeon_init(&g_game_state.dungeons[i], i, dungeon_names[i], floor_count);
@@ -204,30 +556,35 @@ bool load_data_to_game_state(const SaveData* save_data) {
             dungeon->boss_defeated = save_data->dungeon_data[i].boss_defeated;
             dungeon->completed = save_data->dungeon_data[i].completed;
 
+            uint8_t floors_loaded = save_data->dungeon_data[i].floors_loaded | (uint8_t)(1 << dungeon->current_floor);
+
             // Restore current floor player position and encounter steps
-            DungeonFloor* floor = &dungeon->floors[dungeon->current_floor];
+            DungeonFloor* floor = dungeon_materialize_floor(dungeon, dungeon->current_floor);
             floor->player_x = save_data->dungeon_data[i].player_x;
             floor->player_y = save_data->dungeon_data[i].player_y;
             floor->encounter_steps = save_data->dungeon_data[i].encounter_steps;
 
             // Restore explored tiles and collected treasures
             for (int f = 0; f < dungeon->floor_count; f++) {
-                DungeonFloor* df = &dungeon->floors[f];
-                for (int y = 0; y < DUNGEON_HEIGHT; y++) {
-                    for (int x = 0; x < DUNGEON_WIDTH; x++) {
-                        int tile_index = y * DUNGEON_WIDTH + x;
-                        int byte_index = tile_index / 8;
-                        int bit_index = tile_index % 8;
-
-                        // Restore explored status
-                        if (save_data->dungeon_data[i].explored_tiles[byte_index] & (1 << bit_index)) {
-                            df->tiles[y][x].explored = true;
-                        }
-
-                        // Restore treasure collected status
-                        if (save_data->dungeon_data[i].treasure_collected[byte_index] & (1 << bit_index)) {
-                            df->tiles[y][x].type = TILE_FLOOR;  // Treasure was collected
-                        }
+                if (!(floors_loaded & (1 << f))) continue;
+
+                DungeonFloor* df = dungeon_materialize_floor(dungeon, f);
+
+                // Restore explored status
+                for (int b = 0; b < DUNGEON_EXPLORED_BYTES; b++) {
+                    df->explored[b] |= save_data->dungeon_data[i].explored_tiles[b];
+                }
+
+                // Restore treasure collected status (only on this floor's chests)
+                const DungeonMapAsset* fixed_map = dungeon->floor_maps[f];
+                if (!fixed_map) continue;
+
+                for (int t = 0; t < fixed_map->treasure_count; t++) {
+                    uint8_t x = fixed_map->treasures[t].x;
+                    uint8_t y = fixed_map->treasures[t].y;
+                    int tile_index = y * DUNGEON_WIDTH + x;
+                    if (save_data->dungeon_data[i].treasure_collected[tile_index / 8] & (1 << (tile_index % 8))) {
+                        dungeon_floor_set_tile(df, x, y, TILE_FLOOR);  // Treasure was collected
                     }
                 }
             }
@@ -266,6 +623,8 @@ bool load_data_to_game_state(const SaveData* save_data) {
 
             // Status effects
             member->status_effects = save_data->party_data.members[i].status_effects;
+
+            character_invalidate_stats(member);
         }
     }
 
@@ -299,8 +658,97 @@ bool load_data_to_game_state(const SaveData* save_data) {
     return true;
 }
 
+// ============================================================================
+// Slot catalog
+// ============================================================================
+
+// What one generation of a slot holds, from its header alone; first-release
+// saves have no preview and are read whole, once
+static SlotStatus save_catalog_read(const char* path, SavePreview* preview) {
+    FILE* file = fopen(path, "rb");
+    if (!file) return SLOT_EMPTY;
+
+    uint8_t header[SAVE_FORMAT_HEADER_SIZE];
+    uint32_t size = (uint32_t)fread(header, 1, sizeof(header), file);
+    fclose(file);
+
+    uint16_t version = save_format_header_version(header, size);
+    if (version == SAVE_FORMAT_VERSION) {
+        return save_format_read_preview(header, size, preview) ? SLOT_SAVED : SLOT_DAMAGED;
+    }
+    if (version != SAVE_DATA_V1_VERSION) return SLOT_DAMAGED;
+
+    SaveData save_data;
+    save_lock();
+    bool loaded = save_read_image(path, &save_data);
+    save_unlock();
+    if (!loaded) return SLOT_DAMAGED;
+    save_format_preview(&save_data, preview);
+    return SLOT_SAVED;
+}
+
+// Lists the slot as a load would find it: the save, or failing that its backup
+static void save_catalog_scan(uint16_t slot) {
+    char filepath[64];
+    char backup_path[SAVE_PATH_SIZE];
+    get_save_file_path(slot, filepath, sizeof(filepath));
+    snprintf(backup_path, sizeof(backup_path), "%s%s", filepath, SAVE_BACKUP_SUFFIX);
+
+    SlotStatus status = save_catalog_read(filepath, &save_catalog[slot]);
+    if (status != SLOT_SAVED) {
+        SlotStatus backup = save_catalog_read(backup_path, &save_catalog[slot]);
+        if (backup != SLOT_EMPTY) status = backup;
+    }
+    save_catalog_status[slot] = status;
+}
+
+// One pass over the save directory marks every slot without a file (or
+// backup) empty, so an empty slot costs no failed opens. Windows builds
+// probe each slot instead.
+static void save_catalog_list(void) {
+    save_catalog_listed = true;
+#ifndef _WIN32
+    DIR* dir = opendir(".");
+    if (!dir) return;
+
+    static bool present[MAX_SAVE_SLOTS];
+    memset(present, 0, sizeof(present));
+
+    size_t prefix_length = strlen(SAVE_FILE_PREFIX);
+    struct dirent* entry;
+    while ((entry = readdir(dir)) != NULL) {
+        if (strncmp(entry->d_name, SAVE_FILE_PREFIX, prefix_length) != 0) continue;
+
+        const char* number = entry->d_name + prefix_length;
+        char* end;
+        long slot = strtol(number, &end, 10);
+        if (end != number && slot >= 0 && slot < MAX_SAVE_SLOTS && strncmp(end, ".sav", 4) == 0) {
+            present[slot] = true;
+        }
+    }
+    closedir(dir);
+
+    for (uint16_t slot = 0; slot < MAX_SAVE_SLOTS; slot++) {
+        if (!present[slot] && save_catalog_status[slot] == SLOT_UNKNOWN) {
+            save_catalog_status[slot] = SLOT_EMPTY;
+        }
+    }
+#endif
+}
+
+static SlotStatus save_catalog_lookup(uint16_t slot) {
+    if (!save_catalog_listed) save_catalog_list();
+    if (save_catalog_status[slot] == SLOT_UNKNOWN) save_catalog_scan(slot);
+    return (SlotStatus)save_catalog_status[slot];
+}
+
+void save_catalog_invalidate(void) {
+    memset(save_catalog_status, SLOT_UNKNOWN, sizeof(save_catalog_status));
+    save_catalog_listed = false;
+}
+
 // Save to slot
-bool save_game_to_slot(uint8_t slot) {
+bool save_game_to_slot(uint16_t slot) {
     if (slot >= MAX_SAVE_SLOTS) {
         printf("Error: Invalid save slot %d\n", slot);
         return false;
@@ -312,26 +760,20 @@ bool save_game_to_slot(uint8_t slot) {
     SaveData save_data;
     save_data_from_game_state(&save_data);
 
-    FILE* file = fopen(filepath, "wb");
-    if (!file) {
-        printf("Error: Could not create save file %s\n", filepath);
+    if (!save_write_file(filepath, &save_data, true)) {
+        save_catalog_status[slot] = SLOT_UNKNOWN;
         return false;
     }
 
-    size_t written = fwrite(&save_data, sizeof(SaveData), 1, file);
-    fclose(file);
-
-    if (written != 1) {
-        printf("Error: Failed to write save data\n");
-        return false;
-    }
+    save_format_preview(&save_data, &save_catalog[slot]);
+    save_catalog_status[slot] = SLOT_SAVED;
 
     printf("Game saved to slot %d\n", slot + 1);
     return true;
 }
 
 // Load from slot
-bool load_game_from_slot(uint8_t slot) {
+bool load_game_from_slot(uint16_t slot) {
     if (slot >= MAX_SAVE_SLOTS) {
         printf("Error: Invalid save slot %d\n", slot);
         return false;
@@ -340,17 +782,13 @@ bool load_game_from_slot(uint8_t slot) {
     char filepath[64];
     get_save_file_path(slot, filepath, sizeof(filepath));
 
-    FILE* file = fopen(filepath, "rb");
-    if (!file) {
+    if (!save_slot_exists(slot)) {
         printf("Error: Save file %s not found\n", filepath);
         return false;
     }
 
     SaveData save_data;
-    size_t read = fread(&save_data, sizeof(SaveData), 1, file);
-    fclose(file);
-
-    if (read != 1) {
+    if (!save_read_file(filepath, &save_data)) {
         printf("Error: Failed to read save data\n");
         return false;
     }
@@ -368,16 +806,7 @@ bool save_suspend_game(void) {
     SaveData save_data;
     save_data_from_game_state(&save_data);
 
-    FILE* file = fopen(SUSPEND_SAVE_FILE, "wb");
-    if (!file) {
-        printf("Error: Could not create suspend save file\n");
-        return false;
-    }
-
-    size_t written = fwrite(&save_data, sizeof(SaveData), 1, file);
-    fclose(file);
-
-    if (written != 1) {
+    if (!save_write_file(SUSPEND_SAVE_FILE, &save_data, true)) {
         printf("Error: Failed to write suspend save\n");
         return false;
     }
@@ -388,17 +817,13 @@ bool save_suspend_game(void) {
 
 // Load suspend save
 bool load_suspend_game(void) {
-    FILE* file = fopen(SUSPEND_SAVE_FILE, "rb");
-    if (!file) {
+    if (!suspend_save_exists()) {
         printf("No suspend save found\n");
         return false;
     }
 
     SaveData save_data;
-    size_t read = fread(&save_data, sizeof(SaveData), 1, file);
-    fclose(file);
-
-    if (read != 1) {
+    if (!save_read_file(SUSPEND_SAVE_FILE, &save_data)) {
         printf("Error: Failed to read suspend save\n");
         return false;
     }
@@ -414,81 +839,89 @@ bool load_suspend_game(void) {
     return true;
 }
 
-// Delete suspend save
+// Autosave (written by the autosave worker)
+bool save_autosave_data(const SaveData* save_data) {
+    if (!save_data) return false;
+    return save_write_file(AUTOSAVE_FILE, save_data, false);
+}
+
+bool load_autosave_game(void) {
+    if (!autosave_exists()) {
+        printf("No autosave found\n");
+        return false;
+    }
+
+    SaveData save_data;
+    if (!save_read_file(AUTOSAVE_FILE, &save_data)) {
+        printf("Error: Failed to read autosave\n");
+        return false;
+    }
+
+    if (!load_data_to_game_state(&save_data)) {
+        return false;
+    }
+
+    printf("Autosave loaded\n");
+    return true;
+}
+
+// Delete suspend save (and its backup, which would otherwise be loaded in its place)
 bool delete_suspend_save(void) {
+    remove(SUSPEND_SAVE_FILE SAVE_BACKUP_SUFFIX);
     if (remove(SUSPEND_SAVE_FILE) == 0) {
         return true;
     }
     return false;
 }
 
-// Check if save slot exists
-bool save_slot_exists(uint8_t slot) {
+// Check if save slot exists (damaged saves still occupy their slot)
+bool save_slot_exists(uint16_t slot) {
     if (slot >= MAX_SAVE_SLOTS) return false;
-
-    char filepath[64];
-    get_save_file_path(slot, filepath, sizeof(filepath));
-
-    FILE* file = fopen(filepath, "rb");
-    if (file) {
-        fclose(file);
-        return true;
-    }
-    return false;
+    return save_catalog_lookup(slot) != SLOT_EMPTY;
 }
 
 // Check if suspend save exists
 bool suspend_save_exists(void) {
-    FILE* file = fopen(SUSPEND_SAVE_FILE, "rb");
-    if (file) {
-        fclose(file);
-        return true;
-    }
-    return false;
+    return save_generation_exists(SUSPEND_SAVE_FILE);
+}
+
+bool autosave_exists(void) {
+    return save_generation_exists(AUTOSAVE_FILE);
 }
 
 // Get save slot info
-SaveSlotInfo get_save_slot_info(uint8_t slot) {
+SaveSlotInfo get_save_slot_info(uint16_t slot) {
     SaveSlotInfo info;
     memset(&info, 0, sizeof(SaveSlotInfo));
 
-    if (!save_slot_exists(slot)) {
+    SlotStatus status = slot < MAX_SAVE_SLOTS ? save_catalog_lookup(slot) : SLOT_EMPTY;
+    if (status == SLOT_EMPTY) {
         info.exists = false;
         snprintf(info.preview_text, sizeof(info.preview_text), "[ Empty ]");
         return info;
     }
 
-    char filepath[64];
-    get_save_file_path(slot, filepath, sizeof(filepath));
-
-    FILE* file = fopen(filepath, "rb");
-    if (!file) {
-        info.exists = false;
-        return info;
-    }
-
-    SaveData save_data;
-    size_t read = fread(&save_data, sizeof(SaveData), 1, file);
-    fclose(file);
-
-    if (read != 1 || save_data.magic != SAVE_MAGIC) {
+    if (status == SLOT_DAMAGED) {
         info.exists = false;
         snprintf(info.preview_text, sizeof(info.preview_text), "[ Corrupted ]");
         return info;
     }
 
+    const SavePreview* preview = &save_catalog[slot];
     info.exists = true;
-    info.game_time = save_data.game_time;
-    info.gold = save_data.gold;
-    info.party_level = (save_data.party_data.member_count > 0) ? save_data.party_data.members[0].level : 1;
+    info.game_time = preview->game_time;
+    info.gold = preview->gold;
+    info.party_level = preview->party_level;
 
     // Build preview text
     extern const char* dungeon_names[];
     const char* location = "Town";
-    if (save_data.current_state == STATE_DUNGEON_EXPLORE || save_data.current_state == STATE_BATTLE) {
-        if (save_data.current_dungeon_index <= MAX_DUNGEONS) {
-            location = dungeon_names[save_data.current_dungeon_index];
+    if (preview->state == STATE_DUNGEON_EXPLORE || preview->state == STATE_BATTLE) {
+        if (preview->dungeon_index <= MAX_DUNGEONS) {
+            location = dungeon_names[preview->dungeon_index];
         }
+    } else if (preview->state == STATE_WORLD_MAP) {
+        location = "World Map";
     }
 
     snprintf(info.preview_text, sizeof(info.preview_text),
@@ -501,7 +934,7 @@ SaveSlotInfo get_save_slot_info(uint8_t slot) {
 // Display save slots
 void display_save_slots(void) {
     printf("\n=== SAVE SLOTS ===\n");
-    for (uint8_t i = 0; i < MAX_SAVE_SLOTS; i++) {
+    for (uint16_t i = 0; i < MAX_SAVE_SLOTS; i++) {
         SaveSlotInfo info = get_save_slot_info(i);
         printf("%d. %s\n", i + 1, info.preview_text);
     }
@@ -7,10 +7,75 @@
 #include <stdint.h>
 #include <stdbool.h>
 
-#define MAX_SAVE_SLOTS 2
+#define MAX_SAVE_SLOTS 256
 #define SAVE_FILE_PREFIX "dqrpg_save_"
 #define SUSPEND_SAVE_FILE "dqrpg_suspend.sav"
+#define AUTOSAVE_FILE "dqrpg_autosave.sav"
+#define SAVE_TEMP_SUFFIX ".tmp"    // New save, renamed over the old one once it is on disk
+#define SAVE_BACKUP_SUFFIX ".bak"  // Previous save, loaded if the current one is damaged
 #define SAVE_MAGIC 0x44515250  // "DQRP" magic number for validation
+#define SAVE_DATA_VERSION 3    // In-memory SaveData layout (files use the chunked format)
+#define SAVE_DATA_V1_VERSION 1 // First release's layout (SaveDataV1)
+
+// Per-dungeon progress - only save minimal info, will regenerate from fixed maps
+typedef struct {
+    uint8_t current_floor;
+    uint8_t player_x;
+    uint8_t player_y;
+    uint8_t encounter_steps;
+    bool boss_defeated;
+    bool completed;
+    uint8_t floors_loaded; // Floors the party has entered; the rest are rebuilt on demand
+    // Explored tiles (bitfield - 256 bits for 16x16 map)
+    uint8_t explored_tiles[DUNGEON_HEIGHT * DUNGEON_WIDTH / 8];
+    // Treasure collected (bitfield - 256 bits for 16x16 map)
+    uint8_t treasure_collected[DUNGEON_HEIGHT * DUNGEON_WIDTH / 8];
+} SaveDungeonData;
+
+typedef struct {
+    char name[MAX_NAME_LENGTH];
+    JobType job;
+    uint8_t level;
+    uint32_t experience;
+
+    // Stats
+    uint16_t max_hp;
+    uint16_t current_hp;
+    uint16_t max_mp;
+    uint16_t current_mp;
+    uint8_t attack;
+    uint8_t defense;
+    uint8_t intelligence;
+    uint8_t agility;
+    uint8_t luck;
+
+    // Skills
+    uint8_t skill_count;
+    uint8_t skills[MAX_SKILLS];
+
+    // Equipment
+    uint8_t equipped_items[EQUIP_SLOT_COUNT];
+
+    // Status
+    uint8_t status_effects;
+} SaveMemberData;
+
+typedef struct {
+    uint8_t item_id;
+    uint8_t quantity;
+    char name[MAX_NAME_LENGTH];
+} SaveItemData;
+
+typedef struct {
+    uint8_t equipment_id;
+    EquipmentSlot slot;
+    uint8_t attack_bonus;
+    uint8_t defense_bonus;
+    uint8_t intelligence_bonus;
+    uint8_t agility_bonus;
+    bool is_equipped;
+    char name[MAX_NAME_LENGTH];
+} SaveEquipmentData;
 
 // Save data structure - mirrors game state but with fixed sizes for SRAM compatibility
 typedef struct {
@@ -28,76 +93,85 @@ typedef struct {
     uint16_t gold;
     uint32_t game_time;
 
-    // Dungeons - only save minimal info, will regenerate from fixed maps
-    struct {
-        uint8_t current_floor;
-        uint8_t player_x;
-        uint8_t player_y;
-        uint8_t encounter_steps;
-        bool boss_defeated;
-        bool completed;
-        // Explored tiles (bitfield - 256 bits for 16x16 map)
-        uint8_t explored_tiles[DUNGEON_HEIGHT * DUNGEON_WIDTH / 8];
-        // Treasure collected (bitfield - 256 bits for 16x16 map)
-        uint8_t treasure_collected[DUNGEON_HEIGHT * DUNGEON_WIDTH / 8];
-    } dungeon_data[MAX_DUNGEONS + 1];
+    // Overworld
+    uint8_t world_x;
+    uint8_t world_y;
+    uint8_t world_encounter_steps;
+    GameState hub_state;
+
+    SaveDungeonData dungeon_data[MAX_DUNGEONS + 1];
 
     // Party data
     struct {
         uint8_t member_count;
-        struct {
-            char name[MAX_NAME_LENGTH];
-            JobType job;
-            uint8_t level;
-            uint32_t experience;
-
-            // Stats
-            uint16_t max_hp;
-            uint16_t current_hp;
-            uint16_t max_mp;
-            uint16_t current_mp;
-            uint8_t attack;
-            uint8_t defense;
-            uint8_t intelligence;
-            uint8_t agility;
-            uint8_t luck;
-
-            // Skills
-            uint8_t skill_count;
-            uint8_t skills[MAX_SKILLS];
-
-            // Equipment
-            uint8_t equipped_items[EQUIP_SLOT_COUNT];
-
-            // Status
-            uint8_t status_effects;
-        } members[MAX_PARTY_SIZE];
+        SaveMemberData members[MAX_PARTY_SIZE];
     } party_data;
 
     // Inventory
     struct {
         uint8_t item_count;
-        struct {
-            uint8_t item_id;
-            uint8_t quantity;
-            char name[MAX_NAME_LENGTH];
-        } items[MAX_INVENTORY_ITEMS];
+        SaveItemData items[MAX_INVENTORY_ITEMS];
 
         uint8_t equipment_count;
-        struct {
-            uint8_t equipment_id;
-            EquipmentSlot slot;
-            uint8_t attack_bonus;
-            uint8_t defense_bonus;
-            uint8_t intelligence_bonus;
-            uint8_t agility_bonus;
-            bool is_equipped;
-            char name[MAX_NAME_LENGTH];
-        } equipment[MAX_EQUIPMENT_SLOTS];
+        SaveEquipmentData equipment[MAX_EQUIPMENT_SLOTS];
     } inventory_data;
 
 } SaveData;
 
+// What a save menu shows about a save without loading it
+typedef struct {
+    GameState state;
+    uint8_t dungeon_index;
+    uint8_t party_level;      // Party leader's level
+    uint8_t member_count;
+    uint16_t gold;
+    uint32_t game_time;
+} SavePreview;
+
+// Version 1 layout, as the first release wrote it: dungeons had no
+// floors_loaded mask (every floor was built whenever a dungeon was)
+typedef struct {
+    uint8_t current_floor;
+    uint8_t player_x;
+    uint8_t player_y;
+    uint8_t encounter_steps;
+    bool boss_defeated;
+    bool completed;
+    uint8_t explored_tiles[DUNGEON_HEIGHT * DUNGEON_WIDTH / 8];
+    uint8_t treasure_collected[DUNGEON_HEIGHT * DUNGEON_WIDTH / 8];
+} SaveDungeonDataV1;
+
+typedef struct {
+    uint32_t magic;
+    uint32_t version;
+    uint32_t checksum;        // Byte sum of everything after the header, like calculate_checksum
+
+    GameState current_state;
+    uint8_t current_dungeon_index;
+    bool dungeon_initialized[MAX_DUNGEONS + 1];
+    bool dungeons_completed[MAX_DUNGEONS];
+    bool final_dungeon_unlocked;
+    uint8_t key_items_collected;
+    uint16_t gold;
+    uint32_t game_time;
+
+    SaveDungeonDataV1 dungeon_data[MAX_DUNGEONS + 1];
+
+    struct {
+        uint8_t member_count;
+        SaveMemberData members[MAX_PARTY_SIZE];
+    } party_data;
+
+    struct {
+        uint8_t item_count;
+        SaveItemData items[MAX_INVENTORY_ITEMS];
+
+        uint8_t equipment_count;
+        SaveEquipmentData equipment[MAX_EQUIPMENT_SLOTS];
+    } inventory_data;
+
+} SaveDataV1;
+
 // Save slot info (for displaying save slot selection)
 typedef struct {
     bool exists;
@@ -108,21 +182,27 @@ typedef struct {
 } SaveSlotInfo;
 
 // Save/Load functions
-bool save_game_to_slot(uint8_t slot);
-bool load_game_from_slot(uint8_t slot);
+bool save_game_to_slot(uint16_t slot);
+bool load_game_from_slot(uint16_t slot);
 bool save_suspend_game(void);
 bool load_suspend_game(void);
 bool delete_suspend_save(void);
+bool save_autosave_data(const SaveData* save_data); // Silent; safe from the autosave thread
+bool load_autosave_game(void);
 
 // Utility functions
-bool save_slot_exists(uint8_t slot);
+bool save_slot_exists(uint16_t slot);
 bool suspend_save_exists(void);
-SaveSlotInfo get_save_slot_info(uint8_t slot);
+bool autosave_exists(void);
+SaveSlotInfo get_save_slot_info(uint16_t slot);  // From the slot catalog; opens at most one header
 void display_save_slots(void);
+void save_catalog_invalidate(void);  // Re-read every slot header on next use (files changed behind our back)
 
 // Internal functions
 void save_data_from_game_state(SaveData* save_data);
 bool load_data_to_game_state(const SaveData* save_data);
 uint32_t calculate_checksum(const SaveData* save_data);
+bool save_data_from_v1(const SaveDataV1* old_data, SaveData* save_data); // Checks and upgrades a version 1 save
+void save_data_default_world(SaveData* save_data); // New-game overworld fields, for saves made before they were kept
 
 #endif // SAVE_SYSTEM_H
@@ -0,0 +1,339 @@
+#ifndef _WIN32
+#define _POSIX_C_SOURCE 200809L
+#endif
+
+#include "screen.h"
+#include <stdarg.h>
+#include <stdio.h>
+#include <string.h>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <sys/ioctl.h>
+#include <unistd.h>
+#endif
+
+#define SCREEN_TRAILING_ROWS 4    // Room kept below a frame for prompts before it counts as too tall
+#define SCREEN_MAX_SKIP 4         // Re-send up to this many unchanged cells instead of a cursor jump
+#define SCREEN_OUTPUT_SIZE (SCREEN_WIDTH * SCREEN_HEIGHT * 24 + 256)
+#define SCREEN_CURSOR_UNKNOWN 0xFF
+
+static ScreenCell screen_back[SCREEN_HEIGHT][SCREEN_WIDTH];
+static ScreenCell screen_front[SCREEN_HEIGHT][SCREEN_WIDTH]; // What the terminal shows
+static uint8_t screen_front_rows;  // Frame height last presented; plain text may follow below it
+static bool screen_front_valid = false;
+static bool screen_frame_open = false;
+
+// Drawing cursor inside the back buffer
+static uint8_t screen_row;
+static uint8_t screen_col;
+static uint8_t screen_color;
+
+// Output staging for one present
+static char screen_out[SCREEN_OUTPUT_SIZE];
+static size_t screen_out_len;
+static uint8_t screen_term_row;
+static uint8_t screen_term_col;
+static uint8_t screen_term_color;
+
+// SGR sequences for each palette entry; every one resets first so bold never leaks
+static const char* const screen_sgr[SCREEN_COLOR_COUNT] = {
+    "\033[0m",
+    "\033[0;90m",
+    "\033[0;37m",
+    "\033[0;97m",
+    "\033[0;1;97m"
+};
+
+static const ScreenCell screen_blank = { { ' ', 0, 0 }, SCREEN_COLOR_DEFAULT };
+
+// ============================================================================
+// Back buffer
+// ============================================================================
+
+static void screen_fill_blank(ScreenCell (*cells)[SCREEN_WIDTH], uint8_t first_row) {
+    for (uint8_t row = first_row; row < SCREEN_HEIGHT; row++) {
+        for (uint8_t col = 0; col < SCREEN_WIDTH; col++) {
+            cells[row][col] = screen_blank;
+        }
+    }
+}
+
+static void screen_write_cell(const char* glyph, uint8_t length, uint8_t color) {
+    if (screen_row < SCREEN_HEIGHT && screen_col < SCREEN_WIDTH) {
+        ScreenCell* cell = &screen_back[screen_row][screen_col];
+        memset(cell->glyph, 0, sizeof(cell->glyph));
+        memcpy(cell->glyph, glyph, length);
+        cell->color = color;
+    }
+    if (screen_col < 0xFF) screen_col++; // Clipped past the right edge
+}
+
+// Maps the SGR parameters of a GB_COLOR_* escape onto the palette
+static uint8_t screen_color_from_sgr(const char* params, size_t length) {
+    static const struct { const char* params; uint8_t color; } table[] = {
+        { "90", SCREEN_COLOR_DARKEST },
+        { "37", SCREEN_COLOR_DARK },
+        { "97", SCREEN_COLOR_LIGHT },
+        { "1;97", SCREEN_COLOR_LIGHTEST },
+    };
+
+    for (size_t i = 0; i < sizeof(table) / sizeof(table[0]); i++) {
+        if (strlen(table[i].params) == length && memcmp(table[i].params, params, length) == 0) {
+            return table[i].color;
+        }
+    }
+    return SCREEN_COLOR_DEFAULT;
+}
+
+static void screen_feed(const char* text) {
+    const unsigned char* p = (const unsigned char*)text;
+
+    while (*p) {
+        unsigned char c = *p;
+
+        if (c == '\n') {
+            if (screen_row < 0xFF) screen_row++;
+            screen_col = 0;
+            p++;
+        } else if (c == '\r') {
+            screen_col = 0;
+            p++;
+        } else if (c == '\t') {
+            do {
+                screen_write_cell(" ", 1, screen_color);
+            } while (screen_col % 8 != 0 && screen_col < SCREEN_WIDTH);
+            p++;
+        } else if (c == 0x1B && p[1] == '[') {
+            // CSI: only color changes mean anything inside a frame
+            const unsigned char* params = p + 2;
+            const unsigned char* end = params;
+            while (*end && (*end < 0x40 || *end > 0x7E)) end++;
+            if (*end == 'm') {
+                screen_color = screen_color_from_sgr((const char*)params, (size_t)(end - params));
+            }
+            p = *end ? end + 1 : end;
+        } else if (c < 0x20 || c == 0x7F) {
+            p++;
+        } else {
+            // One cell per code point; 4-byte sequences do not fit a cell
+            uint8_t length = (c >= 0xF0) ? 4 : (c >= 0xE0) ? 3 : (c >= 0xC0) ? 2 : 1;
+            uint8_t available = 1;
+            while (available < length && p[available] != '\0') available++;
+
+            if (available < length || length == 4) {
+                screen_write_cell("?", 1, screen_color);
+            } else {
+                screen_write_cell((const char*)p, length, screen_color);
+            }
+            p += available;
+        }
+    }
+}
+
+void screen_begin_frame(void) {
+    screen_fill_blank(screen_back, 0);
+    screen_row = 0;
+    screen_col = 0;
+    screen_color = SCREEN_COLOR_DEFAULT;
+    screen_frame_open = true;
+}
+
+void screen_print(const char* format, ...) {
+    va_list args;
+    va_start(args, format);
+
+    if (!screen_frame_open) {
+        vprintf(format, args);
+    } else {
+        char text[1024];
+        vsnprintf(text, sizeof(text), format, args);
+        screen_feed(text);
+    }
+
+    va_end(args);
+}
+
+void screen_put_glyph(const char* glyph, ScreenColor color) {
+    if (!screen_frame_open) {
+        if (color == SCREEN_COLOR_DEFAULT) {
+            fputs(glyph, stdout);
+        } else {
+            printf("%s%s%s", screen_sgr[color], glyph, screen_sgr[SCREEN_COLOR_DEFAULT]);
+        }
+        return;
+    }
+
+    size_t length = strlen(glyph);
+    if (length == 0 || length > sizeof(screen_blank.glyph)) {
+        screen_write_cell("?", 1, color);
+    } else {
+        screen_write_cell(glyph, (uint8_t)length, color);
+    }
+}
+
+// ============================================================================
+// Presenting
+// ============================================================================
+
+static void screen_emit(const char* bytes, size_t length) {
+    if (screen_out_len + length > sizeof(screen_out)) return;
+    memcpy(screen_out + screen_out_len, bytes, length);
+    screen_out_len += length;
+}
+
+static void screen_emit_move(uint8_t row, uint8_t col) {
+    char sequence[16];
+    int length = snprintf(sequence, sizeof(sequence), "\033[%u;%uH", row + 1u, col + 1u);
+    screen_emit(sequence, (size_t)length);
+    screen_term_row = row;
+    screen_term_col = col;
+}
+
+static void screen_emit_cell(const ScreenCell* cell) {
+    if (cell->color != screen_term_color) {
+        screen_emit(screen_sgr[cell->color], strlen(screen_sgr[cell->color]));
+        screen_term_color = cell->color;
+    }
+
+    size_t length = 0;
+    while (length < sizeof(cell->glyph) && cell->glyph[length] != '\0') length++;
+    screen_emit(cell->glyph, length);
+    screen_term_col++;
+}
+
+static bool screen_cell_equal(const ScreenCell* a, const ScreenCell* b) {
+    return memcmp(a, b, sizeof(ScreenCell)) == 0;
+}
+
+static uint8_t screen_terminal_rows(void) {
+#ifdef _WIN32
+    CONSOLE_SCREEN_BUFFER_INFO info;
+    if (GetConsoleScreenBufferInfo(GetStdHandle(STD_OUTPUT_HANDLE), &info)) {
+        int rows = info.srWindow.Bottom - info.srWindow.Top + 1;
+        return rows > 0xFF ? 0xFF : (uint8_t)rows;
+    }
+#else
+    struct winsize size;
+    if (ioctl(STDOUT_FILENO, TIOCGWINSZ, &size) == 0 && size.ws_row > 0) {
+        return size.ws_row > 0xFF ? 0xFF : (uint8_t)size.ws_row;
+    }
+#endif
+    return 0; // Unknown (not a terminal) - assume everything fits
+}
+
+static void screen_flush_output(void) {
+    fflush(stdout); // Plain printf output must land before the frame
+#ifdef _WIN32
+    fwrite(screen_out, 1, screen_out_len, stdout);
+    fflush(stdout);
+#else
+    size_t written = 0;
+    while (written < screen_out_len) {
+        ssize_t result = write(STDOUT_FILENO, screen_out + written, screen_out_len - written);
+        if (result <= 0) break;
+        written += (size_t)result;
+    }
+#endif
+}
+
+// Taller than the terminal: cursor addressing would land on the wrong rows,
+// so clear and stream the frame top to bottom and let the terminal scroll
+static void screen_present_scrolling(uint8_t height) {
+    screen_emit("\033[H\033[2J", 7);
+    for (uint8_t row = 0; row < height; row++) {
+        uint8_t end = SCREEN_WIDTH;
+        while (end > 0 && screen_cell_equal(&screen_back[row][end - 1], &screen_blank)) end--;
+
+        for (uint8_t col = 0; col < end; col++) {
+            screen_emit_cell(&screen_back[row][col]);
+        }
+        if (screen_term_color != SCREEN_COLOR_DEFAULT) {
+            screen_emit(screen_sgr[SCREEN_COLOR_DEFAULT], strlen(screen_sgr[SCREEN_COLOR_DEFAULT]));
+            screen_term_color = SCREEN_COLOR_DEFAULT;
+        }
+        screen_emit("\n", 1);
+    }
+    screen_front_valid = false;
+}
+
+static void screen_present_diff(uint8_t height) {
+    if (!screen_front_valid) {
+        screen_emit("\033[H\033[2J", 7);
+        screen_fill_blank(screen_front, 0);
+        screen_front_rows = 0;
+        screen_front_valid = true;
+    }
+
+    for (uint8_t row = 0; row < height; row++) {
+        // Below the last frame there may be prompts printed since - wipe the line
+        if (row >= screen_front_rows) {
+            screen_emit_move(row, 0);
+            screen_emit("\033[2K", 4);
+        }
+
+        for (uint8_t col = 0; col < SCREEN_WIDTH; col++) {
+            const ScreenCell* cell = &screen_back[row][col];
+            if (screen_cell_equal(cell, &screen_front[row][col])) continue;
+
+            if (screen_term_row != row || col < screen_term_col || col - screen_term_col > SCREEN_MAX_SKIP) {
+                screen_emit_move(row, col);
+            } else {
+                // A short run of unchanged cells is cheaper to resend than to jump over
+                while (screen_term_col < col) {
+                    screen_emit_cell(&screen_back[row][screen_term_col]);
+                }
+            }
+
+            screen_emit_cell(cell);
+            screen_front[row][col] = *cell;
+        }
+    }
+
+    // Park the cursor under the frame and drop anything left below it
+    if (screen_term_color != SCREEN_COLOR_DEFAULT) {
+        screen_emit(screen_sgr[SCREEN_COLOR_DEFAULT], strlen(screen_sgr[SCREEN_COLOR_DEFAULT]));
+    }
+    screen_emit_move(height, 0);
+    screen_emit("\033[J", 3);
+    screen_fill_blank(screen_front, height);
+    screen_front_rows = height;
+}
+
+uint32_t screen_present(void) {
+    if (!screen_frame_open) return 0;
+    screen_frame_open = false;
+
+    uint8_t height = screen_col > 0 ? screen_row + 1 : screen_row;
+    if (height > SCREEN_HEIGHT) height = SCREEN_HEIGHT;
+
+    screen_out_len = 0;
+    screen_term_row = SCREEN_CURSOR_UNKNOWN;
+    screen_term_col = SCREEN_CURSOR_UNKNOWN;
+    screen_term_color = SCREEN_COLOR_DEFAULT;
+
+    uint8_t terminal_rows = screen_terminal_rows();
+    if (terminal_rows > 0 && height + SCREEN_TRAILING_ROWS > terminal_rows) {
+        screen_present_scrolling(height);
+    } else {
+        screen_present_diff(height);
+    }
+
+    screen_flush_output();
+    return (uint32_t)screen_out_len;
+}
+
+void screen_invalidate(void) {
+    screen_front_valid = false;
+}
+
+void screen_clear(void) {
+    fputs("\033[H\033[2J", stdout);
+    fflush(stdout);
+
+    // The terminal is known blank now; anything printed next sits below row 0
+    screen_fill_blank(screen_front, 0);
+    screen_front_rows = 0;
+    screen_front_valid = true;
+}
@@ -0,0 +1,38 @@
+#ifndef SCREEN_H
+#define SCREEN_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+// Double-buffered terminal renderer. A frame is drawn into a back buffer of
+// cells, then screen_present() compares it with what is already on the
+// terminal and emits only the changed cells - cursor jumps, coalesced color
+// runs and all - in a single write. Outside a frame, screen_print() is plain
+// printf, so display helpers work both ways.
+#define SCREEN_WIDTH 80
+#define SCREEN_HEIGHT 48
+
+// The GameBoy palette from utils.c; GB_COLOR_* escapes in printed text map onto these
+typedef enum {
+    SCREEN_COLOR_DEFAULT = 0,
+    SCREEN_COLOR_DARKEST,
+    SCREEN_COLOR_DARK,
+    SCREEN_COLOR_LIGHT,
+    SCREEN_COLOR_LIGHTEST,
+    SCREEN_COLOR_COUNT
+} ScreenColor;
+
+// One terminal cell: a UTF-8 glyph of up to 3 bytes (NUL padded) plus color
+typedef struct {
+    char glyph[3];
+    uint8_t color;
+} ScreenCell;
+
+void screen_begin_frame(void);  // Start a new frame at the top-left corner
+void screen_print(const char* format, ...); // printf into the frame (or stdout outside one)
+void screen_put_glyph(const char* glyph, ScreenColor color); // One cell at the cursor
+uint32_t screen_present(void);  // Ends the frame; returns bytes sent to the terminal
+void screen_invalidate(void);   // Terminal contents unknown - next present repaints all
+void screen_clear(void);        // Clear the terminal without spawning a shell
+
+#endif // SCREEN_H
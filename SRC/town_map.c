@@ -0,0 +1,160 @@
+#include "town_map.h"
+#include <stdio.h>
+#include <string.h>
+
+TownMap* g_current_town = NULL;
+
+typedef struct {
+    const char* name;             // As on the world map
+    void (*init)(TownMap* map);
+} TownMapSource;
+
+static const TownMapSource town_sources[TOWN_MAP_COUNT] = {
+    { "Greenleaf", greenleaf_init },
+    { "Coral Bay", coral_bay_init },
+    { "Emberforge", emberforge_init },
+    { "Windspire", windspire_init },
+};
+
+static TownMap town_cache[TOWN_MAP_COUNT];
+static bool town_cache_loaded[TOWN_MAP_COUNT];
+
+// Flood fill work list, shared by every index build
+static uint16_t town_fill_queue[TOWN_MAP_SIZE];
+
+static const int8_t town_dx[4] = { 0, 0, -1, 1 };
+static const int8_t town_dy[4] = { -1, 1, 0, 0 };
+
+// ============================================================================
+// Building index
+// ============================================================================
+
+static bool town_is_building_tile(uint8_t tile) {
+    switch (tile) {
+        case TOWN_TILE_ROOF_TOP:
+        case TOWN_TILE_ROOF_MID:
+        case TOWN_TILE_ROOF_PEAK:
+        case TOWN_TILE_WINDOW_LARGE:
+        case TOWN_TILE_WINDOW_SMALL:
+        case TOWN_TILE_DOOR:
+            return true;
+        default:
+            return false;
+    }
+}
+
+static TownBuildingType town_sign_building(uint8_t tile) {
+    switch (tile) {
+        case TOWN_TILE_SIGN_INN:    return BUILDING_INN;
+        case TOWN_TILE_SIGN_ITEM:
+        case TOWN_TILE_SIGN_MAGIC:  return BUILDING_ITEM_SHOP;
+        case TOWN_TILE_SIGN_ARMOR:
+        case TOWN_TILE_SIGN_WEAPON: return BUILDING_EQUIPMENT_SHOP;
+        case TOWN_TILE_SIGN_CLINIC: return BUILDING_CHURCH;
+        default:                    return BUILDING_NONE;
+    }
+}
+
+// Labels every tile of one building (4-connected roof, wall and door tiles)
+// with its id; the sign over the top row says what it is, no sign is a house
+static void town_index_building(TownMap* map, uint8_t start_x, uint8_t start_y) {
+    uint8_t id = (uint8_t)(map->building_count + 1);
+    TownBuilding* building = &map->buildings[map->building_count++];
+    uint8_t top = start_y, left = start_x, right = start_x;
+    uint16_t head = 0, tail = 0;
+
+    building->type = BUILDING_HOUSE;
+    building->door_x = start_x;
+    building->door_y = start_y;
+
+    map->building_id[start_y][start_x] = id;
+    town_fill_queue[tail++] = (uint16_t)start_y * TOWN_MAP_WIDTH + start_x;
+
+    while (head < tail) {
+        uint8_t x = (uint8_t)(town_fill_queue[head] % TOWN_MAP_WIDTH);
+        uint8_t y = (uint8_t)(town_fill_queue[head++] / TOWN_MAP_WIDTH);
+
+        if (map->tiles[y][x] == TOWN_TILE_DOOR) {
+            building->door_x = x;
+            building->door_y = y;
+        }
+        if (y < top) top = y;
+        if (x < left) left = x;
+        if (x > right) right = x;
+
+        for (uint8_t direction = 0; direction < 4; direction++) {
+            int nx = x + town_dx[direction];
+            int ny = y + town_dy[direction];
+            if (nx < 0 || ny < 0 || nx >= map->width || ny >= map->height) continue;
+            if (map->building_id[ny][nx] || !town_is_building_tile(map->tiles[ny][nx])) continue;
+
+            map->building_id[ny][nx] = id;
+            town_fill_queue[tail++] = (uint16_t)(ny * TOWN_MAP_WIDTH + nx);
+        }
+    }
+
+    if (top == 0) return;
+    for (uint8_t x = left; x <= right; x++) {
+        TownBuildingType type = town_sign_building(map->tiles[top - 1][x]);
+        if (type != BUILDING_NONE) {
+            building->type = type;
+            break;
+        }
+    }
+}
+
+static void town_build_index(TownMap* map) {
+    memset(map->building_id, 0, sizeof(map->building_id));
+    map->building_count = 0;
+
+    for (uint8_t y = 0; y < map->height; y++) {
+        for (uint8_t x = 0; x < map->width; x++) {
+            if (map->building_id[y][x] || !town_is_building_tile(map->tiles[y][x])) continue;
+
+            if (map->building_count >= TOWN_MAX_BUILDINGS) {
+                printf("Error: Town has more than %d buildings\n", TOWN_MAX_BUILDINGS);
+                return;
+            }
+            town_index_building(map, x, y);
+        }
+    }
+}
+
+// ============================================================================
+// Town map functions
+// ============================================================================
+
+bool town_map_load(const char* town_name) {
+    if (!town_name) return false;
+
+    for (uint8_t i = 0; i < TOWN_MAP_COUNT; i++) {
+        if (strcmp(town_sources[i].name, town_name) != 0) continue;
+
+        // First visit copies the tiles and indexes the buildings; later ones reuse them
+        if (!town_cache_loaded[i]) {
+            town_sources[i].init(&town_cache[i]);
+            town_build_index(&town_cache[i]);
+            town_cache_loaded[i] = true;
+        }
+        g_current_town = &town_cache[i];
+        return true;
+    }
+    return false;
+}
+
+uint8_t town_map_get_tile(uint8_t x, uint8_t y) {
+    if (!g_current_town || x >= g_current_town->width || y >= g_current_town->height) return TOWN_TILE_GRASS;
+    return g_current_town->tiles[y][x];
+}
+
+uint8_t town_map_is_passable(uint8_t x, uint8_t y) {
+    if (!g_current_town || x >= g_current_town->width || y >= g_current_town->height) return 0;
+    return g_current_town->collision[y][x] == 0;
+}
+
+TownBuildingType town_map_get_building_at(uint8_t x, uint8_t y) {
+    if (!g_current_town || x >= g_current_town->width || y >= g_current_town->height) return BUILDING_NONE;
+
+    uint8_t id = g_current_town->building_id[y][x];
+    return id ? g_current_town->buildings[id - 1].type : BUILDING_NONE;
+}
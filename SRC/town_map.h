@@ -2,6 +2,7 @@
 #define TOWN_MAP_H
 
 #include <stdint.h>
+#include <stdbool.h>
 
 // Town Map Dimensions
 // Towns are smaller than the world map, typically 32×32 tiles
@@ -9,6 +10,29 @@
 #define TOWN_MAP_HEIGHT 32
 #define TOWN_MAP_SIZE   (TOWN_MAP_WIDTH * TOWN_MAP_HEIGHT)
 
+// Rows of the town shown around the player (the full width fits)
+#define TOWN_VIEW_HEIGHT 14
+
+// Corneria metasprite IDs the runtime looks at (see generate_*.py)
+#define TOWN_TILE_PATH          4
+#define TOWN_TILE_GRASS         8
+#define TOWN_TILE_ROOF_TOP      9
+#define TOWN_TILE_ROOF_MID      11
+#define TOWN_TILE_SIGN_MAGIC    14
+#define TOWN_TILE_ROOF_PEAK     15
+#define TOWN_TILE_SIGN_CLINIC   16
+#define TOWN_TILE_WINDOW_LARGE  17
+#define TOWN_TILE_DOOR          18
+#define TOWN_TILE_SIGN_ARMOR    26
+#define TOWN_TILE_SIGN_WEAPON   27
+#define TOWN_TILE_SIGN_ITEM     28
+#define TOWN_TILE_WINDOW_SMALL  30
+#define TOWN_TILE_SIGN_INN      35
+#define TOWN_TILE_COUNT         36
+
+#define TOWN_MAP_COUNT     4    // Towns with map data (Greenleaf, Coral Bay, Emberforge, Windspire)
+#define TOWN_MAX_BUILDINGS 16
+
 // Building/Location Types
 typedef enum {
     BUILDING_NONE = 0,
@@ -23,6 +47,13 @@ typedef enum {
     BUILDING_LIBRARY            // Lore/hints
 } TownBuildingType;
 
+// One building: roof, wall and door tiles joined up, typed by the sign above it
+typedef struct {
+    TownBuildingType type;
+    uint8_t door_x;
+    uint8_t door_y;
+} TownBuilding;
+
 // Town Map Structure
 typedef struct {
     uint8_t width;
@@ -31,6 +62,9 @@ typedef struct {
     uint8_t collision[TOWN_MAP_HEIGHT][TOWN_MAP_WIDTH];  // Collision flags (0=walk, 1=blocked)
     uint8_t entrance_x;                                   // Entry point from world map
     uint8_t entrance_y;
+    uint8_t building_id[TOWN_MAP_HEIGHT][TOWN_MAP_WIDTH]; // 0 = street, else buildings[id - 1]
+    TownBuilding buildings[TOWN_MAX_BUILDINGS];
+    uint8_t building_count;
 } TownMap;
 
 // NPC data structure
@@ -41,8 +75,9 @@ typedef struct {
     uint8_t sprite_id;
 } TownNPC;
 
-// Global town map instance
-extern TownMap g_current_town;
+// Town the party is in: points into the town cache, NULL before the first load.
+// Each town is copied and indexed once; switching back is a pointer swap.
+extern TownMap* g_current_town;
 
 // Town initialization functions
 void greenleaf_init(TownMap* map);
@@ -51,7 +86,7 @@ void emberforge_init(TownMap* map);
 void windspire_init(TownMap* map);
 
 // Town map functions
-void town_map_load(const char* town_name);
+bool town_map_load(const char* town_name);  // false if the town has no map data
 uint8_t town_map_get_tile(uint8_t x, uint8_t y);
 uint8_t town_map_is_passable(uint8_t x, uint8_t y);
 TownBuildingType town_map_get_building_at(uint8_t x, uint8_t y);
@@ -1,8 +1,15 @@
+#ifndef _WIN32
+#define _POSIX_C_SOURCE 200809L
+#endif
+
 #include "utils.h"
 #include "game_state.h"
 #include "party.h"
 #include "battle.h"
 #include "dungeon.h"
+#include "screen.h"
+#include "world_map.h"
+#include "town_map.h"
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
@@ -10,10 +17,12 @@
 
 #ifdef _WIN32
 #include <conio.h>
+#include <windows.h>
 #else
 #include <termios.h>
 #include <unistd.h>
-#include <fcntl.h>
+#include <poll.h>
+#include <signal.h>
 #endif
 
 // External references
@@ -41,26 +50,152 @@ extern const char* job_names[MAX_JOB_TYPES];
 #define TILE_CHAR_PLAYER    "◉"  // Fisheye for player
 #define TILE_CHAR_UNKNOWN   "░"  // Light shade for unexplored
 
-// Simple LCG random number generator
-static uint32_t random_seed_value = 12345;
+// ============================================================================
+// Random number generation (xoshiro128** streams)
+// ============================================================================
 
-void random_seed(uint32_t seed) {
-    random_seed_value = seed;
+static RandomStream random_streams[RNG_STREAM_COUNT];
+static bool random_streams_seeded = false;
+
+static uint32_t random_rotl(uint32_t x, int k) {
+    return (x << k) | (x >> (32 - k));
 }
 
-uint8_t random_range(uint8_t min, uint8_t max) {
+// SplitMix64 expands a seed into well-mixed state words
+static uint64_t random_splitmix64(uint64_t* x) {
+    uint64_t z = (*x += 0x9E3779B97F4A7C15ULL);
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+    return z ^ (z >> 31);
+}
+
+void random_stream_seed(RandomStream* stream, uint64_t seed) {
+    uint64_t a = random_splitmix64(&seed);
+    uint64_t b = random_splitmix64(&seed);
+
+    stream->s[0] = (uint32_t)a;
+    stream->s[1] = (uint32_t)(a >> 32);
+    stream->s[2] = (uint32_t)b;
+    stream->s[3] = (uint32_t)(b >> 32);
+
+    // All-zero state is the one invalid state
+    if ((stream->s[0] | stream->s[1] | stream->s[2] | stream->s[3]) == 0) {
+        stream->s[0] = 1;
+    }
+}
+
+uint32_t random_stream_next(RandomStream* stream) {
+    uint32_t* s = stream->s;
+    const uint32_t result = random_rotl(s[1] * 5, 7) * 9;
+    const uint32_t t = s[1] << 9;
+
+    s[2] ^= s[0];
+    s[3] ^= s[1];
+    s[1] ^= s[2];
+    s[0] ^= s[3];
+    s[2] ^= t;
+    s[3] = random_rotl(s[3], 11);
+
+    return result;
+}
+
+void random_stream_jump(RandomStream* stream) {
+    static const uint32_t jump[] = { 0x8764000b, 0xf542d2d3, 0x6fa035c3, 0x77f2db5b };
+    uint32_t s0 = 0, s1 = 0, s2 = 0, s3 = 0;
+
+    for (int i = 0; i < 4; i++) {
+        for (int b = 0; b < 32; b++) {
+            if (jump[i] & (1u << b)) {
+                s0 ^= stream->s[0];
+                s1 ^= stream->s[1];
+                s2 ^= stream->s[2];
+                s3 ^= stream->s[3];
+            }
+            random_stream_next(stream);
+        }
+    }
+
+    stream->s[0] = s0;
+    stream->s[1] = s1;
+    stream->s[2] = s2;
+    stream->s[3] = s3;
+}
+
+void random_stream_split(RandomStream* parent, RandomStream* child) {
+    *child = *parent;
+    random_stream_jump(parent);
+}
+
+uint32_t random_stream_bounded(RandomStream* stream, uint32_t bound) {
+    if (bound <= 1) return 0;
+
+    // Lemire's multiply-shift with rejection - no modulo bias
+    uint64_t m = (uint64_t)random_stream_next(stream) * bound;
+    uint32_t low = (uint32_t)m;
+    if (low < bound) {
+        uint32_t threshold = (0u - bound) % bound;
+        while (low < threshold) {
+            m = (uint64_t)random_stream_next(stream) * bound;
+            low = (uint32_t)m;
+        }
+    }
+
+    return (uint32_t)(m >> 32);
+}
+
+uint32_t random_stream_range(RandomStream* stream, uint32_t min, uint32_t max) {
     if (min >= max) return min;
-    
-    random_seed_value = random_seed_value * 1103515245 + 12345;
-    uint32_t range = max - min + 1;
-    return min + ((random_seed_value / 65536) % range);
+    return min + random_stream_bounded(stream, max - min + 1);
 }
 
-bool random_chance(uint8_t percentage) {
+bool random_stream_chance(RandomStream* stream, uint8_t percentage) {
     if (percentage >= 100) return true;
     if (percentage == 0) return false;
-    
-    return random_range(0, 99) < percentage;
+
+    return random_stream_bounded(stream, 100) < percentage;
+}
+
+void random_stream_fill(RandomStream* stream, uint32_t* out, size_t count) {
+    for (size_t i = 0; i < count; i++) {
+        out[i] = random_stream_next(stream);
+    }
+}
+
+void random_stream_fill_range(RandomStream* stream, uint8_t* out, size_t count, uint8_t min, uint8_t max) {
+    if (min >= max) {
+        memset(out, min, count);
+        return;
+    }
+
+    uint32_t bound = (uint32_t)(max - min) + 1;
+    for (size_t i = 0; i < count; i++) {
+        out[i] = (uint8_t)(min + random_stream_bounded(stream, bound));
+    }
+}
+
+void random_seed(uint32_t seed) {
+    RandomStream master;
+    random_stream_seed(&master, seed);
+
+    // Hand each subsystem its own non-overlapping block of the master sequence
+    for (int i = 0; i < RNG_STREAM_COUNT; i++) {
+        random_stream_split(&master, &random_streams[i]);
+    }
+    random_streams_seeded = true;
+}
+
+RandomStream* random_get_stream(RandomStreamId id) {
+    if (!random_streams_seeded) random_seed(12345);
+    if (id >= RNG_STREAM_COUNT) id = RNG_STREAM_GENERAL;
+    return &random_streams[id];
+}
+
+uint8_t random_range(uint8_t min, uint8_t max) {
+    return (uint8_t)random_stream_range(random_get_stream(RNG_STREAM_GENERAL), min, max);
+}
+
+bool random_chance(uint8_t percentage) {
+    return random_stream_chance(random_get_stream(RNG_STREAM_GENERAL), percentage);
 }
 
 void safe_string_copy(char* dest, const char* src, uint8_t max_length) {
@@ -126,100 +261,300 @@ bool safe_scanf_string(char* buffer, size_t buffer_size) {
 }
 
 void clear_screen(void) {
+    // ANSI clear instead of system("clear") - no process spawned per screen
+    screen_clear();
+}
+
+// ============================================================================
+// Input
+// ============================================================================
+//
+// Raw mode is entered once, on the first key read, and restored at exit. Keys
+// arrive through a small queue: bytes are read in bursts, escape sequences are
+// parsed into buttons, and waiting blocks in poll() instead of spinning.
+
+#define INPUT_QUEUE_SIZE 32
+#define INPUT_BYTE_BUFFER_SIZE 64
+#define INPUT_ESCAPE_WAIT_MS 25 // A lone ESC is a key once nothing follows it this long
+
+static uint8_t input_queue[INPUT_QUEUE_SIZE]; // InputButton values; INPUT_NONE = unmapped key
+static uint8_t input_queue_head = 0;
+static uint8_t input_queue_count = 0;
+static bool input_closed = false;            // stdin reached EOF
+
+static void input_enqueue(InputButton button) {
+    if (input_queue_count == INPUT_QUEUE_SIZE) return; // Typed far ahead - drop the newest
+    input_queue[(input_queue_head + input_queue_count) % INPUT_QUEUE_SIZE] = (uint8_t)button;
+    input_queue_count++;
+}
+
+static bool input_dequeue(bool accept_unmapped, InputButton* out) {
+    while (input_queue_count > 0) {
+        InputButton button = (InputButton)input_queue[input_queue_head];
+        input_queue_head = (input_queue_head + 1) % INPUT_QUEUE_SIZE;
+        input_queue_count--;
+
+        if (button != INPUT_NONE || accept_unmapped) {
+            *out = button;
+            return true;
+        }
+    }
+    return false;
+}
+
+static InputButton input_map_char(int ch) {
+    switch (ch) {
+        case 'w': case 'W': return INPUT_UP;
+        case 's': case 'S': return INPUT_DOWN;
+        case 'a': case 'A': return INPUT_LEFT;
+        case 'd': case 'D': return INPUT_RIGHT;
+        case 'z': case 'Z': case ' ': return INPUT_A;
+        case 'x': case 'X': case 27: return INPUT_B; // ESC
+        case '\r': case '\n': return INPUT_START; // Enter
+        case '\t': case 'i': case 'I': return INPUT_SELECT;
+    }
+    return INPUT_NONE;
+}
+
+static uint64_t input_now_ms(void) {
 #ifdef _WIN32
-    int result = system("cls");
-    (void)result; // Intentionally unused
+    return (uint64_t)GetTickCount64();
 #else
-    int result = system("clear");
-    (void)result; // Intentionally unused
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000u + (uint64_t)(ts.tv_nsec / 1000000);
 #endif
 }
 
-InputButton input_get_key(void) {
 #ifdef _WIN32
-    if (_kbhit()) {
+
+// Reads every pending key; true if anything arrived
+static bool input_pump(int32_t timeout_ms) {
+    if (!_kbhit() && timeout_ms != 0) {
+        // Wakes on any console event; _kbhit() below filters out the rest
+        WaitForSingleObject(GetStdHandle(STD_INPUT_HANDLE),
+                            timeout_ms < 0 ? INFINITE : (DWORD)timeout_ms);
+    }
+
+    bool received = false;
+    while (_kbhit()) {
         int ch = _getch();
-        
-        // Arrow keys are two-byte sequences on Windows
-        if (ch == 224) {
-            ch = _getch();
-            switch (ch) {
-                case 72: return INPUT_UP;
-                case 80: return INPUT_DOWN;
-                case 75: return INPUT_LEFT;
-                case 77: return INPUT_RIGHT;
+
+        // Arrow and function keys are two-byte sequences on Windows
+        if (ch == 0 || ch == 224) {
+            switch (_getch()) {
+                case 72: input_enqueue(INPUT_UP); break;
+                case 80: input_enqueue(INPUT_DOWN); break;
+                case 75: input_enqueue(INPUT_LEFT); break;
+                case 77: input_enqueue(INPUT_RIGHT); break;
+                default: input_enqueue(INPUT_NONE); break;
             }
+        } else {
+            input_enqueue(input_map_char(ch));
         }
-        
-        switch (ch) {
-            case 'w': case 'W': return INPUT_UP;
-            case 's': case 'S': return INPUT_DOWN;
-            case 'a': case 'A': return INPUT_LEFT;
-            case 'd': case 'D': return INPUT_RIGHT;
-            case 'z': case 'Z': case ' ': return INPUT_A;
-            case 'x': case 'X': case 27: return INPUT_B; // ESC
-            case 13: return INPUT_START; // Enter
-            case '\t': case 'i': case 'I': return INPUT_SELECT;
-        }
+        received = true;
+    }
+    return received;
+}
+
+static void input_discard_pending(void) {
+    while (_kbhit()) {
+        _getch();
     }
+}
+
 #else
-    // Non-blocking input for Unix-like systems
-    struct termios oldt, newt;
-    int ch;
-    int oldf;
-    
-    tcgetattr(STDIN_FILENO, &oldt);
-    newt = oldt;
-    newt.c_lflag &= ~(ICANON | ECHO);
-    tcsetattr(STDIN_FILENO, TCSANOW, &newt);
-    oldf = fcntl(STDIN_FILENO, F_GETFL, 0);
-    fcntl(STDIN_FILENO, F_SETFL, oldf | O_NONBLOCK);
-    
-    ch = getchar();
-    
-    tcsetattr(STDIN_FILENO, TCSANOW, &oldt);
-    fcntl(STDIN_FILENO, F_SETFL, oldf);
-    
-    if (ch != EOF) {
-        switch (ch) {
-            case 'w': case 'W': return INPUT_UP;
-            case 's': case 'S': return INPUT_DOWN;
-            case 'a': case 'A': return INPUT_LEFT;
-            case 'd': case 'D': return INPUT_RIGHT;
-            case 'z': case 'Z': case ' ': return INPUT_A;
-            case 'x': case 'X': case 27: return INPUT_B;
-            case '\n': return INPUT_START;
-            case '\t': case 'i': case 'I': return INPUT_SELECT;
+
+static struct termios input_saved_termios;
+static bool input_raw_active = false;
+static uint8_t input_bytes[INPUT_BYTE_BUFFER_SIZE]; // Read but not yet parsed
+static uint8_t input_byte_count = 0;
+
+static void input_raw_disable(void) {
+    if (input_raw_active) {
+        tcsetattr(STDIN_FILENO, TCSANOW, &input_saved_termios);
+        input_raw_active = false;
+    }
+}
+
+static void input_signal_restore(int sig) {
+    input_raw_disable(); // tcsetattr is async-signal-safe
+    signal(sig, SIG_DFL);
+    raise(sig);
+}
+
+// Unbuffered, no echo; Ctrl-C still works and puts the terminal back first
+static void input_raw_enable(void) {
+    static bool attempted = false;
+    if (attempted) return;
+    attempted = true;
+
+    if (!isatty(STDIN_FILENO) || tcgetattr(STDIN_FILENO, &input_saved_termios) != 0) return;
+
+    struct termios raw = input_saved_termios;
+    raw.c_lflag &= ~(ICANON | ECHO);
+    raw.c_cc[VMIN] = 1;
+    raw.c_cc[VTIME] = 0;
+    if (tcsetattr(STDIN_FILENO, TCSANOW, &raw) != 0) return;
+
+    input_raw_active = true;
+    atexit(input_raw_disable);
+    signal(SIGINT, input_signal_restore);
+    signal(SIGTERM, input_signal_restore);
+    signal(SIGHUP, input_signal_restore);
+}
+
+// Turns buffered bytes into buttons. A sequence cut off at the end of the
+// buffer is kept for the next read unless flush_partial is set.
+static void input_parse_bytes(bool flush_partial) {
+    uint8_t pos = 0;
+
+    while (pos < input_byte_count) {
+        uint8_t ch = input_bytes[pos];
+
+        if (ch != 27) {
+            input_enqueue(input_map_char(ch));
+            pos++;
+            continue;
+        }
+
+        // ESC [ ... final or ESC O final (arrow keys in application mode)
+        if (pos + 1 >= input_byte_count) {
+            if (!flush_partial) break;
+            input_enqueue(INPUT_B);
+            pos++;
+            continue;
+        }
+
+        uint8_t introducer = input_bytes[pos + 1];
+        if (introducer != '[' && introducer != 'O') {
+            input_enqueue(INPUT_B); // ESC followed by an ordinary key
+            pos++;
+            continue;
+        }
+
+        uint8_t end = pos + 2;
+        while (end < input_byte_count && input_bytes[end] >= 0x20 && input_bytes[end] <= 0x3F) end++;
+        if (end >= input_byte_count) {
+            if (!flush_partial) break;
+            input_enqueue(INPUT_NONE); // Truncated sequence - swallow it
+            pos = input_byte_count;
+            break;
+        }
+
+        switch (input_bytes[end]) {
+            case 'A': input_enqueue(INPUT_UP); break;
+            case 'B': input_enqueue(INPUT_DOWN); break;
+            case 'C': input_enqueue(INPUT_RIGHT); break;
+            case 'D': input_enqueue(INPUT_LEFT); break;
+            default: input_enqueue(INPUT_NONE); break; // Home, F-keys, ...
+        }
+        pos = end + 1;
+    }
+
+    memmove(input_bytes, input_bytes + pos, input_byte_count - pos);
+    input_byte_count -= pos;
+}
+
+static bool input_read_bytes(int32_t timeout_ms) {
+    struct pollfd pfd = { STDIN_FILENO, POLLIN, 0 };
+    if (poll(&pfd, 1, timeout_ms) <= 0) return false;
+
+    ssize_t result = read(STDIN_FILENO, input_bytes + input_byte_count,
+                          sizeof(input_bytes) - input_byte_count);
+    if (result <= 0) {
+        if (result == 0) input_closed = true;
+        return false;
+    }
+    input_byte_count += (uint8_t)result;
+    return true;
+}
+
+// Reads whatever is pending (waiting up to timeout_ms for the first byte); true if anything arrived
+static bool input_pump(int32_t timeout_ms) {
+    input_raw_enable();
+    if (input_closed) return false;
+
+    uint8_t queued = input_queue_count;
+    if (!input_read_bytes(timeout_ms)) return false;
+
+    input_parse_bytes(false);
+    if (input_byte_count > 0) {
+        // Mid-sequence: the rest of an escape sequence arrives within a few ms
+        while (input_byte_count > 0 && input_byte_count < sizeof(input_bytes) &&
+               input_read_bytes(INPUT_ESCAPE_WAIT_MS)) {
+            input_parse_bytes(false);
         }
+        input_parse_bytes(true);
     }
+    return input_queue_count != queued;
+}
+
+static void input_discard_pending(void) {
+    input_byte_count = 0;
+    tcflush(STDIN_FILENO, TCIFLUSH);
+}
+
 #endif
-    
-    return INPUT_NONE;
+
+// Next queued key, waiting up to timeout_ms (INPUT_WAIT_FOREVER blocks)
+static bool input_next(int32_t timeout_ms, bool accept_unmapped, InputButton* out) {
+    uint64_t deadline = timeout_ms > 0 ? input_now_ms() + (uint64_t)timeout_ms : 0;
+
+    for (;;) {
+        if (input_dequeue(accept_unmapped, out)) return true;
+
+        if (input_closed) {
+            // Nothing can ever arrive again; blocking would hang the game
+            if (timeout_ms < 0) {
+                printf("\nInput closed.\n");
+                exit(0);
+            }
+            return false;
+        }
+
+        int32_t wait = timeout_ms;
+        if (timeout_ms > 0) {
+            uint64_t now = input_now_ms();
+            if (now >= deadline) return false;
+            wait = (int32_t)(deadline - now);
+        }
+
+        bool received = input_pump(wait);
+        if (!received && timeout_ms == 0) return false;
+    }
+}
+
+InputButton input_get_key(void) {
+    InputButton button = INPUT_NONE;
+    input_next(0, false, &button);
+    return button;
+}
+
+InputButton input_wait_key(int32_t timeout_ms) {
+    InputButton button = INPUT_NONE;
+    input_next(timeout_ms, false, &button);
+    return button;
 }
 
 void input_wait_for_key(void) {
     printf("\nPress any key to continue...");
     fflush(stdout);
 
-#ifdef _WIN32
-    _getch();
-#else
-    getchar();
-#endif
+    InputButton button;
+    input_next(INPUT_WAIT_FOREVER, true, &button);
 
     printf("\n");
+
+    // The message may have scrolled the terminal under the last frame
+    screen_invalidate();
 }
 
 void input_flush_buffer(void) {
-    // Flush stdin to clear any leftover input (like newlines from scanf)
-#ifdef _WIN32
-    while (_kbhit()) {
-        _getch();
-    }
-#else
-    int c;
-    while ((c = getchar()) != '\n' && c != EOF);
-#endif
+    // Drop keys typed ahead during a message or animation
+    input_queue_head = 0;
+    input_queue_count = 0;
+    input_discard_pending();
 }
 
 void display_text(const char* text) {
@@ -241,23 +576,23 @@ void display_menu(const char* title, const char** options, uint8_t option_count,
 void display_party_status(void) {
     if (!g_game_state.party) return;
     
-    printf("\n=== PARTY STATUS ===\n");
-    printf("Gold: %d\n\n", g_game_state.gold);
+    screen_print("\n=== PARTY STATUS ===\n");
+    screen_print("Gold: %d\n\n", g_game_state.gold);
     
     for (uint8_t i = 0; i < g_game_state.party->member_count; i++) {
         PartyMember* member = &g_game_state.party->members[i];
-        printf("%s (Lv%d %s)\n", member->name, member->stats.level, job_names[member->job]);
-        printf("  HP: %d/%d  MP: %d/%d\n", 
+        screen_print("%s (Lv%d %s)\n", member->name, member->stats.level, job_names[member->job]);
+        screen_print("  HP: %d/%d  MP: %d/%d\n", 
                member->stats.current_hp, member->stats.max_hp,
                member->stats.current_mp, member->stats.max_mp);
         
         if (member->status_effects != STATUS_NONE) {
-            printf("  Status: ");
-            if (member->status_effects & STATUS_POISON) printf("POISON ");
-            if (member->status_effects & STATUS_PARALYSIS) printf("PARALYSIS ");
-            if (member->status_effects & STATUS_SLEEP) printf("SLEEP ");
-            if (member->status_effects & STATUS_DEAD) printf("DEAD ");
-            printf("\n");
+            screen_print("  Status: ");
+            if (member->status_effects & STATUS_POISON) screen_print("POISON ");
+            if (member->status_effects & STATUS_PARALYSIS) screen_print("PARALYSIS ");
+            if (member->status_effects & STATUS_SLEEP) screen_print("SLEEP ");
+            if (member->status_effects & STATUS_DEAD) screen_print("DEAD ");
+            screen_print("\n");
         }
     }
 }
@@ -313,19 +648,19 @@ void display_battle_scene(void) {
     // Top: Enemy sprites (left) | Enemy HP/Stats (right)
     // Bottom: Party sprites (left) | Party HP/MP + Menu (right)
 
-    printf("\n");
-    printf("┌─────────────────────────────────┬─────────────────────────────────┐\n");
-    printf("│ ENEMY SPRITES                   │ ENEMY HP / STATS                │\n");
-    printf("├─────────────────────────────────┼─────────────────────────────────┤\n");
+    screen_print("\n");
+    screen_print("┌─────────────────────────────────┬─────────────────────────────────┐\n");
+    screen_print("│ ENEMY SPRITES                   │ ENEMY HP / STATS                │\n");
+    screen_print("├─────────────────────────────────┼─────────────────────────────────┤\n");
 
     // Display enemies (both sides)
     if (g_battle_state.is_boss_battle && g_battle_state.boss) {
         // Boss battle
-        printf("│                                 │ BOSS: %-25s │\n", g_battle_state.boss->name);
-        printf("│         [BOSS SPRITE]           │ HP: %4d/%4d                     │\n",
+        screen_print("│                                 │ BOSS: %-25s │\n", g_battle_state.boss->name);
+        screen_print("│         [BOSS SPRITE]           │ HP: %4d/%4d                     │\n",
                g_battle_state.boss->current_hp, g_battle_state.boss->max_hp);
-        printf("│                                 │                                 │\n");
-        printf("│                                 │                                 │\n");
+        screen_print("│                                 │                                 │\n");
+        screen_print("│                                 │                                 │\n");
     } else {
         // Regular enemies (show up to 4)
         for (uint8_t i = 0; i < 4; i++) {
@@ -336,27 +671,27 @@ void display_battle_scene(void) {
                     get_status_indicators(enemy->status_effects, status_buf, sizeof(status_buf));
 
                     if (strlen(status_buf) > 0) {
-                        printf("│   [%c]%-26s │ %d.%-10s HP:%4d/%4d [%s] │\n",
+                        screen_print("│   [%c]%-26s │ %d.%-10s HP:%4d/%4d [%s] │\n",
                                'A' + i, enemy->name, i+1, enemy->name,
                                enemy->current_hp, enemy->max_hp, status_buf);
                     } else {
-                        printf("│   [%c]%-26s │ %d.%-15s HP:%4d/%4d │\n",
+                        screen_print("│   [%c]%-26s │ %d.%-15s HP:%4d/%4d │\n",
                                'A' + i, enemy->name, i+1, enemy->name,
                                enemy->current_hp, enemy->max_hp);
                     }
                 } else {
-                    printf("│   [X]%-26s │ %d.%-15s [DEFEATED]    │\n",
+                    screen_print("│   [X]%-26s │ %d.%-15s [DEFEATED]    │\n",
                            enemy->name, i+1, enemy->name);
                 }
             } else {
-                printf("│                                 │                                 │\n");
+                screen_print("│                                 │                                 │\n");
             }
         }
     }
 
-    printf("├─────────────────────────────────┼─────────────────────────────────┤\n");
-    printf("│ PARTY SPRITES                   │ PARTY HP / MP                   │\n");
-    printf("├─────────────────────────────────┼─────────────────────────────────┤\n");
+    screen_print("├─────────────────────────────────┼─────────────────────────────────┤\n");
+    screen_print("│ PARTY SPRITES                   │ PARTY HP / MP                   │\n");
+    screen_print("├─────────────────────────────────┼─────────────────────────────────┤\n");
 
     // Display party members (both sides)
     for (uint8_t i = 0; i < 4; i++) {
@@ -370,53 +705,52 @@ void display_battle_scene(void) {
             // Right side: HP/MP stats + status effects
             if (member->stats.current_hp > 0) {
                 if (strlen(status_buf) > 0) {
-                    printf("│   [%c]%-26s │ %-8s HP:%3d/%3d MP:%2d/%2d [%s]│\n",
+                    screen_print("│   [%c]%-26s │ %-8s HP:%3d/%3d MP:%2d/%2d [%s]│\n",
                            sprite_char, member->name, member->name,
                            member->stats.current_hp, member->stats.max_hp,
                            member->stats.current_mp, member->stats.max_mp, status_buf);
                 } else {
-                    printf("│   [%c]%-26s │ %-12s HP:%4d/%4d MP:%3d/%3d│\n",
+                    screen_print("│   [%c]%-26s │ %-12s HP:%4d/%4d MP:%3d/%3d│\n",
                            sprite_char, member->name, member->name,
                            member->stats.current_hp, member->stats.max_hp,
                            member->stats.current_mp, member->stats.max_mp);
                 }
             } else {
-                printf("│   [%c]%-26s │ %-12s [DOWN]                │\n",
+                screen_print("│   [%c]%-26s │ %-12s [DOWN]                │\n",
                        sprite_char, member->name, member->name);
             }
         } else {
-            printf("│                                 │                                 │\n");
+            screen_print("│                                 │                                 │\n");
         }
     }
 
-    printf("└─────────────────────────────────┴─────────────────────────────────┘\n");
+    screen_print("└─────────────────────────────────┴─────────────────────────────────┘\n");
 }
 
 void display_battle_turn_indicator(const char* actor_name) {
-    printf("\n>>> %s's TURN <<<\n", actor_name);
+    screen_print("\n>>> %s's TURN <<<\n", actor_name);
 }
 
 int8_t cursor_menu(const char* title, const char** options, uint8_t option_count) {
     uint8_t cursor = 0;
 
     while (1) {
-        clear_screen();
-        printf("\n=== %s ===\n\n", title);
+        // Each cursor move is a frame - only the two changed lines get redrawn
+        screen_begin_frame();
+        screen_print("\n=== %s ===\n\n", title);
 
         for (uint8_t i = 0; i < option_count; i++) {
             if (i == cursor) {
-                printf("> %s\n", options[i]);
+                screen_print("> %s\n", options[i]);
             } else {
-                printf("  %s\n", options[i]);
+                screen_print("  %s\n", options[i]);
             }
         }
 
-        printf("\nControls: W/S=Move Cursor, Enter/Z=Select, X/Esc=Cancel\n");
+        screen_print("\nControls: W/S=Move Cursor, Enter/Z=Select, X/Esc=Cancel\n");
+        screen_present();
 
-        InputButton input = INPUT_NONE;
-        while (input == INPUT_NONE) {
-            input = input_get_key();
-        }
+        InputButton input = input_wait_key(INPUT_WAIT_FOREVER);
 
         switch (input) {
             case INPUT_UP:
@@ -499,10 +833,7 @@ bool virtual_keyboard(const char* prompt, char* buffer, uint8_t max_length) {
         printf("\nControls: W/A/S/D=Move, Enter/Z=Select, X/Esc=Cancel\n");
 
         // Get input
-        InputButton input = INPUT_NONE;
-        while (input == INPUT_NONE) {
-            input = input_get_key();
-        }
+        InputButton input = input_wait_key(INPUT_WAIT_FOREVER);
 
         switch (input) {
             case INPUT_UP:
@@ -580,57 +911,39 @@ static void print_tile_character(TileType type, bool is_player, bool is_explored
     if (tile_mode) {
         // Tile Graphics Mode (GameBoy Pocket style with Unicode + ANSI colors)
         if (is_player) {
-            printf("%s%s%s", GB_COLOR_LIGHTEST, TILE_CHAR_PLAYER, GB_COLOR_RESET);
+            screen_put_glyph(TILE_CHAR_PLAYER, SCREEN_COLOR_LIGHTEST);
         } else if (!is_explored) {
-            printf("%s%s%s", GB_COLOR_DARKEST, TILE_CHAR_UNKNOWN, GB_COLOR_RESET);
+            screen_put_glyph(TILE_CHAR_UNKNOWN, SCREEN_COLOR_DARKEST);
         } else {
             switch (type) {
-                case TILE_WALL:
-                    printf("%s%s%s", GB_COLOR_DARKEST, TILE_CHAR_WALL, GB_COLOR_RESET);
-                    break;
-                case TILE_FLOOR:
-                    printf("%s%s%s", GB_COLOR_DARK, TILE_CHAR_FLOOR, GB_COLOR_RESET);
-                    break;
-                case TILE_DOOR:
-                    printf("%s%s%s", GB_COLOR_DARK, TILE_CHAR_DOOR, GB_COLOR_RESET);
-                    break;
-                case TILE_STAIRS_UP:
-                    printf("%s%s%s", GB_COLOR_LIGHT, TILE_CHAR_STAIRS_UP, GB_COLOR_RESET);
-                    break;
-                case TILE_STAIRS_DOWN:
-                    printf("%s%s%s", GB_COLOR_LIGHT, TILE_CHAR_STAIRS_DN, GB_COLOR_RESET);
-                    break;
-                case TILE_TREASURE:
-                    printf("%s%s%s", GB_COLOR_LIGHT, TILE_CHAR_TREASURE, GB_COLOR_RESET);
-                    break;
-                case TILE_BOSS_ROOM:
-                    printf("%s%s%s", GB_COLOR_LIGHT, TILE_CHAR_BOSS, GB_COLOR_RESET);
-                    break;
-                case TILE_ENTRANCE:
-                    printf("%s%s%s", GB_COLOR_LIGHT, TILE_CHAR_ENTRANCE, GB_COLOR_RESET);
-                    break;
-                default:
-                    printf(" ");
-                    break;
+                case TILE_WALL: screen_put_glyph(TILE_CHAR_WALL, SCREEN_COLOR_DARKEST); break;
+                case TILE_FLOOR: screen_put_glyph(TILE_CHAR_FLOOR, SCREEN_COLOR_DARK); break;
+                case TILE_DOOR: screen_put_glyph(TILE_CHAR_DOOR, SCREEN_COLOR_DARK); break;
+                case TILE_STAIRS_UP: screen_put_glyph(TILE_CHAR_STAIRS_UP, SCREEN_COLOR_LIGHT); break;
+                case TILE_STAIRS_DOWN: screen_put_glyph(TILE_CHAR_STAIRS_DN, SCREEN_COLOR_LIGHT); break;
+                case TILE_TREASURE: screen_put_glyph(TILE_CHAR_TREASURE, SCREEN_COLOR_LIGHT); break;
+                case TILE_BOSS_ROOM: screen_put_glyph(TILE_CHAR_BOSS, SCREEN_COLOR_LIGHT); break;
+                case TILE_ENTRANCE: screen_put_glyph(TILE_CHAR_ENTRANCE, SCREEN_COLOR_LIGHT); break;
+                default: screen_put_glyph(" ", SCREEN_COLOR_DEFAULT); break;
             }
         }
     } else {
         // ASCII Mode (classic text mode)
         if (is_player) {
-            printf("@");
+            screen_put_glyph("@", SCREEN_COLOR_DEFAULT);
         } else if (!is_explored) {
-            printf("?");
+            screen_put_glyph("?", SCREEN_COLOR_DEFAULT);
         } else {
             switch (type) {
-                case TILE_WALL: printf("#"); break;
-                case TILE_FLOOR: printf("."); break;
-                case TILE_DOOR: printf("+"); break;
-                case TILE_STAIRS_UP: printf("<"); break;
-                case TILE_STAIRS_DOWN: printf(">"); break;
-                case TILE_TREASURE: printf("$"); break;
-                case TILE_BOSS_ROOM: printf("B"); break;
-                case TILE_ENTRANCE: printf("E"); break;
-                default: printf(" "); break;
+                case TILE_WALL: screen_put_glyph("#", SCREEN_COLOR_DEFAULT); break;
+                case TILE_FLOOR: screen_put_glyph(".", SCREEN_COLOR_DEFAULT); break;
+                case TILE_DOOR: screen_put_glyph("+", SCREEN_COLOR_DEFAULT); break;
+                case TILE_STAIRS_UP: screen_put_glyph("<", SCREEN_COLOR_DEFAULT); break;
+                case TILE_STAIRS_DOWN: screen_put_glyph(">", SCREEN_COLOR_DEFAULT); break;
+                case TILE_TREASURE: screen_put_glyph("$", SCREEN_COLOR_DEFAULT); break;
+                case TILE_BOSS_ROOM: screen_put_glyph("B", SCREEN_COLOR_DEFAULT); break;
+                case TILE_ENTRANCE: screen_put_glyph("E", SCREEN_COLOR_DEFAULT); break;
+                default: screen_put_glyph(" ", SCREEN_COLOR_DEFAULT); break;
             }
         }
     }
@@ -643,9 +956,9 @@ void display_dungeon(void) {
     DungeonFloor* floor = &dungeon->floors[dungeon->current_floor];
     bool tile_mode = g_game_state.tile_graphics_mode;
 
-    printf("\n=== %s - Floor %d (%dx%d) ===\n", dungeon->name, dungeon->current_floor + 1, floor->width, floor->height);
+    screen_print("\n=== %s - Floor %d (%dx%d) ===\n", dungeon->name, dungeon->current_floor + 1, floor->width, floor->height);
     if (tile_mode) {
-        printf("[ TILE GRAPHICS MODE ]\n");
+        screen_print("[ TILE GRAPHICS MODE ]\n");
     }
 
     // Display using viewport system (only show visible tiles)
@@ -661,7 +974,7 @@ void display_dungeon(void) {
             }
             // Out of bounds (show black space if camera shows area outside map)
             else if (world_x < 0 || world_x >= floor->width || world_y < 0 || world_y >= floor->height) {
-                printf(" ");
+                screen_print(" ");
             }
             // Show tiles within viewport
             else {
@@ -670,28 +983,198 @@ void display_dungeon(void) {
                 bool is_adjacent = (dx <= 1 && dy <= 1);
 
                 // Show tile if explored OR adjacent to player
-                bool explored = floor->tiles[world_y][world_x].explored || is_adjacent;
-                print_tile_character(floor->tiles[world_y][world_x].type, false, explored, tile_mode);
+                bool explored = is_adjacent || dungeon_floor_is_explored(floor, world_x, world_y);
+                print_tile_character(dungeon_floor_get_tile(floor, world_x, world_y), false, explored, tile_mode);
             }
         }
-        printf("\n");
+        screen_print("\n");
     }
 
     // Map legend
     if (tile_mode) {
-        printf("\nLegend: %s%s%s = You, %s%s%s = Wall, %s%s%s = Floor, %s%s%s = Down, %s%s%s = Up\n",
+        screen_print("\nLegend: %s%s%s = You, %s%s%s = Wall, %s%s%s = Floor, %s%s%s = Down, %s%s%s = Up\n",
                GB_COLOR_LIGHTEST, TILE_CHAR_PLAYER, GB_COLOR_RESET,
                GB_COLOR_DARKEST, TILE_CHAR_WALL, GB_COLOR_RESET,
                GB_COLOR_DARK, TILE_CHAR_FLOOR, GB_COLOR_RESET,
                GB_COLOR_LIGHT, TILE_CHAR_STAIRS_DN, GB_COLOR_RESET,
                GB_COLOR_LIGHT, TILE_CHAR_STAIRS_UP, GB_COLOR_RESET);
-        printf("        %s%s%s = Treasure, %s%s%s = Boss, %s%s%s = Entrance\n",
+        screen_print("        %s%s%s = Treasure, %s%s%s = Boss, %s%s%s = Entrance\n",
                GB_COLOR_LIGHT, TILE_CHAR_TREASURE, GB_COLOR_RESET,
                GB_COLOR_LIGHT, TILE_CHAR_BOSS, GB_COLOR_RESET,
                GB_COLOR_LIGHT, TILE_CHAR_ENTRANCE, GB_COLOR_RESET);
     } else {
-        printf("\nLegend: @ = You, # = Wall, . = Floor, > = Down, < = Up\n");
-        printf("        $ = Treasure, B = Boss, E = Entrance\n");
+        screen_print("\nLegend: @ = You, # = Wall, . = Floor, > = Down, < = Up\n");
+        screen_print("        $ = Treasure, B = Boss, E = Entrance\n");
+    }
+    screen_print("\nControls: WASD=Move, Z=Interact, X=Back, Enter/I=Menu\n");
+}
+
+// Overworld glyphs: terrain by tile ID high nibble, 2x2 structures by kind
+typedef struct {
+    const char* glyph;     // Tile graphics mode
+    const char* ascii;
+    ScreenColor color;
+} WorldGlyph;
+
+static const WorldGlyph world_terrain_glyphs[] = {
+    { "·", ".", SCREEN_COLOR_LIGHT },    // 0x0_ Grass
+    { "♣", "&", SCREEN_COLOR_DARK },     // 0x1_ Forest
+    { "≈", "~", SCREEN_COLOR_DARKEST },  // 0x2_ Water
+    { "▲", "^", SCREEN_COLOR_DARK },     // 0x3_ Mountain
+    { "∴", ":", SCREEN_COLOR_LIGHT },    // 0x4_ Desert
+    { "═", "=", SCREEN_COLOR_LIGHT },    // 0x5_ Bridge
+    { "▒", "+", SCREEN_COLOR_LIGHT },    // 0x6_ Road
+};
+
+static const WorldGlyph world_structure_glyphs[] = {
+    { "⌂", "T", SCREEN_COLOR_LIGHTEST }, // 0x70-0x73 Town
+    { "♜", "C", SCREEN_COLOR_LIGHTEST }, // 0x74-0x77 Castle
+    { "Ω", "D", SCREEN_COLOR_LIGHTEST }, // 0x78-0x7B Dungeon
+    { "✦", "S", SCREEN_COLOR_LIGHTEST }, // 0x7C-0x7F Final Sanctum
+};
+
+static void print_world_tile(uint8_t tile, bool tile_mode) {
+    const WorldGlyph* glyph;
+    uint8_t terrain = tile >> 4;
+
+    if (terrain == 0x7) {
+        glyph = &world_structure_glyphs[(tile >> 2) & 0x3];
+    } else if (terrain < sizeof(world_terrain_glyphs) / sizeof(world_terrain_glyphs[0])) {
+        glyph = &world_terrain_glyphs[terrain];
+    } else {
+        screen_put_glyph(" ", SCREEN_COLOR_DEFAULT);
+        return;
+    }
+
+    if (tile_mode) {
+        screen_put_glyph(glyph->glyph, glyph->color);
+    } else {
+        screen_put_glyph(glyph->ascii, SCREEN_COLOR_DEFAULT);
+    }
+}
+
+// Only the viewport around the party is drawn, so a frame costs the same
+// however large the map is
+void display_world_map(void) {
+    uint8_t player_x = g_game_state.world_x;
+    uint8_t player_y = g_game_state.world_y;
+    bool tile_mode = g_game_state.tile_graphics_mode;
+    uint8_t camera_x, camera_y;
+
+    world_map_get_camera(player_x, player_y, &camera_x, &camera_y);
+
+    const WorldLocation* location = world_map_get_location_at(player_x, player_y);
+    screen_print("\n=== World Map - %s (%d, %d) ===\n",
+                 location ? location->name : world_map_zone_name(world_map_get_zone(player_x, player_y)),
+                 player_x, player_y);
+
+    for (uint8_t screen_y = 0; screen_y < WORLD_VIEW_HEIGHT; screen_y++) {
+        uint8_t world_y = camera_y + screen_y;
+        for (uint8_t screen_x = 0; screen_x < WORLD_VIEW_WIDTH; screen_x++) {
+            uint8_t world_x = camera_x + screen_x;
+            if (world_x == player_x && world_y == player_y) {
+                screen_put_glyph(tile_mode ? TILE_CHAR_PLAYER : "@",
+                                 tile_mode ? SCREEN_COLOR_LIGHTEST : SCREEN_COLOR_DEFAULT);
+            } else {
+                print_world_tile(world_map_get_tile(world_x, world_y), tile_mode);
+            }
+        }
+        screen_print("\n");
+    }
+
+    if (tile_mode) {
+        screen_print("\nLegend: %s%s%s = You, %s⌂%s = Town, %sΩ%s = Dungeon, %s✦%s = Sanctum, %s≈%s/%s▲%s = Impassable\n",
+                     GB_COLOR_LIGHTEST, TILE_CHAR_PLAYER, GB_COLOR_RESET,
+                     GB_COLOR_LIGHTEST, GB_COLOR_RESET,
+                     GB_COLOR_LIGHTEST, GB_COLOR_RESET,
+                     GB_COLOR_LIGHTEST, GB_COLOR_RESET,
+                     GB_COLOR_DARKEST, GB_COLOR_RESET,
+                     GB_COLOR_DARK, GB_COLOR_RESET);
+    } else {
+        screen_print("\nLegend: @ = You, T = Town, D = Dungeon, S = Sanctum, ~/^ = Impassable\n");
+    }
+    screen_print("Controls: WASD=Move, Enter/I=Menu\n");
+}
+
+// Town glyphs by metasprite ID; signs show what the building below them is
+static const WorldGlyph town_glyphs[TOWN_TILE_COUNT] = {
+    { "█", "#", SCREEN_COLOR_DARKEST },  // 0 Wall
+    { "█", "#", SCREEN_COLOR_DARKEST },  // 1 Wall
+    { "█", "#", SCREEN_COLOR_DARKEST },  // 2 Wall
+    { "♣", "&", SCREEN_COLOR_DARK },     // 3 Tree top
+    { "▒", ":", SCREEN_COLOR_LIGHT },    // 4 Path
+    { "█", "#", SCREEN_COLOR_DARKEST },  // 5 Wall
+    { "█", "#", SCREEN_COLOR_DARKEST },  // 6 Wall
+    { "♣", "&", SCREEN_COLOR_DARK },     // 7 Tree
+    { "·", ".", SCREEN_COLOR_LIGHT },    // 8 Grass
+    { "▲", "^", SCREEN_COLOR_DARK },     // 9 Roof
+    { "≈", "~", SCREEN_COLOR_DARKEST },  // 10 Water
+    { "▲", "^", SCREEN_COLOR_DARK },     // 11 Roof
+    { "·", ".", SCREEN_COLOR_LIGHT },    // 12
+    { "·", ".", SCREEN_COLOR_LIGHT },    // 13 Grass shadow
+    { "M", "M", SCREEN_COLOR_LIGHTEST }, // 14 Magic sign
+    { "▲", "^", SCREEN_COLOR_DARK },     // 15 Roof peak
+    { "+", "+", SCREEN_COLOR_LIGHTEST }, // 16 Clinic sign
+    { "▪", "|", SCREEN_COLOR_LIGHT },    // 17 Window
+    { "∩", "D", SCREEN_COLOR_LIGHTEST }, // 18 Door
+    { "·", ".", SCREEN_COLOR_LIGHT },    // 19 Grass shadow
+    { "▒", ":", SCREEN_COLOR_LIGHT },    // 20 Path corner
+    { "═", "=", SCREEN_COLOR_LIGHT },    // 21 Bridge
+    { "▒", ":", SCREEN_COLOR_LIGHT },    // 22 Path
+    { "▒", ":", SCREEN_COLOR_LIGHT },    // 23 Path corner
+    { "┼", "+", SCREEN_COLOR_DARK },     // 24 Fence
+    { "║", "=", SCREEN_COLOR_LIGHT },    // 25 Bridge
+    { "A", "A", SCREEN_COLOR_LIGHTEST }, // 26 Armor sign
+    { "W", "W", SCREEN_COLOR_LIGHTEST }, // 27 Weapon sign
+    { "$", "$", SCREEN_COLOR_LIGHTEST }, // 28 Item sign
+    { "≈", "~", SCREEN_COLOR_DARKEST },  // 29 Water
+    { "▪", "|", SCREEN_COLOR_LIGHT },    // 30 Window
+    { "≈", "~", SCREEN_COLOR_DARKEST },  // 31 Water
+    { "·", ".", SCREEN_COLOR_LIGHT },    // 32
+    { "o", "o", SCREEN_COLOR_LIGHT },    // 33 Well
+    { "█", "#", SCREEN_COLOR_DARKEST },  // 34 Wall
+    { "I", "I", SCREEN_COLOR_LIGHTEST }, // 35 Inn sign
+};
+
+// The rows around the player; towns are never wider than the screen
+void display_town(const char* town_name, uint8_t player_x, uint8_t player_y) {
+    bool tile_mode = g_game_state.tile_graphics_mode;
+    uint8_t width = g_current_town ? g_current_town->width : 0;
+    uint8_t height = g_current_town ? g_current_town->height : 0;
+    uint8_t view_height = (height < TOWN_VIEW_HEIGHT) ? height : TOWN_VIEW_HEIGHT;
+
+    int camera_y = player_y - view_height / 2;
+    if (camera_y > height - view_height) camera_y = height - view_height;
+    if (camera_y < 0) camera_y = 0;
+
+    screen_print("\n=== %s ===\n", town_name);
+
+    for (uint8_t screen_y = 0; screen_y < view_height; screen_y++) {
+        uint8_t y = (uint8_t)(camera_y + screen_y);
+        for (uint8_t x = 0; x < width; x++) {
+            if (x == player_x && y == player_y) {
+                screen_put_glyph(tile_mode ? TILE_CHAR_PLAYER : "@",
+                                 tile_mode ? SCREEN_COLOR_LIGHTEST : SCREEN_COLOR_DEFAULT);
+                continue;
+            }
+
+            uint8_t tile = town_map_get_tile(x, y);
+            const WorldGlyph* glyph = &town_glyphs[tile < TOWN_TILE_COUNT ? tile : TOWN_TILE_GRASS];
+            if (tile_mode) {
+                screen_put_glyph(glyph->glyph, glyph->color);
+            } else {
+                screen_put_glyph(glyph->ascii, SCREEN_COLOR_DEFAULT);
+            }
+        }
+        screen_print("\n");
+    }
+
+    if (tile_mode) {
+        screen_print("\nLegend: %s%s%s = You, %s∩%s = Door, I = Inn, $ = Items, A/W = Equipment\n",
+                     GB_COLOR_LIGHTEST, TILE_CHAR_PLAYER, GB_COLOR_RESET,
+                     GB_COLOR_LIGHTEST, GB_COLOR_RESET);
+    } else {
+        screen_print("\nLegend: @ = You, D = Door, I = Inn, $ = Items, A/W = Equipment\n");
     }
-    printf("\nControls: WASD=Move, Z=Interact, X=Back, Enter/I=Menu\n");
-}
\ No newline at end of file
+    screen_print("Controls: WASD=Move (walk into a door), X=Leave, Enter/I=Menu\n");
+}
@@ -6,10 +6,40 @@
 #include <stddef.h>
 
 // Random number generation
-void random_seed(uint32_t seed);
+// Independent xoshiro128** streams: each subsystem (and each headless battle
+// or simulation thread) draws from its own stream, so they never perturb
+// each other. Streams are plain structs - copy them to snapshot/restore.
+typedef struct {
+    uint32_t s[4];
+} RandomStream;
+
+// Per-subsystem streams of the running game
+typedef enum {
+    RNG_STREAM_GENERAL = 0, // random_range / random_chance
+    RNG_STREAM_BATTLE,      // Enemy generation, damage, AI, steal
+    RNG_STREAM_LOOT,        // Treasure chests and battle drops
+    RNG_STREAM_LEVEL_UP,    // Stat growth rolls
+    RNG_STREAM_MAP_GEN,     // Floor generation
+    RNG_STREAM_ENCOUNTER,   // Random encounter step counters
+    RNG_STREAM_COUNT
+} RandomStreamId;
+
+void random_seed(uint32_t seed); // Reseeds every subsystem stream
+RandomStream* random_get_stream(RandomStreamId id);
 uint8_t random_range(uint8_t min, uint8_t max);
 bool random_chance(uint8_t percentage);
 
+// Stream API
+void random_stream_seed(RandomStream* stream, uint64_t seed);
+void random_stream_jump(RandomStream* stream);  // Skip ahead 2^64 draws
+void random_stream_split(RandomStream* parent, RandomStream* child); // Child gets the next 2^64 block
+uint32_t random_stream_next(RandomStream* stream);
+uint32_t random_stream_bounded(RandomStream* stream, uint32_t bound); // Unbiased, [0, bound)
+uint32_t random_stream_range(RandomStream* stream, uint32_t min, uint32_t max); // Inclusive
+bool random_stream_chance(RandomStream* stream, uint8_t percentage);
+void random_stream_fill(RandomStream* stream, uint32_t* out, size_t count);
+void random_stream_fill_range(RandomStream* stream, uint8_t* out, size_t count, uint8_t min, uint8_t max);
+
 // String utilities
 void safe_string_copy(char* dest, const char* src, uint8_t max_length);
 void clear_screen(void);
@@ -32,7 +62,10 @@ typedef enum {
     INPUT_NONE
 } InputButton;
 
-InputButton input_get_key(void);
+#define INPUT_WAIT_FOREVER (-1)
+
+InputButton input_get_key(void);                  // Never blocks; INPUT_NONE if no key is queued
+InputButton input_wait_key(int32_t timeout_ms);   // Sleeps until a key or the timeout (INPUT_NONE)
 void input_wait_for_key(void);
 void input_flush_buffer(void);
 
@@ -43,6 +76,8 @@ void display_party_status(void);
 void display_battle_scene(void);
 void display_battle_turn_indicator(const char* actor_name);
 void display_dungeon(void);
+void display_world_map(void);
+void display_town(const char* town_name, uint8_t player_x, uint8_t player_y);
 
 // Cursor-based menu (returns selected index, or -1 if cancelled)
 int8_t cursor_menu(const char* title, const char** options, uint8_t option_count);
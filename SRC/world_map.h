@@ -2,11 +2,17 @@
 #define WORLD_MAP_H
 
 #include <stdint.h>
+#include <stdbool.h>
 
 // World Map Dimensions
 #define WORLD_MAP_WIDTH  128
 #define WORLD_MAP_HEIGHT 128
 #define WORLD_MAP_SIZE   (WORLD_MAP_WIDTH * WORLD_MAP_HEIGHT)
+#define WORLD_MAP_ROW_WORDS (WORLD_MAP_WIDTH / 64)  // Passability words per row
+
+// Overworld viewport in tiles; the camera keeps the player centred
+#define WORLD_VIEW_WIDTH  32
+#define WORLD_VIEW_HEIGHT 14
 
 // Tile ID Definitions (based on Final Fantasy NES tileset)
 // These correspond to the tileset: "NES - Final Fantasy - Tilesets - Overworld.png"
@@ -99,6 +105,25 @@ typedef struct {
 #define NUM_TOWNS       8
 #define NUM_DUNGEONS    9
 
+// Location index
+// The map is split into 8x8-tile cells; each cell lists the locations whose
+// 2x2 footprint touches it, packed back to back (cell_start[c] .. cell_start[c+1]
+// into entries[]). A lookup only checks the few entries of one cell, so the
+// per-step cost stays flat as more points of interest are added.
+#define WORLD_LOCATION_COUNT    (NUM_TOWNS + NUM_DUNGEONS)  // Ids: towns first, then dungeons
+#define WORLD_LOCATION_SIZE     2                           // Footprint is size x size tiles
+#define WORLD_CELL_SHIFT        3
+#define WORLD_CELL_COLS         (WORLD_MAP_WIDTH >> WORLD_CELL_SHIFT)
+#define WORLD_CELL_ROWS         (WORLD_MAP_HEIGHT >> WORLD_CELL_SHIFT)
+#define WORLD_CELL_COUNT        (WORLD_CELL_COLS * WORLD_CELL_ROWS)
+#define WORLD_LOCATION_INDEX_CAPACITY (WORLD_LOCATION_COUNT * 4)    // A footprint touches at most 4 cells
+#define WORLD_LOCATION_NONE     0xFFFF
+
+typedef struct {
+    uint16_t cell_start[WORLD_CELL_COUNT + 1];
+    uint16_t entries[WORLD_LOCATION_INDEX_CAPACITY];
+} WorldLocationIndex;
+
 // Encounter Zone Definitions
 typedef enum {
     ZONE_NONE = 0,
@@ -116,20 +141,39 @@ typedef enum {
 typedef struct {
     uint8_t tiles[WORLD_MAP_HEIGHT][WORLD_MAP_WIDTH];      // Tile IDs
     uint8_t zones[WORLD_MAP_HEIGHT][WORLD_MAP_WIDTH];      // Encounter zones
-    uint8_t collision[WORLD_MAP_HEIGHT][WORLD_MAP_WIDTH];  // Collision flags
     WorldLocation towns[NUM_TOWNS];
     WorldLocation dungeons[NUM_DUNGEONS];
+    WorldLocationIndex location_index;
 } WorldMap;
 
 // Global world map data
 extern WorldMap g_world_map;
 
+// Precomputed passability bitmap (2 KB, read-only): one bit per tile, set if
+// walkable. Generated alongside the tile table by generate_world_map.py.
+extern const uint64_t world_map_passable[WORLD_MAP_HEIGHT][WORLD_MAP_ROW_WORDS];
+
 // World map functions
 void world_map_init(void);
 uint8_t world_map_get_tile(uint8_t x, uint8_t y);
 uint8_t world_map_get_zone(uint8_t x, uint8_t y);
 uint8_t world_map_is_passable(uint8_t x, uint8_t y);
+// True if every tile in the span/rectangle is walkable (false if it leaves the map)
+bool world_map_row_is_passable(uint8_t x, uint8_t y, uint8_t width);
+bool world_map_rect_is_passable(uint8_t x, uint8_t y, uint8_t width, uint8_t height);
 void world_map_set_player_position(uint8_t x, uint8_t y);
+void world_map_start_position(uint8_t* x, uint8_t* y); // Greenleaf, where a new game starts
 WorldLocation* world_map_get_location_at(uint8_t x, uint8_t y);
+uint16_t world_map_get_location_id_at(uint8_t x, uint8_t y); // WORLD_LOCATION_NONE if none
+WorldLocation* world_map_get_location(uint16_t id);
+void world_map_build_location_index(void); // Call again after moving a location
+
+// Top-left of the viewport for a player at (x, y), clamped to the map
+void world_map_get_camera(uint8_t x, uint8_t y, uint8_t* camera_x, uint8_t* camera_y);
+
+// Zone encounters
+const char* world_map_zone_name(uint8_t zone);
+uint8_t world_map_zone_level(uint8_t zone);  // Enemy level, 0 if the zone has no encounters
+bool world_map_check_encounter(uint8_t x, uint8_t y, uint8_t* steps_left); // Counts down one step
 
 #endif // WORLD_MAP_H
@@ -0,0 +1,722 @@
+// Battle simulator - Monte Carlo balance runs on the headless battle core
+//
+// Runs N encounters for every (party composition, party level, dungeon floor)
+// combination across all cores and reports win rate plus percentiles for
+// turns taken, HP/MP consumed, potions used and party knockouts. Potions and
+// knockouts are tallied from the battle event stream. With -a the party is
+// played by the auto-battle search instead of the greedy policy.
+//
+// Host-only tool (POSIX threads). Build with: make sim
+//
+// Usage: battle_sim [-n encounters] [-j threads] [-p KTPM,KBSM,...]
+//                   [-l 1-10] [-d 1-5] [-i potions] [-s seed] [-b] [-L log]
+//                   [-a rollouts]
+
+#define _POSIX_C_SOURCE 200809L
+
+#include "battle.h"
+#include "battle_ai.h"
+#include "dungeon.h"
+#include "inventory.h"
+#include "party.h"
+#include "utils.h"
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+#define SIM_MAX_COMPOSITIONS 16
+#define SIM_JOB_CHUNK 256        // Encounters per job in the work queue
+#define SIM_MAX_PARTY_ACTIONS 200 // Battles longer than this count as losses
+#define SIM_LOW_HP_PERCENT 35    // Heal threshold for the party policy
+
+// One finished encounter
+typedef struct {
+    uint16_t turns;      // Party actions taken
+    uint16_t hp_used;    // Net HP lost across the party
+    uint16_t mp_used;    // Net MP spent across the party
+    uint8_t potions_used;
+    uint8_t knockouts;   // Party members defeated (a member can fall more than once)
+    bool won;
+} SimSample;
+
+// One (composition, party level, dungeon floor) cell of the report
+typedef struct {
+    char composition[MAX_PARTY_SIZE + 1];
+    uint8_t party_level;
+    uint8_t dungeon;      // Dungeon / boss ID, 1-based
+    uint8_t floor;        // 1-based; 0 for boss fights
+    const EncounterTable* encounters;
+    Party party;          // Template copied into every encounter
+    Inventory inventory;
+    BossData boss;
+    SimSample* samples;
+} SimConfig;
+
+typedef struct {
+    uint32_t config;
+    uint32_t first;
+    uint32_t count;
+} SimJob;
+
+// Per-worker deque: the owner pops from the tail, thieves take from the head
+typedef struct {
+    pthread_mutex_t lock;
+    SimJob* jobs;
+    uint32_t head;
+    uint32_t tail;
+} SimDeque;
+
+typedef struct {
+    uint32_t encounters;
+    uint32_t seed;
+    uint8_t potions;
+    bool boss_mode;
+    uint32_t auto_rollouts; // Auto-battle rollouts per decision (0 = greedy policy)
+    uint32_t thread_count;
+    SimConfig* configs;
+    uint32_t config_count;
+    SimDeque* deques;
+} Simulation;
+
+typedef struct {
+    Simulation* sim;
+    uint32_t index;
+    BattleAIWorkspace* ai; // NULL unless auto-battle is on
+} SimWorker;
+
+// ============================================================================
+// Party setup
+// ============================================================================
+
+static int sim_job_from_letter(char letter) {
+    switch (letter) {
+        case 'K': return JOB_KNIGHT;
+        case 'B': return JOB_BLACK_BELT;
+        case 'T': return JOB_THIEF;
+        case 'S': return JOB_SAGE;
+        case 'P': return JOB_PRIEST;
+        case 'M': return JOB_MAGE;
+        default: return -1;
+    }
+}
+
+// Equip without the inventory_equip_item chatter (templates are private)
+static void sim_equip(Inventory* inv, PartyMember* member, uint8_t equip_id) {
+    if (inv->equipment_count >= MAX_EQUIPMENT_SLOTS) return;
+
+    Item item = item_create_equipment(equip_id);
+    item.is_equipped = true;
+    member->equipped_items[item.equip_type] = inv->equipment_count;
+    inv->equipment[inv->equipment_count++] = item;
+    character_invalidate_stats(member);
+}
+
+static void sim_build_party(SimConfig* config, uint8_t potions, uint32_t seed) {
+    Party* party = &config->party;
+    Inventory* inv = &config->inventory;
+    memset(party, 0, sizeof(Party));
+    memset(inv, 0, sizeof(Inventory));
+
+    // Level-up rolls come from a private stream, seeded per config
+    RandomStream rng;
+    random_stream_seed(&rng, seed);
+
+    for (uint8_t i = 0; config->composition[i] != '\0'; i++) {
+        JobType job = (JobType)sim_job_from_letter(config->composition[i]);
+        PartyMember* member = &party->members[party->member_count++];
+
+        character_init_member(member, job, job_names[job]);
+        for (uint8_t level = 1; level < config->party_level; level++) {
+            character_level_up(member, &rng);
+        }
+
+        const uint8_t* kit = job_starting_equipment[job];
+        for (uint8_t k = 0; k < STARTING_EQUIPMENT_COUNT && kit[k] != EQUIP_NONE; k++) {
+            sim_equip(inv, member, kit[k]);
+        }
+    }
+
+    if (potions > 0) {
+        inventory_store_item(inv, ITEM_POTION, potions);
+    }
+}
+
+// ============================================================================
+// Party policy - simple greedy play so numbers reflect a competent player
+// ============================================================================
+
+static uint8_t sim_lowest_member(Party* party, uint16_t* hp_percent) {
+    uint8_t lowest = 0;
+    uint16_t lowest_percent = 0xFFFF;
+
+    for (uint8_t i = 0; i < party->member_count; i++) {
+        CharacterStats* stats = &party->members[i].stats;
+        if (stats->current_hp == 0) continue;
+
+        uint16_t percent = (uint16_t)((stats->current_hp * 100u) / stats->max_hp);
+        if (percent < lowest_percent) {
+            lowest_percent = percent;
+            lowest = i;
+        }
+    }
+
+    *hp_percent = lowest_percent;
+    return lowest;
+}
+
+static uint8_t sim_weakest_enemy(BattleState* state) {
+    uint8_t weakest = 0;
+    uint16_t weakest_hp = 0xFFFF;
+
+    for (uint8_t i = 0; i < state->enemy_count; i++) {
+        if (state->enemies[i].is_alive && state->enemies[i].current_hp < weakest_hp) {
+            weakest_hp = state->enemies[i].current_hp;
+            weakest = i;
+        }
+    }
+
+    return weakest;
+}
+
+static void sim_choose_action(BattleContext* ctx, uint8_t actor_index, BattleAction* action) {
+    PartyMember* actor = &ctx->party->members[actor_index];
+    uint16_t hp_percent;
+    uint8_t wounded = sim_lowest_member(ctx->party, &hp_percent);
+
+    action->actor_index = actor_index;
+    action->type = ACTION_ATTACK;
+    action->target_index = sim_weakest_enemy(ctx->state);
+    action->item_or_skill_id = 0;
+
+    const Skill* best_attack = NULL;
+    const Skill* best_heal = NULL;
+    for (uint8_t i = 0; i < actor->skill_count; i++) {
+        const Skill* skill = get_skill_data(actor->skills[i]);
+        if (!skill || skill->mp_cost > actor->stats.current_mp) continue;
+
+        if (skill->type == SKILL_TYPE_HEAL && skill->power > 0 && !skill->target_all &&
+            (!best_heal || skill->power > best_heal->power)) {
+            best_heal = skill;
+        } else if (skill->type == SKILL_TYPE_ATTACK && skill->mp_cost > 0 &&
+                   (!best_attack || skill->power > best_attack->power)) {
+            best_attack = skill;
+        }
+    }
+
+    // Heal the most wounded ally: spell first, potion second
+    if (hp_percent < SIM_LOW_HP_PERCENT) {
+        if (best_heal) {
+            action->type = ACTION_SKILL;
+            action->item_or_skill_id = best_heal->skill_id;
+            action->target_index = wounded;
+            return;
+        }
+
+        int8_t potion = inventory_find_item(ctx->inventory, ITEM_POTION);
+        if (potion >= 0) {
+            action->type = ACTION_ITEM;
+            action->item_or_skill_id = (uint8_t)potion;
+            action->target_index = wounded;
+            return;
+        }
+    }
+
+    // Spend MP on the strongest attack while keeping a quarter in reserve
+    if (best_attack && actor->stats.current_mp - best_attack->mp_cost >= actor->stats.max_mp / 4) {
+        action->type = ACTION_SKILL;
+        action->item_or_skill_id = best_attack->skill_id;
+    }
+}
+
+// ============================================================================
+// Encounter loop
+// ============================================================================
+
+// Stateless seed mixing so results do not depend on thread scheduling
+static uint32_t sim_mix_seed(uint32_t seed, uint32_t config, uint32_t encounter) {
+    uint32_t x = seed ^ (config * 0x9E3779B9u) ^ (encounter * 0x85EBCA6Bu);
+    x ^= x >> 16;
+    x *= 0x7FEB352Du;
+    x ^= x >> 15;
+    x *= 0x846CA68Bu;
+    x ^= x >> 16;
+    return x;
+}
+
+// Statistics collector (and optional transcript) fed from the event ring
+static void sim_collect_events(BattleContext* ctx, BattleEventReader* reader, SimSample* sample, FILE* log) {
+    BattleEvent event;
+    char text[160];
+
+    while (battle_event_read(ctx->events, reader, &event)) {
+        switch (event.type) {
+            case BATTLE_EVENT_ITEM_USED:
+                if (event.value == ITEM_POTION) sample->potions_used++;
+                break;
+            case BATTLE_EVENT_ACTOR_DEFEATED:
+                if (!BATTLE_ACTOR_IS_ENEMY(event.target)) sample->knockouts++;
+                break;
+            default:
+                break;
+        }
+
+        if (log && battle_format_event(ctx, &event, text, sizeof(text))) {
+            fputs(text, log);
+        }
+    }
+}
+
+static void sim_run_encounter(const Simulation* sim, const SimConfig* config, uint32_t rng_seed,
+                              BattleAIWorkspace* ai, SimSample* sample, FILE* log) {
+    Party party = config->party;
+    Inventory inventory = config->inventory;
+    BossData boss = config->boss;
+    BattleState state;
+    BattleContext ctx;
+    RandomStream rng;
+    BattleEventRing events;
+    BattleEventReader reader;
+
+    memset(sample, 0, sizeof(SimSample));
+    battle_event_ring_reset(&events);
+    battle_event_reader_init(&reader, &events);
+
+    random_stream_seed(&rng, rng_seed);
+    battle_context_init(&ctx, &state, &party, &inventory, &rng);
+    ctx.events = &events;
+    battle_core_start(&ctx, config->encounters, sim->boss_mode);
+    if (sim->boss_mode) {
+        battle_core_set_boss(&ctx, &boss);
+    }
+    sim_collect_events(&ctx, &reader, sample, log);
+
+    uint16_t turns = 0;
+
+    while (!battle_core_is_over(&ctx) && turns < SIM_MAX_PARTY_ACTIONS) {
+        battle_core_run_enemy_turns(&ctx);
+        sim_collect_events(&ctx, &reader, sample, log);
+        if (battle_core_is_over(&ctx)) break;
+
+        uint8_t actor = battle_core_current_actor(&ctx);
+        if (party.members[actor].stats.current_hp == 0) {
+            battle_core_advance_turn(&ctx);
+            continue;
+        }
+
+        BattleAction action;
+        if (ai) {
+            // Fixed rollout count, one search thread: results stay reproducible
+            BattleAIConfig ai_config;
+            battle_ai_default_config(&ai_config, 0, sim_mix_seed(rng_seed, turns, 0));
+            ai_config.max_rollouts = sim->auto_rollouts;
+            ai_config.threads = 1;
+            if (!battle_ai_choose_action(&ctx, actor, &ai_config, ai, &action, NULL)) {
+                sim_choose_action(&ctx, actor, &action);
+            }
+        } else {
+            sim_choose_action(&ctx, actor, &action);
+        }
+        battle_core_process_action(&ctx, &action);
+        sim_collect_events(&ctx, &reader, sample, log);
+        turns++;
+    }
+
+    int32_t hp_used = 0;
+    int32_t mp_used = 0;
+    for (uint8_t i = 0; i < party.member_count; i++) {
+        hp_used += config->party.members[i].stats.current_hp - party.members[i].stats.current_hp;
+        mp_used += config->party.members[i].stats.current_mp - party.members[i].stats.current_mp;
+    }
+
+    sample->turns = turns;
+    sample->hp_used = hp_used > 0 ? (uint16_t)hp_used : 0;
+    sample->mp_used = mp_used > 0 ? (uint16_t)mp_used : 0;
+    sample->won = battle_core_is_victory(&ctx);
+}
+
+// ============================================================================
+// Work-stealing scheduler
+// ============================================================================
+
+static bool sim_deque_pop(SimDeque* deque, SimJob* job) {
+    bool found = false;
+    pthread_mutex_lock(&deque->lock);
+    if (deque->tail > deque->head) {
+        *job = deque->jobs[--deque->tail];
+        found = true;
+    }
+    pthread_mutex_unlock(&deque->lock);
+    return found;
+}
+
+static bool sim_deque_steal(SimDeque* deque, SimJob* job) {
+    bool found = false;
+    pthread_mutex_lock(&deque->lock);
+    if (deque->tail > deque->head) {
+        *job = deque->jobs[deque->head++];
+        found = true;
+    }
+    pthread_mutex_unlock(&deque->lock);
+    return found;
+}
+
+static void* sim_worker_main(void* arg) {
+    SimWorker* worker = (SimWorker*)arg;
+    Simulation* sim = worker->sim;
+    SimJob job;
+
+    for (;;) {
+        bool found = sim_deque_pop(&sim->deques[worker->index], &job);
+
+        // Own queue drained - steal from the others, starting with the neighbour
+        for (uint32_t k = 1; !found && k < sim->thread_count; k++) {
+            found = sim_deque_steal(&sim->deques[(worker->index + k) % sim->thread_count], &job);
+        }
+        if (!found) break; // No work is ever added once the run starts
+
+        SimConfig* config = &sim->configs[job.config];
+        for (uint32_t i = job.first; i < job.first + job.count; i++) {
+            sim_run_encounter(sim, config, sim_mix_seed(sim->seed, job.config, i),
+                              worker->ai, &config->samples[i], NULL);
+        }
+    }
+
+    return NULL;
+}
+
+// ============================================================================
+// Reporting
+// ============================================================================
+
+static int sim_compare_u16(const void* a, const void* b) {
+    return (int)*(const uint16_t*)a - (int)*(const uint16_t*)b;
+}
+
+static void sim_percentiles(uint16_t* values, uint32_t count, uint16_t out[3]) {
+    qsort(values, count, sizeof(uint16_t), sim_compare_u16);
+    out[0] = values[(count - 1) * 50 / 100];
+    out[1] = values[(count - 1) * 90 / 100];
+    out[2] = values[(count - 1) * 99 / 100];
+}
+
+// "2" for a boss, "2-3" for dungeon 2 floor 3
+static void sim_config_label(const SimConfig* config, char* label, size_t size) {
+    if (config->floor == 0) {
+        snprintf(label, size, "%d", config->dungeon);
+    } else {
+        snprintf(label, size, "%d-%d", config->dungeon, config->floor);
+    }
+}
+
+static void sim_report(const Simulation* sim, const SimConfig* config, uint16_t* scratch) {
+    const uint32_t n = sim->encounters;
+    uint32_t wins = 0;
+    uint16_t turns[3], hp[3], mp[3], potions[3], knockouts[3];
+
+    for (uint32_t i = 0; i < n; i++) wins += config->samples[i].won;
+
+    for (uint32_t i = 0; i < n; i++) scratch[i] = config->samples[i].turns;
+    sim_percentiles(scratch, n, turns);
+    for (uint32_t i = 0; i < n; i++) scratch[i] = config->samples[i].hp_used;
+    sim_percentiles(scratch, n, hp);
+    for (uint32_t i = 0; i < n; i++) scratch[i] = config->samples[i].mp_used;
+    sim_percentiles(scratch, n, mp);
+    for (uint32_t i = 0; i < n; i++) scratch[i] = config->samples[i].potions_used;
+    sim_percentiles(scratch, n, potions);
+    for (uint32_t i = 0; i < n; i++) scratch[i] = config->samples[i].knockouts;
+    sim_percentiles(scratch, n, knockouts);
+
+    char label[8];
+    sim_config_label(config, label, sizeof(label));
+
+    printf("%-5s %3d %3s  %6.2f%%  %4d/%4d/%4d  %4d/%4d/%4d  %4d/%4d/%4d  %2d/%2d/%2d  %2d/%2d/%2d\n",
+           config->composition, config->party_level, label,
+           100.0 * wins / n,
+           turns[0], turns[1], turns[2], hp[0], hp[1], hp[2],
+           mp[0], mp[1], mp[2], potions[0], potions[1], potions[2],
+           knockouts[0], knockouts[1], knockouts[2]);
+}
+
+// ============================================================================
+// Command line
+// ============================================================================
+
+static bool sim_parse_range(const char* text, uint8_t* low, uint8_t* high) {
+    int a, b;
+    if (sscanf(text, "%d-%d", &a, &b) == 2) {
+        // Range given
+    } else if (sscanf(text, "%d", &a) == 1) {
+        b = a;
+    } else {
+        return false;
+    }
+
+    if (a < 1 || b < a || b > 99) return false;
+    *low = (uint8_t)a;
+    *high = (uint8_t)b;
+    return true;
+}
+
+static void sim_usage(void) {
+    printf("Usage: battle_sim [options]\n");
+    printf("  -n N      Encounters per configuration (default 10000)\n");
+    printf("  -j N      Worker threads (default: all cores)\n");
+    printf("  -p LIST   Party compositions, comma separated (default KTPM)\n");
+    printf("            K=Knight B=Black Belt T=Thief S=Sage P=Priest M=Mage\n");
+    printf("  -l A-B    Party levels (default 1-10)\n");
+    printf("  -d A-B    Dungeon IDs 1-5, every floor's encounter table (default 1-5)\n");
+    printf("  -i N      Potions carried into each battle (default 5)\n");
+    printf("  -s SEED   RNG seed (default 12345)\n");
+    printf("  -b        Fight the dungeon bosses instead of random encounters\n");
+    printf("  -L FILE   Write a battle transcript of each configuration's first encounter\n");
+    printf("  -a N      Play the party with auto-battle search, N rollouts per action\n");
+}
+
+int main(int argc, char** argv) {
+    Simulation sim;
+    memset(&sim, 0, sizeof(sim));
+    sim.encounters = 10000;
+    sim.seed = 12345;
+    sim.potions = 5;
+
+    long cores = sysconf(_SC_NPROCESSORS_ONLN);
+    sim.thread_count = cores > 0 ? (uint32_t)cores : 1;
+
+    char compositions[SIM_MAX_COMPOSITIONS][MAX_PARTY_SIZE + 1];
+    uint8_t composition_count = 0;
+    const char* composition_list = "KTPM";
+    uint8_t level_low = 1, level_high = 10;
+    uint8_t dungeon_low = 1, dungeon_high = 5;
+    const char* log_path = NULL;
+
+    int opt;
+    while ((opt = getopt(argc, argv, "n:j:p:l:d:i:s:bL:a:h")) != -1) {
+        switch (opt) {
+            case 'n': sim.encounters = (uint32_t)strtoul(optarg, NULL, 10); break;
+            case 'j': sim.thread_count = (uint32_t)strtoul(optarg, NULL, 10); break;
+            case 'p': composition_list = optarg; break;
+            case 'l':
+                if (!sim_parse_range(optarg, &level_low, &level_high)) {
+                    printf("Error: Invalid party level range '%s'\n", optarg);
+                    return 1;
+                }
+                break;
+            case 'd':
+                if (!sim_parse_range(optarg, &dungeon_low, &dungeon_high)) {
+                    printf("Error: Invalid dungeon range '%s'\n", optarg);
+                    return 1;
+                }
+                break;
+            case 'i': sim.potions = (uint8_t)strtoul(optarg, NULL, 10); break;
+            case 's': sim.seed = (uint32_t)strtoul(optarg, NULL, 10); break;
+            case 'b': sim.boss_mode = true; break;
+            case 'L': log_path = optarg; break;
+            case 'a': sim.auto_rollouts = (uint32_t)strtoul(optarg, NULL, 10); break;
+            default:
+                sim_usage();
+                return opt == 'h' ? 0 : 1;
+        }
+    }
+
+    if (sim.encounters == 0 || sim.thread_count == 0) {
+        printf("Error: Encounter and thread counts must be positive\n");
+        return 1;
+    }
+    if (dungeon_high > MAX_DUNGEONS + 1) {
+        printf("Error: Dungeon IDs run from 1 to %d\n", MAX_DUNGEONS + 1);
+        return 1;
+    }
+
+    // Parse compositions ("KTPM,KBSM")
+    const char* cursor = composition_list;
+    while (*cursor && composition_count < SIM_MAX_COMPOSITIONS) {
+        uint8_t length = 0;
+        while (*cursor && *cursor != ',') {
+            if (length >= MAX_PARTY_SIZE || sim_job_from_letter(*cursor) < 0) {
+                printf("Error: Invalid party composition '%s'\n", composition_list);
+                return 1;
+            }
+            compositions[composition_count][length++] = *cursor++;
+        }
+        compositions[composition_count][length] = '\0';
+        if (length > 0) composition_count++;
+        if (*cursor == ',') cursor++;
+    }
+    if (composition_count == 0) {
+        printf("Error: No party composition given\n");
+        return 1;
+    }
+
+    // One row per boss, or per dungeon floor that has an encounter table
+    encounter_tables_init();
+    uint32_t rows_per_level = 0;
+    for (uint8_t dungeon = dungeon_low; dungeon <= dungeon_high; dungeon++) {
+        for (uint8_t floor = 0; floor < MAX_DUNGEON_FLOORS; floor++) {
+            if (sim.boss_mode ? floor == 0 : encounter_table_for_floor(dungeon - 1, floor) != NULL) rows_per_level++;
+        }
+    }
+
+    // Build every configuration up front (single-threaded, shared RNG)
+    sim.config_count = composition_count * (level_high - level_low + 1) * rows_per_level;
+    sim.configs = calloc(sim.config_count, sizeof(SimConfig));
+    if (!sim.configs) {
+        printf("Error: Out of memory\n");
+        return 1;
+    }
+
+    static Dungeon boss_dungeon;
+    uint32_t index = 0;
+    for (uint8_t c = 0; c < composition_count; c++) {
+        for (uint8_t level = level_low; level <= level_high; level++) {
+            for (uint8_t dungeon = dungeon_low; dungeon <= dungeon_high; dungeon++) {
+                for (uint8_t floor = 0; floor < MAX_DUNGEON_FLOORS; floor++) {
+                    const EncounterTable* encounters = NULL;
+                    if (sim.boss_mode) {
+                        if (floor > 0) break;
+                    } else {
+                        encounters = encounter_table_for_floor(dungeon - 1, floor);
+                        if (!encounters) continue;
+                    }
+
+                    SimConfig* config = &sim.configs[index];
+                    memcpy(config->composition, compositions[c], sizeof(config->composition));
+                    config->party_level = level;
+                    config->dungeon = dungeon;
+                    config->floor = sim.boss_mode ? 0 : floor + 1;
+                    config->encounters = encounters;
+
+                    if (sim.boss_mode) {
+                        // Boss battles spawn no regular enemies
+                        dungeon_init_boss(&boss_dungeon, dungeon - 1);
+                        config->boss = boss_dungeon.boss;
+                    }
+
+                    sim_build_party(config, sim.potions, sim_mix_seed(sim.seed, index, 0xFFFFFFFFu));
+                    config->samples = calloc(sim.encounters, sizeof(SimSample));
+                    if (!config->samples) {
+                        printf("Error: Out of memory\n");
+                        return 1;
+                    }
+                    index++;
+                }
+            }
+        }
+    }
+
+    // Split the work into chunks and deal them round-robin to the workers
+    uint32_t chunks_per_config = (sim.encounters + SIM_JOB_CHUNK - 1) / SIM_JOB_CHUNK;
+    uint32_t job_total = sim.config_count * chunks_per_config;
+    sim.deques = calloc(sim.thread_count, sizeof(SimDeque));
+    SimWorker* workers = calloc(sim.thread_count, sizeof(SimWorker));
+    pthread_t* threads = calloc(sim.thread_count, sizeof(pthread_t));
+    if (!sim.deques || !workers || !threads) {
+        printf("Error: Out of memory\n");
+        return 1;
+    }
+
+    for (uint32_t t = 0; t < sim.thread_count; t++) {
+        pthread_mutex_init(&sim.deques[t].lock, NULL);
+        sim.deques[t].jobs = calloc(job_total / sim.thread_count + 1, sizeof(SimJob));
+        if (!sim.deques[t].jobs) {
+            printf("Error: Out of memory\n");
+            return 1;
+        }
+    }
+
+    uint32_t job_index = 0;
+    for (uint32_t c = 0; c < sim.config_count; c++) {
+        for (uint32_t first = 0; first < sim.encounters; first += SIM_JOB_CHUNK) {
+            SimDeque* deque = &sim.deques[job_index++ % sim.thread_count];
+            SimJob* job = &deque->jobs[deque->tail++];
+            job->config = c;
+            job->first = first;
+            job->count = (sim.encounters - first < SIM_JOB_CHUNK) ? sim.encounters - first : SIM_JOB_CHUNK;
+        }
+    }
+
+    struct timespec start, end;
+    clock_gettime(CLOCK_MONOTONIC, &start);
+
+    for (uint32_t t = 0; t < sim.thread_count; t++) {
+        workers[t].sim = &sim;
+        workers[t].index = t;
+        if (sim.auto_rollouts > 0) {
+            workers[t].ai = malloc(sizeof(BattleAIWorkspace));
+            if (!workers[t].ai) {
+                printf("Error: Out of memory\n");
+                return 1;
+            }
+        }
+        if (pthread_create(&threads[t], NULL, sim_worker_main, &workers[t]) != 0) {
+            printf("Error: Could not start worker thread %u\n", t);
+            return 1;
+        }
+    }
+    for (uint32_t t = 0; t < sim.thread_count; t++) {
+        pthread_join(threads[t], NULL);
+    }
+
+    clock_gettime(CLOCK_MONOTONIC, &end);
+    double seconds = (end.tv_sec - start.tv_sec) + (end.tv_nsec - start.tv_nsec) / 1e9;
+    double total = (double)sim.config_count * sim.encounters;
+
+    // Report
+    printf("=== Battle Simulation (%s) ===\n", sim.boss_mode ? "bosses" : "random encounters");
+    printf("%u configurations x %u encounters, %u threads, seed %u, %d potions",
+           sim.config_count, sim.encounters, sim.thread_count, sim.seed, sim.potions);
+    if (sim.auto_rollouts > 0) {
+        printf(", auto-battle %u rollouts", sim.auto_rollouts);
+    }
+    printf("\n\n");
+    printf("%-5s %3s %3s  %7s  %-14s  %-14s  %-14s  %-8s  %-8s\n",
+           "Party", "PLv", sim.boss_mode ? "Bos" : "D-F", "Win",
+           "Turns p50/90/99", "HP p50/90/99", "MP p50/90/99", "Potions", "KOs");
+
+    uint16_t* scratch = malloc(sim.encounters * sizeof(uint16_t));
+    if (!scratch) {
+        printf("Error: Out of memory\n");
+        return 1;
+    }
+    for (uint32_t c = 0; c < sim.config_count; c++) {
+        sim_report(&sim, &sim.configs[c], scratch);
+    }
+
+    printf("\n%.0f encounters in %.3f s (%.0f encounters/s)\n", total, seconds, total / seconds);
+
+    // Seeds are per encounter, so replaying encounter 0 reproduces the sampled battle exactly
+    if (log_path) {
+        FILE* log = fopen(log_path, "w");
+        if (!log) {
+            printf("Error: Could not open log file '%s'\n", log_path);
+            return 1;
+        }
+        for (uint32_t c = 0; c < sim.config_count; c++) {
+            SimConfig* config = &sim.configs[c];
+            SimSample sample;
+            char label[8];
+            sim_config_label(config, label, sizeof(label));
+            fprintf(log, "=== %s PLv %d %s %s, encounter 0 ===\n", config->composition,
+                    config->party_level, sim.boss_mode ? "Boss" : "Floor", label);
+            sim_run_encounter(&sim, config, sim_mix_seed(sim.seed, c, 0), workers[0].ai, &sample, log);
+            fprintf(log, "\n%s after %d turns\n\n", sample.won ? "Won" : "Lost", sample.turns);
+        }
+        fclose(log);
+        printf("Transcripts written to %s\n", log_path);
+    }
+
+    free(scratch);
+    for (uint32_t c = 0; c < sim.config_count; c++) free(sim.configs[c].samples);
+    for (uint32_t t = 0; t < sim.thread_count; t++) {
+        pthread_mutex_destroy(&sim.deques[t].lock);
+        free(sim.deques[t].jobs);
+        free(workers[t].ai); // NULL unless -a
+    }
+    free(sim.configs);
+    free(sim.deques);
+    free(workers);
+    free(threads);
+    return 0;
+}
@@ -0,0 +1,263 @@
+// Map compiler - turns the ASCII dungeon floors into ready-to-copy C tables
+//
+// Reads MAPS/dungeon_floors.txt and writes SRC/dungeon_map_data.c: one packed
+// tile blob per floor (DungeonFloor.tiles layout, two TileType nibbles per
+// byte), the floor's landmarks (start, stairs, boss, treasures) found ahead of
+// time, and a flat [dungeon][floor] index. The game copies a blob when a floor
+// is first entered instead of parsing characters.
+//
+// Host-only tool. Build and run with: make maps
+//
+// Usage: map_compiler <input.txt> <output.c>
+
+#include "dungeon_maps.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define MAPC_MAX_FLOORS ((MAX_DUNGEONS + 1) * MAX_DUNGEON_FLOORS)
+#define MAPC_LINE_SIZE 256
+
+typedef struct {
+    DungeonMapAsset asset;
+    uint8_t tiles[DUNGEON_TILE_BYTES];
+    uint16_t line;          // Where the floor starts in the source, for messages
+    uint8_t start_count;
+} MapcFloor;
+
+static MapcFloor mapc_floors[MAPC_MAX_FLOORS];
+static uint8_t mapc_floor_count = 0;
+static uint8_t mapc_index[MAX_DUNGEONS + 1][MAX_DUNGEON_FLOORS];
+
+static const DungeonMapPoint mapc_none = { DUNGEON_MAP_NONE, DUNGEON_MAP_NONE };
+
+static void mapc_set_tile(uint8_t* tiles, uint8_t x, uint8_t y, TileType type) {
+    uint16_t index = (uint16_t)y * DUNGEON_WIDTH + x;
+    uint8_t* packed = &tiles[index >> 1];
+    if (index & 1) {
+        *packed = (uint8_t)((*packed & 0x0F) | (type << 4));
+    } else {
+        *packed = (uint8_t)((*packed & 0xF0) | type);
+    }
+}
+
+static bool mapc_set_landmark(DungeonMapPoint* point, uint8_t x, uint8_t y, const char* what,
+                              const char* path, uint16_t line) {
+    if (point->x != DUNGEON_MAP_NONE) {
+        printf("Error: %s:%u: second %s on this floor\n", path, line, what);
+        return false;
+    }
+    point->x = x;
+    point->y = y;
+    return true;
+}
+
+// One map row; characters past the end of a short row stay floor, as they
+// always did when the loader read the string's NUL padding
+static bool mapc_parse_row(MapcFloor* floor, const char* row, uint8_t y, const char* path, uint16_t line) {
+    size_t length = strlen(row);
+    if (length > DUNGEON_WIDTH) {
+        printf("Error: %s:%u: row is %zu wide (max %d)\n", path, line, length, DUNGEON_WIDTH);
+        return false;
+    }
+
+    DungeonMapAsset* asset = &floor->asset;
+    for (uint8_t x = 0; x < length; x++) {
+        TileType type;
+        switch (row[x]) {
+            case '#': type = TILE_WALL; break;
+            case '.': type = TILE_FLOOR; break;
+            case 'E':
+            case 'U':
+                type = (row[x] == 'E') ? TILE_ENTRANCE : TILE_STAIRS_UP;
+                asset->start.x = x;
+                asset->start.y = y;
+                floor->start_count++;
+                if (row[x] == 'U' && !mapc_set_landmark(&asset->stairs_up, x, y, "stairs up", path, line)) return false;
+                break;
+            case 'D':
+                type = TILE_STAIRS_DOWN;
+                if (!mapc_set_landmark(&asset->stairs_down, x, y, "stairs down", path, line)) return false;
+                break;
+            case 'T':
+                type = TILE_TREASURE;
+                if (asset->treasure_count >= DUNGEON_MAP_MAX_TREASURES) {
+                    printf("Error: %s:%u: more than %d treasures on one floor\n", path, line, DUNGEON_MAP_MAX_TREASURES);
+                    return false;
+                }
+                asset->treasures[asset->treasure_count].x = x;
+                asset->treasures[asset->treasure_count].y = y;
+                asset->treasure_count++;
+                break;
+            case 'B':
+                type = TILE_BOSS_ROOM;
+                if (!mapc_set_landmark(&asset->boss, x, y, "boss room", path, line)) return false;
+                break;
+            default:
+                printf("Error: %s:%u: unknown map character '%c'\n", path, line, row[x]);
+                return false;
+        }
+        mapc_set_tile(floor->tiles, x, y, type);
+    }
+
+    if (length > asset->width) asset->width = (uint8_t)length;
+    return true;
+}
+
+static bool mapc_read(const char* path) {
+    FILE* file = fopen(path, "r");
+    if (!file) {
+        printf("Error: Cannot open %s\n", path);
+        return false;
+    }
+
+    char text[MAPC_LINE_SIZE];
+    uint16_t line = 0;
+    MapcFloor* floor = NULL;
+    bool ok = true;
+
+    while (ok && fgets(text, sizeof(text), file)) {
+        line++;
+        text[strcspn(text, "\r\n")] = '\0';
+
+        if (!floor) {
+            // Between floors: blank lines and '#' comments
+            if (text[0] == '\0' || text[0] == '#') continue;
+
+            unsigned dungeon_id, floor_number;
+            if (sscanf(text, "floor %u %u", &dungeon_id, &floor_number) != 2) {
+                printf("Error: %s:%u: expected 'floor <dungeon> <floor>'\n", path, line);
+                ok = false;
+            } else if (dungeon_id > MAX_DUNGEONS || floor_number >= MAX_DUNGEON_FLOORS) {
+                printf("Error: %s:%u: floor %u %u is out of range\n", path, line, dungeon_id, floor_number);
+                ok = false;
+            } else if (mapc_index[dungeon_id][floor_number] != DUNGEON_MAP_NONE) {
+                printf("Error: %s:%u: floor %u %u is defined twice\n", path, line, dungeon_id, floor_number);
+                ok = false;
+            } else {
+                mapc_index[dungeon_id][floor_number] = mapc_floor_count;
+                floor = &mapc_floors[mapc_floor_count++];
+                floor->line = line;
+                floor->asset.dungeon_id = (uint8_t)dungeon_id;
+                floor->asset.floor_number = (uint8_t)floor_number;
+                floor->asset.start = mapc_none;
+                floor->asset.stairs_down = mapc_none;
+                floor->asset.stairs_up = mapc_none;
+                floor->asset.boss = mapc_none;
+            }
+            continue;
+        }
+
+        if (strcmp(text, "end") == 0) {
+            if (floor->start_count != 1) {
+                printf("Error: %s:%u: floor needs exactly one 'E' or 'U' start (found %u)\n",
+                       path, floor->line, floor->start_count);
+                ok = false;
+            }
+            floor = NULL;
+        } else if (floor->asset.height >= DUNGEON_HEIGHT) {
+            printf("Error: %s:%u: more than %d rows\n", path, line, DUNGEON_HEIGHT);
+            ok = false;
+        } else {
+            ok = mapc_parse_row(floor, text, floor->asset.height, path, line);
+            floor->asset.height++;
+        }
+    }
+
+    if (ok && floor) {
+        printf("Error: %s:%u: floor is missing its 'end'\n", path, floor->line);
+        ok = false;
+    }
+
+    fclose(file);
+    return ok;
+}
+
+static void mapc_print_point(FILE* out, DungeonMapPoint point) {
+    if (point.x == DUNGEON_MAP_NONE) {
+        fprintf(out, "{ DUNGEON_MAP_NONE, DUNGEON_MAP_NONE }");
+    } else {
+        fprintf(out, "{ %u, %u }", point.x, point.y);
+    }
+}
+
+static bool mapc_write(const char* path, const char* source_path) {
+    FILE* out = fopen(path, "w");
+    if (!out) {
+        printf("Error: Cannot write %s\n", path);
+        return false;
+    }
+
+    fprintf(out, "// Generated by TOOLS/map_compiler.c from %s - do not edit.\n", source_path);
+    fprintf(out, "// Rebuild with: make maps\n\n");
+    fprintf(out, "#include \"dungeon_maps.h\"\n\n");
+
+    // Tile blobs, one source row (DUNGEON_WIDTH / 2 bytes) per line
+    fprintf(out, "static const uint8_t dungeon_map_tiles[%u][DUNGEON_TILE_BYTES] = {\n", mapc_floor_count);
+    for (uint8_t i = 0; i < mapc_floor_count; i++) {
+        const MapcFloor* floor = &mapc_floors[i];
+        fprintf(out, "    { // Dungeon %u, floor %u\n", floor->asset.dungeon_id, floor->asset.floor_number + 1);
+        for (uint16_t b = 0; b < DUNGEON_TILE_BYTES; b++) {
+            if (b % (DUNGEON_WIDTH / 2) == 0) fprintf(out, "        ");
+            fprintf(out, "0x%02X,", floor->tiles[b]);
+            fprintf(out, (b % (DUNGEON_WIDTH / 2) == DUNGEON_WIDTH / 2 - 1) ? "\n" : " ");
+        }
+        fprintf(out, "    },\n");
+    }
+    fprintf(out, "};\n\n");
+
+    fprintf(out, "const DungeonMapAsset dungeon_map_assets[] = {\n");
+    for (uint8_t i = 0; i < mapc_floor_count; i++) {
+        const DungeonMapAsset* asset = &mapc_floors[i].asset;
+        fprintf(out, "    { %u, %u, %u, %u, ", asset->dungeon_id, asset->floor_number, asset->width, asset->height);
+        mapc_print_point(out, asset->start);
+        fprintf(out, ", ");
+        mapc_print_point(out, asset->stairs_down);
+        fprintf(out, ", ");
+        mapc_print_point(out, asset->stairs_up);
+        fprintf(out, ", ");
+        mapc_print_point(out, asset->boss);
+        fprintf(out, ",\n      %u, { ", asset->treasure_count);
+        for (uint8_t t = 0; t < asset->treasure_count; t++) {
+            fprintf(out, "%s{ %u, %u }", t ? ", " : "", asset->treasures[t].x, asset->treasures[t].y);
+        }
+        fprintf(out, " }, dungeon_map_tiles[%u] },\n", i);
+    }
+    fprintf(out, "};\n\n");
+
+    fprintf(out, "const uint8_t dungeon_map_asset_count = %u;\n\n", mapc_floor_count);
+
+    fprintf(out, "const uint8_t dungeon_map_index[MAX_DUNGEONS + 1][MAX_DUNGEON_FLOORS] = {\n");
+    for (uint8_t d = 0; d <= MAX_DUNGEONS; d++) {
+        fprintf(out, "    { ");
+        for (uint8_t f = 0; f < MAX_DUNGEON_FLOORS; f++) {
+            if (mapc_index[d][f] == DUNGEON_MAP_NONE) {
+                fprintf(out, "%sDUNGEON_MAP_NONE", f ? ", " : "");
+            } else {
+                fprintf(out, "%s%u", f ? ", " : "", mapc_index[d][f]);
+            }
+        }
+        fprintf(out, " },\n");
+    }
+    fprintf(out, "};\n");
+
+    bool ok = !ferror(out);
+    if (fclose(out) != 0) ok = false;
+    if (!ok) printf("Error: Failed writing %s\n", path);
+    return ok;
+}
+
+int main(int argc, char** argv) {
+    if (argc != 3) {
+        printf("Usage: map_compiler <input.txt> <output.c>\n");
+        return 1;
+    }
+
+    memset(mapc_index, DUNGEON_MAP_NONE, sizeof(mapc_index));
+
+    if (!mapc_read(argv[1])) return 1;
+    if (!mapc_write(argv[2], argv[1])) return 1;
+
+    printf("Compiled %u dungeon floors into %s\n", mapc_floor_count, argv[2]);
+    return 0;
+}
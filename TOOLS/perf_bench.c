@@ -0,0 +1,1104 @@
+// Performance microbenchmarks for the game core
+//
+// Each benchmark times a hot path against the straightforward version it
+// replaced, on the same data, and prints ns per operation plus the speedup.
+//
+// Host-only tool. Build with: make bench
+//
+// Usage: perf_bench [-n iterations] [benchmark...]
+//        Benchmarks: stats snapshot render floor path explore passable location encounter
+//        town save autosave catalog pack (default: all)
+
+#define _POSIX_C_SOURCE 200809L
+
+#include "autosave.h"
+#include "battle.h"
+#include "dungeon.h"
+#include "dungeon_maps.h"
+#include "explore.h"
+#include "inventory.h"
+#include "party.h"
+#include "pathfind.h"
+#include "save_format.h"
+#include "save_pack.h"
+#include "save_system.h"
+#include "screen.h"
+#include "town_map.h"
+#include "utils.h"
+#include "world_map.h"
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <dirent.h>
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <time.h>
+#include <unistd.h>
+
+#define BENCH_DEFAULT_ITERATIONS 10000000u
+
+static volatile uint32_t bench_sink; // Keeps results observable
+
+static double bench_now(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + (double)ts.tv_nsec / 1e9;
+}
+
+static void bench_report(const char* name, uint32_t iterations, double seconds, double baseline) {
+    double ns = seconds * 1e9 / iterations;
+    if (baseline > 0.0) {
+        printf("  %-28s %8.2f ns/op  (%.2fx)\n", name, ns, baseline / seconds);
+    } else {
+        printf("  %-28s %8.2f ns/op\n", name, ns);
+    }
+}
+
+// ============================================================================
+// Derived stat cache
+// ============================================================================
+
+// Level 20 party in starting gear with a spread of active buffs, so the
+// uncached path pays for the full equipment and buff scans
+static void bench_build_party(Party* party, Inventory* inv) {
+    static const JobType jobs[MAX_PARTY_SIZE] = { JOB_KNIGHT, JOB_THIEF, JOB_PRIEST, JOB_MAGE };
+    RandomStream rng;
+
+    memset(party, 0, sizeof(Party));
+    memset(inv, 0, sizeof(Inventory));
+    random_stream_seed(&rng, 20);
+
+    for (uint8_t i = 0; i < MAX_PARTY_SIZE; i++) {
+        PartyMember* member = &party->members[party->member_count++];
+        character_init_member(member, jobs[i], job_names[jobs[i]]);
+        for (uint8_t level = 1; level < 20; level++) {
+            character_level_up(member, &rng);
+        }
+
+        const uint8_t* kit = job_starting_equipment[jobs[i]];
+        for (uint8_t k = 0; k < STARTING_EQUIPMENT_COUNT && kit[k] != EQUIP_NONE; k++) {
+            Item item = item_create_equipment(kit[k]);
+            item.is_equipped = true;
+            member->equipped_items[item.equip_type] = inv->equipment_count;
+            inv->equipment[inv->equipment_count++] = item;
+        }
+
+        character_add_buff(member, BUFF_REGEN_MP, 5, 200);
+        character_add_buff(member, BUFF_DEF_UP, 50, 200);
+        character_add_buff(member, BUFF_AGI_UP, 25, 200);
+        character_add_buff(member, BUFF_ATK_DOWN, 10, 200);
+    }
+}
+
+// One "read set" is what a battle action typically touches: every total once
+static void bench_stats(uint32_t iterations) {
+    static Party party;
+    static Inventory inv;
+    bench_build_party(&party, &inv);
+
+    printf("stats: derived combat stat reads (%u read sets)\n", iterations);
+
+    uint32_t sum = 0;
+    double start = bench_now();
+    for (uint32_t i = 0; i < iterations; i++) {
+        DerivedStats stats;
+        character_compute_derived_stats(&party.members[i & 3], &inv, &stats);
+        sum += stats.attack + stats.defense + stats.intelligence + stats.agility + stats.luck;
+    }
+    double uncached = bench_now() - start;
+    bench_sink = sum;
+    bench_report("uncached (recompute)", iterations, uncached, 0.0);
+
+    sum = 0;
+    start = bench_now();
+    for (uint32_t i = 0; i < iterations; i++) {
+        PartyMember* member = &party.members[i & 3];
+        sum += character_calc_total_attack(member, &inv);
+        sum += character_calc_total_defense(member, &inv);
+        sum += character_calc_total_intelligence(member, &inv);
+        sum += character_calc_total_agility(member, &inv);
+        sum += character_calc_total_luck(member, &inv);
+    }
+    bench_report("cached", iterations, bench_now() - start, uncached);
+    bench_sink = sum;
+
+    // A buff lands or expires roughly every couple of actions in a real fight
+    sum = 0;
+    start = bench_now();
+    for (uint32_t i = 0; i < iterations; i++) {
+        PartyMember* member = &party.members[i & 3];
+        if ((i & 7) == 0) character_invalidate_stats(member);
+        sum += character_calc_total_attack(member, &inv);
+        sum += character_calc_total_defense(member, &inv);
+        sum += character_calc_total_intelligence(member, &inv);
+        sum += character_calc_total_agility(member, &inv);
+        sum += character_calc_total_luck(member, &inv);
+    }
+    bench_report("cached, 1 in 8 invalidated", iterations, bench_now() - start, uncached);
+    bench_sink = sum;
+}
+
+// ============================================================================
+// Battle snapshots
+// ============================================================================
+
+// Mid-fight position: four enemies, party potions in the bag, buffs running.
+// Baseline copies the whole party, inventory and state the naive way.
+static void bench_snapshot(uint32_t iterations) {
+    static Party party;
+    static Inventory inv;
+    static BattleState state;
+    static BattleSnapshot snapshot;
+    static Party party_copy;
+    static Inventory inv_copy;
+    static BattleState state_copy;
+    static const EncounterFormation formation = {
+        1, 10, 13, MAX_ENEMIES, { ENEMY_ORC, ENEMY_SKELETON, ENEMY_DRAGON, ENEMY_DEMON }
+    };
+    RandomStream rng;
+    BattleContext ctx;
+
+    bench_build_party(&party, &inv);
+    inventory_store_item(&inv, ITEM_POTION, 5);
+    inventory_store_item(&inv, ITEM_ETHER, 3);
+    random_stream_seed(&rng, 7);
+    battle_context_init(&ctx, &state, &party, &inv, &rng);
+    battle_core_start(&ctx, NULL, false);
+    battle_core_generate_enemies(&ctx, &formation);
+    battle_core_calculate_turn_order(&ctx);
+
+    printf("snapshot: battle save + restore (%u round trips, %u-byte snapshot)\n",
+           iterations, (unsigned)sizeof(BattleSnapshot));
+
+    uint32_t sum = 0;
+    double start = bench_now();
+    for (uint32_t i = 0; i < iterations; i++) {
+        party_copy = party;
+        inv_copy = inv;
+        state_copy = state;
+        party.members[i & 3].stats.current_hp ^= 1;
+        party = party_copy;
+        inv = inv_copy;
+        state = state_copy;
+        sum += party.members[i & 3].stats.current_hp;
+    }
+    double baseline = bench_now() - start;
+    bench_sink = sum;
+    bench_report("full struct copies", iterations, baseline, 0.0);
+
+    sum = 0;
+    start = bench_now();
+    for (uint32_t i = 0; i < iterations; i++) {
+        battle_snapshot_save(&ctx, &snapshot);
+        party.members[i & 3].stats.current_hp ^= 1;
+        if (!battle_snapshot_restore(&ctx, &snapshot)) {
+            printf("  Error: snapshot does not fit the battle context\n");
+            return;
+        }
+        sum += party.members[i & 3].stats.current_hp;
+    }
+    bench_report("snapshot save/restore", iterations, bench_now() - start, baseline);
+    bench_sink = sum;
+}
+
+// ============================================================================
+// Terminal rendering
+// ============================================================================
+
+#define BENCH_VIEW_WIDTH 18
+#define BENCH_VIEW_HEIGHT 16
+
+// Walls round the edge, floor inside, the player walking along one row
+static const char* bench_view_cell(int x, int y, int frame, ScreenColor* color) {
+    if (y == 8 && x == 1 + frame % (BENCH_VIEW_WIDTH - 2)) {
+        *color = SCREEN_COLOR_LIGHTEST;
+        return "◉";
+    }
+    if (x == 0 || y == 0 || x == BENCH_VIEW_WIDTH - 1 || y == BENCH_VIEW_HEIGHT - 1) {
+        *color = SCREEN_COLOR_DARKEST;
+        return "█";
+    }
+    *color = SCREEN_COLOR_DARK;
+    return "·";
+}
+
+// Frames go to /dev/null; the report goes to the real stdout
+static void bench_render(uint32_t iterations) {
+    uint32_t frames = iterations / 1000 ? iterations / 1000 : 1;
+    int saved_stdout = dup(STDOUT_FILENO);
+    int null_fd = open("/dev/null", O_WRONLY);
+    if (saved_stdout < 0 || null_fd < 0) {
+        printf("Error: Could not redirect output to /dev/null\n");
+        return;
+    }
+
+    printf("render: dungeon viewport while walking (%u frames)\n", frames);
+    fflush(stdout);
+    dup2(null_fd, STDOUT_FILENO);
+
+    // Old path: every cell through printf with its own color and reset
+    static const char* const colors[SCREEN_COLOR_COUNT] = {
+        "\033[0m", "\033[90m", "\033[37m", "\033[97m", "\033[1;97m"
+    };
+    uint64_t legacy_bytes = 0;
+    double start = bench_now();
+    for (uint32_t f = 0; f < frames; f++) {
+        for (int y = 0; y < BENCH_VIEW_HEIGHT; y++) {
+            for (int x = 0; x < BENCH_VIEW_WIDTH; x++) {
+                ScreenColor color;
+                const char* glyph = bench_view_cell(x, y, (int)f, &color);
+                legacy_bytes += (uint64_t)printf("%s%s%s", colors[color], glyph, colors[0]);
+            }
+            legacy_bytes += (uint64_t)printf("\n");
+        }
+        fflush(stdout);
+    }
+    double legacy = bench_now() - start;
+
+    uint64_t diff_bytes = 0;
+    start = bench_now();
+    for (uint32_t f = 0; f < frames; f++) {
+        screen_begin_frame();
+        for (int y = 0; y < BENCH_VIEW_HEIGHT; y++) {
+            for (int x = 0; x < BENCH_VIEW_WIDTH; x++) {
+                ScreenColor color;
+                const char* glyph = bench_view_cell(x, y, (int)f, &color);
+                screen_put_glyph(glyph, color);
+            }
+            screen_print("\n");
+        }
+        diff_bytes += screen_present();
+    }
+    double diffed = bench_now() - start;
+
+    // The fork the old clear_screen() paid on every frame
+    uint32_t clears = frames < 200 ? frames : 200;
+    start = bench_now();
+    for (uint32_t f = 0; f < clears; f++) {
+        int result = system("clear");
+        (void)result;
+    }
+    double fork_cost = (bench_now() - start) / clears * frames;
+
+    fflush(stdout);
+    dup2(saved_stdout, STDOUT_FILENO);
+    close(saved_stdout);
+    close(null_fd);
+
+    bench_report("printf per cell", frames, legacy, 0.0);
+    bench_report("printf per cell + clear", frames, legacy + fork_cost, 0.0);
+    bench_report("diffed frame", frames, diffed, legacy + fork_cost);
+    printf("  bytes/frame: %llu per cell, %llu diffed\n",
+           (unsigned long long)(legacy_bytes / frames), (unsigned long long)(diff_bytes / frames));
+}
+
+// ============================================================================
+// Floor loading
+// ============================================================================
+
+static char bench_floor_ascii[MAX_DUNGEONS + 1][MAX_DUNGEON_FLOORS][DUNGEON_HEIGHT][DUNGEON_WIDTH + 1];
+
+// The runtime parser the map compiler replaced, character by character
+static void bench_parse_ascii_floor(DungeonFloor* floor, const char map[DUNGEON_HEIGHT][DUNGEON_WIDTH + 1],
+                                    uint8_t floor_number) {
+    memset(floor, 0, sizeof(DungeonFloor));
+    floor->encounter_steps = random_stream_range(random_get_stream(RNG_STREAM_MAP_GEN), 15, 30);
+    floor->encounter_rate = 20 + (floor_number * 5);
+
+    for (int y = 0; y < DUNGEON_HEIGHT; y++) {
+        for (int x = 0; x < DUNGEON_WIDTH; x++) {
+            TileType type;
+            switch (map[y][x]) {
+                case '#': type = TILE_WALL; break;
+                case 'E':
+                    type = TILE_ENTRANCE;
+                    floor->player_x = x;
+                    floor->player_y = y;
+                    dungeon_floor_set_explored(floor, x, y);
+                    break;
+                case 'D': type = TILE_STAIRS_DOWN; break;
+                case 'U':
+                    type = TILE_STAIRS_UP;
+                    floor->player_x = x;
+                    floor->player_y = y;
+                    dungeon_floor_set_explored(floor, x, y);
+                    break;
+                case 'T': type = TILE_TREASURE; break;
+                case 'B': type = TILE_BOSS_ROOM; break;
+                default: type = TILE_FLOOR; break;
+            }
+            dungeon_floor_set_tile(floor, x, y, type);
+        }
+    }
+    floor->width = 16;
+    floor->height = 16;
+}
+
+// Every fixed floor in turn; the ASCII is rebuilt from the compiled tables
+static void bench_floor(uint32_t iterations) {
+    static const char symbols[] = { '.', '#', '+', 'U', 'D', 'T', 'B', 'E' };
+    static DungeonFloor floor;
+    uint32_t loads = iterations / 100 ? iterations / 100 : 1;
+
+    for (uint8_t i = 0; i < dungeon_map_asset_count; i++) {
+        const DungeonMapAsset* asset = &dungeon_map_assets[i];
+        for (uint8_t y = 0; y < asset->height; y++) {
+            for (uint8_t x = 0; x < asset->width; x++) {
+                bench_floor_ascii[asset->dungeon_id][asset->floor_number][y][x] = symbols[dungeon_map_get_tile(asset, x, y)];
+            }
+        }
+    }
+
+    printf("floor: materialize a dungeon floor (%u loads over %u floors)\n", loads, dungeon_map_asset_count);
+
+    uint32_t sum = 0;
+    double start = bench_now();
+    for (uint32_t i = 0; i < loads; i++) {
+        const DungeonMapAsset* asset = &dungeon_map_assets[i % dungeon_map_asset_count];
+        bench_parse_ascii_floor(&floor, bench_floor_ascii[asset->dungeon_id][asset->floor_number], asset->floor_number);
+        sum += floor.player_x;
+    }
+    double baseline = bench_now() - start;
+    bench_sink = sum;
+    bench_report("parse ASCII map", loads, baseline, 0.0);
+
+    sum = 0;
+    start = bench_now();
+    for (uint32_t i = 0; i < loads; i++) {
+        const DungeonMapAsset* asset = &dungeon_map_assets[i % dungeon_map_asset_count];
+        dungeon_load_map_asset(&floor, asset, asset->floor_number);
+        sum += floor.player_x;
+    }
+    bench_report("copy compiled map", loads, bench_now() - start, baseline);
+    bench_sink = sum;
+}
+
+// ============================================================================
+// Pathfinding
+// ============================================================================
+
+// Fixed floors (start to stairs down or boss) plus an open 32x32 floor with
+// 25% random walls, routed corner to corner - the largest search a floor allows
+static void bench_path(uint32_t iterations) {
+    static DungeonFloor floors[MAX_DUNGEONS + 1][MAX_DUNGEON_FLOORS];
+    static DungeonFloor open_floor;
+    static DungeonPath path;
+    DungeonMapPoint goals[MAX_DUNGEONS + 1][MAX_DUNGEON_FLOORS];
+    uint32_t searches = iterations / 100 ? iterations / 100 : 1;
+    RandomStream rng;
+
+    for (uint8_t i = 0; i < dungeon_map_asset_count; i++) {
+        const DungeonMapAsset* asset = &dungeon_map_assets[i];
+        dungeon_load_map_asset(&floors[asset->dungeon_id][asset->floor_number], asset, asset->floor_number);
+        goals[asset->dungeon_id][asset->floor_number] =
+            asset->stairs_down.x != DUNGEON_MAP_NONE ? asset->stairs_down : asset->boss;
+    }
+
+    random_stream_seed(&rng, 32);
+    open_floor.width = DUNGEON_WIDTH;
+    open_floor.height = DUNGEON_HEIGHT;
+    for (uint8_t y = 0; y < DUNGEON_HEIGHT; y++) {
+        for (uint8_t x = 0; x < DUNGEON_WIDTH; x++) {
+            bool corner = (x + y < 3) || (x + y > 2 * DUNGEON_WIDTH - 5);
+            if (!corner && random_stream_chance(&rng, 25)) dungeon_floor_set_tile(&open_floor, x, y, TILE_WALL);
+        }
+    }
+    DungeonMapPoint far_corner = { DUNGEON_WIDTH - 1, DUNGEON_HEIGHT - 1 };
+
+    printf("path: A* routes (%u searches each)\n", searches);
+
+    uint32_t sum = 0;
+    double start = bench_now();
+    for (uint32_t i = 0; i < searches; i++) {
+        const DungeonMapAsset* asset = &dungeon_map_assets[i % dungeon_map_asset_count];
+        const DungeonFloor* floor = &floors[asset->dungeon_id][asset->floor_number];
+        if (pathfind_route(floor, floor->player_x, floor->player_y,
+                           &goals[asset->dungeon_id][asset->floor_number], 1, &path)) {
+            sum += path.length;
+        }
+    }
+    bench_report("16x16 floor to stairs/boss", searches, bench_now() - start, 0.0);
+
+    uint16_t length = 0;
+    start = bench_now();
+    for (uint32_t i = 0; i < searches; i++) {
+        if (pathfind_route(&open_floor, 0, 0, &far_corner, 1, &path)) {
+            sum += path.length;
+            length = path.length;
+        }
+    }
+    bench_report("32x32 floor corner to corner", searches, bench_now() - start, 0.0);
+    printf("  32x32 route: %u steps\n", length);
+    bench_sink = sum;
+}
+
+// ============================================================================
+// Auto-explore
+// ============================================================================
+
+// Walks a floor until nothing reachable is unexplored, asking the field for
+// every step. Returns the number of steps taken.
+static uint16_t bench_explore_floor(Dungeon* dungeon, const DungeonFloor* source, ExploreField* field, bool rebuild) {
+    DungeonFloor* floor = &dungeon->floors[0];
+    PathDirection direction;
+    int8_t dx, dy;
+    uint16_t steps = 0;
+
+    *floor = *source;
+    explore_field_build(field, floor);
+    while (explore_field_next_step(field, floor, &direction)) {
+        pathfind_direction_delta(direction, &dx, &dy);
+        dungeon_move_player(dungeon, dx, dy);
+        if (rebuild) {
+            explore_field_build(field, floor);
+        } else {
+            explore_field_update(field, floor);
+        }
+        steps++;
+    }
+    return steps;
+}
+
+// Explores every floor in the set once per run; returns seconds taken
+static double bench_explore_set(const DungeonFloor* floors, uint8_t count, uint32_t runs, bool rebuild,
+                                uint32_t* steps) {
+    static Dungeon dungeon;
+    static ExploreField field;
+
+    *steps = 0;
+    double start = bench_now();
+    for (uint32_t i = 0; i < runs; i++) {
+        *steps += bench_explore_floor(&dungeon, &floors[i % count], &field, rebuild);
+    }
+    return bench_now() - start;
+}
+
+// Whole-floor exploration, field rebuilt every step vs repaired in place, on
+// the fixed floors and the 32x32 floor from the path benchmark
+static void bench_explore(uint32_t iterations) {
+    static DungeonFloor fixed[MAX_DUNGEONS * MAX_DUNGEON_FLOORS + MAX_DUNGEON_FLOORS];
+    static DungeonFloor open_floor;
+    uint32_t runs = iterations / 1000 ? iterations / 1000 : 1;
+    uint32_t steps;
+    RandomStream rng;
+
+    for (uint8_t i = 0; i < dungeon_map_asset_count; i++) {
+        const DungeonMapAsset* asset = &dungeon_map_assets[i];
+        dungeon_load_map_asset(&fixed[i], asset, asset->floor_number);
+    }
+
+    random_stream_seed(&rng, 32);
+    open_floor.width = DUNGEON_WIDTH;
+    open_floor.height = DUNGEON_HEIGHT;
+    for (uint8_t y = 0; y < DUNGEON_HEIGHT; y++) {
+        for (uint8_t x = 0; x < DUNGEON_WIDTH; x++) {
+            bool corner = (x + y < 3) || (x + y > 2 * DUNGEON_WIDTH - 5);
+            if (!corner && random_stream_chance(&rng, 25)) dungeon_floor_set_tile(&open_floor, x, y, TILE_WALL);
+        }
+    }
+    dungeon_floor_set_explored(&open_floor, 0, 0);
+
+    printf("explore: auto-explore a whole floor (%u runs each)\n", runs);
+
+    double baseline = bench_explore_set(fixed, dungeon_map_asset_count, runs, true, &steps);
+    bench_report("16x16 floor, rebuild/step", runs, baseline, 0.0);
+    bench_report("16x16 floor, repair/step", runs,
+                 bench_explore_set(fixed, dungeon_map_asset_count, runs, false, &steps), baseline);
+    printf("  16x16 floors: %.1f steps each\n", (double)steps / runs);
+
+    baseline = bench_explore_set(&open_floor, 1, runs, true, &steps);
+    bench_report("32x32 floor, rebuild/step", runs, baseline, 0.0);
+    bench_report("32x32 floor, repair/step", runs, bench_explore_set(&open_floor, 1, runs, false, &steps), baseline);
+    printf("  32x32 floor: %u steps\n", steps / runs);
+    bench_sink = steps;
+}
+
+// ============================================================================
+// World map passability
+// ============================================================================
+
+// Old layout: one collision byte per tile, filled at startup
+static uint8_t bench_collision[WORLD_MAP_HEIGHT][WORLD_MAP_WIDTH];
+
+static bool bench_rect_bytes(uint8_t x, uint8_t y, uint8_t width, uint8_t height) {
+    if (x + width > WORLD_MAP_WIDTH || y + height > WORLD_MAP_HEIGHT) return false;
+    for (uint8_t row = y; row < y + height; row++) {
+        for (uint8_t col = x; col < x + width; col++) {
+            if (bench_collision[row][col]) return false;
+        }
+    }
+    return true;
+}
+
+// 8x8 rectangle checks at random spots (about 1 in 4 fully walkable)
+static void bench_passable(uint32_t iterations) {
+    static uint8_t spots[4096][2];
+    RandomStream rng;
+
+    world_map_init();
+    for (uint8_t y = 0; y < WORLD_MAP_HEIGHT; y++) {
+        for (uint8_t x = 0; x < WORLD_MAP_WIDTH; x++) {
+            uint8_t tile = g_world_map.tiles[y][x];
+            bench_collision[y][x] = (tile >= 0x20 && tile < 0x40);
+        }
+    }
+    random_stream_seed(&rng, 16);
+    for (uint16_t i = 0; i < 4096; i++) {
+        spots[i][0] = (uint8_t)random_stream_range(&rng, 0, WORLD_MAP_WIDTH - 8);
+        spots[i][1] = (uint8_t)random_stream_range(&rng, 0, WORLD_MAP_HEIGHT - 8);
+    }
+
+    printf("passable: world map 8x8 rectangle query (collision %zu -> %zu bytes)\n",
+           sizeof(bench_collision), sizeof(world_map_passable));
+
+    uint32_t sum = 0;
+    double start = bench_now();
+    for (uint32_t i = 0; i < iterations; i++) {
+        sum += bench_rect_bytes(spots[i & 4095][0], spots[i & 4095][1], 8, 8);
+    }
+    double baseline = bench_now() - start;
+    bench_report("byte per tile", iterations, baseline, 0.0);
+    uint32_t expected = sum;
+
+    sum = 0;
+    start = bench_now();
+    for (uint32_t i = 0; i < iterations; i++) {
+        sum += world_map_rect_is_passable(spots[i & 4095][0], spots[i & 4095][1], 8, 8);
+    }
+    bench_report("bit per tile, word at a time", iterations, bench_now() - start, baseline);
+    if (sum != expected) printf("  Error: bitmap disagrees with collision bytes\n");
+    bench_sink = sum;
+}
+
+// Old lookup: every town and dungeon's 2x2 bounds, in order
+static WorldLocation* bench_location_scan(uint8_t x, uint8_t y) {
+    for (int i = 0; i < NUM_TOWNS; i++) {
+        int tx = g_world_map.towns[i].x;
+        int ty = g_world_map.towns[i].y;
+        if (x >= tx && x <= tx + 1 && y >= ty && y <= ty + 1) return &g_world_map.towns[i];
+    }
+    for (int i = 0; i < NUM_DUNGEONS; i++) {
+        int dx = g_world_map.dungeons[i].x;
+        int dy = g_world_map.dungeons[i].y;
+        if (x >= dx && x <= dx + 1 && y >= dy && y <= dy + 1) return &g_world_map.dungeons[i];
+    }
+    return NULL;
+}
+
+// Location lookup on every tile of the map in turn (one overworld step each)
+static void bench_location(uint32_t iterations) {
+    world_map_init();
+    printf("location: world map location lookup per step\n");
+
+    uint32_t hits = 0;
+    double start = bench_now();
+    for (uint32_t i = 0; i < iterations; i++) {
+        hits += bench_location_scan((uint8_t)(i & 127), (uint8_t)((i >> 7) & 127)) != NULL;
+    }
+    double baseline = bench_now() - start;
+    bench_report("scan all locations", iterations, baseline, 0.0);
+    uint32_t expected = hits;
+
+    hits = 0;
+    start = bench_now();
+    for (uint32_t i = 0; i < iterations; i++) {
+        hits += world_map_get_location_at((uint8_t)(i & 127), (uint8_t)((i >> 7) & 127)) != NULL;
+    }
+    bench_report("8x8 cell index", iterations, bench_now() - start, baseline);
+    if (hits != expected) printf("  Error: index disagrees with the scan\n");
+    bench_sink = hits;
+}
+
+// ============================================================================
+// Encounter formations
+// ============================================================================
+
+#define BENCH_ENCOUNTER_TABLES (ENCOUNTER_ZONE_COUNT + (MAX_DUNGEONS + 1) * MAX_DUNGEON_FLOORS)
+
+// Straightforward pick: walk the cumulative weights until the draw is passed
+static const EncounterFormation* bench_encounter_scan(const EncounterTable* table, RandomStream* rng) {
+    uint32_t draw = random_stream_bounded(rng, table->total_weight);
+    for (uint8_t i = 0; i < table->formation_count; i++) {
+        if (draw < table->formations[i].weight) return &table->formations[i];
+        draw -= table->formations[i].weight;
+    }
+    return &table->formations[table->formation_count - 1];
+}
+
+// One formation pick per encounter, cycling through every zone and floor table.
+// Also checks the alias picks land on each formation at its weighted rate.
+static void bench_encounter(uint32_t iterations) {
+    const EncounterTable* tables[BENCH_ENCOUNTER_TABLES];
+    uint8_t table_count = 0;
+
+    encounter_tables_init();
+    for (uint8_t zone = 0; zone < ENCOUNTER_ZONE_COUNT; zone++) {
+        if (encounter_table_for_zone(zone)) tables[table_count++] = encounter_table_for_zone(zone);
+    }
+    for (uint8_t dungeon = 0; dungeon <= MAX_DUNGEONS; dungeon++) {
+        for (uint8_t floor = 0; floor < MAX_DUNGEON_FLOORS; floor++) {
+            if (encounter_table_for_floor(dungeon, floor)) tables[table_count++] = encounter_table_for_floor(dungeon, floor);
+        }
+    }
+    printf("encounter: formation pick (%u tables)\n", table_count);
+
+    RandomStream rng;
+    uint32_t sum = 0;
+    random_stream_seed(&rng, 11);
+    double start = bench_now();
+    for (uint32_t i = 0; i < iterations; i++) {
+        sum += bench_encounter_scan(tables[i % table_count], &rng)->count;
+    }
+    double baseline = bench_now() - start;
+    bench_report("cumulative weight scan", iterations, baseline, 0.0);
+
+    random_stream_seed(&rng, 11);
+    start = bench_now();
+    for (uint32_t i = 0; i < iterations; i++) {
+        sum += encounter_table_pick(tables[i % table_count], &rng)->count;
+    }
+    bench_report("alias table", iterations, bench_now() - start, baseline);
+    bench_sink = sum;
+
+    // Largest gap between observed and weighted share on the first table. A
+    // correct table still wanders by about one standard error, sqrt(p(1-p)/n),
+    // so a formation only counts as off past five of them.
+    const EncounterTable* table = tables[0];
+    uint32_t hits[ENCOUNTER_MAX_FORMATIONS] = { 0 };
+    random_stream_seed(&rng, 13);
+    for (uint32_t i = 0; i < iterations; i++) {
+        hits[encounter_table_pick(table, &rng) - table->formations]++;
+    }
+    double worst = 0.0;
+    bool off = false;
+    for (uint8_t i = 0; i < table->formation_count; i++) {
+        double expected = (double)table->formations[i].weight / table->total_weight;
+        double gap = fabs((double)hits[i] / iterations - expected);
+        if (gap > worst) worst = gap;
+        if (gap > 5.0 * sqrt(expected * (1.0 - expected) / iterations)) off = true;
+    }
+    printf("  largest share error          %8.4f%%\n", worst * 100.0);
+    if (off) printf("  Error: alias picks are off their weights\n");
+}
+
+// ============================================================================
+// Towns
+// ============================================================================
+
+// Walking between the four mapped towns: copying each one in again on every
+// visit vs the cache, then a building lookup on every tile of the town
+static void bench_town(uint32_t iterations) {
+    static const char* names[TOWN_MAP_COUNT] = { "Greenleaf", "Coral Bay", "Emberforge", "Windspire" };
+    static void (*const inits[TOWN_MAP_COUNT])(TownMap* map) = {
+        greenleaf_init, coral_bay_init, emberforge_init, windspire_init
+    };
+    static TownMap copy;
+    uint32_t switches = iterations / 1000 + 1;
+    uint32_t sum = 0;
+
+    printf("town: town switch (%u switches) and building lookup\n", switches);
+
+    double start = bench_now();
+    for (uint32_t i = 0; i < switches; i++) {
+        inits[i % TOWN_MAP_COUNT](&copy);
+        sum += copy.tiles[i & 31][i & 31];
+    }
+    double baseline = bench_now() - start;
+    bench_report("copy tiles + collision", switches, baseline, 0.0);
+
+    start = bench_now();
+    for (uint32_t i = 0; i < switches; i++) {
+        town_map_load(names[i % TOWN_MAP_COUNT]);
+        sum += g_current_town->tiles[i & 31][i & 31];
+    }
+    bench_report("town cache", switches, bench_now() - start, baseline);
+
+    town_map_load("Greenleaf");
+    start = bench_now();
+    for (uint32_t i = 0; i < iterations; i++) {
+        sum += town_map_get_building_at((uint8_t)(i & 31), (uint8_t)((i >> 5) & 31));
+    }
+    bench_report("building lookup", iterations, bench_now() - start, 0.0);
+    bench_sink = sum;
+}
+
+// ============================================================================
+// Save commit
+// ============================================================================
+
+typedef struct {
+    char directory[32];
+    char cwd[256];
+    int saved_stdout;
+    int null_fd;
+} BenchScratch;
+
+// Moves into a fresh directory beside the real saves (same disk, none of
+// their files), mutes the game's own messages and sets up a level 20 party
+static bool bench_scratch_enter(BenchScratch* scratch) {
+    snprintf(scratch->directory, sizeof(scratch->directory), "dqrpg_bench_XXXXXX");
+    if (!getcwd(scratch->cwd, sizeof(scratch->cwd)) || !mkdtemp(scratch->directory) ||
+        chdir(scratch->directory) != 0) {
+        printf("Error: Could not create a scratch directory for the benchmark\n");
+        return false;
+    }
+
+    scratch->saved_stdout = dup(STDOUT_FILENO);
+    scratch->null_fd = open("/dev/null", O_WRONLY);
+    if (scratch->saved_stdout < 0 || scratch->null_fd < 0) {
+        printf("Error: Could not redirect output to /dev/null\n");
+        return false;
+    }
+    fflush(stdout);
+    dup2(scratch->null_fd, STDOUT_FILENO);
+
+    game_state_init();
+    g_game_state.party = party_create();
+    g_game_state.inventory = inventory_create();
+    bench_build_party(g_game_state.party, g_game_state.inventory);
+    return true;
+}
+
+static void bench_scratch_leave(BenchScratch* scratch) {
+    fflush(stdout);
+    dup2(scratch->saved_stdout, STDOUT_FILENO);
+    close(scratch->saved_stdout);
+    close(scratch->null_fd);
+
+    DIR* dir = opendir(".");
+    if (dir) {
+        struct dirent* entry;
+        while ((entry = readdir(dir)) != NULL) {
+            if (entry->d_name[0] != '.') remove(entry->d_name);
+        }
+        closedir(dir);
+    }
+    if (chdir(scratch->cwd) != 0 || rmdir(scratch->directory) != 0) {
+        printf("Error: Could not remove scratch directory %s\n", scratch->directory);
+    }
+}
+
+// Committing a save crash-safe (temp file, fsync, rename, directory fsync) vs
+// the old in-place overwrite of the raw struct, then a save of an unchanged game
+static void bench_save(uint32_t iterations) {
+    uint32_t commits = iterations / 100000 + 1;
+    BenchScratch scratch;
+
+    printf("save: commit a save (%u commits)\n", commits);
+    if (!bench_scratch_enter(&scratch)) return;
+
+    static SaveData save_data;
+    double start = bench_now();
+    for (uint32_t i = 0; i < commits; i++) {
+        g_game_state.gold = (uint16_t)i;
+        save_data_from_game_state(&save_data);
+        FILE* file = fopen("dqrpg_save_0.sav", "wb");
+        if (file) {
+            fwrite(&save_data, sizeof(SaveData), 1, file);
+            fclose(file);
+        }
+    }
+    double baseline = bench_now() - start;
+    remove("dqrpg_save_0.sav");
+
+    uint32_t failures = 0;
+    start = bench_now();
+    for (uint32_t i = 0; i < commits; i++) {
+        g_game_state.gold = (uint16_t)i;
+        if (!save_game_to_slot(0)) failures++;
+    }
+    double atomic = bench_now() - start;
+
+    start = bench_now();
+    for (uint32_t i = 0; i < commits; i++) {
+        if (!save_game_to_slot(0)) failures++;
+    }
+    double unchanged = bench_now() - start;
+
+    struct stat st;
+    long bytes = stat("dqrpg_save_0.sav", &st) == 0 ? (long)st.st_size : -1;
+    bench_scratch_leave(&scratch);
+
+    bench_report("overwrite raw struct", commits, baseline, 0.0);
+    bench_report("temp + fsync + rename", commits, atomic, baseline);
+    bench_report("unchanged game", commits, unchanged, baseline);
+    printf("  bytes/save: %lu raw struct, %ld chunked\n", (unsigned long)sizeof(SaveData), bytes);
+    if (failures) printf("  %u saves failed\n", failures);
+}
+
+// Time the game spends at a safe point: committing the autosave inline vs
+// handing a snapshot to the worker. The requests come back to back, as in a
+// burst of floor changes, so most of them coalesce.
+static void bench_autosave(uint32_t iterations) {
+    uint32_t requests = iterations / 10000 + 1;
+    BenchScratch scratch;
+
+    printf("autosave: safe point cost (%u requests)\n", requests);
+    if (!bench_scratch_enter(&scratch)) return;
+
+    static SaveData snapshot;
+    uint32_t failures = 0;
+    uint32_t inline_requests = requests < 200 ? requests : 200;
+    double start = bench_now();
+    for (uint32_t i = 0; i < inline_requests; i++) {
+        g_game_state.gold = (uint16_t)i;
+        save_data_from_game_state(&snapshot);
+        if (!save_autosave_data(&snapshot)) failures++;
+    }
+    double inline_cost = (bench_now() - start) / inline_requests * requests;
+
+    if (!autosave_start()) {
+        bench_scratch_leave(&scratch);
+        printf("Error: Could not start the autosave worker\n");
+        return;
+    }
+
+    double worst = 0.0;
+    start = bench_now();
+    for (uint32_t i = 0; i < requests; i++) {
+        g_game_state.gold = (uint16_t)(i + 1000);
+        double before = bench_now();
+        autosave_request();
+        double took = bench_now() - before;
+        if (took > worst) worst = took;
+    }
+    double background = bench_now() - start;
+
+    start = bench_now();
+    autosave_stop();
+    double drain = bench_now() - start;
+
+    AutosaveStats stats = autosave_get_stats();
+    bench_scratch_leave(&scratch);
+
+    bench_report("snapshot + commit inline", requests, inline_cost, 0.0);
+    bench_report("autosave_request", requests, background, inline_cost);
+    printf("  slowest request: %.1f us, final write drained in %.1f us\n", worst * 1e6, drain * 1e6);
+    printf("  %u requests, %u written, %u coalesced, %u failed\n",
+           stats.requests, stats.writes, stats.coalesced, stats.failures + failures);
+}
+
+// Drawing the slot list: every slot, one in eight saved. Baseline is the old
+// listing, which opened each slot (or its backup) and read and decoded the
+// whole save to fill in a preview; the catalog reads the header only, and only once.
+static void bench_catalog(uint32_t iterations) {
+    uint32_t listings = iterations / 1000000 + 1;
+    BenchScratch scratch;
+
+    printf("catalog: list %d save slots (%u listings)\n", MAX_SAVE_SLOTS, listings);
+    if (!bench_scratch_enter(&scratch)) return;
+
+    uint32_t failures = 0;
+    for (uint16_t slot = 0; slot < MAX_SAVE_SLOTS; slot += 8) {
+        g_game_state.gold = slot;
+        if (!save_game_to_slot(slot)) failures++;
+    }
+
+    static SaveImage image;
+    static SaveData save_data;
+    SavePreview preview;
+    uint32_t found = 0;
+    double start = bench_now();
+    for (uint32_t i = 0; i < listings; i++) {
+        for (uint16_t slot = 0; slot < MAX_SAVE_SLOTS; slot++) {
+            char path[64];
+            char backup_path[80];
+            snprintf(path, sizeof(path), "%s%d.sav", SAVE_FILE_PREFIX, slot);
+            snprintf(backup_path, sizeof(backup_path), "%s%s", path, SAVE_BACKUP_SUFFIX);
+            FILE* file = fopen(path, "rb");
+            if (!file) file = fopen(backup_path, "rb");
+            if (!file) continue;
+            image.size = (uint32_t)fread(image.bytes, 1, sizeof(image.bytes), file);
+            fclose(file);
+            if (save_format_parse(&image, &save_data)) {
+                save_format_preview(&save_data, &preview);
+                found += preview.gold;
+            }
+        }
+    }
+    double baseline = bench_now() - start;
+
+    start = bench_now();
+    for (uint32_t i = 0; i < listings; i++) {
+        save_catalog_invalidate();
+        for (uint16_t slot = 0; slot < MAX_SAVE_SLOTS; slot++) {
+            found += get_save_slot_info(slot).gold;
+        }
+    }
+    double cold = bench_now() - start;
+
+    start = bench_now();
+    for (uint32_t i = 0; i < listings; i++) {
+        for (uint16_t slot = 0; slot < MAX_SAVE_SLOTS; slot++) {
+            found += get_save_slot_info(slot).gold;
+        }
+    }
+    double warm = bench_now() - start;
+
+    bench_sink = found;
+    bench_scratch_leave(&scratch);
+
+    bench_report("open + decode every save", listings, baseline, 0.0);
+    bench_report("catalog, headers only", listings, cold, baseline);
+    bench_report("catalog, already read", listings, warm, baseline);
+    printf("  header read per slot: %d of %lu bytes (fresh game)\n",
+           SAVE_FORMAT_HEADER_SIZE, (unsigned long)image.size);
+    if (failures) printf("  %u saves failed\n", failures);
+}
+
+// Mid-game save: the level 20 party, three dungeons entered with every floor
+// but the last explored. Baseline is the chunked file image, built and parsed.
+static void bench_pack(uint32_t iterations) {
+    uint32_t saves = iterations / 100 + 1;
+    BenchScratch scratch;
+
+    printf("pack: SRAM image encode / decode (%u saves)\n", saves);
+    if (!bench_scratch_enter(&scratch)) return;
+
+    static ExploreField field;
+    PathDirection direction;
+    int8_t dx, dy;
+    for (uint8_t d = 0; d < 3; d++) {
+        Dungeon* dungeon = &g_game_state.dungeons[d];
+        dungeon_init(dungeon, d, dungeon_names[d], 3);
+        g_game_state.dungeon_initialized[d] = true;
+
+        for (uint8_t f = 0; f < dungeon->floor_count; f++) {
+            dungeon->current_floor = f;
+            DungeonFloor* floor = dungeon_materialize_floor(dungeon, f);
+            explore_field_build(&field, floor);
+            uint16_t steps = f + 1 < dungeon->floor_count ? 1000 : 60;
+            for (uint16_t i = 0; i < steps && explore_field_next_step(&field, floor, &direction); i++) {
+                pathfind_direction_delta(direction, &dx, &dy);
+                dungeon_move_player(dungeon, dx, dy);
+                explore_field_update(&field, floor);
+            }
+        }
+    }
+    g_game_state.current_dungeon_index = 2;
+    g_game_state.current_state = STATE_DUNGEON_EXPLORE;
+
+    static SaveData save_data;
+    static SaveData decoded;
+    static SaveImage chunked;
+    static uint8_t image[SAVE_PACK_MAX_SIZE];
+    save_data_from_game_state(&save_data);
+    bench_scratch_leave(&scratch);
+
+    double start = bench_now();
+    for (uint32_t i = 0; i < saves; i++) {
+        save_format_build(&chunked, &save_data);
+    }
+    double build = bench_now() - start;
+
+    uint16_t size = 0;
+    start = bench_now();
+    for (uint32_t i = 0; i < saves; i++) {
+        size = save_pack_encode(&save_data, image);
+    }
+    double encode = bench_now() - start;
+
+    uint32_t failures = 0;
+    start = bench_now();
+    for (uint32_t i = 0; i < saves; i++) {
+        if (!save_format_parse(&chunked, &decoded)) failures++;
+    }
+    double parse = bench_now() - start;
+
+    start = bench_now();
+    for (uint32_t i = 0; i < saves; i++) {
+        if (!save_pack_decode(image, size, &decoded)) failures++;
+    }
+    double decode = bench_now() - start;
+
+    if (memcmp(&save_data, &decoded, sizeof(SaveData)) != 0) failures++;
+
+    bench_report("chunked file build", saves, build, 0.0);
+    bench_report("save_pack_encode", saves, encode, build);
+    bench_report("chunked file parse", saves, parse, 0.0);
+    bench_report("save_pack_decode", saves, decode, parse);
+    printf("  bytes: %u packed, %u chunked, %lu raw struct; encode %.1f MB/s, decode %.1f MB/s of SaveData\n",
+           size, chunked.size, (unsigned long)sizeof(SaveData),
+           sizeof(SaveData) * saves / encode / 1e6, sizeof(SaveData) * saves / decode / 1e6);
+    if (failures) printf("  %u round trips failed\n", failures);
+}
+
+// ============================================================================
+// Driver
+// ============================================================================
+
+typedef struct {
+    const char* name;
+    void (*run)(uint32_t iterations);
+} Benchmark;
+
+static const Benchmark benchmarks[] = {
+    { "stats", bench_stats },
+    { "snapshot", bench_snapshot },
+    { "render", bench_render },
+    { "floor", bench_floor },
+    { "path", bench_path },
+    { "explore", bench_explore },
+    { "passable", bench_passable },
+    { "location", bench_location },
+    { "encounter", bench_encounter },
+    { "town", bench_town },
+    { "save", bench_save },
+    { "autosave", bench_autosave },
+    { "catalog", bench_catalog },
+    { "pack", bench_pack },
+};
+
+#define BENCHMARK_COUNT (sizeof(benchmarks) / sizeof(benchmarks[0]))
+
+static void bench_usage(const char* program) {
+    printf("Usage: %s [-n iterations] [benchmark...]\n", program);
+    printf("Benchmarks:");
+    for (size_t i = 0; i < BENCHMARK_COUNT; i++) {
+        printf(" %s", benchmarks[i].name);
+    }
+    printf("\n");
+}
+
+int main(int argc, char** argv) {
+    uint32_t iterations = BENCH_DEFAULT_ITERATIONS;
+    int opt;
+
+    while ((opt = getopt(argc, argv, "n:h")) != -1) {
+        switch (opt) {
+            case 'n':
+                iterations = (uint32_t)strtoul(optarg, NULL, 10);
+                if (iterations == 0) {
+                    printf("Error: Iteration count must be positive\n");
+                    return 1;
+                }
+                break;
+            default:
+                bench_usage(argv[0]);
+                return opt == 'h' ? 0 : 1;
+        }
+    }
+
+    // No names given - run everything
+    if (optind >= argc) {
+        for (size_t i = 0; i < BENCHMARK_COUNT; i++) {
+            benchmarks[i].run(iterations);
+        }
+        return 0;
+    }
+
+    for (int arg = optind; arg < argc; arg++) {
+        size_t i = 0;
+        while (i < BENCHMARK_COUNT && strcmp(argv[arg], benchmarks[i].name) != 0) i++;
+
+        if (i == BENCHMARK_COUNT) {
+            printf("Error: Unknown benchmark '%s'\n", argv[arg]);
+            bench_usage(argv[0]);
+            return 1;
+        }
+        benchmarks[i].run(iterations);
+    }
+
+    return 0;
+}
@@ -0,0 +1,388 @@
+// Save file compatibility check - old save files must still load
+//
+// Plays short games (party levelled up, dungeons entered and partly
+// explored, treasure taken) and for each one:
+//   version 1     writes the save as the first release did (SaveDataV1, raw
+//                 struct, byte-sum checksum), loads it through
+//                 load_game_from_slot and checks the game comes back the same;
+//                 only floors_loaded may differ, rebuilt as save_data_from_v1
+//                 documents
+//   current       saves that game again in the current format, loads it and
+//                 checks the state is unchanged
+//   damaged       a version 1 file with one bit flipped, and one cut short,
+//                 must be refused
+// Runs in a scratch directory; exits non-zero on any failure.
+//
+// Host-only tool. Build with: make saves
+//
+// Usage: save_check [-g played_games] [-s seed]
+
+#define _POSIX_C_SOURCE 200809L
+
+#include "dungeon.h"
+#include "dungeon_maps.h"
+#include "explore.h"
+#include "inventory.h"
+#include "party.h"
+#include "pathfind.h"
+#include "save_system.h"
+#include "utils.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <dirent.h>
+#include <fcntl.h>
+#include <unistd.h>
+
+#define CHECK_DEFAULT_PLAYED_GAMES 200
+#define CHECK_MAX_EXPLORE_STEPS 400
+#define CHECK_SLOT 0
+#define CHECK_DAMAGED_SLOT 1
+
+static int check_saved_stdout = -1;
+
+// The game reports every save and load; keep the report readable
+static void check_mute(void) {
+    int null_fd = open("/dev/null", O_WRONLY);
+    if (null_fd < 0) return;
+    fflush(stdout);
+    check_saved_stdout = dup(STDOUT_FILENO);
+    dup2(null_fd, STDOUT_FILENO);
+    close(null_fd);
+}
+
+static void check_unmute(void) {
+    if (check_saved_stdout < 0) return;
+    fflush(stdout);
+    dup2(check_saved_stdout, STDOUT_FILENO);
+    close(check_saved_stdout);
+    check_saved_stdout = -1;
+}
+
+static bool check_fail(const char* label, uint32_t index, const char* what) {
+    printf("  FAIL %s #%u: %s\n", label, index, what);
+    return false;
+}
+
+static bool check_same(const SaveData* expected, const SaveData* actual, const char* label, uint32_t index) {
+    if (memcmp(expected, actual, sizeof(SaveData)) == 0) return true;
+
+    const uint8_t* a = (const uint8_t*)expected;
+    const uint8_t* b = (const uint8_t*)actual;
+    size_t offset = 0;
+    while (a[offset] == b[offset]) offset++;
+    printf("  FAIL %s #%u: loaded game differs at byte %lu of %lu\n",
+           label, index, (unsigned long)offset, (unsigned long)sizeof(SaveData));
+    return false;
+}
+
+// ============================================================================
+// Played games
+// ============================================================================
+
+static const char* check_names[] = { "Aria", "Bo", "Cid", "Dorothea", "Eli", "Faris", "Galuf", "Hiro" };
+
+static void check_build_party(RandomStream* rng) {
+    Party* party = g_game_state.party;
+    Inventory* inv = g_game_state.inventory;
+    memset(party, 0, sizeof(Party));
+    memset(inv, 0, sizeof(Inventory));
+
+    uint8_t members = (uint8_t)random_stream_range(rng, 1, MAX_PARTY_SIZE);
+    uint8_t level = (uint8_t)random_stream_range(rng, 1, 40);
+    for (uint8_t i = 0; i < members; i++) {
+        PartyMember* member = &party->members[party->member_count++];
+        JobType job = (JobType)random_stream_bounded(rng, MAX_JOB_TYPES);
+        character_init_member(member, job, check_names[random_stream_bounded(rng, 8)]);
+        for (uint8_t l = 1; l < level; l++) character_level_up(member, rng);
+        member->stats.current_hp = (uint16_t)random_stream_range(rng, 0, member->stats.max_hp);
+
+        const uint8_t* kit = job_starting_equipment[job];
+        for (uint8_t k = 0; k < STARTING_EQUIPMENT_COUNT && kit[k] != EQUIP_NONE; k++) {
+            Item item = item_create_equipment(kit[k]);
+            item.is_equipped = true;
+            member->equipped_items[item.equip_type] = inv->equipment_count;
+            inv->equipment[inv->equipment_count++] = item;
+        }
+    }
+
+    for (uint8_t id = 0; id < ITEM_CONSUMABLE_COUNT; id++) {
+        if (random_stream_chance(rng, 60)) {
+            inventory_store_item(inv, id, (uint8_t)random_stream_range(rng, 1, 30));
+        }
+    }
+}
+
+// Enters the floor, walks part of it, and picks up what was reached
+static void check_play_floor(Dungeon* dungeon, uint8_t floor_index, uint16_t steps, RandomStream* rng) {
+    static ExploreField field;
+    PathDirection direction;
+    int8_t dx, dy;
+
+    dungeon->current_floor = floor_index;
+    DungeonFloor* floor = dungeon_materialize_floor(dungeon, floor_index);
+    explore_field_build(&field, floor);
+    for (uint16_t i = 0; i < steps && explore_field_next_step(&field, floor, &direction); i++) {
+        pathfind_direction_delta(direction, &dx, &dy);
+        dungeon_move_player(dungeon, dx, dy);
+        explore_field_update(&field, floor);
+    }
+
+    const DungeonMapAsset* map = dungeon->floor_maps[floor_index];
+    for (uint8_t t = 0; map && t < map->treasure_count; t++) {
+        uint8_t x = map->treasures[t].x;
+        uint8_t y = map->treasures[t].y;
+        if (dungeon_floor_is_explored(floor, x, y) && random_stream_chance(rng, 70)) {
+            dungeon_floor_set_tile(floor, x, y, TILE_FLOOR);
+        }
+    }
+}
+
+static void check_build_game(SaveData* save_data, RandomStream* rng) {
+    game_state_init();
+    g_game_state.party = party_create();
+    g_game_state.inventory = inventory_create();
+    check_build_party(rng);
+
+    uint8_t dungeons = (uint8_t)random_stream_range(rng, 0, MAX_DUNGEONS + 1);
+    for (uint8_t d = 0; d < dungeons; d++) {
+        Dungeon* dungeon = &g_game_state.dungeons[d];
+        uint8_t floor_count = (d == MAX_DUNGEONS) ? 5 : 3;
+        dungeon_init(dungeon, d, dungeon_names[d], floor_count);
+        g_game_state.dungeon_initialized[d] = true;
+
+        uint8_t reached = (uint8_t)random_stream_range(rng, 1, floor_count);
+        for (uint8_t f = 0; f < reached; f++) {
+            uint16_t steps = f + 1 < reached ? CHECK_MAX_EXPLORE_STEPS
+                                             : (uint16_t)random_stream_bounded(rng, CHECK_MAX_EXPLORE_STEPS);
+            check_play_floor(dungeon, f, steps, rng);
+        }
+        g_game_state.current_dungeon_index = d;
+    }
+
+    // The first release had no world map
+    g_game_state.current_state = dungeons ? STATE_DUNGEON_EXPLORE : STATE_DUNGEON_SELECT;
+    g_game_state.gold = (uint16_t)random_stream_bounded(rng, 20000);
+    g_game_state.game_time = random_stream_bounded(rng, 360000);
+
+    save_data_from_game_state(save_data);
+}
+
+// ============================================================================
+// Version 1 files
+// ============================================================================
+
+// The save as the first release's save_data_from_game_state laid it out
+static void check_build_v1(const SaveData* save_data, SaveDataV1* old_data) {
+    memset(old_data, 0, sizeof(SaveDataV1));
+    old_data->magic = SAVE_MAGIC;
+    old_data->version = SAVE_DATA_V1_VERSION;
+
+    old_data->current_state = save_data->current_state;
+    old_data->current_dungeon_index = save_data->current_dungeon_index;
+    memcpy(old_data->dungeon_initialized, save_data->dungeon_initialized, sizeof(old_data->dungeon_initialized));
+    memcpy(old_data->dungeons_completed, save_data->dungeons_completed, sizeof(old_data->dungeons_completed));
+    old_data->final_dungeon_unlocked = save_data->final_dungeon_unlocked;
+    old_data->key_items_collected = save_data->key_items_collected;
+    old_data->gold = save_data->gold;
+    old_data->game_time = save_data->game_time;
+
+    for (int i = 0; i <= MAX_DUNGEONS; i++) {
+        const SaveDungeonData* dungeon = &save_data->dungeon_data[i];
+        SaveDungeonDataV1* old_dungeon = &old_data->dungeon_data[i];
+        old_dungeon->current_floor = dungeon->current_floor;
+        old_dungeon->player_x = dungeon->player_x;
+        old_dungeon->player_y = dungeon->player_y;
+        old_dungeon->encounter_steps = dungeon->encounter_steps;
+        old_dungeon->boss_defeated = dungeon->boss_defeated;
+        old_dungeon->completed = dungeon->completed;
+        memcpy(old_dungeon->explored_tiles, dungeon->explored_tiles, sizeof(old_dungeon->explored_tiles));
+        memcpy(old_dungeon->treasure_collected, dungeon->treasure_collected, sizeof(old_dungeon->treasure_collected));
+    }
+
+    old_data->party_data.member_count = save_data->party_data.member_count;
+    memcpy(old_data->party_data.members, save_data->party_data.members, sizeof(old_data->party_data.members));
+    old_data->inventory_data.item_count = save_data->inventory_data.item_count;
+    memcpy(old_data->inventory_data.items, save_data->inventory_data.items, sizeof(old_data->inventory_data.items));
+    old_data->inventory_data.equipment_count = save_data->inventory_data.equipment_count;
+    memcpy(old_data->inventory_data.equipment, save_data->inventory_data.equipment,
+           sizeof(old_data->inventory_data.equipment));
+
+    const uint8_t* data = (const uint8_t*)old_data;
+    size_t offset = sizeof(old_data->magic) + sizeof(old_data->version) + sizeof(old_data->checksum);
+    for (size_t i = offset; i < sizeof(SaveDataV1); i++) {
+        old_data->checksum += data[i];
+    }
+}
+
+// The first release wrote the struct in one fwrite, straight over the slot
+static bool check_write_v1(uint16_t slot, const SaveDataV1* old_data, size_t length) {
+    char path[64];
+    snprintf(path, sizeof(path), "%s%d.sav", SAVE_FILE_PREFIX, slot);
+
+    FILE* file = fopen(path, "wb");
+    if (!file) return false;
+    bool written = fwrite(old_data, 1, length, file) == length;
+    fclose(file);
+    save_catalog_invalidate();
+    return written;
+}
+
+// What the game saves after loading the version 1 file: every dungeon with
+// anything explored has all its floors back (see save_data_from_v1), and the
+// floors the party never entered add what arriving on them marks explored
+static void check_expect_v1(SaveData* save_data) {
+    static Dungeon fresh;
+
+    for (int i = 0; i <= MAX_DUNGEONS; i++) {
+        if (!save_data->dungeon_initialized[i]) continue;
+
+        SaveDungeonData* dungeon = &save_data->dungeon_data[i];
+        uint8_t floor_count = (i == MAX_DUNGEONS) ? 5 : 3;
+        bool explored = false;
+        for (int b = 0; b < DUNGEON_EXPLORED_BYTES && !explored; b++) {
+            explored = dungeon->explored_tiles[b] != 0;
+        }
+        if (!explored) continue;
+
+        dungeon_init(&fresh, (uint8_t)i, dungeon_names[i], floor_count);
+        for (uint8_t f = 0; f < floor_count; f++) {
+            if (dungeon->floors_loaded & (1 << f)) continue;
+            DungeonFloor* floor = dungeon_materialize_floor(&fresh, f);
+            for (int b = 0; b < DUNGEON_EXPLORED_BYTES; b++) dungeon->explored_tiles[b] |= floor->explored[b];
+        }
+        dungeon->floors_loaded = (uint8_t)((1u << floor_count) - 1);
+    }
+    save_data->checksum = calculate_checksum(save_data);
+}
+
+// ============================================================================
+// Checks
+// ============================================================================
+
+static bool check_game(const SaveData* played, uint32_t index, RandomStream* rng) {
+    static SaveDataV1 old_data;
+    static SaveData expected;
+    static SaveData loaded;
+    static SaveData reloaded;
+
+    check_build_v1(played, &old_data);
+    if (!check_write_v1(CHECK_SLOT, &old_data, sizeof(SaveDataV1))) {
+        return check_fail("version 1", index, "could not write the file");
+    }
+
+    SaveSlotInfo info = get_save_slot_info(CHECK_SLOT);
+    if (!info.exists || info.gold != played->gold || info.game_time != played->game_time) {
+        return check_fail("version 1", index, "slot list does not show the save");
+    }
+
+    check_mute();
+    bool loaded_ok = load_game_from_slot(CHECK_SLOT);
+    if (loaded_ok) save_data_from_game_state(&loaded);
+    check_unmute();
+    if (!loaded_ok) return check_fail("version 1", index, "file refused");
+
+    expected = *played;
+    check_mute();
+    check_expect_v1(&expected);
+    check_unmute();
+    if (!check_same(&expected, &loaded, "version 1", index)) return false;
+
+    // Saving upgrades the file; the game must survive that too
+    check_mute();
+    bool saved_ok = save_game_to_slot(CHECK_SLOT);
+    game_state_init();
+    bool reloaded_ok = saved_ok && load_game_from_slot(CHECK_SLOT);
+    if (reloaded_ok) save_data_from_game_state(&reloaded);
+    check_unmute();
+    if (!saved_ok) return check_fail("current", index, "could not save");
+    if (!reloaded_ok) return check_fail("current", index, "file refused");
+    if (!check_same(&loaded, &reloaded, "current", index)) return false;
+
+    // Damage must be caught, never loaded as a different game (this slot has
+    // no backup to fall back on)
+    uint32_t bit = random_stream_bounded(rng, (uint32_t)sizeof(SaveDataV1) * 8);
+    ((uint8_t*)&old_data)[bit / 8] ^= (uint8_t)(1 << (bit % 8));
+    check_mute();
+    bool flipped_ok = check_write_v1(CHECK_DAMAGED_SLOT, &old_data, sizeof(SaveDataV1)) &&
+                      load_game_from_slot(CHECK_DAMAGED_SLOT);
+    ((uint8_t*)&old_data)[bit / 8] ^= (uint8_t)(1 << (bit % 8));
+    bool truncated_ok = check_write_v1(CHECK_DAMAGED_SLOT, &old_data, sizeof(SaveDataV1) - 1) &&
+                        load_game_from_slot(CHECK_DAMAGED_SLOT);
+    check_unmute();
+    if (flipped_ok) return check_fail("damaged", index, "flipped bit not detected");
+    if (truncated_ok) return check_fail("damaged", index, "truncated file accepted");
+    return true;
+}
+
+// Scratch directory beside the real saves, so none of them are touched
+static bool check_enter(char* directory, size_t directory_size, char* cwd, size_t cwd_size) {
+    snprintf(directory, directory_size, "dqrpg_check_XXXXXX");
+    if (!getcwd(cwd, cwd_size) || !mkdtemp(directory) || chdir(directory) != 0) {
+        printf("Error: Could not create a scratch directory for the check\n");
+        return false;
+    }
+    return true;
+}
+
+static void check_leave(const char* directory, const char* cwd) {
+    DIR* dir = opendir(".");
+    if (dir) {
+        struct dirent* entry;
+        while ((entry = readdir(dir)) != NULL) {
+            if (entry->d_name[0] != '.') remove(entry->d_name);
+        }
+        closedir(dir);
+    }
+    if (chdir(cwd) != 0 || rmdir(directory) != 0) {
+        printf("Error: Could not remove scratch directory %s\n", directory);
+    }
+}
+
+int main(int argc, char** argv) {
+    uint32_t played_games = CHECK_DEFAULT_PLAYED_GAMES;
+    uint64_t seed = 12;
+    int opt;
+
+    while ((opt = getopt(argc, argv, "g:s:h")) != -1) {
+        switch (opt) {
+            case 'g':
+                played_games = (uint32_t)strtoul(optarg, NULL, 10);
+                break;
+            case 's':
+                seed = strtoull(optarg, NULL, 10);
+                break;
+            default:
+                printf("Usage: %s [-g played_games] [-s seed]\n", argv[0]);
+                return opt == 'h' ? 0 : 1;
+        }
+    }
+
+    char directory[32];
+    char cwd[256];
+    if (!check_enter(directory, sizeof(directory), cwd, sizeof(cwd))) return 1;
+
+    printf("save_check: version 1 files (%lu bytes) against the current loader\n",
+           (unsigned long)sizeof(SaveDataV1));
+
+    static SaveData played;
+    RandomStream rng;
+    random_stream_seed(&rng, seed);
+    uint32_t failures = 0;
+
+    for (uint32_t i = 0; i < played_games; i++) {
+        check_mute();
+        check_build_game(&played, &rng);
+        check_unmute();
+        if (!check_game(&played, i, &rng)) failures++;
+    }
+
+    check_leave(directory, cwd);
+
+    if (failures) {
+        printf("%u of %u games failed\n", failures, played_games);
+        return 1;
+    }
+    printf("All %u games load from version 1 files and survive a save in the current format\n", played_games);
+    return 0;
+}
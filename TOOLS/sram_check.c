@@ -0,0 +1,524 @@
+// SRAM save image check - packed save round trips against the SRAM budget
+//
+// Runs three kinds of save data through save_pack:
+//   played games  parties levelled up, dungeons entered and auto-explored in
+//                 part, treasure taken, items bought - what the game saves
+//   random saves  every SaveData field drawn at random (names, skills and
+//                 bitsets included) in the form save_data_from_game_state
+//                 leaves it: unused records and padding zeroed
+//   worst case    every field at its escape code and every bitset beyond
+//                 the run codings; must pack to exactly SAVE_PACK_MAX_SIZE
+// Each save must decode to the same bytes, re-encode to the same image, and
+// have a flipped bit or a truncated image rejected. Prints image sizes next
+// to the chunked file and the SRAM budget; exits non-zero on any failure.
+//
+// Host-only tool. Build with: make sram
+//
+// Usage: sram_check [-n random_saves] [-g played_games] [-s seed]
+
+#define _POSIX_C_SOURCE 200809L
+
+#include "dungeon.h"
+#include "dungeon_maps.h"
+#include "explore.h"
+#include "inventory.h"
+#include "party.h"
+#include "pathfind.h"
+#include "save_format.h"
+#include "save_pack.h"
+#include "save_system.h"
+#include "utils.h"
+#include "world_map.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <fcntl.h>
+#include <unistd.h>
+
+#define SRAM_DEFAULT_RANDOM_SAVES 20000
+#define SRAM_DEFAULT_PLAYED_GAMES 200
+#define SRAM_MAX_EXPLORE_STEPS 400
+
+typedef struct {
+    uint32_t saves;
+    uint32_t failures;
+    uint32_t min_size;
+    uint32_t max_size;
+    uint64_t total_size;
+    uint64_t total_chunked;
+} SramTally;
+
+static int sram_saved_stdout = -1;
+
+// Game setup and expected decode failures talk; keep the report readable
+static void sram_mute(void) {
+    int null_fd = open("/dev/null", O_WRONLY);
+    if (null_fd < 0) return;
+    fflush(stdout);
+    sram_saved_stdout = dup(STDOUT_FILENO);
+    dup2(null_fd, STDOUT_FILENO);
+    close(null_fd);
+}
+
+static void sram_unmute(void) {
+    if (sram_saved_stdout < 0) return;
+    fflush(stdout);
+    dup2(sram_saved_stdout, STDOUT_FILENO);
+    close(sram_saved_stdout);
+    sram_saved_stdout = -1;
+}
+
+// ============================================================================
+// Round trip
+// ============================================================================
+
+static bool sram_fail(const char* label, uint32_t index, const char* what) {
+    printf("  FAIL %s #%u: %s\n", label, index, what);
+    return false;
+}
+
+static bool sram_round_trip(const SaveData* save_data, const char* label, uint32_t index,
+                            RandomStream* rng, SramTally* tally) {
+    static uint8_t image[SAVE_PACK_MAX_SIZE];
+    static uint8_t again[SAVE_PACK_MAX_SIZE];
+    static SaveData decoded;
+    static SaveImage chunked;
+
+    uint16_t size = save_pack_encode(save_data, image);
+    if (size > SAVE_PACK_MAX_SIZE || size > SAVE_SRAM_SIZE) return sram_fail(label, index, "image over budget");
+
+    sram_mute();
+    bool decoded_ok = save_pack_decode(image, size, &decoded);
+    sram_unmute();
+    if (!decoded_ok) return sram_fail(label, index, "image rejected");
+
+    if (memcmp(save_data, &decoded, sizeof(SaveData)) != 0) {
+        const uint8_t* a = (const uint8_t*)save_data;
+        const uint8_t* b = (const uint8_t*)&decoded;
+        size_t offset = 0;
+        while (a[offset] == b[offset]) offset++;
+        printf("  FAIL %s #%u: decoded data differs at byte %lu of %lu\n",
+               label, index, (unsigned long)offset, (unsigned long)sizeof(SaveData));
+        return false;
+    }
+
+    if (save_pack_encode(&decoded, again) != size || memcmp(image, again, size) != 0) {
+        return sram_fail(label, index, "re-encoding changed the image");
+    }
+
+    // Damage must be caught, never loaded as a different game
+    uint32_t bit = random_stream_bounded(rng, (uint32_t)size * 8);
+    image[bit / 8] ^= (uint8_t)(1 << (bit % 8));
+    sram_mute();
+    bool flipped_ok = save_pack_decode(image, size, &decoded);
+    bool truncated_ok = save_pack_decode(again, (uint16_t)(size - 1), &decoded);
+    sram_unmute();
+    if (flipped_ok) return sram_fail(label, index, "flipped bit not detected");
+    if (truncated_ok) return sram_fail(label, index, "truncated image accepted");
+
+    save_format_build(&chunked, save_data);
+    if (tally->saves == 0 || size < tally->min_size) tally->min_size = size;
+    if (size > tally->max_size) tally->max_size = size;
+    tally->total_size += size;
+    tally->total_chunked += chunked.size;
+    tally->saves++;
+    return true;
+}
+
+static void sram_run(const SaveData* save_data, const char* label, uint32_t index,
+                     RandomStream* rng, SramTally* tally) {
+    if (!sram_round_trip(save_data, label, index, rng, tally)) tally->failures++;
+}
+
+static void sram_report(const char* label, const SramTally* tally) {
+    if (tally->saves == 0) return;
+    printf("  %-13s %6u saves  %5u min %7.1f avg %5u max bytes  (chunked file avg %.1f)\n",
+           label, tally->saves, tally->min_size, (double)tally->total_size / tally->saves,
+           tally->max_size, (double)tally->total_chunked / tally->saves);
+}
+
+// ============================================================================
+// Played games
+// ============================================================================
+
+static const char* sram_names[] = { "Aria", "Bo", "Cid", "Dorothea", "Eli", "Faris", "Galuf", "Hiro" };
+
+static void sram_build_party(RandomStream* rng) {
+    Party* party = g_game_state.party;
+    Inventory* inv = g_game_state.inventory;
+    memset(party, 0, sizeof(Party));
+    memset(inv, 0, sizeof(Inventory));
+
+    uint8_t members = (uint8_t)random_stream_range(rng, 1, MAX_PARTY_SIZE);
+    uint8_t level = (uint8_t)random_stream_range(rng, 1, 40);
+    for (uint8_t i = 0; i < members; i++) {
+        PartyMember* member = &party->members[party->member_count++];
+        JobType job = (JobType)random_stream_bounded(rng, MAX_JOB_TYPES);
+        character_init_member(member, job, sram_names[random_stream_bounded(rng, 8)]);
+        for (uint8_t l = 1; l < level; l++) character_level_up(member, rng);
+        member->stats.current_hp = (uint16_t)random_stream_range(rng, 0, member->stats.max_hp);
+
+        const uint8_t* kit = job_starting_equipment[job];
+        for (uint8_t k = 0; k < STARTING_EQUIPMENT_COUNT && kit[k] != EQUIP_NONE; k++) {
+            Item item = item_create_equipment(kit[k]);
+            item.is_equipped = true;
+            member->equipped_items[item.equip_type] = inv->equipment_count;
+            inv->equipment[inv->equipment_count++] = item;
+        }
+    }
+
+    // Spare gear from other kits, and a bag of consumables
+    uint8_t spares = (uint8_t)random_stream_bounded(rng, 6);
+    for (uint8_t i = 0; i < spares && inv->equipment_count < MAX_EQUIPMENT_SLOTS; i++) {
+        uint8_t equip_id = job_starting_equipment[random_stream_bounded(rng, MAX_JOB_TYPES)][0];
+        inv->equipment[inv->equipment_count++] = item_create_equipment(equip_id);
+    }
+    for (uint8_t id = 0; id < ITEM_CONSUMABLE_COUNT; id++) {
+        if (random_stream_chance(rng, 60)) {
+            inventory_store_item(inv, id, (uint8_t)random_stream_range(rng, 1, 30));
+        }
+    }
+}
+
+// Enters the floor, walks part of it, and picks up what was reached
+static void sram_play_floor(Dungeon* dungeon, uint8_t floor_index, uint16_t steps, RandomStream* rng) {
+    static ExploreField field;
+    PathDirection direction;
+    int8_t dx, dy;
+
+    dungeon->current_floor = floor_index;
+    DungeonFloor* floor = dungeon_materialize_floor(dungeon, floor_index);
+    explore_field_build(&field, floor);
+    for (uint16_t i = 0; i < steps && explore_field_next_step(&field, floor, &direction); i++) {
+        pathfind_direction_delta(direction, &dx, &dy);
+        dungeon_move_player(dungeon, dx, dy);
+        explore_field_update(&field, floor);
+    }
+
+    const DungeonMapAsset* map = dungeon->floor_maps[floor_index];
+    for (uint8_t t = 0; map && t < map->treasure_count; t++) {
+        uint8_t x = map->treasures[t].x;
+        uint8_t y = map->treasures[t].y;
+        if (dungeon_floor_is_explored(floor, x, y) && random_stream_chance(rng, 70)) {
+            dungeon_floor_set_tile(floor, x, y, TILE_FLOOR);
+        }
+    }
+}
+
+static void sram_build_game(SaveData* save_data, RandomStream* rng) {
+    game_state_init();
+    g_game_state.party = party_create();
+    g_game_state.inventory = inventory_create();
+    sram_build_party(rng);
+
+    uint8_t dungeons = (uint8_t)random_stream_range(rng, 0, MAX_DUNGEONS + 1);
+    for (uint8_t d = 0; d < dungeons; d++) {
+        Dungeon* dungeon = &g_game_state.dungeons[d];
+        uint8_t floor_count = (d == MAX_DUNGEONS) ? 5 : 3;
+        dungeon_init(dungeon, d, dungeon_names[d], floor_count);
+        g_game_state.dungeon_initialized[d] = true;
+
+        // Earlier floors cleared, the last one reached only partly explored
+        uint8_t reached = (uint8_t)random_stream_range(rng, 1, floor_count);
+        for (uint8_t f = 0; f < reached; f++) {
+            uint16_t steps = f + 1 < reached ? SRAM_MAX_EXPLORE_STEPS
+                                             : (uint16_t)random_stream_bounded(rng, SRAM_MAX_EXPLORE_STEPS);
+            sram_play_floor(dungeon, f, steps, rng);
+        }
+
+        if (d < MAX_DUNGEONS && reached == floor_count && random_stream_chance(rng, 50)) {
+            dungeon->boss_defeated = true;
+            dungeon->completed = true;
+            g_game_state.dungeons_completed[d] = true;
+            g_game_state.key_items_collected |= (uint8_t)(1 << d);
+        }
+        g_game_state.current_dungeon_index = d;
+    }
+
+    g_game_state.current_state = dungeons ? STATE_DUNGEON_EXPLORE : STATE_WORLD_MAP;
+    g_game_state.final_dungeon_unlocked = g_game_state.key_items_collected == 0x0F;
+    g_game_state.gold = (uint16_t)random_stream_bounded(rng, 20000);
+    g_game_state.game_time = random_stream_bounded(rng, 360000);
+    g_game_state.world_x = (uint8_t)random_stream_bounded(rng, WORLD_MAP_WIDTH);
+    g_game_state.world_y = (uint8_t)random_stream_bounded(rng, WORLD_MAP_HEIGHT);
+    g_game_state.world_encounter_steps = (uint8_t)random_stream_bounded(rng, 64);
+    g_game_state.hub_state = random_stream_chance(rng, 50) ? STATE_WORLD_MAP : STATE_DUNGEON_SELECT;
+
+    save_data_from_game_state(save_data);
+}
+
+// ============================================================================
+// Random and worst-case saves
+// ============================================================================
+
+// 7-bit text, now and then with bytes the plain coding cannot hold
+static void sram_random_name(char* name, RandomStream* rng) {
+    uint8_t length = (uint8_t)random_stream_bounded(rng, MAX_NAME_LENGTH);
+    bool high = random_stream_chance(rng, 5);
+    for (uint8_t i = 0; i < length; i++) {
+        name[i] = (char)random_stream_range(rng, high ? 1 : 32, high ? 255 : 126);
+    }
+}
+
+// Empty, sparse (treasure), rooms (explored), or noise
+static void sram_random_bitset(uint8_t* bits, RandomStream* rng) {
+    switch (random_stream_bounded(rng, 4)) {
+        case 0:
+            break;
+        case 1: {
+            uint8_t count = (uint8_t)random_stream_bounded(rng, 12);
+            for (uint8_t i = 0; i < count; i++) {
+                uint16_t tile = (uint16_t)random_stream_bounded(rng, DUNGEON_WIDTH * DUNGEON_HEIGHT);
+                bits[tile / 8] |= (uint8_t)(1 << (tile % 8));
+            }
+            break;
+        }
+        case 2: {
+            uint8_t rooms = (uint8_t)random_stream_range(rng, 1, 8);
+            for (uint8_t r = 0; r < rooms; r++) {
+                uint8_t x0 = (uint8_t)random_stream_bounded(rng, DUNGEON_WIDTH);
+                uint8_t y0 = (uint8_t)random_stream_bounded(rng, DUNGEON_HEIGHT);
+                uint8_t x1 = (uint8_t)random_stream_range(rng, x0, DUNGEON_WIDTH - 1);
+                uint8_t y1 = (uint8_t)random_stream_range(rng, y0, DUNGEON_HEIGHT - 1);
+                for (uint8_t y = y0; y <= y1; y++) {
+                    for (uint8_t x = x0; x <= x1; x++) {
+                        uint16_t tile = (uint16_t)(y * DUNGEON_WIDTH + x);
+                        bits[tile / 8] |= (uint8_t)(1 << (tile % 8));
+                    }
+                }
+            }
+            break;
+        }
+        default:
+            for (uint16_t i = 0; i < DUNGEON_EXPLORED_BYTES; i++) bits[i] = (uint8_t)random_stream_next(rng);
+            break;
+    }
+}
+
+// A wide value now and then, so the escape codes get exercised
+static uint32_t sram_random_value(RandomStream* rng, uint32_t usual, uint32_t full) {
+    if (random_stream_chance(rng, 10)) return full ? random_stream_next(rng) % full : random_stream_next(rng);
+    return random_stream_bounded(rng, usual);
+}
+
+static void sram_build_random(SaveData* save_data, RandomStream* rng) {
+    memset(save_data, 0, sizeof(SaveData));
+    save_data->magic = SAVE_MAGIC;
+    save_data->version = SAVE_DATA_VERSION;
+
+    save_data->current_state = (GameState)sram_random_value(rng, STATE_WORLD_MAP + 1, 0);
+    save_data->current_dungeon_index = (uint8_t)sram_random_value(rng, MAX_DUNGEONS + 1, 256);
+    for (uint8_t i = 0; i <= MAX_DUNGEONS; i++) save_data->dungeon_initialized[i] = random_stream_chance(rng, 50);
+    for (uint8_t i = 0; i < MAX_DUNGEONS; i++) save_data->dungeons_completed[i] = random_stream_chance(rng, 30);
+    save_data->final_dungeon_unlocked = random_stream_chance(rng, 20);
+    save_data->key_items_collected = (uint8_t)random_stream_bounded(rng, 256);
+    save_data->gold = (uint16_t)sram_random_value(rng, 5000, 65536);
+    save_data->game_time = sram_random_value(rng, 100000, 0);
+    save_data->world_x = (uint8_t)random_stream_bounded(rng, 256);
+    save_data->world_y = (uint8_t)random_stream_bounded(rng, 256);
+    save_data->world_encounter_steps = (uint8_t)random_stream_bounded(rng, 256);
+    save_data->hub_state = (GameState)sram_random_value(rng, STATE_WORLD_MAP + 1, 0);
+
+    for (uint8_t i = 0; i <= MAX_DUNGEONS; i++) {
+        if (!save_data->dungeon_initialized[i]) continue;
+        SaveDungeonData* dungeon = &save_data->dungeon_data[i];
+        dungeon->current_floor = (uint8_t)sram_random_value(rng, MAX_DUNGEON_FLOORS, 256);
+        dungeon->player_x = (uint8_t)sram_random_value(rng, DUNGEON_WIDTH, 256);
+        dungeon->player_y = (uint8_t)sram_random_value(rng, DUNGEON_HEIGHT, 256);
+        dungeon->encounter_steps = (uint8_t)random_stream_bounded(rng, 256);
+        dungeon->boss_defeated = random_stream_chance(rng, 30);
+        dungeon->completed = random_stream_chance(rng, 30);
+        dungeon->floors_loaded = (uint8_t)random_stream_bounded(rng, 1 << MAX_DUNGEON_FLOORS);
+        sram_random_bitset(dungeon->explored_tiles, rng);
+        sram_random_bitset(dungeon->treasure_collected, rng);
+    }
+
+    save_data->party_data.member_count = (uint8_t)random_stream_range(rng, 0, MAX_PARTY_SIZE);
+    for (uint8_t i = 0; i < save_data->party_data.member_count; i++) {
+        SaveMemberData* member = &save_data->party_data.members[i];
+        sram_random_name(member->name, rng);
+        member->job = (JobType)(random_stream_chance(rng, 5) ? JOB_NONE : random_stream_bounded(rng, MAX_JOB_TYPES));
+        member->level = (uint8_t)random_stream_range(rng, 1, 99);
+        member->experience = sram_random_value(rng, 100000, 0);
+        member->max_hp = (uint16_t)sram_random_value(rng, 1000, 65536);
+        member->current_hp = (uint16_t)random_stream_range(rng, 0, member->max_hp);
+        member->max_mp = (uint16_t)sram_random_value(rng, 300, 65536);
+        member->current_mp = (uint16_t)random_stream_range(rng, 0, member->max_mp);
+        member->attack = (uint8_t)random_stream_bounded(rng, 256);
+        member->defense = (uint8_t)random_stream_bounded(rng, 256);
+        member->intelligence = (uint8_t)random_stream_bounded(rng, 256);
+        member->agility = (uint8_t)random_stream_bounded(rng, 256);
+        member->luck = (uint8_t)random_stream_bounded(rng, 256);
+        member->skill_count = (uint8_t)random_stream_range(rng, 0, MAX_SKILLS);
+        for (uint8_t s = 0; s < member->skill_count; s++) member->skills[s] = (uint8_t)random_stream_bounded(rng, 256);
+        for (uint8_t e = 0; e < EQUIP_SLOT_COUNT; e++) {
+            member->equipped_items[e] = random_stream_chance(rng, 30) ? EQUIP_NONE
+                                                                      : (uint8_t)random_stream_bounded(rng, MAX_EQUIPMENT_SLOTS);
+        }
+        member->status_effects = random_stream_chance(rng, 80) ? 0 : (uint8_t)random_stream_bounded(rng, 256);
+    }
+
+    // Database entries mostly, edited ones now and then
+    save_data->inventory_data.item_count = (uint8_t)random_stream_range(rng, 0, MAX_INVENTORY_ITEMS);
+    for (uint8_t i = 0; i < save_data->inventory_data.item_count; i++) {
+        SaveItemData* item = &save_data->inventory_data.items[i];
+        item->item_id = (uint8_t)random_stream_bounded(rng, ITEM_CONSUMABLE_COUNT + 2);
+        item->quantity = (uint8_t)sram_random_value(rng, 15, 256);
+        if (random_stream_chance(rng, 90)) {
+            Item entry = item_create_consumable(item->item_id);
+            safe_string_copy(item->name, entry.name, MAX_NAME_LENGTH);
+        } else {
+            sram_random_name(item->name, rng);
+        }
+    }
+
+    save_data->inventory_data.equipment_count = (uint8_t)random_stream_range(rng, 0, MAX_EQUIPMENT_SLOTS);
+    for (uint8_t i = 0; i < save_data->inventory_data.equipment_count; i++) {
+        SaveEquipmentData* equip = &save_data->inventory_data.equipment[i];
+        Item entry = item_create_equipment((uint8_t)random_stream_bounded(rng, 80));
+        equip->equipment_id = entry.item_id;
+        equip->slot = (EquipmentSlot)entry.equip_type;
+        equip->attack_bonus = entry.attack_bonus;
+        equip->defense_bonus = entry.defense_bonus;
+        equip->intelligence_bonus = entry.intelligence_bonus;
+        equip->agility_bonus = entry.agility_bonus;
+        equip->is_equipped = random_stream_chance(rng, 40);
+        safe_string_copy(equip->name, entry.name, MAX_NAME_LENGTH);
+        if (random_stream_chance(rng, 10)) equip->attack_bonus = (uint8_t)random_stream_bounded(rng, 256);
+    }
+
+    save_data->checksum = calculate_checksum(save_data);
+}
+
+// Beyond every short code: counts, enums and totals escaped, names not plain
+// text, nothing left out, and bitsets whose runs (and row differences) are
+// all one or two bits long
+static void sram_build_worst(SaveData* save_data) {
+    memset(save_data, 0, sizeof(SaveData));
+    save_data->magic = SAVE_MAGIC;
+    save_data->version = SAVE_DATA_VERSION;
+
+    save_data->current_state = (GameState)0x7FFFFFFF;
+    save_data->current_dungeon_index = 0xFF;
+    save_data->key_items_collected = 0xFF;
+    save_data->gold = 0xFFFF;
+    save_data->game_time = 0xFFFFFFFF;
+    save_data->world_x = 0xFF;
+    save_data->world_y = 0xFF;
+    save_data->world_encounter_steps = 0xFF;
+    save_data->hub_state = (GameState)0x7FFFFFFF;
+
+    for (uint8_t i = 0; i <= MAX_DUNGEONS; i++) {
+        SaveDungeonData* dungeon = &save_data->dungeon_data[i];
+        save_data->dungeon_initialized[i] = true;
+        dungeon->current_floor = 0xFF;
+        dungeon->player_x = 0xFF;
+        dungeon->player_y = 0xFF;
+        for (uint16_t tile = 0; tile < DUNGEON_WIDTH * DUNGEON_HEIGHT; tile++) {
+            uint8_t x = tile % DUNGEON_WIDTH;
+            uint8_t y = (uint8_t)(tile / DUNGEON_WIDTH);
+            if (((x + y) >> 1) & 1) dungeon->explored_tiles[tile / 8] |= (uint8_t)(1 << (tile % 8));
+        }
+        memcpy(dungeon->treasure_collected, dungeon->explored_tiles, DUNGEON_EXPLORED_BYTES);
+    }
+
+    save_data->party_data.member_count = 0xFF;
+    for (uint8_t i = 0; i < MAX_PARTY_SIZE; i++) {
+        SaveMemberData* member = &save_data->party_data.members[i];
+        memset(member->name, 0xC0, MAX_NAME_LENGTH);
+        member->job = JOB_NONE;
+        member->experience = 0xFFFFFFFF;
+        member->max_hp = member->current_hp = 0xFFFF;
+        member->max_mp = member->current_mp = 0xFFFF;
+        member->skill_count = 0xFF;
+        memset(member->skills, 0xFF, MAX_SKILLS);
+        memset(member->equipped_items, 0xFE, EQUIP_SLOT_COUNT);
+        member->status_effects = 0xFF;
+    }
+
+    save_data->inventory_data.item_count = 0xFF;
+    for (uint8_t i = 0; i < MAX_INVENTORY_ITEMS; i++) {
+        save_data->inventory_data.items[i].quantity = 0xFF;
+        memset(save_data->inventory_data.items[i].name, 0xC0, MAX_NAME_LENGTH);
+    }
+
+    save_data->inventory_data.equipment_count = 0xFF;
+    for (uint8_t i = 0; i < MAX_EQUIPMENT_SLOTS; i++) {
+        save_data->inventory_data.equipment[i].slot = (EquipmentSlot)0x7FFFFFFF;
+        memset(save_data->inventory_data.equipment[i].name, 0xC0, MAX_NAME_LENGTH);
+    }
+
+    save_data->checksum = calculate_checksum(save_data);
+}
+
+// ============================================================================
+// Driver
+// ============================================================================
+
+int main(int argc, char** argv) {
+    uint32_t random_saves = SRAM_DEFAULT_RANDOM_SAVES;
+    uint32_t played_games = SRAM_DEFAULT_PLAYED_GAMES;
+    uint64_t seed = 25;
+    int opt;
+
+    while ((opt = getopt(argc, argv, "n:g:s:h")) != -1) {
+        switch (opt) {
+            case 'n':
+                random_saves = (uint32_t)strtoul(optarg, NULL, 10);
+                break;
+            case 'g':
+                played_games = (uint32_t)strtoul(optarg, NULL, 10);
+                break;
+            case 's':
+                seed = strtoull(optarg, NULL, 10);
+                break;
+            default:
+                printf("Usage: %s [-n random_saves] [-g played_games] [-s seed]\n", argv[0]);
+                return opt == 'h' ? 0 : 1;
+        }
+    }
+
+    static SaveData save_data;
+    SramTally played = { 0 }, random = { 0 }, worst = { 0 };
+    RandomStream rng;
+    random_stream_seed(&rng, seed);
+
+    printf("sram_check: packed save images (SRAM budget %d bytes, raw SaveData %lu bytes)\n",
+           SAVE_SRAM_SIZE, (unsigned long)sizeof(SaveData));
+
+    for (uint32_t i = 0; i < played_games; i++) {
+        sram_mute();
+        sram_build_game(&save_data, &rng);
+        sram_unmute();
+        sram_run(&save_data, "played game", i, &rng, &played);
+    }
+
+    for (uint32_t i = 0; i < random_saves; i++) {
+        sram_build_random(&save_data, &rng);
+        sram_run(&save_data, "random save", i, &rng, &random);
+    }
+
+    sram_build_worst(&save_data);
+    sram_run(&save_data, "worst case", 0, &rng, &worst);
+    if (worst.failures == 0 && worst.max_size != SAVE_PACK_MAX_SIZE) {
+        printf("  FAIL worst case: %u bytes, SAVE_PACK_MAX_SIZE is %d\n", worst.max_size, SAVE_PACK_MAX_SIZE);
+        worst.failures++;
+    }
+
+    sram_report("played games", &played);
+    sram_report("random saves", &random);
+    sram_report("worst case", &worst);
+    if (played.saves) {
+        printf("  images per bank: %d worst case, %u of the largest played game\n",
+               SAVE_SRAM_SIZE / SAVE_PACK_MAX_SIZE, SAVE_SRAM_SIZE / played.max_size);
+    }
+
+    uint32_t failures = played.failures + random.failures + worst.failures;
+    uint32_t total = played_games + random_saves + 1;
+    if (failures) {
+        printf("%u of %u saves failed\n", failures, total);
+        return 1;
+    }
+    printf("All %u saves round-trip byte for byte\n", total);
+    return 0;
+}
@@ -14,9 +14,25 @@ gcc -Wall -Wextra -std=c99 -O2 -c SRC/game_state.c -o obj/game_state.o
 gcc -Wall -Wextra -std=c99 -O2 -c SRC/party.c -o obj/party.o
 gcc -Wall -Wextra -std=c99 -O2 -c SRC/dungeon.c -o obj/dungeon.o
 gcc -Wall -Wextra -std=c99 -O2 -c SRC/dungeon_maps.c -o obj/dungeon_maps.o
+gcc -Wall -Wextra -std=c99 -O2 -c SRC/dungeon_map_data.c -o obj/dungeon_map_data.o
+gcc -Wall -Wextra -std=c99 -O2 -c SRC/pathfind.c -o obj/pathfind.o
+gcc -Wall -Wextra -std=c99 -O2 -c SRC/explore.c -o obj/explore.o
+gcc -Wall -Wextra -std=c99 -O2 -c SRC/world_map.c -o obj/world_map.o
+gcc -Wall -Wextra -std=c99 -O2 -c SRC/encounter.c -o obj/encounter.o
+gcc -Wall -Wextra -std=c99 -O2 -c SRC/town_map.c -o obj/town_map.o
+gcc -Wall -Wextra -std=c99 -O2 -c SRC/greenleaf_map.c -o obj/greenleaf_map.o
+gcc -Wall -Wextra -std=c99 -O2 -c SRC/coral_bay_map.c -o obj/coral_bay_map.o
+gcc -Wall -Wextra -std=c99 -O2 -c SRC/emberforge_map.c -o obj/emberforge_map.o
+gcc -Wall -Wextra -std=c99 -O2 -c SRC/windspire_map.c -o obj/windspire_map.o
 gcc -Wall -Wextra -std=c99 -O2 -c SRC/battle.c -o obj/battle.o
+gcc -Wall -Wextra -std=c99 -O2 -c SRC/battle_event.c -o obj/battle_event.o
+gcc -Wall -Wextra -std=c99 -O2 -c SRC/battle_ai.c -o obj/battle_ai.o
+gcc -Wall -Wextra -std=c99 -O2 -c SRC/screen.c -o obj/screen.o
 gcc -Wall -Wextra -std=c99 -O2 -c SRC/inventory.c -o obj/inventory.o
 gcc -Wall -Wextra -std=c99 -O2 -c SRC/save_system.c -o obj/save_system.o
+gcc -Wall -Wextra -std=c99 -O2 -c SRC/save_format.c -o obj/save_format.o
+gcc -Wall -Wextra -std=c99 -O2 -c SRC/autosave.c -o obj/autosave.o
+gcc -Wall -Wextra -std=c99 -O2 -c SRC/save_pack.c -o obj/save_pack.o
 gcc -Wall -Wextra -std=c99 -O2 -c SRC/utils.c -o obj/utils.o
 
 if errorlevel 1 (
@@ -28,7 +44,7 @@ if errorlevel 1 (
 
 REM Link all object files
 echo Linking...
-gcc obj/main.o obj/game_state.o obj/party.o obj/dungeon.o obj/dungeon_maps.o obj/battle.o obj/inventory.o obj/save_system.o obj/utils.o -o rpg_game.exe
+gcc obj/main.o obj/game_state.o obj/party.o obj/dungeon.o obj/dungeon_maps.o obj/dungeon_map_data.o obj/pathfind.o obj/explore.o obj/world_map.o obj/encounter.o obj/town_map.o obj/greenleaf_map.o obj/coral_bay_map.o obj/emberforge_map.o obj/windspire_map.o obj/battle.o obj/battle_event.o obj/battle_ai.o obj/inventory.o obj/save_system.o obj/save_format.o obj/save_pack.o obj/autosave.o obj/screen.o obj/utils.o -o rpg_game.exe
 
 if errorlevel 1 (
     echo.
@@ -244,6 +244,7 @@ print("\n💾 Generating C code...")
 
 with open("SRC/world_map_generated.c", "w") as f:
     f.write("""#include "world_map.h"
+#include "utils.h"
 #include <string.h>
 
 // Global world map instance
@@ -288,6 +289,27 @@ static const uint8_t world_map_zones[WORLD_MAP_HEIGHT][WORLD_MAP_WIDTH] = {
 
     f.write("};\n\n")
 
+    # Write passability bitmap (1 = walkable); bit x % 64 of word x / 64
+    f.write("""// Passability, one bit per tile (1 = walkable): bit x % 64 of word x / 64.
+// Water (0x20-0x2F) and mountains (0x30-0x3F) are blocked.
+const uint64_t world_map_passable[WORLD_MAP_HEIGHT][WORLD_MAP_ROW_WORDS] = {
+""")
+
+    for y in range(HEIGHT):
+        words = []
+        for w in range(WIDTH // 64):
+            bits = 0
+            for b in range(64):
+                if not (0x20 <= world_map[y][w * 64 + b] < 0x40):
+                    bits |= 1 << b
+            words.append(f"0x{bits:016X}ULL")
+        f.write("    {" + ",".join(words) + "}")
+        if y < HEIGHT - 1:
+            f.write(",")
+        f.write(f"  // Row {y}\n")
+
+    f.write("};\n\n")
+
     # Write location data
     f.write("""// Town coordinates (x, y) and names
 static const WorldLocation default_towns[NUM_TOWNS] = {
@@ -314,22 +336,10 @@ void world_map_init(void) {
     memcpy(g_world_map.tiles, world_map_tiles, sizeof(world_map_tiles));
     memcpy(g_world_map.zones, world_map_zones, sizeof(world_map_zones));
 
-    // Initialize collision based on tile types
-    for (int y = 0; y < WORLD_MAP_HEIGHT; y++) {
-        for (int x = 0; x < WORLD_MAP_WIDTH; x++) {
-            uint8_t tile = g_world_map.tiles[y][x];
-            // Water (0x20-0x2F) and mountains (0x30-0x3F) are impassable
-            if ((tile >= 0x20 && tile < 0x30) || (tile >= 0x30 && tile < 0x40)) {
-                g_world_map.collision[y][x] = 1;  // Blocked
-            } else {
-                g_world_map.collision[y][x] = 0;  // Walkable
-            }
-        }
-    }
-
     // Copy location data
     memcpy(g_world_map.towns, default_towns, sizeof(default_towns));
     memcpy(g_world_map.dungeons, default_dungeons, sizeof(default_dungeons));
+    world_map_build_location_index();
 }
 
 uint8_t world_map_get_tile(uint8_t x, uint8_t y) {
@@ -344,7 +354,44 @@ uint8_t world_map_get_zone(uint8_t x, uint8_t y) {
 
 uint8_t world_map_is_passable(uint8_t x, uint8_t y) {
     if (x >= WORLD_MAP_WIDTH || y >= WORLD_MAP_HEIGHT) return 0;
-    return !g_world_map.collision[y][x];
+    return (uint8_t)((world_map_passable[y][x >> 6] >> (x & 63)) & 1);
+}
+
+// Bits lo..hi (inclusive, both 0-63) of one word
+static uint64_t world_map_span_mask(uint8_t lo, uint8_t hi) {
+    return (~UINT64_C(0) >> (63 - hi)) & (~UINT64_C(0) << lo);
+}
+
+// All of columns x..last of row y passable, checked 64 tiles per word
+static bool world_map_row_span_passable(const uint64_t* row, uint8_t x, uint8_t last) {
+    uint8_t first_word = x >> 6;
+    uint8_t last_word = last >> 6;
+
+    for (uint8_t w = first_word; w <= last_word; w++) {
+        uint8_t lo = (w == first_word) ? (x & 63) : 0;
+        uint8_t hi = (w == last_word) ? (last & 63) : 63;
+        uint64_t mask = world_map_span_mask(lo, hi);
+        if ((row[w] & mask) != mask) return false;
+    }
+    return true;
+}
+
+bool world_map_row_is_passable(uint8_t x, uint8_t y, uint8_t width) {
+    if (width == 0) return true;
+    if (y >= WORLD_MAP_HEIGHT || x >= WORLD_MAP_WIDTH || width > WORLD_MAP_WIDTH - x) return false;
+    return world_map_row_span_passable(world_map_passable[y], x, (uint8_t)(x + width - 1));
+}
+
+bool world_map_rect_is_passable(uint8_t x, uint8_t y, uint8_t width, uint8_t height) {
+    if (width == 0 || height == 0) return true;
+    if (x >= WORLD_MAP_WIDTH || width > WORLD_MAP_WIDTH - x) return false;
+    if (y >= WORLD_MAP_HEIGHT || height > WORLD_MAP_HEIGHT - y) return false;
+
+    uint8_t last = (uint8_t)(x + width - 1);
+    for (uint8_t row = y; row < y + height; row++) {
+        if (!world_map_row_span_passable(world_map_passable[row], x, last)) return false;
+    }
+    return true;
 }
 
 void world_map_set_player_position(uint8_t x, uint8_t y) {
@@ -353,23 +400,143 @@ void world_map_set_player_position(uint8_t x, uint8_t y) {
     (void)y;
 }
 
-WorldLocation* world_map_get_location_at(uint8_t x, uint8_t y) {
-    // Check if coordinates match any town or dungeon (within 2x2 area)
-    for (int i = 0; i < NUM_TOWNS; i++) {
-        int tx = g_world_map.towns[i].x;
-        int ty = g_world_map.towns[i].y;
-        if (x >= tx && x <= tx+1 && y >= ty && y <= ty+1) {
-            return &g_world_map.towns[i];
+WorldLocation* world_map_get_location(uint16_t id) {
+    if (id < NUM_TOWNS) return &g_world_map.towns[id];
+    if (id < WORLD_LOCATION_COUNT) return &g_world_map.dungeons[id - NUM_TOWNS];
+    return NULL;
+}
+
+// Cell range [first, last] covered by a location's footprint along one axis
+static void world_map_cell_span(uint8_t origin, uint8_t limit, uint8_t* first, uint8_t* last) {
+    uint8_t end = origin + WORLD_LOCATION_SIZE - 1;
+    if (end >= limit) end = limit - 1;
+    *first = origin >> WORLD_CELL_SHIFT;
+    *last = end >> WORLD_CELL_SHIFT;
+}
+
+void world_map_build_location_index(void) {
+    WorldLocationIndex* index = &g_world_map.location_index;
+    memset(index->cell_start, 0, sizeof(index->cell_start));
+
+    // Pass 1: count entries per cell (offset by one for the prefix sum)
+    for (uint16_t id = 0; id < WORLD_LOCATION_COUNT; id++) {
+        const WorldLocation* location = world_map_get_location(id);
+        if (location->x >= WORLD_MAP_WIDTH || location->y >= WORLD_MAP_HEIGHT) continue;
+
+        uint8_t cx0, cx1, cy0, cy1;
+        world_map_cell_span(location->x, WORLD_MAP_WIDTH, &cx0, &cx1);
+        world_map_cell_span(location->y, WORLD_MAP_HEIGHT, &cy0, &cy1);
+        for (uint8_t cy = cy0; cy <= cy1; cy++) {
+            for (uint8_t cx = cx0; cx <= cx1; cx++) {
+                index->cell_start[cy * WORLD_CELL_COLS + cx + 1]++;
+            }
+        }
+    }
+    for (uint16_t cell = 0; cell < WORLD_CELL_COUNT; cell++) {
+        index->cell_start[cell + 1] += index->cell_start[cell];
+    }
+
+    // Pass 2: fill in id order so towns still win over dungeons on overlap
+    uint16_t fill[WORLD_CELL_COUNT];
+    memcpy(fill, index->cell_start, sizeof(fill));
+    for (uint16_t id = 0; id < WORLD_LOCATION_COUNT; id++) {
+        const WorldLocation* location = world_map_get_location(id);
+        if (location->x >= WORLD_MAP_WIDTH || location->y >= WORLD_MAP_HEIGHT) continue;
+
+        uint8_t cx0, cx1, cy0, cy1;
+        world_map_cell_span(location->x, WORLD_MAP_WIDTH, &cx0, &cx1);
+        world_map_cell_span(location->y, WORLD_MAP_HEIGHT, &cy0, &cy1);
+        for (uint8_t cy = cy0; cy <= cy1; cy++) {
+            for (uint8_t cx = cx0; cx <= cx1; cx++) {
+                index->entries[fill[cy * WORLD_CELL_COLS + cx]++] = id;
+            }
         }
     }
-    for (int i = 0; i < NUM_DUNGEONS; i++) {
-        int dx = g_world_map.dungeons[i].x;
-        int dy = g_world_map.dungeons[i].y;
-        if (x >= dx && x <= dx+1 && y >= dy && y <= dy+1) {
-            return &g_world_map.dungeons[i];
+}
+
+uint16_t world_map_get_location_id_at(uint8_t x, uint8_t y) {
+    if (x >= WORLD_MAP_WIDTH || y >= WORLD_MAP_HEIGHT) return WORLD_LOCATION_NONE;
+
+    // Only the locations registered in this tile's cell can cover it
+    const WorldLocationIndex* index = &g_world_map.location_index;
+    uint16_t cell = (uint16_t)(y >> WORLD_CELL_SHIFT) * WORLD_CELL_COLS + (x >> WORLD_CELL_SHIFT);
+    for (uint16_t i = index->cell_start[cell]; i < index->cell_start[cell + 1]; i++) {
+        const WorldLocation* location = world_map_get_location(index->entries[i]);
+        if (x >= location->x && x < location->x + WORLD_LOCATION_SIZE &&
+            y >= location->y && y < location->y + WORLD_LOCATION_SIZE) {
+            return index->entries[i];
         }
     }
-    return NULL;
+    return WORLD_LOCATION_NONE;
+}
+
+WorldLocation* world_map_get_location_at(uint8_t x, uint8_t y) {
+    uint16_t id = world_map_get_location_id_at(x, y);
+    return (id == WORLD_LOCATION_NONE) ? NULL : world_map_get_location(id);
+}
+
+void world_map_get_camera(uint8_t x, uint8_t y, uint8_t* camera_x, uint8_t* camera_y) {
+    int cx = x - WORLD_VIEW_WIDTH / 2;
+    int cy = y - WORLD_VIEW_HEIGHT / 2;
+
+    if (cx > WORLD_MAP_WIDTH - WORLD_VIEW_WIDTH) cx = WORLD_MAP_WIDTH - WORLD_VIEW_WIDTH;
+    if (cy > WORLD_MAP_HEIGHT - WORLD_VIEW_HEIGHT) cy = WORLD_MAP_HEIGHT - WORLD_VIEW_HEIGHT;
+    if (cx < 0) cx = 0;
+    if (cy < 0) cy = 0;
+
+    *camera_x = (uint8_t)cx;
+    *camera_y = (uint8_t)cy;
+}
+
+// ============================================================================
+// Zone encounters
+// ============================================================================
+
+typedef struct {
+    const char* name;
+    uint8_t level;       // Enemy level; 0 = no encounters
+    uint8_t min_steps;   // Steps between encounters
+    uint8_t max_steps;
+} WorldZoneInfo;
+
+static const WorldZoneInfo world_zone_info[] = {
+    [ZONE_NONE]         = { "Wilds",         0,  0,  0 },
+    [ZONE_GRASSLAND]    = { "Grassland",     1, 20, 35 },
+    [ZONE_FOREST]       = { "Forest",        3, 15, 30 },
+    [ZONE_DESERT]       = { "Desert",        3, 15, 30 },
+    [ZONE_MOUNTAIN]     = { "Mountains",     5, 12, 25 },
+    [ZONE_COAST]        = { "Coast",         2, 18, 32 },
+    [ZONE_DEEP_WATER]   = { "Deep Water",    0,  0,  0 },
+    [ZONE_HIGHLAND]     = { "Highlands",     5, 12, 25 },
+    [ZONE_SANCTUM_PATH] = { "Sanctum Path",  8, 10, 20 },
+};
+
+#define WORLD_ZONE_COUNT (sizeof(world_zone_info) / sizeof(world_zone_info[0]))
+
+const char* world_map_zone_name(uint8_t zone) {
+    return (zone < WORLD_ZONE_COUNT) ? world_zone_info[zone].name : world_zone_info[ZONE_NONE].name;
+}
+
+uint8_t world_map_zone_level(uint8_t zone) {
+    return (zone < WORLD_ZONE_COUNT) ? world_zone_info[zone].level : 0;
+}
+
+bool world_map_check_encounter(uint8_t x, uint8_t y, uint8_t* steps_left) {
+    uint8_t zone = world_map_get_zone(x, y);
+    if (!steps_left || world_map_zone_level(zone) == 0) return false;
+
+    // Step-counter encounters as in dungeons; the count is drawn from the
+    // zone the party is in when the previous one fired (0 = not drawn yet)
+    const WorldZoneInfo* info = &world_zone_info[zone];
+    RandomStream* rng = random_get_stream(RNG_STREAM_ENCOUNTER);
+    if (*steps_left == 0) {
+        *steps_left = (uint8_t)random_stream_range(rng, info->min_steps, info->max_steps);
+        return false;
+    }
+    if (--*steps_left > 0) return false;
+
+    *steps_left = (uint8_t)random_stream_range(rng, info->min_steps, info->max_steps);
+    return true;
 }
 """)
 